@@ -0,0 +1,182 @@
+/*
+ * Self-organizing lists under skewed access: looks keys up with Zipf-distributed popularity and reports how
+ * many nodes each successful find visits on average, and how long it takes, for every reorganization policy.
+ *
+ * usage: bench_reorg [keys] [lookups] [zipf exponent]
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <math.h>
+# include <time.h>
+# include "./include/dlist.h"
+# include "./include/slist.h"
+
+static size_t bench_keys = 1000;
+static size_t bench_lookups = 1000000;
+static double bench_exponent = 1.0;
+
+static int * values;
+static double * cdf;
+static size_t * order;
+
+static int target;
+static uint64_t visited;
+static uint64_t rng_state = 88172645463325252ULL;
+
+
+static uint64_t __bench_rand(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double __bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Draws a key rank, rank r (from 0) being chosen with probability proportional to 1 / (r + 1)^s
+ */
+static size_t __bench_zipf(void)
+{
+    double u = (double)(__bench_rand() >> 11) * (1.0 / 9007199254740992.0);
+    size_t lo = 0, hi = bench_keys - 1;
+
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (cdf[mid] < u) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Lookup predicate; it runs once per node a find visits
+ */
+static bool __bench_is_target(const jll_data_t * dptr)
+{
+    visited++;
+    return *(const int *)dptr == target;
+}
+
+static const char * __bench_policy_name(jll_reorg_policy_t policy)
+{
+    switch (policy)
+    {
+        case JLL_REORG_MOVE_TO_FRONT: return "move-to-front";
+        case JLL_REORG_TRANSPOSE:     return "transpose";
+        case JLL_REORG_COUNT:         return "count";
+        default:                      return "none";
+    }
+}
+
+static void __bench_report(const char * kind, jll_reorg_policy_t policy, double seconds)
+{
+    printf("%-6s %-14s %10.2f nodes/lookup %10.1f ns/lookup\n", kind, __bench_policy_name(policy),
+           (double)visited / (double)bench_lookups, seconds * 1e9 / (double)bench_lookups);
+}
+
+static void __bench_dlist(jll_reorg_policy_t policy)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    jll_dlist_set_reorg_policy(dlist, policy);
+
+    for (size_t k = 0; k < bench_keys; k++) jll_dlist_append_tail(dlist, (const jll_data_t *)&values[order[k]]);
+
+    // Replaying the ranks from a fixed seed gives every list and policy identical traffic.
+    rng_state = 88172645463325252ULL;
+    visited = 0;
+
+    double start = __bench_now();
+    for (size_t k = 0; k < bench_lookups; k++)
+    {
+        target = values[__bench_zipf()];
+        if (!jll_dlist_find_first_occurrence(dlist, __bench_is_target)) abort();
+    }
+
+    __bench_report("dlist", policy, __bench_now() - start);
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+static void __bench_slist(jll_reorg_policy_t policy)
+{
+    jll_slist_t * slist = jll_alloc_slist(NULL, false, false, false);
+    jll_slist_set_reorg_policy(slist, policy);
+
+    for (size_t k = 0; k < bench_keys; k++) jll_slist_append_tail(slist, (const jll_data_t *)&values[order[k]]);
+
+    // Replaying the ranks from a fixed seed gives every list and policy identical traffic.
+    rng_state = 88172645463325252ULL;
+    visited = 0;
+
+    double start = __bench_now();
+    for (size_t k = 0; k < bench_lookups; k++)
+    {
+        target = values[__bench_zipf()];
+        if (!jll_slist_find_first_occurrence(slist, __bench_is_target)) abort();
+    }
+
+    __bench_report("slist", policy, __bench_now() - start);
+    jll_dealloc_slist(slist, NULL);
+}
+
+
+int main(int argc, char ** argv)
+{
+    if (argc > 1) bench_keys = (size_t)strtoull(argv[1], NULL, 10);
+    if (argc > 2) bench_lookups = (size_t)strtoull(argv[2], NULL, 10);
+    if (argc > 3) bench_exponent = strtod(argv[3], NULL);
+
+    if ((bench_keys == 0) || (bench_lookups == 0))
+    {
+        fprintf(stderr, "usage: %s [keys] [lookups] [zipf exponent]\n", argv[0]);
+        return 1;
+    }
+
+    values = (int *)malloc(bench_keys * sizeof(int));
+    cdf = (double *)malloc(bench_keys * sizeof(double));
+    order = (size_t *)malloc(bench_keys * sizeof(size_t));
+
+    double total = 0;
+    for (size_t k = 0; k < bench_keys; k++)
+    {
+        values[k] = (int)k;
+        total += 1.0 / pow((double)(k + 1), bench_exponent);
+        cdf[k] = total;
+    }
+    for (size_t k = 0; k < bench_keys; k++) cdf[k] /= total;
+    cdf[bench_keys - 1] = 1.0;
+
+    // Insert in shuffled order, so popular keys start out anywhere in the list.
+    for (size_t k = 0; k < bench_keys; k++) order[k] = k;
+    for (size_t k = bench_keys - 1; k > 0; k--)
+    {
+        size_t j = __bench_rand() % (k + 1);
+        size_t swap = order[k];
+        order[k] = order[j];
+        order[j] = swap;
+    }
+
+    printf("%zu keys, %zu lookups, zipf exponent %.2f\n", bench_keys, bench_lookups, bench_exponent);
+
+    jll_reorg_policy_t policies[] = { JLL_REORG_NONE, JLL_REORG_MOVE_TO_FRONT, JLL_REORG_TRANSPOSE, JLL_REORG_COUNT };
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++)
+    {
+        __bench_slist(policies[p]);
+        __bench_dlist(policies[p]);
+    }
+
+    free(values);
+    free(cdf);
+    free(order);
+    return 0;
+}
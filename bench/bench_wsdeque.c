@@ -0,0 +1,245 @@
+/*
+ * Fork/join scheduling from 1 to 64 threads: every worker runs a binary tree of tasks out of its own queue,
+ * forking two subtasks per inner task, and idle workers steal from random victims. The work-stealing deque
+ * (lock-free owner operations, CAS steals of half the victim's queue) is compared with per-worker dlists
+ * under one mutex each, where owners pop the tail and thieves take the head.
+ *
+ * usage: bench_wsdeque [tree depth] [leaf work]
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <stdint.h>
+# include <time.h>
+# include <pthread.h>
+# include <sched.h>
+# include "./include/wsdeque.h"
+# include "./include/dlist.h"
+
+# define BENCH_MAX_THREADS 64
+# define BENCH_FLUSH       256
+
+static size_t bench_depth = 20;
+static size_t bench_leaf_work = 200;
+
+/**
+ * @brief Per-worker task queue of either kind, padded so neighbouring workers do not share a line
+ */
+typedef struct bench_queue_type
+{
+    _Alignas(JLL_WSDEQUE_LINE) jll_wsdeque_t * deque;
+
+    pthread_mutex_t lock;
+    jll_dlist_t * dlist;
+
+} bench_queue_t;
+
+typedef struct bench_worker_type
+{
+    size_t self;
+    size_t threads;
+    bool locked;
+    uint64_t rng;
+
+} bench_worker_t;
+
+static bench_queue_t queues[BENCH_MAX_THREADS];
+static size_t bench_total;
+static size_t bench_executed;
+static volatile uint64_t bench_sink;
+
+
+static uint64_t __bench_rand(uint64_t * state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static double __bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* Tasks are encoded in the data pointer as their remaining depth plus one, so they are never NULL. */
+
+static const jll_data_t * __bench_task(size_t depth)
+{
+    return (const jll_data_t *)(uintptr_t)(depth + 1);
+}
+
+static size_t __bench_depth_of(const jll_data_t * dptr)
+{
+    return (size_t)(uintptr_t)dptr - 1;
+}
+
+
+/* queue operations of both kinds */
+
+static void __bench_push(bench_worker_t * worker, const jll_data_t * dptr)
+{
+    bench_queue_t * queue = &queues[worker->self];
+
+    if (!worker->locked) return jll_wsdeque_push(queue->deque, dptr);
+
+    pthread_mutex_lock(&queue->lock);
+    jll_dlist_append_tail(queue->dlist, dptr);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static const jll_data_t * __bench_pop(bench_worker_t * worker)
+{
+    bench_queue_t * queue = &queues[worker->self];
+
+    if (!worker->locked) return jll_wsdeque_pop(queue->deque);
+
+    pthread_mutex_lock(&queue->lock);
+    const jll_data_t * dptr = jll_dlist_remove_tail(queue->dlist);
+    pthread_mutex_unlock(&queue->lock);
+
+    return dptr;
+}
+
+/**
+ * @brief Takes work from a random victim: half its deque, or the head of its dlist
+ */
+static const jll_data_t * __bench_steal(bench_worker_t * worker)
+{
+    size_t victim = __bench_rand(&worker->rng) % worker->threads;
+    if (victim == worker->self) return NULL;
+
+    if (!worker->locked)
+    {
+        bench_queue_t * queue = &queues[worker->self];
+        if (!jll_wsdeque_steal_half_into(queues[victim].deque, queue->deque)) return NULL;
+
+        return jll_wsdeque_pop(queue->deque);
+    }
+
+    pthread_mutex_lock(&queues[victim].lock);
+    const jll_data_t * dptr = jll_dlist_remove_head(queues[victim].dlist);
+    pthread_mutex_unlock(&queues[victim].lock);
+
+    return dptr;
+}
+
+
+/* workers */
+
+static void __bench_run_task(bench_worker_t * worker, const jll_data_t * dptr)
+{
+    size_t depth = __bench_depth_of(dptr);
+
+    if (depth)
+    {
+        __bench_push(worker, __bench_task(depth - 1));
+        __bench_push(worker, __bench_task(depth - 1));
+        return;
+    }
+
+    uint64_t acc = (uint64_t)(uintptr_t)dptr;
+    for (size_t k = 0; k < bench_leaf_work; k++) acc = acc * 6364136223846793005ULL + 1442695040888963407ULL;
+    bench_sink = acc;
+}
+
+static void * __bench_worker(void * arg)
+{
+    bench_worker_t * worker = (bench_worker_t *)arg;
+    size_t executed = 0;
+
+    for (;;)
+    {
+        const jll_data_t * dptr = __bench_pop(worker);
+        if (!dptr) dptr = __bench_steal(worker);
+
+        if (dptr)
+        {
+            __bench_run_task(worker, dptr);
+            if (++executed < BENCH_FLUSH) continue;
+        }
+
+        // Progress is published in batches, and always before looking for work elsewhere.
+        size_t done = __atomic_add_fetch(&bench_executed, executed, __ATOMIC_RELAXED);
+        executed = 0;
+
+        if (done == bench_total) break;
+
+        // An idle worker gives way, so machines with fewer cores than threads are not held up by spinning.
+        if (!dptr) sched_yield();
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Runs the whole task tree on the given number of threads, the root starting in worker 0's queue
+ *
+ * @returns Elapsed seconds
+ */
+static double __bench_run(size_t threads, bool locked)
+{
+    pthread_t handles[BENCH_MAX_THREADS];
+    bench_worker_t workers[BENCH_MAX_THREADS];
+
+    for (size_t k = 0; k < threads; k++)
+    {
+        queues[k].deque = jll_alloc_wsdeque(0);
+        queues[k].dlist = jll_alloc_dlist(NULL, false, false, false);
+        pthread_mutex_init(&queues[k].lock, NULL);
+
+        workers[k].self = k;
+        workers[k].threads = threads;
+        workers[k].locked = locked;
+        workers[k].rng = 0x9E3779B97F4A7C15ULL * (k + 1);
+    }
+
+    bench_executed = 0;
+    __bench_push(&workers[0], __bench_task(bench_depth));
+
+    double start = __bench_now();
+
+    for (size_t k = 0; k < threads; k++) pthread_create(&handles[k], NULL, __bench_worker, &workers[k]);
+    for (size_t k = 0; k < threads; k++) pthread_join(handles[k], NULL);
+
+    double seconds = __bench_now() - start;
+
+    for (size_t k = 0; k < threads; k++)
+    {
+        jll_dealloc_wsdeque(queues[k].deque, NULL);
+        jll_dealloc_dlist(queues[k].dlist, NULL);
+        pthread_mutex_destroy(&queues[k].lock);
+    }
+
+    return seconds;
+}
+
+
+int main(int argc, char ** argv)
+{
+    if (argc > 1) bench_depth = (size_t)strtoull(argv[1], NULL, 10);
+    if (argc > 2) bench_leaf_work = (size_t)strtoull(argv[2], NULL, 10);
+
+    if (bench_depth > 40)
+    {
+        fprintf(stderr, "usage: %s [tree depth <= 40] [leaf work]\n", argv[0]);
+        return 1;
+    }
+
+    bench_total = ((size_t)2 << bench_depth) - 1;
+    printf("%zu tasks (depth %zu), %zu steps of leaf work\n", bench_total, bench_depth, bench_leaf_work);
+    printf("%7s %14s %14s %9s\n", "threads", "wsdeque Mt/s", "mutex Mt/s", "speedup");
+
+    for (size_t threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2)
+    {
+        double lock_free = __bench_run(threads, false);
+        double locked = __bench_run(threads, true);
+
+        printf("%7zu %14.2f %14.2f %8.2fx\n", threads, (double)bench_total / lock_free * 1e-6,
+               (double)bench_total / locked * 1e-6, locked / lock_free);
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+
+# ifndef __JLL_BLOOM_H__
+# define __JLL_BLOOM_H__
+
+# include <stdint.h>
+# include "datatype.h"
+
+/**
+ * @brief Counters describing how well a Bloom filter is screening membership queries
+ */
+typedef struct jll_bloom_stats_type
+{
+    size_t queries;
+    size_t negatives;
+    size_t false_positives;
+    size_t rebuilds;
+
+} jll_bloom_stats_t;
+
+/**
+ * @brief Blocked Bloom filter; every key sets all of its bits inside one 512-bit (cache line sized) block
+ */
+typedef struct jll_bloom_type
+{
+    uint64_t * blocks;
+    size_t nblocks;
+    unsigned nhashes;
+
+    size_t capacity;
+    size_t inserted;
+    size_t stale;
+    double target_fpr;
+
+    data_hashfunc_t bloom_hash_func;
+
+    jll_bloom_stats_t stats;
+
+} jll_bloom_t;
+
+
+/* allocators and deallocators */
+jll_bloom_t * jll_alloc_bloom(data_hashfunc_t, size_t, double);
+void jll_dealloc_bloom(jll_bloom_t *);
+
+/* filter operations */
+void jll_bloom_insert(jll_bloom_t *, const jll_data_t *);
+bool jll_bloom_may_contain(const jll_bloom_t *, const jll_data_t *);
+void jll_bloom_note_removal(jll_bloom_t *);
+bool jll_bloom_needs_rebuild(const jll_bloom_t *);
+void jll_bloom_reset(jll_bloom_t *, size_t);
+
+/* inspection */
+double jll_bloom_estimated_fpr(const jll_bloom_t *);
+double jll_bloom_observed_fpr(const jll_bloom_t *);
+size_t jll_bloom_bytes(const jll_bloom_t *);
+jll_bloom_stats_t jll_bloom_get_stats(const jll_bloom_t *);
+void jll_bloom_reset_stats(jll_bloom_t *);
+
+
+# endif
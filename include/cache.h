@@ -0,0 +1,95 @@
+
+# ifndef __JLL_CACHE_H__
+# define __JLL_CACHE_H__
+
+# include "dlist.h"
+
+
+typedef enum jll_cache_policy_type
+{
+    JLL_CACHE_LRU,
+    JLL_CACHE_LFU
+
+} jll_cache_policy_t;
+
+/**
+ * @brief Cache entry; the embedded node links the entry into its recency (LRU) or frequency (LFU) list
+ */
+typedef struct jll_cache_entry_type
+{
+    jll_dnode_t node;
+
+    struct jll_cache_entry_type * chain;
+    struct jll_cache_freq_type  * bucket;
+
+    size_t hash;
+    size_t size;
+
+} jll_cache_entry_t;
+
+/**
+ * @brief LFU frequency bucket; buckets are kept in ascending order of access count
+ */
+typedef struct jll_cache_freq_type
+{
+    jll_dlist_t entries;
+    size_t count;
+
+    struct jll_cache_freq_type * next;
+    struct jll_cache_freq_type * prev;
+
+} jll_cache_freq_t;
+
+typedef struct jll_cache_stats_type
+{
+    size_t hits;
+    size_t misses;
+    size_t insertions;
+    size_t evictions;
+
+} jll_cache_stats_t;
+
+typedef struct jll_cache_type
+{
+    jll_cache_entry_t ** table;
+    size_t table_size;
+
+    size_t length;
+    size_t bytes;
+    size_t max_length;
+    size_t max_bytes;
+
+    jll_cache_policy_t policy;
+    jll_dlist_t recency;
+    jll_cache_freq_t * freq_head;
+
+    data_hashfunc_t cache_hash_func;
+    data_compfunc_t cache_comp_func;
+    void (*evict_func)(const jll_data_t *);
+
+    jll_cache_stats_t stats;
+
+} jll_cache_t;
+
+
+/* allocators and deallocators */
+jll_cache_t * jll_alloc_cache(data_hashfunc_t, data_compfunc_t, jll_cache_policy_t, size_t, size_t, void (*)(const jll_data_t *));
+void jll_dealloc_cache(jll_cache_t *, void (*)(const jll_data_t *));
+
+/* cache operations */
+const jll_data_t * jll_cache_get(jll_cache_t *, const jll_data_t *);
+const jll_data_t * jll_cache_peek(jll_cache_t *, const jll_data_t *);
+bool jll_cache_touch(jll_cache_t *, const jll_data_t *);
+const jll_data_t * jll_cache_put(jll_cache_t *, const jll_data_t *, size_t);
+const jll_data_t * jll_cache_remove(jll_cache_t *, const jll_data_t *);
+bool jll_cache_evict(jll_cache_t *);
+void jll_cache_resize(jll_cache_t *, size_t, size_t);
+
+/* inspection */
+size_t jll_cache_length(const jll_cache_t *);
+size_t jll_cache_bytes(const jll_cache_t *);
+jll_cache_stats_t jll_cache_get_stats(const jll_cache_t *);
+void jll_cache_reset_stats(jll_cache_t *);
+
+
+# endif
@@ -0,0 +1,107 @@
+
+# ifndef __JLL_CLIST_H__
+# define __JLL_CLIST_H__
+
+# include <stdio.h>
+# include <stdint.h>
+# include "datatype.h"
+# include "dlist.h"
+# include "latency.h"
+# include "memstat.h"
+
+# define JLL_CLIST_NIL UINT32_MAX
+
+/**
+ * @brief Compact list node; links are 32-bit indices into the owning list's node array
+ */
+typedef struct jll_compact_node_type
+{
+    uint32_t next;
+    uint32_t prev;
+    const jll_data_t * data;
+
+} jll_cnode_t;
+
+/**
+ * @brief Index-linked doubly-linked list. All nodes live in one growable array and refer to each other
+ * by index, so the array can be moved with realloc, written out in one piece or mapped by another process.
+ * Freed slots are chained through their next index and reused before the array grows.
+ */
+typedef struct jll_compact_list_type
+{
+    jll_cnode_t * nodes;
+    uint32_t capacity;
+    uint32_t used;
+    uint32_t free_head;
+
+    uint32_t head;
+    uint32_t tail;
+    size_t length;
+
+    bool circular;
+    bool sorted;
+
+    size_t payload_bytes_issued;
+
+    data_compfunc_t clist_comp_func;
+
+} jll_clist_t;
+
+
+/* allocators and deallocators */
+void jll_init_clist(jll_clist_t *, data_compfunc_t, bool, bool);
+jll_clist_t * jll_alloc_clist(data_compfunc_t, bool, bool);
+void jll_dealloc_clist(jll_clist_t *, void (*)(const jll_data_t *));
+void jll_fini_clist(jll_clist_t *, void (*)(const jll_data_t *));
+void jll_clist_reserve(jll_clist_t *, size_t);
+void jll_clist_shrink_to_fit(jll_clist_t *);
+
+/* insertion functions */
+void jll_clist_append_head(jll_clist_t *, const jll_data_t *);
+void jll_clist_append_tail(jll_clist_t *, const jll_data_t *);
+void jll_clist_insert_sorted(jll_clist_t *, const jll_data_t *);
+void jll_clist_insert_from_payload(jll_clist_t *, const jll_data_payload_t *);
+void jll_clist_insert_from_dlist(jll_clist_t *, const jll_dlist_t *);
+
+/* deletion functions */
+const jll_data_t * jll_clist_remove_index(jll_clist_t *, size_t);
+const jll_data_t * jll_clist_remove_head(jll_clist_t *);
+const jll_data_t * jll_clist_remove_tail(jll_clist_t *);
+const jll_data_t * jll_clist_remove_cond_first(jll_clist_t *, bool (*)(const jll_data_t *));
+const jll_data_t * jll_clist_remove_cond_nth(jll_clist_t *, bool (*)(const jll_data_t *), size_t);
+jll_data_payload_t * jll_clist_remove_cond_first_n(jll_clist_t *, bool (*)(const jll_data_t *), size_t);
+jll_data_payload_t * jll_clist_remove_cond_all(jll_clist_t *, bool (*)(const jll_data_t *));
+jll_data_payload_t * jll_clist_remove_all(jll_clist_t *);
+
+/* export and drain into caller-provided storage */
+size_t jll_clist_to_array(const jll_clist_t *, const jll_data_t **, size_t);
+size_t jll_clist_drain(jll_clist_t *, const jll_data_t **, size_t);
+
+/* access functions */
+const jll_data_t * jll_clist_index_pos(const jll_clist_t *, size_t);
+const jll_data_t * jll_clist_index_head(const jll_clist_t *);
+const jll_data_t * jll_clist_index_tail(const jll_clist_t *);
+const jll_data_t * jll_clist_find_first_occurrence(const jll_clist_t *, bool (*)(const jll_data_t *));
+const jll_data_t * jll_clist_find_nth_occurrence(const jll_clist_t *, bool (*)(const jll_data_t *), size_t);
+bool jll_clist_check_if_sorted(const jll_clist_t *);
+bool jll_clist_check_if_contains(const jll_clist_t *, bool (*)(const jll_data_t *));
+bool jll_clist_is_empty(const jll_clist_t *);
+bool jll_clist_is_circular(const jll_clist_t *);
+
+/* list manipulation */
+void jll_clist_reversal(jll_clist_t *);
+void jll_clist_rotate_n(jll_clist_t *, size_t);
+void jll_clist_concat(jll_clist_t *, jll_clist_t *);
+jll_clist_t * jll_clist_split_at_nth(jll_clist_t *, size_t);
+void jll_clist_merge_sorted(jll_clist_t *, jll_clist_t *);
+size_t jll_clist_unique(jll_clist_t *, void (*)(const jll_data_t *));
+
+/* relocation and serialization */
+bool jll_clist_write(const jll_clist_t *, FILE *);
+jll_clist_t * jll_clist_read(FILE *, data_compfunc_t);
+
+/* memory accounting */
+void jll_clist_memory(const jll_clist_t *, jll_list_memory_t *);
+
+
+# endif
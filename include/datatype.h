@@ -4,6 +4,7 @@
 
 # include <stddef.h>
 # include <stdbool.h>
+# include <stdint.h>
 
 typedef struct jll_data_type
 {
@@ -12,16 +13,73 @@ typedef struct jll_data_type
 } jll_data_t;
 
 typedef int (*data_compfunc_t)(const jll_data_t *, const jll_data_t *);
+typedef size_t (*data_hashfunc_t)(const jll_data_t *);
+typedef void (*data_batchdealloc_t)(const jll_data_t **, size_t);
+typedef uint64_t (*data_keyfunc_t)(const jll_data_t *);
+typedef void (*data_batchpred_t)(const jll_data_t **, size_t, uint8_t *);
+
+/**
+ * @brief Self-organizing policy applied to a list on every successful find or contains check
+ */
+typedef enum jll_reorg_policy_type
+{
+    JLL_REORG_NONE,
+    JLL_REORG_MOVE_TO_FRONT,
+    JLL_REORG_TRANSPOSE,
+    JLL_REORG_COUNT
+
+} jll_reorg_policy_t;
+
+/**
+ * @brief Set operation applied to two sorted lists sharing a comparison function
+ */
+typedef enum jll_setop_type
+{
+    JLL_SET_UNION,
+    JLL_SET_INTERSECTION,
+    JLL_SET_DIFFERENCE,
+    JLL_SET_SYMMETRIC_DIFFERENCE
+
+} jll_setop_t;
+
+/**
+ * @brief What a bounded ring does when a push finds it full
+ */
+typedef enum jll_ring_policy_type
+{
+    JLL_RING_OVERWRITE,
+    JLL_RING_REJECT
+
+} jll_ring_policy_t;
+
+/**
+ * @brief Counters kept by sorted insertion so its adaptivity can be checked on a workload. With cached
+ * keys, comparisons counts only the ties handed to the comparison function; key_decisions counts the rest.
+ */
+typedef struct jll_insert_stats_type
+{
+    size_t inserts;
+    size_t comparisons;
+    size_t hops;
+    size_t tail_hits;
+    size_t finger_hits;
+    size_t key_decisions;
+
+} jll_insert_stats_t;
 
 typedef struct jll_data_payload_type
 {
     const jll_data_t ** data;
     size_t length;
+    size_t capacity;
 
 } jll_data_payload_t;
 
 jll_data_payload_t * jll_allocate_data_payload(const jll_data_t **, size_t);
+jll_data_payload_t * jll_allocate_empty_payload(size_t);
 void jll_deallocate_data_payload(jll_data_payload_t *);
+void jll_data_payload_reserve(jll_data_payload_t *, size_t);
+void jll_data_payload_clear(jll_data_payload_t *);
 
 
 
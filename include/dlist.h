@@ -4,6 +4,10 @@
 # define __JLL_DLIST_H__
 
 # include "dnode.h"
+# include "bloom.h"
+# include "profile.h"
+# include "latency.h"
+# include "memstat.h"
 
 
 typedef struct jll_doubly_list_type
@@ -16,15 +20,52 @@ typedef struct jll_doubly_list_type
     bool circular;
     bool sorted;
     bool persistent;
+    bool keyed;
+
+    jll_reorg_policy_t reorg;
+    jll_bloom_t * bloom;
+
+    size_t payload_bytes_issued;
+
+    jll_pool_t * pool;
+    bool pool_shared;
+    bool heap_header;
+    bool caller_nodes;
+    bool foreign_nodes;
+    size_t generation;
+
+    jll_dnode_t * finger;
+    size_t finger_generation;
+    jll_insert_stats_t insert_stats;
+
+    size_t capacity;
+    jll_ring_policy_t ring_policy;
+    jll_dnode_t * spare;
+    void (*ring_evict_func)(const jll_data_t *);
+
+    size_t scan_batch;
+
+    size_t tombstones;
+    double tombstone_ratio;
 
     data_compfunc_t dlist_comp_func;
+    data_keyfunc_t dlist_key_func;
+
+    // Always present, so the layout does not depend on how the library or its clients were built.
+    jll_profile_t profile;
 
 } jll_dlist_t;
 
 
 /* allocators and deallocators */
+void jll_init_dlist(jll_dlist_t *, data_compfunc_t, bool, bool, bool);
 jll_dlist_t * jll_alloc_dlist(data_compfunc_t, bool, bool, bool);
+jll_dlist_t * jll_alloc_dlist_ring(data_compfunc_t, size_t, jll_ring_policy_t, void (*)(const jll_data_t *));
 void jll_dealloc_dlist(jll_dlist_t *, void (*)(const jll_data_t *));
+void jll_dealloc_dlist_batched(jll_dlist_t *, data_batchdealloc_t);
+void jll_fini_dlist(jll_dlist_t *, void (*)(const jll_data_t *));
+void jll_dealloc_dlist_deferred(jll_dlist_t *, void (*)(const jll_data_t *));
+void jll_dealloc_dlist_deferred_batched(jll_dlist_t *, data_batchdealloc_t);
 
 /* insertion functions */
 void jll_dlist_append_head(jll_dlist_t *, const jll_data_t *);
@@ -44,15 +85,27 @@ jll_data_payload_t * jll_dlist_remove_cond_first_n(jll_dlist_t *, bool (*)(const
 jll_data_payload_t * jll_dlist_remove_cond_all(jll_dlist_t *, bool (*)(const jll_data_t *));
 jll_data_payload_t * jll_dlist_remove_all(jll_dlist_t *);
 
+/* export and drain into caller-provided storage */
+size_t jll_dlist_to_array(const jll_dlist_t *, const jll_data_t **, size_t);
+size_t jll_dlist_export_into(const jll_dlist_t *, jll_data_payload_t *);
+size_t jll_dlist_drain(jll_dlist_t *, const jll_data_t **, size_t);
+size_t jll_dlist_drain_cond(jll_dlist_t *, bool (*)(const jll_data_t *), const jll_data_t **, size_t);
+size_t jll_dlist_drain_into(jll_dlist_t *, jll_data_payload_t *);
+size_t jll_dlist_drain_cond_into(jll_dlist_t *, bool (*)(const jll_data_t *), jll_data_payload_t *);
+
 
 /* access functions */
 const jll_data_t * jll_dlist_index_pos(jll_dlist_t *, size_t);
 const jll_data_t * jll_dlist_index_head(jll_dlist_t *);
 const jll_data_t * jll_dlist_index_tail(jll_dlist_t *);
 const jll_data_t * jll_dlist_find_first_occurrence(jll_dlist_t *, bool (*)(const jll_data_t *));
-const jll_data_t * jll_dlist_nth_occurrence(jll_dlist_t *, bool (*)(const jll_data_t *), size_t);
+const jll_data_t * jll_dlist_find_nth_occurrence(jll_dlist_t *, bool (*)(const jll_data_t *), size_t);
 bool jll_dlist_check_if_sorted(jll_dlist_t *);
 bool jll_dlist_check_if_contains(jll_dlist_t *, bool (*)(const jll_data_t *));
+const jll_data_t * jll_dlist_find_first_batched(jll_dlist_t *, data_batchpred_t);
+const jll_data_t * jll_dlist_find_nth_batched(jll_dlist_t *, data_batchpred_t, size_t);
+bool jll_dlist_check_if_contains_batched(jll_dlist_t *, data_batchpred_t);
+void jll_dlist_set_scan_batch(jll_dlist_t *, size_t);
 bool jll_dlist_is_empty(jll_dlist_t *);
 bool jll_dlist_is_circular(jll_dlist_t *);
 
@@ -61,6 +114,61 @@ void jll_dlist_reversal(jll_dlist_t *);
 void jll_dlist_rotate_n(jll_dlist_t *, size_t);
 void jll_dlist_concat(jll_dlist_t *, jll_dlist_t *);
 jll_dlist_t * jll_dlist_split_at_nth(jll_dlist_t *, size_t);
+void jll_dlist_merge_sorted(jll_dlist_t *, jll_dlist_t *);
+void jll_dlist_merge_sorted_n(jll_dlist_t *, jll_dlist_t **, size_t);
+void jll_dlist_radix_sort(jll_dlist_t *, data_keyfunc_t);
+
+/* node-level operations (no allocation) */
+void jll_dlist_link_head(jll_dlist_t *, jll_dnode_t *);
+void jll_dlist_link_tail(jll_dlist_t *, jll_dnode_t *);
+void jll_dlist_unlink(jll_dlist_t *, jll_dnode_t *);
+void jll_dlist_move_to_head(jll_dlist_t *, jll_dnode_t *);
+void jll_dlist_link_before(jll_dlist_t *, jll_dnode_t *, jll_dnode_t *);
+
+/* set algebra on sorted lists */
+void jll_dlist_set_operation(jll_dlist_t *, jll_dlist_t *, jll_setop_t, void (*)(const jll_data_t *));
+jll_dlist_t * jll_dlist_set_operation_copy(const jll_dlist_t *, const jll_dlist_t *, jll_setop_t);
+size_t jll_dlist_unique(jll_dlist_t *, void (*)(const jll_data_t *));
+size_t jll_dlist_dedupe(jll_dlist_t *, data_hashfunc_t, void (*)(const jll_data_t *));
+
+/* bounded ring mode (pop and peek with remove_head/tail and index_head/tail) */
+bool jll_dlist_ring_push_head(jll_dlist_t *, const jll_data_t *);
+bool jll_dlist_ring_push_tail(jll_dlist_t *, const jll_data_t *);
+bool jll_dlist_ring_is_full(const jll_dlist_t *);
+
+/* cached sort keys (sorted insertion and sortedness checks compare keys before data) */
+bool jll_dlist_set_key_func(jll_dlist_t *, data_keyfunc_t);
+const jll_data_t * jll_dlist_find_cached_key(jll_dlist_t *, uint64_t);
+
+/* self-organization */
+bool jll_dlist_set_reorg_policy(jll_dlist_t *, jll_reorg_policy_t);
+
+/* keyed membership with an optional Bloom filter */
+void jll_dlist_attach_bloom(jll_dlist_t *, data_hashfunc_t, double);
+void jll_dlist_detach_bloom(jll_dlist_t *);
+const jll_data_t * jll_dlist_find_key(jll_dlist_t *, const jll_data_t *);
+bool jll_dlist_check_if_contains_key(jll_dlist_t *, const jll_data_t *);
+
+/* profiling */
+void jll_dlist_get_profile(const jll_dlist_t *, jll_profile_t *);
+void jll_dlist_reset_profile(jll_dlist_t *);
+void jll_dlist_get_insert_stats(const jll_dlist_t *, jll_insert_stats_t *);
+void jll_dlist_reset_insert_stats(jll_dlist_t *);
+
+/* memory accounting */
+void jll_dlist_memory(const jll_dlist_t *, jll_list_memory_t *);
+void jll_dlist_layout(const jll_dlist_t *, jll_layout_report_t *);
+
+/* compaction */
+void jll_dlist_compact(jll_dlist_t *, bool);
+void jll_dlist_compact_begin(jll_dlist_t *, jll_compact_t *, bool);
+bool jll_dlist_compact_step(jll_dlist_t *, jll_compact_t *, size_t);
+void jll_dlist_compact_end(jll_dlist_t *, jll_compact_t *);
+
+/* lazy deletion (removals mark nodes dead; length counts live elements, tombstones the dead nodes left linked) */
+void jll_dlist_set_lazy_delete(jll_dlist_t *, double);
+size_t jll_dlist_purge_tombstones(jll_dlist_t *);
+size_t jll_dlist_tombstones(const jll_dlist_t *);
 
 
 # endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 # define __JLL_DNODE_H__
 
 # include "datatype.h"
+# include "pool.h"
 
 /**
  * @brief Doubly linked list node type
@@ -16,8 +17,29 @@ typedef struct jll_doubly_node_type
 
 } jll_dnode_t;
 
+/**
+ * @brief Doubly linked list node which also caches a sort key and an access count. Lists switch to it
+ * once they are given a key function or the count-ordered policy; the plain node comes first, so it
+ * is linked and passed around as a jll_dnode_t.
+ */
+typedef struct jll_doubly_keyed_node_type
+{
+    jll_dnode_t node;
+    uint64_t key;
+    size_t freq;
+
+} jll_dknode_t;
+
+# define JLL_DKNODE(node) ((jll_dknode_t *)(node))
+
 jll_dnode_t * jll_alloc_dnode(const jll_data_t *);
+jll_dnode_t * jll_alloc_dnode_from(jll_pool_t *, const jll_data_t *);
 const jll_data_t * jll_dealloc_dnode(jll_dnode_t *);
+const jll_data_t * jll_dealloc_dnode_to(jll_pool_t *, jll_dnode_t *);
+jll_dknode_t * jll_alloc_dknode(const jll_data_t *);
+jll_dknode_t * jll_alloc_dknode_from(jll_pool_t *, const jll_data_t *);
+const jll_data_t * jll_dealloc_dknode(jll_dknode_t *);
+const jll_data_t * jll_dealloc_dknode_to(jll_pool_t *, jll_dknode_t *);
 const jll_data_t * jll_access_dnode(const jll_dnode_t *);
 
 
@@ -0,0 +1,68 @@
+
+# ifndef __JLL_GRAPH_H__
+# define __JLL_GRAPH_H__
+
+# include <stdint.h>
+# include "slist.h"
+
+# define JLL_GRAPH_NO_VERTEX UINT32_MAX
+
+typedef uint32_t jll_vertex_t;
+
+/**
+ * @brief Directed graph with two representations. While it is being edited, each vertex's out-edges
+ * are held in an embedded singly-linked list, so adding an edge is an O(1) append. Freezing packs
+ * every edge into compressed sparse row arrays (the out-edges of vertex v are targets[offsets[v]]
+ * to targets[offsets[v + 1] - 1]), which the traversals walk sequentially.
+ *
+ * Unfreezing is free: the arrays stay in place and later edits go to the adjacency lists. A row is
+ * copied out of the arrays ("thawed") only when one of its edges is removed, so the next freeze
+ * merges the untouched rows with the edges added since.
+ */
+typedef struct jll_graph_type
+{
+    size_t vertices;
+    size_t edges;
+    size_t capacity;
+
+    jll_slist_t * adjacency;
+    bool * thawed;
+    jll_pool_t * pool;
+
+    bool frozen;
+    size_t csr_vertices;
+    size_t * offsets;
+    jll_vertex_t * targets;
+
+} jll_graph_t;
+
+
+/* allocators and deallocators */
+jll_graph_t * jll_alloc_graph(size_t);
+void jll_dealloc_graph(jll_graph_t *);
+
+/* editing (the graph must not be frozen) */
+jll_vertex_t jll_graph_add_vertex(jll_graph_t *);
+void jll_graph_add_edge(jll_graph_t *, jll_vertex_t, jll_vertex_t);
+bool jll_graph_remove_edge(jll_graph_t *, jll_vertex_t, jll_vertex_t);
+
+/* representation */
+void jll_graph_freeze(jll_graph_t *);
+void jll_graph_unfreeze(jll_graph_t *);
+bool jll_graph_is_frozen(const jll_graph_t *);
+
+/* access functions */
+size_t jll_graph_vertices(const jll_graph_t *);
+size_t jll_graph_edges(const jll_graph_t *);
+size_t jll_graph_out_degree(const jll_graph_t *, jll_vertex_t);
+bool jll_graph_has_edge(const jll_graph_t *, jll_vertex_t, jll_vertex_t);
+const jll_vertex_t * jll_graph_neighbours(const jll_graph_t *, jll_vertex_t, size_t *);
+
+/* traversals (the graph must be frozen) */
+size_t jll_graph_bfs(const jll_graph_t *, jll_vertex_t, jll_vertex_t *, uint32_t *);
+size_t jll_graph_dfs(const jll_graph_t *, jll_vertex_t, jll_vertex_t *);
+bool jll_graph_topological_sort(const jll_graph_t *, jll_vertex_t *);
+bool jll_graph_has_cycle(const jll_graph_t *);
+
+
+# endif
@@ -0,0 +1,789 @@
+
+# ifndef __JLL_HPP__
+# define __JLL_HPP__
+
+# include <algorithm>
+# include <cassert>
+# include <cstddef>
+# include <initializer_list>
+# include <iterator>
+# include <memory>
+# include <memory_resource>
+# include <new>
+# include <type_traits>
+# include <utility>
+
+extern "C"
+{
+# include "dlist.h"
+# include "slist.h"
+}
+
+/*
+ * Header-only C++ front end over the C lists (C++17; the iterators model the C++20 iterator concepts).
+ *
+ * Each element is constructed in place in one block together with its C node, and the node's data
+ * pointer refers to the element. Blocks come from the container's allocator, which may be a
+ * std::pmr::polymorphic_allocator (see jll::pmr), so nodes can live in a memory resource such as an
+ * arena. The C list header is embedded in the container and only its node-level operations are used,
+ * so nodes are linked, unlinked and spliced without ever being copied.
+ *
+ * c_list() exposes the underlying C list to the read-only C functions (searches, scans, subsequence
+ * matching); functions which allocate, free or copy nodes, or move data between nodes, must not be
+ * called on it.
+ */
+
+namespace jll
+{
+
+namespace detail
+{
+
+/**
+ * @brief C node and element in one allocation; the element's lifetime is managed separately
+ */
+template <class Node, class T>
+struct block : Node
+{
+    union
+    {
+        T value;
+    };
+
+    block() noexcept {}
+    ~block() {}
+};
+
+template <class T, class Allocator, class Node>
+class node_factory
+{
+protected:
+    using block_type = block<Node, T>;
+    using value_traits = std::allocator_traits<Allocator>;
+    using block_allocator = typename value_traits::template rebind_alloc<block_type>;
+    using block_traits = std::allocator_traits<block_allocator>;
+
+    explicit node_factory(const Allocator & alloc) noexcept : alloc_(alloc) {}
+
+    template <class... Args>
+    Node * make_node(Args &&... args)
+    {
+        block_allocator blocks(alloc_);
+        block_type * made = block_traits::allocate(blocks, 1);
+        ::new (static_cast<void *>(made)) block_type();
+
+        try
+        {
+            value_traits::construct(alloc_, std::addressof(made->value), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            made->~block_type();
+            block_traits::deallocate(blocks, made, 1);
+            throw;
+        }
+
+        made->next = nullptr;
+        made->data = reinterpret_cast<const jll_data_t *>(std::addressof(made->value));
+
+        return made;
+    }
+
+    void destroy_node(Node * node) noexcept
+    {
+        block_allocator blocks(alloc_);
+        block_type * made = static_cast<block_type *>(node);
+
+        value_traits::destroy(alloc_, std::addressof(made->value));
+        made->~block_type();
+        block_traits::deallocate(blocks, made, 1);
+    }
+
+    static T & value_of(Node * node) noexcept
+    {
+        return static_cast<block_type *>(node)->value;
+    }
+
+    Allocator alloc_;
+};
+
+} // namespace detail
+
+
+/* doubly-linked list */
+
+template <class T, bool Const>
+class dlist_iterator
+{
+public:
+    using iterator_concept = std::bidirectional_iterator_tag;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    dlist_iterator() noexcept = default;
+    dlist_iterator(const jll_dlist_t * list, jll_dnode_t * node) noexcept : list_(list), node_(node) {}
+
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    dlist_iterator(const dlist_iterator<T, false> & other) noexcept : list_(other.list()), node_(other.node()) {}
+
+    reference operator*() const noexcept { return static_cast<detail::block<jll_dnode_t, T> *>(node_)->value; }
+    pointer operator->() const noexcept { return std::addressof(**this); }
+
+    dlist_iterator & operator++() noexcept
+    {
+        node_ = (node_ == list_->tail) ? nullptr : node_->next;
+        return *this;
+    }
+
+    dlist_iterator operator++(int) noexcept
+    {
+        dlist_iterator before = *this;
+        ++*this;
+        return before;
+    }
+
+    // end() steps back onto the tail.
+    dlist_iterator & operator--() noexcept
+    {
+        node_ = (node_) ? node_->prev : list_->tail;
+        return *this;
+    }
+
+    dlist_iterator operator--(int) noexcept
+    {
+        dlist_iterator before = *this;
+        --*this;
+        return before;
+    }
+
+    friend bool operator==(const dlist_iterator & a, const dlist_iterator & b) noexcept { return a.node_ == b.node_; }
+    friend bool operator!=(const dlist_iterator & a, const dlist_iterator & b) noexcept { return a.node_ != b.node_; }
+
+    /**
+     * @brief Returns the C node handle (NULL for end())
+     */
+    jll_dnode_t * node() const noexcept { return node_; }
+    const jll_dlist_t * list() const noexcept { return list_; }
+
+private:
+    const jll_dlist_t * list_ = nullptr;
+    jll_dnode_t * node_ = nullptr;
+};
+
+/**
+ * @brief RAII doubly-linked list in the manner of std::list, over an embedded jll_dlist_t
+ */
+template <class T, class Allocator = std::allocator<T>>
+class dlist : private detail::node_factory<T, Allocator, jll_dnode_t>
+{
+    using factory = detail::node_factory<T, Allocator, jll_dnode_t>;
+    using typename factory::value_traits;
+    using factory::alloc_;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = dlist_iterator<T, false>;
+    using const_iterator = dlist_iterator<T, true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /* construction and assignment */
+
+    dlist() : dlist(Allocator()) {}
+
+    explicit dlist(const Allocator & alloc) noexcept : factory(alloc)
+    {
+        jll_init_dlist(&list_, nullptr, false, false, false);
+    }
+
+    dlist(std::initializer_list<T> init, const Allocator & alloc = Allocator()) : dlist(init.begin(), init.end(), alloc) {}
+
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    dlist(InputIt first, InputIt last, const Allocator & alloc = Allocator()) : dlist(alloc)
+    {
+        for (; first != last; ++first) emplace_back(*first);
+    }
+
+    dlist(const dlist & other) : dlist(other, value_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    dlist(const dlist & other, const Allocator & alloc) : dlist(other.begin(), other.end(), alloc) {}
+
+    dlist(dlist && other) noexcept : dlist(other.alloc_)
+    {
+        steal(other);
+    }
+
+    dlist(dlist && other, const Allocator & alloc) : dlist(alloc)
+    {
+        if (alloc_ == other.alloc_) steal(other);
+        else move_elements(other);
+    }
+
+    ~dlist()
+    {
+        clear();
+        jll_fini_dlist(&list_, nullptr);
+    }
+
+    dlist & operator=(const dlist & other)
+    {
+        if (this == &other) return *this;
+
+        clear();
+        if constexpr (value_traits::propagate_on_container_copy_assignment::value) alloc_ = other.alloc_;
+
+        for (const T & value : other) emplace_back(value);
+        return *this;
+    }
+
+    dlist & operator=(dlist && other) noexcept(value_traits::is_always_equal::value || value_traits::propagate_on_container_move_assignment::value)
+    {
+        if (this == &other) return *this;
+
+        clear();
+
+        if constexpr (value_traits::propagate_on_container_move_assignment::value)
+        {
+            alloc_ = other.alloc_;
+            steal(other);
+        }
+        else if (alloc_ == other.alloc_) steal(other);
+        else move_elements(other);
+
+        return *this;
+    }
+
+    void swap(dlist & other) noexcept
+    {
+        if constexpr (value_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+        else assert(alloc_ == other.alloc_);
+
+        // Nodes never point at the header of a linear list, so headers can be exchanged wholesale.
+        std::swap(list_, other.list_);
+    }
+
+    friend void swap(dlist & a, dlist & b) noexcept { a.swap(b); }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    /* iterators */
+
+    iterator begin() noexcept { return iterator(&list_, list_.head); }
+    const_iterator begin() const noexcept { return const_iterator(&list_, list_.head); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(&list_, nullptr); }
+    const_iterator end() const noexcept { return const_iterator(&list_, nullptr); }
+    const_iterator cend() const noexcept { return end(); }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /* access */
+
+    bool empty() const noexcept { return list_.length == 0; }
+    size_type size() const noexcept { return list_.length; }
+    reference front() noexcept { return factory::value_of(list_.head); }
+    const_reference front() const noexcept { return factory::value_of(list_.head); }
+    reference back() noexcept { return factory::value_of(list_.tail); }
+    const_reference back() const noexcept { return factory::value_of(list_.tail); }
+
+    jll_dlist_t * c_list() noexcept { return &list_; }
+    const jll_dlist_t * c_list() const noexcept { return &list_; }
+
+    /* insertion (elements are constructed in place) */
+
+    template <class... Args>
+    reference emplace_front(Args &&... args)
+    {
+        jll_dnode_t * node = factory::make_node(std::forward<Args>(args)...);
+        jll_dlist_link_head(&list_, node);
+        return factory::value_of(node);
+    }
+
+    template <class... Args>
+    reference emplace_back(Args &&... args)
+    {
+        jll_dnode_t * node = factory::make_node(std::forward<Args>(args)...);
+        jll_dlist_link_tail(&list_, node);
+        return factory::value_of(node);
+    }
+
+    template <class... Args>
+    iterator emplace(const_iterator pos, Args &&... args)
+    {
+        jll_dnode_t * node = factory::make_node(std::forward<Args>(args)...);
+        link_before(node, pos.node());
+        return iterator(&list_, node);
+    }
+
+    void push_front(const T & value) { emplace_front(value); }
+    void push_front(T && value) { emplace_front(std::move(value)); }
+    void push_back(const T & value) { emplace_back(value); }
+    void push_back(T && value) { emplace_back(std::move(value)); }
+    iterator insert(const_iterator pos, const T & value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T && value) { return emplace(pos, std::move(value)); }
+
+    /* removal */
+
+    void pop_front() noexcept { erase(begin()); }
+    void pop_back() noexcept { erase(const_iterator(&list_, list_.tail)); }
+
+    iterator erase(const_iterator pos) noexcept
+    {
+        jll_dnode_t * node = pos.node();
+        jll_dnode_t * next = (node == list_.tail) ? nullptr : node->next;
+
+        jll_dlist_unlink(&list_, node);
+        factory::destroy_node(node);
+
+        return iterator(&list_, next);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept
+    {
+        while (first != last) first = erase(first);
+        return iterator(&list_, last.node());
+    }
+
+    void clear() noexcept
+    {
+        while (list_.head)
+        {
+            jll_dnode_t * node = list_.head;
+            jll_dlist_unlink(&list_, node);
+            factory::destroy_node(node);
+        }
+    }
+
+    /* relinking (nodes move between lists; both must use equal allocators) */
+
+    void splice(const_iterator pos, dlist & other) noexcept
+    {
+        splice(pos, other, other.begin(), other.end());
+    }
+
+    void splice(const_iterator pos, dlist && other) noexcept { splice(pos, other); }
+
+    void splice(const_iterator pos, dlist & other, const_iterator it) noexcept
+    {
+        assert(alloc_ == other.alloc_);
+        if (it == pos) return;
+
+        jll_dlist_unlink(&other.list_, it.node());
+        link_before(it.node(), pos.node());
+    }
+
+    /**
+     * @brief Moves [first, last) of other before pos, one O(1) relink per node; no element is copied
+     */
+    void splice(const_iterator pos, dlist & other, const_iterator first, const_iterator last) noexcept
+    {
+        assert(alloc_ == other.alloc_);
+
+        while (first != last)
+        {
+            const_iterator next = std::next(first);
+            splice(pos, other, first);
+            first = next;
+        }
+    }
+
+    /**
+     * @brief Reverses the list by relinking nodes (jll_dlist_reversal swaps data pointers between
+     * nodes, which would separate them from the elements stored with them)
+     */
+    void reverse() noexcept
+    {
+        jll_dnode_t * first = list_.head;
+
+        while ((first) && (first != list_.tail))
+        {
+            jll_dnode_t * node = first->next;
+            jll_dlist_unlink(&list_, node);
+            jll_dlist_link_head(&list_, node);
+        }
+    }
+
+private:
+    void link_before(jll_dnode_t * node, jll_dnode_t * at) noexcept
+    {
+        if (at) jll_dlist_link_before(&list_, node, at);
+        else jll_dlist_link_tail(&list_, node);
+    }
+
+    void steal(dlist & other) noexcept
+    {
+        list_ = other.list_;
+        jll_init_dlist(&other.list_, nullptr, false, false, false);
+    }
+
+    void move_elements(dlist & other)
+    {
+        for (T & value : other) emplace_back(std::move(value));
+        other.clear();
+    }
+
+    jll_dlist_t list_;
+};
+
+
+/* singly-linked list */
+
+template <class T, bool Const>
+class slist_iterator
+{
+public:
+    using iterator_concept = std::forward_iterator_tag;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    slist_iterator() noexcept = default;
+    slist_iterator(const jll_slist_t * list, jll_snode_t * node, bool before = false) noexcept : list_(list), node_(node), before_(before) {}
+
+    template <bool C = Const, std::enable_if_t<C, int> = 0>
+    slist_iterator(const slist_iterator<T, false> & other) noexcept : list_(other.list()), node_(other.node()), before_(other.is_before_begin()) {}
+
+    reference operator*() const noexcept { return static_cast<detail::block<jll_snode_t, T> *>(node_)->value; }
+    pointer operator->() const noexcept { return std::addressof(**this); }
+
+    slist_iterator & operator++() noexcept
+    {
+        if (before_) node_ = list_->head;
+        else node_ = (node_ == list_->tail) ? nullptr : node_->next;
+
+        before_ = false;
+        return *this;
+    }
+
+    slist_iterator operator++(int) noexcept
+    {
+        slist_iterator before = *this;
+        ++*this;
+        return before;
+    }
+
+    friend bool operator==(const slist_iterator & a, const slist_iterator & b) noexcept
+    {
+        return (a.node_ == b.node_) && (a.before_ == b.before_);
+    }
+
+    friend bool operator!=(const slist_iterator & a, const slist_iterator & b) noexcept { return !(a == b); }
+
+    /**
+     * @brief Returns the C node handle (NULL for end() and before_begin())
+     */
+    jll_snode_t * node() const noexcept { return node_; }
+    const jll_slist_t * list() const noexcept { return list_; }
+    bool is_before_begin() const noexcept { return before_; }
+
+private:
+    const jll_slist_t * list_ = nullptr;
+    jll_snode_t * node_ = nullptr;
+    bool before_ = false;
+};
+
+/**
+ * @brief RAII singly-linked list in the manner of std::forward_list, over an embedded jll_slist_t.
+ * Unlike std::forward_list it knows its size and its tail, so size() and emplace_back() are O(1).
+ */
+template <class T, class Allocator = std::allocator<T>>
+class slist : private detail::node_factory<T, Allocator, jll_snode_t>
+{
+    using factory = detail::node_factory<T, Allocator, jll_snode_t>;
+    using typename factory::value_traits;
+    using factory::alloc_;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = slist_iterator<T, false>;
+    using const_iterator = slist_iterator<T, true>;
+
+    /* construction and assignment */
+
+    slist() : slist(Allocator()) {}
+
+    explicit slist(const Allocator & alloc) noexcept : factory(alloc)
+    {
+        jll_init_slist(&list_, nullptr, false, false, false);
+    }
+
+    slist(std::initializer_list<T> init, const Allocator & alloc = Allocator()) : slist(init.begin(), init.end(), alloc) {}
+
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    slist(InputIt first, InputIt last, const Allocator & alloc = Allocator()) : slist(alloc)
+    {
+        for (; first != last; ++first) emplace_back(*first);
+    }
+
+    slist(const slist & other) : slist(other, value_traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    slist(const slist & other, const Allocator & alloc) : slist(other.begin(), other.end(), alloc) {}
+
+    slist(slist && other) noexcept : slist(other.alloc_)
+    {
+        steal(other);
+    }
+
+    slist(slist && other, const Allocator & alloc) : slist(alloc)
+    {
+        if (alloc_ == other.alloc_) steal(other);
+        else move_elements(other);
+    }
+
+    ~slist()
+    {
+        clear();
+        jll_fini_slist(&list_, nullptr);
+    }
+
+    slist & operator=(const slist & other)
+    {
+        if (this == &other) return *this;
+
+        clear();
+        if constexpr (value_traits::propagate_on_container_copy_assignment::value) alloc_ = other.alloc_;
+
+        for (const T & value : other) emplace_back(value);
+        return *this;
+    }
+
+    slist & operator=(slist && other) noexcept(value_traits::is_always_equal::value || value_traits::propagate_on_container_move_assignment::value)
+    {
+        if (this == &other) return *this;
+
+        clear();
+
+        if constexpr (value_traits::propagate_on_container_move_assignment::value)
+        {
+            alloc_ = other.alloc_;
+            steal(other);
+        }
+        else if (alloc_ == other.alloc_) steal(other);
+        else move_elements(other);
+
+        return *this;
+    }
+
+    void swap(slist & other) noexcept
+    {
+        if constexpr (value_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+        else assert(alloc_ == other.alloc_);
+
+        std::swap(list_, other.list_);
+    }
+
+    friend void swap(slist & a, slist & b) noexcept { a.swap(b); }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    /* iterators */
+
+    iterator before_begin() noexcept { return iterator(&list_, nullptr, true); }
+    const_iterator before_begin() const noexcept { return const_iterator(&list_, nullptr, true); }
+    const_iterator cbefore_begin() const noexcept { return before_begin(); }
+    iterator begin() noexcept { return iterator(&list_, list_.head); }
+    const_iterator begin() const noexcept { return const_iterator(&list_, list_.head); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(&list_, nullptr); }
+    const_iterator end() const noexcept { return const_iterator(&list_, nullptr); }
+    const_iterator cend() const noexcept { return end(); }
+
+    /* access */
+
+    bool empty() const noexcept { return list_.length == 0; }
+    size_type size() const noexcept { return list_.length; }
+    reference front() noexcept { return factory::value_of(list_.head); }
+    const_reference front() const noexcept { return factory::value_of(list_.head); }
+    reference back() noexcept { return factory::value_of(list_.tail); }
+    const_reference back() const noexcept { return factory::value_of(list_.tail); }
+
+    jll_slist_t * c_list() noexcept { return &list_; }
+    const jll_slist_t * c_list() const noexcept { return &list_; }
+
+    /* insertion (elements are constructed in place) */
+
+    template <class... Args>
+    reference emplace_front(Args &&... args)
+    {
+        jll_snode_t * node = factory::make_node(std::forward<Args>(args)...);
+        jll_slist_link_head(&list_, node);
+        return factory::value_of(node);
+    }
+
+    template <class... Args>
+    reference emplace_back(Args &&... args)
+    {
+        jll_snode_t * node = factory::make_node(std::forward<Args>(args)...);
+        jll_slist_link_tail(&list_, node);
+        return factory::value_of(node);
+    }
+
+    template <class... Args>
+    iterator emplace_after(const_iterator pos, Args &&... args)
+    {
+        jll_snode_t * node = factory::make_node(std::forward<Args>(args)...);
+        jll_slist_link_after(&list_, node, pos.node());
+        return iterator(&list_, node);
+    }
+
+    void push_front(const T & value) { emplace_front(value); }
+    void push_front(T && value) { emplace_front(std::move(value)); }
+    void push_back(const T & value) { emplace_back(value); }
+    void push_back(T && value) { emplace_back(std::move(value)); }
+    iterator insert_after(const_iterator pos, const T & value) { return emplace_after(pos, value); }
+    iterator insert_after(const_iterator pos, T && value) { return emplace_after(pos, std::move(value)); }
+
+    /* removal */
+
+    void pop_front() noexcept { erase_after(before_begin()); }
+
+    iterator erase_after(const_iterator pos) noexcept
+    {
+        jll_snode_t * at = pos.node();
+
+        factory::destroy_node(jll_slist_unlink_after(&list_, at));
+        return following(at);
+    }
+
+    iterator erase_after(const_iterator pos, const_iterator last) noexcept
+    {
+        while (std::next(pos) != last) erase_after(pos);
+        return iterator(&list_, last.node());
+    }
+
+    void clear() noexcept
+    {
+        while (list_.head) factory::destroy_node(jll_slist_unlink_after(&list_, nullptr));
+    }
+
+    /* relinking (nodes move between lists; both must use equal allocators) */
+
+    /**
+     * @brief Moves every element of other after pos, one O(1) relink per node; no element is copied
+     */
+    void splice_after(const_iterator pos, slist & other) noexcept
+    {
+        assert(alloc_ == other.alloc_);
+        jll_snode_t * at = pos.node();
+
+        while (other.list_.head)
+        {
+            jll_snode_t * node = jll_slist_unlink_after(&other.list_, nullptr);
+            jll_slist_link_after(&list_, node, at);
+            at = node;
+        }
+    }
+
+    void splice_after(const_iterator pos, slist && other) noexcept { splice_after(pos, other); }
+
+    /**
+     * @brief Moves the element following it in other after pos
+     */
+    void splice_after(const_iterator pos, slist & other, const_iterator it) noexcept
+    {
+        assert(alloc_ == other.alloc_);
+        if ((pos == it) || (pos.node() == std::next(it).node())) return;
+
+        jll_snode_t * node = jll_slist_unlink_after(&other.list_, it.node());
+        jll_slist_link_after(&list_, node, pos.node());
+    }
+
+    void reverse() noexcept
+    {
+        jll_snode_t * first = list_.head;
+        while ((first) && (first != list_.tail)) jll_slist_link_head(&list_, jll_slist_unlink_after(&list_, first));
+    }
+
+private:
+    iterator following(jll_snode_t * at) noexcept
+    {
+        if (!at) return begin();
+        return iterator(&list_, (at == list_.tail) ? nullptr : at->next);
+    }
+
+    void steal(slist & other) noexcept
+    {
+        list_ = other.list_;
+        jll_init_slist(&other.list_, nullptr, false, false, false);
+    }
+
+    void move_elements(slist & other)
+    {
+        for (T & value : other) emplace_back(std::move(value));
+        other.clear();
+    }
+
+    jll_slist_t list_;
+};
+
+
+/* comparison */
+
+template <class T, class A>
+bool operator==(const dlist<T, A> & a, const dlist<T, A> & b)
+{
+    return (a.size() == b.size()) && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <class T, class A>
+bool operator!=(const dlist<T, A> & a, const dlist<T, A> & b) { return !(a == b); }
+
+template <class T, class A>
+bool operator==(const slist<T, A> & a, const slist<T, A> & b)
+{
+    return (a.size() == b.size()) && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <class T, class A>
+bool operator!=(const slist<T, A> & a, const slist<T, A> & b) { return !(a == b); }
+
+
+/* lists allocating from a std::pmr::memory_resource */
+
+namespace pmr
+{
+
+template <class T>
+using dlist = jll::dlist<T, std::pmr::polymorphic_allocator<T>>;
+
+template <class T>
+using slist = jll::slist<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+# if __cplusplus >= 202002L
+static_assert(std::bidirectional_iterator<dlist<int>::iterator>);
+static_assert(std::bidirectional_iterator<dlist<int>::const_iterator>);
+static_assert(std::forward_iterator<slist<int>::iterator>);
+static_assert(std::forward_iterator<slist<int>::const_iterator>);
+# endif
+
+} // namespace jll
+
+
+# endif
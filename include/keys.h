@@ -0,0 +1,34 @@
+
+# ifndef __JLL_KEYS_H__
+# define __JLL_KEYS_H__
+
+# include <stddef.h>
+# include <stdbool.h>
+# include <stdint.h>
+
+/**
+ * @brief Instruction set used by the cached-key search kernels. The best one the CPU supports
+ * is picked at the first search; the scalar kernels are always available.
+ */
+typedef enum jll_keys_isa_type
+{
+    JLL_KEYS_SCALAR,
+    JLL_KEYS_SSE42,
+    JLL_KEYS_AVX2,
+    JLL_KEYS_ISA_COUNT
+
+} jll_keys_isa_t;
+
+
+/* search kernels over contiguous blocks of cached keys */
+size_t jll_keys_find(const uint64_t *, size_t, uint64_t);
+size_t jll_keys_lower_bound(const uint64_t *, size_t, uint64_t);
+size_t jll_keys_upper_bound(const uint64_t *, size_t, uint64_t);
+
+/* kernel dispatch */
+jll_keys_isa_t jll_keys_get_isa(void);
+bool jll_keys_set_isa(jll_keys_isa_t);
+const char * jll_keys_isa_name(jll_keys_isa_t);
+
+
+# endif
@@ -0,0 +1,302 @@
+
+# ifndef __JLL_LATENCY_H__
+# define __JLL_LATENCY_H__
+
+# include <stdio.h>
+# include <stdint.h>
+# include "datatype.h"
+
+/*
+ * Public list operations which can be timed. Recording is compiled out unless the library is
+ * built with JLL_ENABLE_LATENCY defined; defining JLL_LATENCY_USE_RDTSC as well (x86 only)
+ * times with the TSC in cycles instead of CLOCK_MONOTONIC nanoseconds.
+ */
+# define JLL_LATENCY_OPS(X)                                                 \
+    X(SLIST_ALLOC,                  "jll_alloc_slist")                      \
+    X(SLIST_ALLOC_RING,             "jll_alloc_slist_ring")                 \
+    X(SLIST_DEALLOC,                "jll_dealloc_slist")                    \
+    X(SLIST_DEALLOC_BATCHED,        "jll_dealloc_slist_batched")            \
+    X(SLIST_DEALLOC_DEFERRED,       "jll_dealloc_slist_deferred")           \
+    X(SLIST_DEALLOC_DEFERRED_BATCHED, "jll_dealloc_slist_deferred_batched") \
+    X(SLIST_APPEND_HEAD,            "jll_slist_append_head")                \
+    X(SLIST_APPEND_TAIL,            "jll_slist_append_tail")                \
+    X(SLIST_RING_PUSH_HEAD,         "jll_slist_ring_push_head")             \
+    X(SLIST_RING_PUSH_TAIL,         "jll_slist_ring_push_tail")             \
+    X(SLIST_INSERT_SORTED,          "jll_slist_insert_sorted")              \
+    X(SLIST_INSERT_RANGED,          "jll_slist_insert_ranged")              \
+    X(SLIST_INSERT_FROM_PAYLOAD,    "jll_slist_insert_from_payload")        \
+    X(SLIST_INSERT_FROM_SLIST,      "jll_slist_insert_from_slist")          \
+    X(SLIST_REMOVE_INDEX,           "jll_slist_remove_index")               \
+    X(SLIST_REMOVE_HEAD,            "jll_slist_remove_head")                \
+    X(SLIST_REMOVE_TAIL,            "jll_slist_remove_tail")                \
+    X(SLIST_REMOVE_COND_FIRST,      "jll_slist_remove_cond_first")          \
+    X(SLIST_REMOVE_COND_NTH,        "jll_slist_remove_cond_nth")            \
+    X(SLIST_REMOVE_COND_FIRST_N,    "jll_slist_remove_cond_first_n")        \
+    X(SLIST_REMOVE_COND_ALL,        "jll_slist_remove_cond_all")            \
+    X(SLIST_REMOVE_ALL,             "jll_slist_remove_all")                 \
+    X(SLIST_TO_ARRAY,               "jll_slist_to_array")                   \
+    X(SLIST_DRAIN,                  "jll_slist_drain")                      \
+    X(SLIST_DRAIN_COND,             "jll_slist_drain_cond")                 \
+    X(SLIST_INDEX_POS,              "jll_slist_index_pos")                  \
+    X(SLIST_INDEX_HEAD,             "jll_slist_index_head")                 \
+    X(SLIST_INDEX_TAIL,             "jll_slist_index_tail")                 \
+    X(SLIST_FIND_FIRST_OCCURRENCE,  "jll_slist_find_first_occurrence")      \
+    X(SLIST_FIND_NTH_OCCURRENCE,    "jll_slist_find_nth_occurrence")        \
+    X(SLIST_CHECK_IF_SORTED,        "jll_slist_check_if_sorted")            \
+    X(SLIST_CHECK_IF_CONTAINS,      "jll_slist_check_if_contains")          \
+    X(SLIST_FIND_FIRST_BATCHED,     "jll_slist_find_first_batched")         \
+    X(SLIST_FIND_NTH_BATCHED,       "jll_slist_find_nth_batched")           \
+    X(SLIST_CONTAINS_BATCHED,       "jll_slist_check_if_contains_batched")  \
+    X(SLIST_SET_KEY_FUNC,           "jll_slist_set_key_func")               \
+    X(SLIST_FIND_CACHED_KEY,        "jll_slist_find_cached_key")            \
+    X(SLIST_IS_EMPTY,               "jll_slist_is_empty")                   \
+    X(SLIST_REVERSAL,               "jll_slist_reversal")                   \
+    X(SLIST_ROTATE_N,               "jll_slist_rotate_n")                   \
+    X(SLIST_CONCAT,                 "jll_slist_concat")                     \
+    X(SLIST_SPLIT_AT_NTH,           "jll_slist_split_at_nth")               \
+    X(SLIST_MERGE_SORTED,           "jll_slist_merge_sorted")               \
+    X(SLIST_MERGE_SORTED_N,         "jll_slist_merge_sorted_n")             \
+    X(SLIST_RADIX_SORT,             "jll_slist_radix_sort")                 \
+    X(SLIST_SET_OPERATION,          "jll_slist_set_operation")              \
+    X(SLIST_SET_OPERATION_COPY,     "jll_slist_set_operation_copy")         \
+    X(SLIST_UNIQUE,                 "jll_slist_unique")                     \
+    X(SLIST_DEDUPE,                 "jll_slist_dedupe")                     \
+    X(SLIST_FIND_KEY,               "jll_slist_find_key")                   \
+    X(SLIST_CHECK_IF_CONTAINS_KEY,  "jll_slist_check_if_contains_key")      \
+    X(SLIST_COMPACT,                "jll_slist_compact")                    \
+    X(SLIST_COMPACT_STEP,           "jll_slist_compact_step")               \
+    X(DLIST_ALLOC,                  "jll_alloc_dlist")                      \
+    X(DLIST_ALLOC_RING,             "jll_alloc_dlist_ring")                 \
+    X(DLIST_DEALLOC,                "jll_dealloc_dlist")                    \
+    X(DLIST_DEALLOC_BATCHED,        "jll_dealloc_dlist_batched")            \
+    X(DLIST_DEALLOC_DEFERRED,       "jll_dealloc_dlist_deferred")           \
+    X(DLIST_DEALLOC_DEFERRED_BATCHED, "jll_dealloc_dlist_deferred_batched") \
+    X(DLIST_APPEND_HEAD,            "jll_dlist_append_head")                \
+    X(DLIST_APPEND_TAIL,            "jll_dlist_append_tail")                \
+    X(DLIST_RING_PUSH_HEAD,         "jll_dlist_ring_push_head")             \
+    X(DLIST_RING_PUSH_TAIL,         "jll_dlist_ring_push_tail")             \
+    X(DLIST_INSERT_SORTED,          "jll_dlist_insert_sorted")              \
+    X(DLIST_INSERT_RANGED,          "jll_dlist_insert_ranged")              \
+    X(DLIST_INSERT_FROM_PAYLOAD,    "jll_dlist_insert_from_payload")        \
+    X(DLIST_INSERT_FROM_DLIST,      "jll_dlist_insert_from_dlist")          \
+    X(DLIST_REMOVE_INDEX,           "jll_dlist_remove_index")               \
+    X(DLIST_REMOVE_HEAD,            "jll_dlist_remove_head")                \
+    X(DLIST_REMOVE_TAIL,            "jll_dlist_remove_tail")                \
+    X(DLIST_REMOVE_COND_FIRST,      "jll_dlist_remove_cond_first")          \
+    X(DLIST_REMOVE_COND_NTH,        "jll_dlist_remove_cond_nth")            \
+    X(DLIST_REMOVE_COND_FIRST_N,    "jll_dlist_remove_cond_first_n")        \
+    X(DLIST_REMOVE_COND_ALL,        "jll_dlist_remove_cond_all")            \
+    X(DLIST_REMOVE_ALL,             "jll_dlist_remove_all")                 \
+    X(DLIST_TO_ARRAY,               "jll_dlist_to_array")                   \
+    X(DLIST_DRAIN,                  "jll_dlist_drain")                      \
+    X(DLIST_DRAIN_COND,             "jll_dlist_drain_cond")                 \
+    X(DLIST_INDEX_POS,              "jll_dlist_index_pos")                  \
+    X(DLIST_INDEX_HEAD,             "jll_dlist_index_head")                 \
+    X(DLIST_INDEX_TAIL,             "jll_dlist_index_tail")                 \
+    X(DLIST_FIND_FIRST_OCCURRENCE,  "jll_dlist_find_first_occurrence")      \
+    X(DLIST_FIND_NTH_OCCURRENCE,    "jll_dlist_find_nth_occurrence")        \
+    X(DLIST_CHECK_IF_SORTED,        "jll_dlist_check_if_sorted")            \
+    X(DLIST_CHECK_IF_CONTAINS,      "jll_dlist_check_if_contains")          \
+    X(DLIST_FIND_FIRST_BATCHED,     "jll_dlist_find_first_batched")         \
+    X(DLIST_FIND_NTH_BATCHED,       "jll_dlist_find_nth_batched")           \
+    X(DLIST_CONTAINS_BATCHED,       "jll_dlist_check_if_contains_batched")  \
+    X(DLIST_SET_KEY_FUNC,           "jll_dlist_set_key_func")               \
+    X(DLIST_FIND_CACHED_KEY,        "jll_dlist_find_cached_key")            \
+    X(DLIST_IS_EMPTY,               "jll_dlist_is_empty")                   \
+    X(DLIST_IS_CIRCULAR,            "jll_dlist_is_circular")                \
+    X(DLIST_REVERSAL,               "jll_dlist_reversal")                   \
+    X(DLIST_ROTATE_N,               "jll_dlist_rotate_n")                   \
+    X(DLIST_CONCAT,                 "jll_dlist_concat")                     \
+    X(DLIST_SPLIT_AT_NTH,           "jll_dlist_split_at_nth")               \
+    X(DLIST_MERGE_SORTED,           "jll_dlist_merge_sorted")               \
+    X(DLIST_MERGE_SORTED_N,         "jll_dlist_merge_sorted_n")             \
+    X(DLIST_RADIX_SORT,             "jll_dlist_radix_sort")                 \
+    X(DLIST_SET_OPERATION,          "jll_dlist_set_operation")              \
+    X(DLIST_SET_OPERATION_COPY,     "jll_dlist_set_operation_copy")         \
+    X(DLIST_UNIQUE,                 "jll_dlist_unique")                     \
+    X(DLIST_DEDUPE,                 "jll_dlist_dedupe")                     \
+    X(DLIST_LINK_HEAD,              "jll_dlist_link_head")                  \
+    X(DLIST_LINK_TAIL,              "jll_dlist_link_tail")                  \
+    X(DLIST_LINK_BEFORE,            "jll_dlist_link_before")                \
+    X(DLIST_UNLINK,                 "jll_dlist_unlink")                     \
+    X(DLIST_MOVE_TO_HEAD,           "jll_dlist_move_to_head")               \
+    X(SLIST_LINK_HEAD,              "jll_slist_link_head")                  \
+    X(SLIST_LINK_TAIL,              "jll_slist_link_tail")                  \
+    X(SLIST_LINK_AFTER,             "jll_slist_link_after")                 \
+    X(SLIST_UNLINK_AFTER,           "jll_slist_unlink_after")               \
+    X(DLIST_FIND_KEY,               "jll_dlist_find_key")                   \
+    X(DLIST_CHECK_IF_CONTAINS_KEY,  "jll_dlist_check_if_contains_key")      \
+    X(DLIST_COMPACT,                "jll_dlist_compact")                    \
+    X(DLIST_COMPACT_STEP,           "jll_dlist_compact_step")               \
+    X(DLIST_SET_LAZY_DELETE,        "jll_dlist_set_lazy_delete")            \
+    X(DLIST_PURGE_TOMBSTONES,       "jll_dlist_purge_tombstones")           \
+    X(CLIST_ALLOC,                  "jll_alloc_clist")                      \
+    X(CLIST_DEALLOC,                "jll_dealloc_clist")                    \
+    X(CLIST_SHRINK_TO_FIT,          "jll_clist_shrink_to_fit")              \
+    X(CLIST_APPEND_HEAD,            "jll_clist_append_head")                \
+    X(CLIST_APPEND_TAIL,            "jll_clist_append_tail")                \
+    X(CLIST_INSERT_SORTED,          "jll_clist_insert_sorted")              \
+    X(CLIST_INSERT_FROM_PAYLOAD,    "jll_clist_insert_from_payload")        \
+    X(CLIST_INSERT_FROM_DLIST,      "jll_clist_insert_from_dlist")          \
+    X(CLIST_REMOVE_INDEX,           "jll_clist_remove_index")               \
+    X(CLIST_REMOVE_HEAD,            "jll_clist_remove_head")                \
+    X(CLIST_REMOVE_TAIL,            "jll_clist_remove_tail")                \
+    X(CLIST_REMOVE_COND_FIRST,      "jll_clist_remove_cond_first")          \
+    X(CLIST_REMOVE_COND_NTH,        "jll_clist_remove_cond_nth")            \
+    X(CLIST_REMOVE_COND_FIRST_N,    "jll_clist_remove_cond_first_n")        \
+    X(CLIST_REMOVE_COND_ALL,        "jll_clist_remove_cond_all")            \
+    X(CLIST_REMOVE_ALL,             "jll_clist_remove_all")                 \
+    X(CLIST_TO_ARRAY,               "jll_clist_to_array")                   \
+    X(CLIST_DRAIN,                  "jll_clist_drain")                      \
+    X(CLIST_INDEX_POS,              "jll_clist_index_pos")                  \
+    X(CLIST_FIND_NTH_OCCURRENCE,    "jll_clist_find_nth_occurrence")        \
+    X(CLIST_CHECK_IF_SORTED,        "jll_clist_check_if_sorted")            \
+    X(CLIST_REVERSAL,               "jll_clist_reversal")                   \
+    X(CLIST_ROTATE_N,               "jll_clist_rotate_n")                   \
+    X(CLIST_CONCAT,                 "jll_clist_concat")                     \
+    X(CLIST_SPLIT_AT_NTH,           "jll_clist_split_at_nth")               \
+    X(CLIST_MERGE_SORTED,           "jll_clist_merge_sorted")               \
+    X(CLIST_UNIQUE,                 "jll_clist_unique")                     \
+    X(CLIST_WRITE,                  "jll_clist_write")                      \
+    X(CLIST_READ,                   "jll_clist_read")                       \
+    X(WSDEQUE_ALLOC,                "jll_alloc_wsdeque")                    \
+    X(WSDEQUE_DEALLOC,              "jll_dealloc_wsdeque")                  \
+    X(WSDEQUE_PUSH,                 "jll_wsdeque_push")                     \
+    X(WSDEQUE_POP,                  "jll_wsdeque_pop")                      \
+    X(WSDEQUE_STEAL,                "jll_wsdeque_steal")                    \
+    X(WSDEQUE_STEAL_HALF,           "jll_wsdeque_steal_half")               \
+    X(GRAPH_ALLOC,                  "jll_alloc_graph")                      \
+    X(GRAPH_DEALLOC,                "jll_dealloc_graph")                    \
+    X(GRAPH_ADD_EDGE,               "jll_graph_add_edge")                   \
+    X(GRAPH_REMOVE_EDGE,            "jll_graph_remove_edge")                \
+    X(GRAPH_FREEZE,                 "jll_graph_freeze")                     \
+    X(GRAPH_BFS,                    "jll_graph_bfs")                        \
+    X(GRAPH_DFS,                    "jll_graph_dfs")                        \
+    X(GRAPH_TOPOLOGICAL_SORT,       "jll_graph_topological_sort")           \
+    X(GRAPH_HAS_CYCLE,              "jll_graph_has_cycle")                  \
+    X(SPARSE_ALLOC,                 "jll_alloc_sparse")                     \
+    X(SPARSE_DEALLOC,               "jll_dealloc_sparse")                   \
+    X(SPARSE_GET,                   "jll_sparse_get")                       \
+    X(SPARSE_SET,                   "jll_sparse_set")                       \
+    X(SPARSE_CLEAR,                 "jll_sparse_clear")                     \
+    X(SPARSE_INSERT,                "jll_sparse_insert")                    \
+    X(SPARSE_INSERT_GAP,            "jll_sparse_insert_gap")                \
+    X(SPARSE_REMOVE,                "jll_sparse_remove")                    \
+    X(SPARSE_NEXT_OCCUPIED,         "jll_sparse_next_occupied")             \
+    X(SPARSE_TO_ARRAYS,             "jll_sparse_to_arrays")                 \
+    X(RLIST_ALLOC,                  "jll_alloc_rlist")                      \
+    X(RLIST_DEALLOC,                "jll_dealloc_rlist")                    \
+    X(RLIST_APPEND_HEAD,            "jll_rlist_append_head")                \
+    X(RLIST_APPEND_TAIL,            "jll_rlist_append_tail")                \
+    X(RLIST_APPEND_TAIL_N,          "jll_rlist_append_tail_n")              \
+    X(RLIST_INSERT_INDEX,           "jll_rlist_insert_index")               \
+    X(RLIST_INSERT_FROM_DLIST,      "jll_rlist_insert_from_dlist")          \
+    X(RLIST_REMOVE_INDEX,           "jll_rlist_remove_index")               \
+    X(RLIST_REMOVE_HEAD,            "jll_rlist_remove_head")                \
+    X(RLIST_REMOVE_TAIL,            "jll_rlist_remove_tail")                \
+    X(RLIST_REMOVE_RANGE,           "jll_rlist_remove_range")               \
+    X(RLIST_INDEX_POS,              "jll_rlist_index_pos")                  \
+    X(RLIST_FIND_FIRST_OCCURRENCE,  "jll_rlist_find_first_occurrence")      \
+    X(RLIST_COUNT_COND,             "jll_rlist_count_cond")                 \
+    X(MATCHER_ALLOC,                "jll_alloc_matcher")                    \
+    X(MATCHER_DEALLOC,              "jll_dealloc_matcher")                  \
+    X(MATCHER_FEED,                 "jll_matcher_feed")                     \
+    X(MULTIMATCHER_ALLOC,           "jll_alloc_multimatcher")               \
+    X(MULTIMATCHER_DEALLOC,         "jll_dealloc_multimatcher")             \
+    X(MULTIMATCHER_FEED,            "jll_multimatcher_feed")                \
+    X(SLIST_FIND_SUBSEQUENCE,       "jll_slist_find_subsequence")           \
+    X(SLIST_FIND_ALL_SUBSEQUENCES,  "jll_slist_find_all_subsequences")      \
+    X(SLIST_MATCH_PATTERNS,         "jll_slist_match_patterns")             \
+    X(DLIST_FIND_SUBSEQUENCE,       "jll_dlist_find_subsequence")           \
+    X(DLIST_FIND_ALL_SUBSEQUENCES,  "jll_dlist_find_all_subsequences")      \
+    X(DLIST_MATCH_PATTERNS,         "jll_dlist_match_patterns")
+
+# define JLL_LATENCY_ENUM_ENTRY(name, label) JLL_LAT_##name,
+
+typedef enum jll_latency_op_type
+{
+    JLL_LATENCY_OPS(JLL_LATENCY_ENUM_ENTRY)
+    JLL_LAT_OP_COUNT
+
+} jll_latency_op_t;
+
+/*
+ * Log-linear buckets: values below 8 get a bucket each, every power of two above that is split
+ * into 8 linear sub-buckets (12.5% relative precision). Values past 2^40 land in the last bucket.
+ */
+# define JLL_LATENCY_SUB_BITS   3
+# define JLL_LATENCY_MAX_BITS   40
+# define JLL_LATENCY_BUCKETS    ((JLL_LATENCY_MAX_BITS - JLL_LATENCY_SUB_BITS + 1) << JLL_LATENCY_SUB_BITS)
+
+typedef struct jll_latency_hist_type
+{
+    uint64_t count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+    uint64_t buckets[JLL_LATENCY_BUCKETS];
+
+} jll_latency_hist_t;
+
+typedef struct jll_latency_snapshot_type
+{
+    jll_latency_hist_t ops[JLL_LAT_OP_COUNT];
+
+} jll_latency_snapshot_t;
+
+
+/* configuration */
+bool jll_latency_enabled(void);
+void jll_latency_set_sample_rate(uint32_t);
+const char * jll_latency_unit(void);
+const char * jll_latency_op_name(jll_latency_op_t);
+
+/* histograms */
+void jll_latency_hist_record(jll_latency_hist_t *, uint64_t);
+void jll_latency_hist_merge(jll_latency_hist_t *, const jll_latency_hist_t *);
+uint64_t jll_latency_hist_percentile(const jll_latency_hist_t *, double);
+
+/* snapshots */
+void jll_latency_snapshot(jll_latency_snapshot_t *);
+void jll_latency_reset(void);
+void jll_latency_dump_text(FILE *, const jll_latency_snapshot_t *);
+void jll_latency_dump_json(FILE *, const jll_latency_snapshot_t *);
+
+
+# ifdef JLL_ENABLE_LATENCY
+
+typedef struct jll_latency_scope_type
+{
+    int op;
+    uint64_t start;
+
+} jll_latency_scope_t;
+
+extern _Thread_local uint32_t jll_latency_countdown;
+
+jll_latency_scope_t jll_latency_begin_sampled(jll_latency_op_t);
+void jll_latency_end(jll_latency_scope_t *);
+
+static inline jll_latency_scope_t jll_latency_begin(jll_latency_op_t op)
+{
+    if (--jll_latency_countdown)
+    {
+        jll_latency_scope_t skipped = { -1, 0 };
+        return skipped;
+    }
+
+    return jll_latency_begin_sampled(op);
+}
+
+/* Times the rest of the enclosing scope, including every early return. */
+#   define JLL_LAT_SCOPE(op) \
+        jll_latency_scope_t __jll_lat_scope __attribute__((cleanup(jll_latency_end))) = jll_latency_begin(JLL_LAT_##op)
+
+# else
+
+#   define JLL_LAT_SCOPE(op) ((void)0)
+
+# endif
+
+
+# endif
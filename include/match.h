@@ -0,0 +1,107 @@
+
+# ifndef __JLL_MATCH_H__
+# define __JLL_MATCH_H__
+
+# include "slist.h"
+# include "dlist.h"
+
+/**
+ * @brief Single-pattern matcher (Knuth-Morris-Pratt). Elements are equal when their pointers match or,
+ * given a comparator, when it returns 0; the comparator must then behave as an equivalence. The
+ * failure table lets a search resume after a mismatch without re-reading any element, so a search
+ * over n elements costs O(n) comparisons amortised whatever the pattern.
+ *
+ * Searches over lists leave the matcher untouched; feeding it element by element (streaming) uses
+ * state and position, so the pattern can be found across batches of appended nodes.
+ */
+typedef struct jll_matcher_type
+{
+    const jll_data_t ** pattern;
+    size_t * failure;
+    size_t length;
+
+    data_compfunc_t match_comp_func;
+
+    size_t state;
+    size_t position;
+
+} jll_matcher_t;
+
+/**
+ * @brief Patterns of one length in a multi-pattern matcher, with the rolling hash of the last
+ * length elements fed and the pattern hashes sorted for lookup
+ */
+typedef struct jll_pattern_group_type
+{
+    size_t length;
+    uint64_t power;
+    uint64_t rolling;
+
+    size_t count;
+    uint64_t * hashes;
+    size_t * ids;
+
+} jll_pattern_group_t;
+
+/**
+ * @brief Multi-pattern matcher (Rabin-Karp). Every distinct pattern length keeps one rolling hash
+ * over the elements fed, so each element costs one hash update and lookup per distinct length, and
+ * only hash hits are compared element by element. A comparator needs a hash function which gives
+ * equal elements equal hashes; without a comparator, pointers are hashed.
+ */
+typedef struct jll_multimatcher_type
+{
+    size_t patterns;
+    const jll_data_t ** elements;
+    size_t * offsets;
+
+    size_t groups;
+    jll_pattern_group_t * group;
+
+    size_t window_length;
+    const jll_data_t ** window;
+    uint64_t * window_hashes;
+
+    data_compfunc_t match_comp_func;
+    data_hashfunc_t match_hash_func;
+
+    size_t position;
+    size_t bytes;
+
+} jll_multimatcher_t;
+
+/**
+ * @brief Occurrence of one pattern of a multi-pattern matcher
+ */
+typedef struct jll_match_type
+{
+    size_t pattern;
+    size_t position;
+
+} jll_match_t;
+
+
+/* single-pattern matching */
+jll_matcher_t * jll_alloc_matcher(const jll_data_t * const *, size_t, data_compfunc_t);
+void jll_dealloc_matcher(jll_matcher_t *);
+void jll_matcher_reset(jll_matcher_t *);
+bool jll_matcher_feed(jll_matcher_t *, const jll_data_t *);
+size_t jll_matcher_position(const jll_matcher_t *);
+
+/* multi-pattern matching */
+jll_multimatcher_t * jll_alloc_multimatcher(const jll_data_t * const * const *, const size_t *, size_t, data_compfunc_t, data_hashfunc_t);
+void jll_dealloc_multimatcher(jll_multimatcher_t *);
+void jll_multimatcher_reset(jll_multimatcher_t *);
+size_t jll_multimatcher_feed(jll_multimatcher_t *, const jll_data_t *, size_t *, size_t);
+size_t jll_multimatcher_position(const jll_multimatcher_t *);
+
+/* searching lists */
+jll_snode_t * jll_slist_find_subsequence(const jll_slist_t *, const jll_matcher_t *, size_t *);
+size_t jll_slist_find_all_subsequences(const jll_slist_t *, const jll_matcher_t *, size_t *, size_t);
+size_t jll_slist_match_patterns(const jll_slist_t *, jll_multimatcher_t *, jll_match_t *, size_t);
+jll_dnode_t * jll_dlist_find_subsequence(const jll_dlist_t *, const jll_matcher_t *, size_t *);
+size_t jll_dlist_find_all_subsequences(const jll_dlist_t *, const jll_matcher_t *, size_t *, size_t);
+size_t jll_dlist_match_patterns(const jll_dlist_t *, jll_multimatcher_t *, jll_match_t *, size_t);
+
+
+# endif
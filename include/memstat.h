@@ -0,0 +1,96 @@
+
+# ifndef __JLL_MEMSTAT_H__
+# define __JLL_MEMSTAT_H__
+
+# include <stdint.h>
+# include "datatype.h"
+
+# define JLL_CACHE_LINE_SIZE 64
+
+typedef enum jll_mem_category_type
+{
+    JLL_MEM_NODES,
+    JLL_MEM_HEADERS,
+    JLL_MEM_PAYLOADS,
+    JLL_MEM_CATEGORIES
+
+} jll_mem_category_t;
+
+/**
+ * @brief Process-wide bytes currently held by the library, by category, with the high-water mark of the total
+ * (all zero unless the library is built with JLL_ENABLE_MEMSTAT)
+ */
+typedef struct jll_memstat_type
+{
+    size_t bytes[JLL_MEM_CATEGORIES];
+    size_t total_bytes;
+    size_t peak_bytes;
+
+} jll_memstat_t;
+
+/**
+ * @brief Bytes attributed to a single list. The total covers what the list currently holds (header and
+ * nodes). Payload buffers belong to the caller once handed out, so the bytes issued through the list's
+ * remove_* functions are a cumulative count since it was allocated and are not part of the total.
+ */
+typedef struct jll_list_memory_type
+{
+    size_t header_bytes;
+    size_t node_bytes;
+    size_t payload_bytes_issued;
+    size_t total_bytes;
+
+} jll_list_memory_t;
+
+/**
+ * @brief How scattered a list's nodes are: for every next-hop, where the next node sits relative to the current one
+ */
+typedef struct jll_layout_report_type
+{
+    size_t hops;
+    size_t same_line;
+    size_t adjacent_line;
+    size_t same_page;
+    size_t adjacent_page;
+    size_t forward;
+    double mean_distance;
+
+} jll_layout_report_t;
+
+
+/* accounting (used by the instrumentation macros) */
+void jll_memstat_record_add(jll_mem_category_t, size_t);
+void jll_memstat_record_sub(jll_mem_category_t, size_t);
+
+/* queries */
+bool jll_memstat_enabled(void);
+void jll_memstat_global(jll_memstat_t *);
+void jll_memstat_reset_peak(void);
+
+/* layout analysis */
+void jll_layout_begin(jll_layout_report_t *);
+void jll_layout_hop(jll_layout_report_t *, const void *, const void *);
+void jll_layout_end(jll_layout_report_t *);
+double jll_layout_share(const jll_layout_report_t *, size_t);
+
+
+
+/*
+ * The process-wide counters are shared by every thread, so the allocation paths only touch them
+ * when the library is built with JLL_ENABLE_MEMSTAT defined; otherwise the global counts stay zero.
+ * The per-list jll_X_memory reports are computed from the list itself and are always available.
+ */
+# ifdef JLL_ENABLE_MEMSTAT
+
+#   define JLL_MEM_ADD(category, bytes) jll_memstat_record_add((category), (bytes))
+#   define JLL_MEM_SUB(category, bytes) jll_memstat_record_sub((category), (bytes))
+
+# else
+
+#   define JLL_MEM_ADD(category, bytes) ((void)0)
+#   define JLL_MEM_SUB(category, bytes) ((void)0)
+
+# endif
+
+
+# endif
@@ -0,0 +1,83 @@
+
+# ifndef __JLL_POOL_H__
+# define __JLL_POOL_H__
+
+# include <stddef.h>
+# include <stdbool.h>
+# include <pthread.h>
+
+/**
+ * @brief Contiguous slab of equally sized nodes owned by a pool
+ */
+typedef struct jll_pool_block_type
+{
+    struct jll_pool_block_type * next;
+
+    char * base;
+    size_t nodes;
+    size_t bytes;
+    bool mapped;
+
+} jll_pool_block_t;
+
+/**
+ * @brief Fixed-size node allocator. Nodes are carved from blocks and recycled through a free list.
+ * Every pool registers its blocks so that jll_pool_release can route any node back to its owner,
+ * which lets nodes be spliced between lists regardless of where they were allocated.
+ */
+typedef struct jll_pool_type
+{
+    size_t node_size;
+    size_t nodes_per_block;
+    bool hugepage;
+
+    void * free_list;
+    jll_pool_block_t * blocks;
+
+    size_t capacity;
+    size_t live;
+    bool orphaned;
+
+    pthread_mutex_t lock;
+
+} jll_pool_t;
+
+/**
+ * @brief Progress of an incremental compaction pass. Nodes are copied one at a time, in traversal
+ * order, into a contiguous block; the cursor is the last node placed. The list's generation is
+ * recorded so that a step can tell when removals or reordering invalidated the cursor, and the pool the
+ * block came from so that it can tell when the list has moved its nodes to another pool since.
+ */
+typedef struct jll_compact_type
+{
+    char * block;
+    jll_pool_t * pool;
+    size_t node_size;
+    size_t capacity;
+    size_t placed;
+
+    void * cursor;
+    size_t generation;
+    bool active;
+
+} jll_compact_t;
+
+
+/* allocators and deallocators */
+jll_pool_t * jll_alloc_pool(size_t, size_t, bool);
+void jll_dealloc_pool(jll_pool_t *);
+void jll_pool_discard(jll_pool_t *);
+
+/* node operations */
+void * jll_pool_get(jll_pool_t *);
+void jll_pool_put(jll_pool_t *, void *);
+void * jll_pool_get_block(jll_pool_t *, size_t, bool);
+bool jll_pool_owns(jll_pool_t *, const void *);
+bool jll_pool_release(void *);
+
+/* inspection */
+size_t jll_pool_live(jll_pool_t *);
+size_t jll_pool_capacity(jll_pool_t *);
+
+
+# endif
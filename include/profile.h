@@ -0,0 +1,73 @@
+
+# ifndef __JLL_PROFILE_H__
+# define __JLL_PROFILE_H__
+
+# include <stdio.h>
+# include <stdint.h>
+# include <string.h>
+# include "datatype.h"
+
+/**
+ * @brief Operation counters kept per list and process-wide.
+ * Counting is compiled out unless the library is built with JLL_ENABLE_PROFILING defined.
+ */
+typedef struct jll_profile_type
+{
+    uint64_t operations;
+    uint64_t hops;
+    uint64_t comparisons;
+    uint64_t predicates;
+    uint64_t node_allocs;
+    uint64_t node_frees;
+    uint64_t walks_forward;
+    uint64_t walks_backward;
+    uint64_t length_sum;
+    uint64_t length_max;
+
+} jll_profile_t;
+
+typedef void (*jll_profile_export_t)(const jll_profile_t *, void *);
+
+
+/* recording (used by the instrumentation macros) */
+void jll_profile_record_op(jll_profile_t *, size_t);
+
+/* query and export */
+bool jll_profile_enabled(void);
+void jll_profile_global(jll_profile_t *);
+void jll_profile_reset_global(void);
+void jll_profile_set_export_hook(jll_profile_export_t, void *, uint64_t);
+void jll_profile_dump(FILE *, const char *, const jll_profile_t *);
+
+
+# ifdef JLL_ENABLE_PROFILING
+
+extern jll_profile_t jll_profile_global_counters;
+
+#   define JLL_PROF_OP(list)    jll_profile_record_op(&(list)->profile, (list)->length)
+#   define JLL_PROF_COUNT(list, field, n)                                                   \
+        do                                                                                  \
+        {                                                                                   \
+            (list)->profile.field += (n);                                                   \
+            __atomic_fetch_add(&jll_profile_global_counters.field, (n), __ATOMIC_RELAXED);  \
+        } while (0)
+
+# else
+
+#   define JLL_PROF_OP(list)              ((void)0)
+#   define JLL_PROF_COUNT(list, field, n) ((void)0)
+
+# endif
+
+// The counters are zeroed either way, so reading them from an uninstrumented build yields zeros.
+# define JLL_PROF_INIT(list)      memset(&(list)->profile, 0, sizeof(jll_profile_t))
+# define JLL_PROF_HOP(list)       JLL_PROF_COUNT(list, hops, 1)
+# define JLL_PROF_CMP(list)       JLL_PROF_COUNT(list, comparisons, 1)
+# define JLL_PROF_PRED(list)      JLL_PROF_COUNT(list, predicates, 1)
+# define JLL_PROF_ALLOC(list)     JLL_PROF_COUNT(list, node_allocs, 1)
+# define JLL_PROF_FREE(list)      JLL_PROF_COUNT(list, node_frees, 1)
+# define JLL_PROF_WALK_FWD(list)  JLL_PROF_COUNT(list, walks_forward, 1)
+# define JLL_PROF_WALK_BWD(list)  JLL_PROF_COUNT(list, walks_backward, 1)
+
+
+# endif
@@ -0,0 +1,42 @@
+
+# ifndef __JLL_RECLAIM_H__
+# define __JLL_RECLAIM_H__
+
+# include <stddef.h>
+# include "datatype.h"
+
+/**
+ * @brief Deferred teardown queued for the background reclaimer. The object has already been detached
+ * by the submitting thread; the reclaim function releases it along with its data.
+ */
+typedef struct jll_reclaim_job_type
+{
+    struct jll_reclaim_job_type * next;
+
+    void (*reclaim_func)(struct jll_reclaim_job_type *);
+    void * object;
+
+    void (*data_dealloc_func)(const jll_data_t *);
+    data_batchdealloc_t data_batch_func;
+
+} jll_reclaim_job_t;
+
+typedef struct jll_reclaim_stats_type
+{
+    size_t submitted;
+    size_t completed;
+    size_t pending;
+
+} jll_reclaim_stats_t;
+
+
+/* reclaimer thread */
+void jll_reclaim_submit(void (*)(jll_reclaim_job_t *), void *, void (*)(const jll_data_t *), data_batchdealloc_t);
+void jll_reclaim_drain(void);
+void jll_reclaim_stop(void);
+
+/* inspection */
+jll_reclaim_stats_t jll_reclaim_get_stats(void);
+
+
+# endif
@@ -0,0 +1,77 @@
+
+# ifndef __JLL_RLIST_H__
+# define __JLL_RLIST_H__
+
+# include "dlist.h"
+
+/**
+ * @brief Run of equal elements: one data pointer standing for count consecutive positions
+ */
+typedef struct jll_run_node_type
+{
+    struct jll_run_node_type * next;
+    struct jll_run_node_type * prev;
+    const jll_data_t * data;
+    size_t count;
+
+} jll_rnode_t;
+
+/**
+ * @brief Run-length compressed doubly-linked list. Consecutive equal elements share one node; they
+ * are equal when their data pointers match or, if the list has a comparator, when it returns 0. A run
+ * keeps the first pointer it was given, so the pointer of an element merged into a run by comparison
+ * is not retained (the insertion functions report this by returning true).
+ *
+ * Positions count elements, not runs. The run found by the last positional lookup is remembered
+ * (finger, starting at position finger_start), so walking the list by index costs O(1) per step.
+ */
+typedef struct jll_rlist_type
+{
+    jll_rnode_t * head;
+    jll_rnode_t * tail;
+
+    size_t length;
+    size_t runs;
+
+    jll_rnode_t * finger;
+    size_t finger_start;
+
+    data_compfunc_t rlist_comp_func;
+
+} jll_rlist_t;
+
+
+/* allocators and deallocators */
+jll_rlist_t * jll_alloc_rlist(data_compfunc_t);
+void jll_dealloc_rlist(jll_rlist_t *, void (*)(const jll_data_t *));
+
+/* insertion functions (true when the data joined an existing run) */
+bool jll_rlist_append_head(jll_rlist_t *, const jll_data_t *);
+bool jll_rlist_append_tail(jll_rlist_t *, const jll_data_t *);
+bool jll_rlist_append_tail_n(jll_rlist_t *, const jll_data_t *, size_t);
+bool jll_rlist_insert_index(jll_rlist_t *, size_t, const jll_data_t *);
+void jll_rlist_insert_from_dlist(jll_rlist_t *, const jll_dlist_t *);
+
+/* deletion functions */
+const jll_data_t * jll_rlist_remove_index(jll_rlist_t *, size_t);
+const jll_data_t * jll_rlist_remove_head(jll_rlist_t *);
+const jll_data_t * jll_rlist_remove_tail(jll_rlist_t *);
+size_t jll_rlist_remove_range(jll_rlist_t *, size_t, size_t, void (*)(const jll_data_t *));
+
+/* access functions */
+const jll_data_t * jll_rlist_index_pos(jll_rlist_t *, size_t);
+const jll_data_t * jll_rlist_index_head(const jll_rlist_t *);
+const jll_data_t * jll_rlist_index_tail(const jll_rlist_t *);
+const jll_data_t * jll_rlist_find_first_occurrence(const jll_rlist_t *, bool (*)(const jll_data_t *), size_t *);
+size_t jll_rlist_count_cond(const jll_rlist_t *, bool (*)(const jll_data_t *));
+size_t jll_rlist_to_array(const jll_rlist_t *, const jll_data_t **, size_t);
+size_t jll_rlist_runs_to_arrays(const jll_rlist_t *, const jll_data_t **, size_t *, size_t);
+bool jll_rlist_is_empty(const jll_rlist_t *);
+
+/* compression statistics */
+size_t jll_rlist_length(const jll_rlist_t *);
+size_t jll_rlist_runs(const jll_rlist_t *);
+double jll_rlist_compression_ratio(const jll_rlist_t *);
+
+
+# endif
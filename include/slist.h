@@ -5,6 +5,10 @@
 
 
 # include "snode.h"
+# include "bloom.h"
+# include "profile.h"
+# include "latency.h"
+# include "memstat.h"
 
 
 typedef struct jll_singly_list_type
@@ -18,14 +22,47 @@ typedef struct jll_singly_list_type
     bool circular;
     bool sorted;
     bool persistent;
+    bool keyed;
+
+    jll_reorg_policy_t reorg;
+    jll_bloom_t * bloom;
+
+    size_t payload_bytes_issued;
+
+    jll_pool_t * pool;
+    bool pool_shared;
+    bool caller_nodes;
+    bool foreign_nodes;
+    size_t generation;
+
+    jll_snode_t * finger;
+    size_t finger_generation;
+    jll_insert_stats_t insert_stats;
+
+    size_t capacity;
+    jll_ring_policy_t ring_policy;
+    jll_snode_t * spare;
+    void (*ring_evict_func)(const jll_data_t *);
+
+    size_t scan_batch;
 
     data_compfunc_t slist_comp_func;
+    data_keyfunc_t slist_key_func;
+
+    // Always present, so the layout does not depend on how the library or its clients were built.
+    jll_profile_t profile;
 
 } jll_slist_t;
 
 /* allocators and deallocators*/
+void jll_init_slist(jll_slist_t *, data_compfunc_t, bool, bool, bool);
 jll_slist_t * jll_alloc_slist(data_compfunc_t, bool, bool, bool);
+jll_slist_t * jll_alloc_slist_ring(data_compfunc_t, size_t, jll_ring_policy_t, void (*)(const jll_data_t *));
 void jll_dealloc_slist(jll_slist_t *, void (*)(const jll_data_t *));
+void jll_dealloc_slist_batched(jll_slist_t *, data_batchdealloc_t);
+void jll_fini_slist(jll_slist_t *, void (*)(const jll_data_t *));
+void jll_dealloc_slist_deferred(jll_slist_t *, void (*)(const jll_data_t *));
+void jll_dealloc_slist_deferred_batched(jll_slist_t *, data_batchdealloc_t);
 
 /*insertion functions*/
 void jll_slist_append_head(jll_slist_t *, const jll_data_t *);
@@ -45,6 +82,14 @@ jll_data_payload_t * jll_slist_remove_cond_first_n(jll_slist_t *, bool (*)(const
 jll_data_payload_t * jll_slist_remove_cond_all(jll_slist_t *, bool (*)(const jll_data_t *));
 jll_data_payload_t * jll_slist_remove_all(jll_slist_t *);
 
+/*export and drain into caller-provided storage*/
+size_t jll_slist_to_array(const jll_slist_t *, const jll_data_t **, size_t);
+size_t jll_slist_export_into(const jll_slist_t *, jll_data_payload_t *);
+size_t jll_slist_drain(jll_slist_t *, const jll_data_t **, size_t);
+size_t jll_slist_drain_cond(jll_slist_t *, bool (*)(const jll_data_t *), const jll_data_t **, size_t);
+size_t jll_slist_drain_into(jll_slist_t *, jll_data_payload_t *);
+size_t jll_slist_drain_cond_into(jll_slist_t *, bool (*)(const jll_data_t *), jll_data_payload_t *);
+
 /*access functions*/
 const jll_data_t * jll_slist_index_pos(jll_slist_t *, size_t);
 const jll_data_t * jll_slist_index_head(jll_slist_t *);
@@ -53,6 +98,10 @@ const jll_data_t * jll_slist_find_first_occurrence(jll_slist_t *, bool (*)(const
 const jll_data_t * jll_slist_find_nth_occurrence(jll_slist_t *, bool (*)(const jll_data_t *), size_t);
 bool jll_slist_check_if_sorted(jll_slist_t *);
 bool jll_slist_check_if_contains(jll_slist_t *, bool (*)(const jll_data_t *));
+const jll_data_t * jll_slist_find_first_batched(jll_slist_t *, data_batchpred_t);
+const jll_data_t * jll_slist_find_nth_batched(jll_slist_t *, data_batchpred_t, size_t);
+bool jll_slist_check_if_contains_batched(jll_slist_t *, data_batchpred_t);
+void jll_slist_set_scan_batch(jll_slist_t *, size_t);
 bool jll_slist_is_empty(jll_slist_t *);
 
 /*list manipulation*/
@@ -60,5 +109,54 @@ void jll_slist_reversal(jll_slist_t *);
 void jll_slist_rotate_n(jll_slist_t *, size_t);
 void jll_slist_concat(jll_slist_t *, jll_slist_t *);
 jll_slist_t * jll_slist_split_at_nth(jll_slist_t *, size_t);
+void jll_slist_merge_sorted(jll_slist_t *, jll_slist_t *);
+void jll_slist_merge_sorted_n(jll_slist_t *, jll_slist_t **, size_t);
+void jll_slist_radix_sort(jll_slist_t *, data_keyfunc_t);
+
+/*node-level operations (no allocation)*/
+void jll_slist_link_head(jll_slist_t *, jll_snode_t *);
+void jll_slist_link_tail(jll_slist_t *, jll_snode_t *);
+void jll_slist_link_after(jll_slist_t *, jll_snode_t *, jll_snode_t *);
+jll_snode_t * jll_slist_unlink_after(jll_slist_t *, jll_snode_t *);
+
+/*set algebra on sorted lists*/
+void jll_slist_set_operation(jll_slist_t *, jll_slist_t *, jll_setop_t, void (*)(const jll_data_t *));
+jll_slist_t * jll_slist_set_operation_copy(const jll_slist_t *, const jll_slist_t *, jll_setop_t);
+size_t jll_slist_unique(jll_slist_t *, void (*)(const jll_data_t *));
+size_t jll_slist_dedupe(jll_slist_t *, data_hashfunc_t, void (*)(const jll_data_t *));
+
+/*bounded ring mode (pop and peek with remove_head/tail and index_head/tail)*/
+bool jll_slist_ring_push_head(jll_slist_t *, const jll_data_t *);
+bool jll_slist_ring_push_tail(jll_slist_t *, const jll_data_t *);
+bool jll_slist_ring_is_full(const jll_slist_t *);
+
+/*cached sort keys (sorted insertion and sortedness checks compare keys before data)*/
+bool jll_slist_set_key_func(jll_slist_t *, data_keyfunc_t);
+const jll_data_t * jll_slist_find_cached_key(jll_slist_t *, uint64_t);
+
+/*self-organization*/
+bool jll_slist_set_reorg_policy(jll_slist_t *, jll_reorg_policy_t);
+
+/*keyed membership with an optional Bloom filter*/
+void jll_slist_attach_bloom(jll_slist_t *, data_hashfunc_t, double);
+void jll_slist_detach_bloom(jll_slist_t *);
+const jll_data_t * jll_slist_find_key(jll_slist_t *, const jll_data_t *);
+bool jll_slist_check_if_contains_key(jll_slist_t *, const jll_data_t *);
+
+/*profiling*/
+void jll_slist_get_profile(const jll_slist_t *, jll_profile_t *);
+void jll_slist_reset_profile(jll_slist_t *);
+void jll_slist_get_insert_stats(const jll_slist_t *, jll_insert_stats_t *);
+void jll_slist_reset_insert_stats(jll_slist_t *);
+
+/*memory accounting*/
+void jll_slist_memory(const jll_slist_t *, jll_list_memory_t *);
+void jll_slist_layout(const jll_slist_t *, jll_layout_report_t *);
+
+/*compaction*/
+void jll_slist_compact(jll_slist_t *, bool);
+void jll_slist_compact_begin(jll_slist_t *, jll_compact_t *, bool);
+bool jll_slist_compact_step(jll_slist_t *, jll_compact_t *, size_t);
+void jll_slist_compact_end(jll_slist_t *, jll_compact_t *);
 
 # endif
\ No newline at end of file
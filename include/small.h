@@ -0,0 +1,75 @@
+
+# ifndef __JLL_SMALL_H__
+# define __JLL_SMALL_H__
+
+# include "dlist.h"
+# include "keys.h"
+
+# define JLL_SMALL_INLINE 8
+
+/**
+ * @brief Small list: up to JLL_SMALL_INLINE data pointers are stored inline, in order, in the list
+ * object itself. The list promotes itself to an embedded doubly-linked list once it outgrows the
+ * inline storage and stays promoted. It may be embedded by value, in which case an inline list
+ * costs no allocation at all. With a key function the inline keys are kept in their own contiguous
+ * array, which sorted insertion and key lookups search with the vector kernels of keys.h.
+ */
+typedef struct jll_small_type
+{
+    size_t length;
+    bool promoted;
+
+    data_compfunc_t small_comp_func;
+    data_keyfunc_t small_key_func;
+
+    union
+    {
+        struct
+        {
+            const jll_data_t * items[JLL_SMALL_INLINE];
+            uint64_t keys[JLL_SMALL_INLINE];
+        };
+        jll_dlist_t list;
+
+    } store;
+
+} jll_small_t;
+
+
+/* allocators and deallocators */
+void jll_init_small(jll_small_t *, data_compfunc_t);
+void jll_fini_small(jll_small_t *, void (*)(const jll_data_t *));
+jll_small_t * jll_alloc_small(data_compfunc_t);
+void jll_dealloc_small(jll_small_t *, void (*)(const jll_data_t *));
+
+/* insertion functions */
+void jll_small_append_head(jll_small_t *, const jll_data_t *);
+void jll_small_append_tail(jll_small_t *, const jll_data_t *);
+void jll_small_insert_sorted(jll_small_t *, const jll_data_t *);
+
+/* deletion functions */
+const jll_data_t * jll_small_remove_index(jll_small_t *, size_t);
+const jll_data_t * jll_small_remove_head(jll_small_t *);
+const jll_data_t * jll_small_remove_tail(jll_small_t *);
+const jll_data_t * jll_small_remove_cond_first(jll_small_t *, bool (*)(const jll_data_t *));
+
+/* access functions */
+const jll_data_t * jll_small_index_pos(jll_small_t *, size_t);
+const jll_data_t * jll_small_index_head(jll_small_t *);
+const jll_data_t * jll_small_index_tail(jll_small_t *);
+const jll_data_t * jll_small_find_first_occurrence(jll_small_t *, bool (*)(const jll_data_t *));
+bool jll_small_check_if_contains(jll_small_t *, bool (*)(const jll_data_t *));
+size_t jll_small_length(const jll_small_t *);
+bool jll_small_is_empty(const jll_small_t *);
+size_t jll_small_to_array(const jll_small_t *, const jll_data_t **, size_t);
+
+/* cached sort keys */
+void jll_small_set_key_func(jll_small_t *, data_keyfunc_t);
+const jll_data_t * jll_small_find_cached_key(jll_small_t *, uint64_t);
+
+/* representation */
+bool jll_small_is_promoted(const jll_small_t *);
+jll_dlist_t * jll_small_as_dlist(jll_small_t *);
+
+
+# endif
@@ -4,6 +4,7 @@
 # define __JLL_SNODE_H__
 
 # include "datatype.h"
+# include "pool.h"
 
 /**
  * @brief Singly linked list node type
@@ -15,8 +16,29 @@ typedef struct jll_singly_node_type
 
 } jll_snode_t;
 
+/**
+ * @brief Singly linked list node which also caches a sort key and an access count. Lists switch to it
+ * once they are given a key function or the count-ordered policy; the plain node comes first, so it
+ * is linked and passed around as a jll_snode_t.
+ */
+typedef struct jll_singly_keyed_node_type
+{
+    jll_snode_t node;
+    uint64_t key;
+    size_t freq;
+
+} jll_sknode_t;
+
+# define JLL_SKNODE(node) ((jll_sknode_t *)(node))
+
 jll_snode_t * jll_alloc_snode(const jll_data_t *);
+jll_snode_t * jll_alloc_snode_from(jll_pool_t *, const jll_data_t *);
 const jll_data_t * jll_dealloc_snode(jll_snode_t *);
+const jll_data_t * jll_dealloc_snode_to(jll_pool_t *, jll_snode_t *);
+jll_sknode_t * jll_alloc_sknode(const jll_data_t *);
+jll_sknode_t * jll_alloc_sknode_from(jll_pool_t *, const jll_data_t *);
+const jll_data_t * jll_dealloc_sknode(jll_sknode_t *);
+const jll_data_t * jll_dealloc_sknode_to(jll_pool_t *, jll_sknode_t *);
 const jll_data_t * jll_access_snode(const jll_snode_t *);
 
 
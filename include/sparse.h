@@ -0,0 +1,68 @@
+
+# ifndef __JLL_SPARSE_H__
+# define __JLL_SPARSE_H__
+
+# include <stdint.h>
+# include "datatype.h"
+# include "latency.h"
+# include "memstat.h"
+
+/**
+ * @brief Occupied slot of a sparse list. Positions are not stored: gap counts the empty slots between
+ * this node and its in-order predecessor, and span totals gap + 1 over the subtree, so a node's logical
+ * position is the span of everything before it plus its own gap.
+ */
+typedef struct jll_sparse_node_type
+{
+    struct jll_sparse_node_type * left;
+    struct jll_sparse_node_type * right;
+    const jll_data_t * data;
+
+    size_t gap;
+    size_t span;
+    size_t count;
+    uint32_t priority;
+
+} jll_sparse_node_t;
+
+/**
+ * @brief Sparse positional list: a logically long sequence of slots of which only the occupied ones
+ * are stored, in a treap ordered by position. Access by position is O(log n) in the number of occupied
+ * slots. Shifting inserts and removals renumber every later element by editing a single gap, so memory
+ * and time depend on occupancy, never on the logical length.
+ */
+typedef struct jll_sparse_list_type
+{
+    jll_sparse_node_t * root;
+    size_t length;
+    uint64_t seed;
+
+} jll_sparse_t;
+
+
+/* allocators and deallocators */
+jll_sparse_t * jll_alloc_sparse(size_t);
+void jll_dealloc_sparse(jll_sparse_t *, void (*)(const jll_data_t *));
+
+/* slot access (no renumbering) */
+const jll_data_t * jll_sparse_get(const jll_sparse_t *, size_t);
+const jll_data_t * jll_sparse_set(jll_sparse_t *, size_t, const jll_data_t *);
+const jll_data_t * jll_sparse_clear(jll_sparse_t *, size_t);
+
+/* shifting insertion and removal (later elements are renumbered) */
+void jll_sparse_insert(jll_sparse_t *, size_t, const jll_data_t *);
+void jll_sparse_insert_gap(jll_sparse_t *, size_t, size_t);
+const jll_data_t * jll_sparse_remove(jll_sparse_t *, size_t);
+
+/* iteration over occupied slots */
+const jll_data_t * jll_sparse_next_occupied(const jll_sparse_t *, size_t, size_t *);
+size_t jll_sparse_next_run(const jll_sparse_t *, size_t, size_t *);
+size_t jll_sparse_to_arrays(const jll_sparse_t *, size_t *, const jll_data_t **, size_t);
+
+/* access functions */
+size_t jll_sparse_length(const jll_sparse_t *);
+size_t jll_sparse_occupied(const jll_sparse_t *);
+bool jll_sparse_is_empty(const jll_sparse_t *);
+
+
+# endif
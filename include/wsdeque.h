@@ -0,0 +1,71 @@
+
+# ifndef __JLL_WSDEQUE_H__
+# define __JLL_WSDEQUE_H__
+
+# include <stdint.h>
+# include "datatype.h"
+# include "latency.h"
+# include "memstat.h"
+
+# define JLL_WSDEQUE_LINE 64
+# define JLL_WSDEQUE_MIN_CAPACITY 64
+
+/**
+ * @brief Outcome of a steal: a thief which loses a race for the oldest element gets JLL_STEAL_RETRY
+ * rather than spinning, so it can move on to another victim.
+ */
+typedef enum jll_steal_result_type
+{
+    JLL_STEAL_SUCCESS,
+    JLL_STEAL_EMPTY,
+    JLL_STEAL_RETRY
+
+} jll_steal_result_t;
+
+/**
+ * @brief Circular slot array of a work-stealing deque. Arrays replaced by a larger one stay chained
+ * to their successor until the deque is deallocated, since a thief may still be reading them.
+ */
+typedef struct jll_wsdeque_array_type
+{
+    struct jll_wsdeque_array_type * retired;
+    size_t capacity;
+    size_t mask;
+    const jll_data_t * slots[];
+
+} jll_wsdeque_array_t;
+
+/**
+ * @brief Chase-Lev work-stealing deque. The owning thread pushes and pops at the bottom without locks or
+ * read-modify-write instructions (except when taking the last element); any thread may steal from the
+ * top with a single compare-and-swap. The slot array doubles whenever the owner pushes into a full one.
+ */
+typedef struct jll_wsdeque_type
+{
+    _Alignas(JLL_WSDEQUE_LINE) int64_t top;
+    _Alignas(JLL_WSDEQUE_LINE) int64_t bottom;
+    jll_wsdeque_array_t * array;
+
+} jll_wsdeque_t;
+
+
+/* allocators and deallocators */
+jll_wsdeque_t * jll_alloc_wsdeque(size_t);
+void jll_dealloc_wsdeque(jll_wsdeque_t *, void (*)(const jll_data_t *));
+
+/* owner operations */
+void jll_wsdeque_push(jll_wsdeque_t *, const jll_data_t *);
+const jll_data_t * jll_wsdeque_pop(jll_wsdeque_t *);
+
+/* thief operations */
+jll_steal_result_t jll_wsdeque_steal(jll_wsdeque_t *, const jll_data_t **);
+size_t jll_wsdeque_steal_half(jll_wsdeque_t *, const jll_data_t **, size_t);
+size_t jll_wsdeque_steal_half_into(jll_wsdeque_t *, jll_wsdeque_t *);
+
+/* inspection (a snapshot; other threads may change the deque at any moment) */
+size_t jll_wsdeque_size(const jll_wsdeque_t *);
+bool jll_wsdeque_is_empty(const jll_wsdeque_t *);
+size_t jll_wsdeque_capacity(const jll_wsdeque_t *);
+
+
+# endif
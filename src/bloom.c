@@ -0,0 +1,242 @@
+
+
+# include <stdlib.h>
+# include <string.h>
+# include <math.h>
+# include <assert.h>
+# include "./include/bloom.h"
+# include "./include/memstat.h"
+
+# define JLL_BLOOM_BLOCK_WORDS 8
+# define JLL_BLOOM_BLOCK_BITS  512
+# define JLL_BLOOM_MAX_HASHES  16
+# define JLL_BLOOM_MIN_CAPACITY 64
+
+
+/* internal helpers */
+
+static uint64_t __jll_bloom_mix(uint64_t x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Sizes the filter for a number of keys at the target false-positive rate;
+ * the block count is rounded up to a power of two so block selection is a mask.
+ */
+static void __jll_bloom_size(jll_bloom_t * bloom, size_t capacity)
+{
+    if (capacity < JLL_BLOOM_MIN_CAPACITY) capacity = JLL_BLOOM_MIN_CAPACITY;
+
+    double ln2 = log(2.0);
+    double bits_per_key = -log(bloom->target_fpr) / (ln2 * ln2);
+    size_t bits = (size_t)ceil(bits_per_key * (double)capacity);
+
+    size_t nblocks = 1;
+    while (nblocks * JLL_BLOOM_BLOCK_BITS < bits) nblocks <<= 1;
+
+    unsigned nhashes = (unsigned)lround(bits_per_key * ln2);
+    if (nhashes < 1) nhashes = 1;
+    if (nhashes > JLL_BLOOM_MAX_HASHES) nhashes = JLL_BLOOM_MAX_HASHES;
+
+    bloom->blocks = (uint64_t *)calloc(nblocks * JLL_BLOOM_BLOCK_WORDS, sizeof(uint64_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, nblocks * JLL_BLOOM_BLOCK_WORDS * sizeof(uint64_t));
+    bloom->nblocks = nblocks;
+    bloom->nhashes = nhashes;
+    bloom->capacity = capacity;
+    bloom->inserted = 0;
+    bloom->stale = 0;
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Allocate a blocked Bloom filter
+ *
+ * @param hashfunc User-specified hash over the key portion of the data
+ * @param capacity Number of keys the filter is expected to hold
+ * @param fpr      Target false-positive rate at capacity, in (0, 1)
+ *
+ * @returns Pointer to the newly created filter
+ */
+jll_bloom_t * jll_alloc_bloom(data_hashfunc_t hashfunc, size_t capacity, double fpr)
+{
+    assert(hashfunc);
+    assert((fpr > 0.0) && (fpr < 1.0));
+
+    jll_bloom_t * new_bloom = (jll_bloom_t *)malloc(sizeof(jll_bloom_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_bloom_t));
+
+    new_bloom->target_fpr = fpr;
+    new_bloom->bloom_hash_func = hashfunc;
+    memset(&new_bloom->stats, 0, sizeof(jll_bloom_stats_t));
+
+    __jll_bloom_size(new_bloom, capacity);
+
+    return new_bloom;
+}
+
+void jll_dealloc_bloom(jll_bloom_t * bloom)
+{
+    assert(bloom);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, jll_bloom_bytes(bloom));
+
+    free(bloom->blocks);
+    free(bloom);
+}
+
+
+/* filter operations */
+
+void jll_bloom_insert(jll_bloom_t * bloom, const jll_data_t * dptr)
+{
+    assert(bloom);
+    assert(dptr);
+
+    uint64_t h = __jll_bloom_mix((uint64_t)bloom->bloom_hash_func(dptr));
+    uint64_t * block = bloom->blocks + ((h >> 32) & (bloom->nblocks - 1)) * JLL_BLOOM_BLOCK_WORDS;
+
+    uint32_t h1 = (uint32_t)h;
+    uint32_t h2 = (uint32_t)(h >> 41) | 1;
+
+    for (unsigned k = 0; k < bloom->nhashes; k++)
+    {
+        uint32_t bit = (h1 + k * h2) & (JLL_BLOOM_BLOCK_BITS - 1);
+        block[bit >> 6] |= (1ULL << (bit & 63));
+    }
+
+    bloom->inserted++;
+}
+
+/**
+ * @brief Tests a key against the filter
+ *
+ * @returns False if the key is definitely absent, true if it may be present
+ */
+bool jll_bloom_may_contain(const jll_bloom_t * bloom, const jll_data_t * dptr)
+{
+    assert(bloom);
+    assert(dptr);
+
+    uint64_t h = __jll_bloom_mix((uint64_t)bloom->bloom_hash_func(dptr));
+    const uint64_t * block = bloom->blocks + ((h >> 32) & (bloom->nblocks - 1)) * JLL_BLOOM_BLOCK_WORDS;
+
+    uint32_t h1 = (uint32_t)h;
+    uint32_t h2 = (uint32_t)(h >> 41) | 1;
+
+    for (unsigned k = 0; k < bloom->nhashes; k++)
+    {
+        uint32_t bit = (h1 + k * h2) & (JLL_BLOOM_BLOCK_BITS - 1);
+        if (!(block[bit >> 6] & (1ULL << (bit & 63)))) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Records that a key was removed from the list the filter is screening.
+ * Bits are never cleared, so removals only raise the false-positive rate until the next rebuild.
+ */
+void jll_bloom_note_removal(jll_bloom_t * bloom)
+{
+    assert(bloom);
+    bloom->stale++;
+}
+
+/**
+ * @brief Reports whether the filter has degraded enough to be worth rebuilding,
+ * either because a quarter of its keys are stale or because it holds twice its capacity.
+ */
+bool jll_bloom_needs_rebuild(const jll_bloom_t * bloom)
+{
+    assert(bloom);
+
+    if (bloom->stale * 4 > bloom->inserted) return true;
+    if (bloom->inserted > 2 * bloom->capacity) return true;
+    return false;
+}
+
+/**
+ * @brief Clears the filter ahead of a rebuild, resizing it when the expected key count has changed a lot
+ *
+ * @param bloom    Filter to be cleared
+ * @param capacity Number of keys about to be reinserted
+ *
+ * @returns None (is void)
+ */
+void jll_bloom_reset(jll_bloom_t * bloom, size_t capacity)
+{
+    assert(bloom);
+
+    if ((capacity > bloom->capacity) || (capacity * 4 < bloom->capacity))
+    {
+        JLL_MEM_SUB(JLL_MEM_HEADERS, jll_bloom_bytes(bloom) - sizeof(jll_bloom_t));
+        free(bloom->blocks);
+        __jll_bloom_size(bloom, capacity);
+    }
+    else
+    {
+        memset(bloom->blocks, 0, bloom->nblocks * JLL_BLOOM_BLOCK_WORDS * sizeof(uint64_t));
+        bloom->inserted = 0;
+        bloom->stale = 0;
+    }
+
+    bloom->stats.rebuilds++;
+}
+
+
+/* inspection */
+
+/**
+ * @brief Estimates the current false-positive rate from the share of bits which are set
+ */
+double jll_bloom_estimated_fpr(const jll_bloom_t * bloom)
+{
+    assert(bloom);
+
+    size_t words = bloom->nblocks * JLL_BLOOM_BLOCK_WORDS;
+    size_t set = 0;
+
+    for (size_t k = 0; k < words; k++) set += (size_t)__builtin_popcountll(bloom->blocks[k]);
+
+    return pow((double)set / (double)(words * 64), (double)bloom->nhashes);
+}
+
+/**
+ * @brief Share of queries for absent keys which the filter failed to screen out
+ */
+double jll_bloom_observed_fpr(const jll_bloom_t * bloom)
+{
+    assert(bloom);
+
+    size_t absent = bloom->stats.negatives + bloom->stats.false_positives;
+    if (absent == 0) return 0.0;
+
+    return (double)bloom->stats.false_positives / (double)absent;
+}
+
+/**
+ * @brief Bytes held by the filter, including its bit array
+ */
+size_t jll_bloom_bytes(const jll_bloom_t * bloom)
+{
+    assert(bloom);
+    return sizeof(jll_bloom_t) + bloom->nblocks * JLL_BLOOM_BLOCK_WORDS * sizeof(uint64_t);
+}
+
+jll_bloom_stats_t jll_bloom_get_stats(const jll_bloom_t * bloom)
+{
+    assert(bloom);
+    return bloom->stats;
+}
+
+void jll_bloom_reset_stats(jll_bloom_t * bloom)
+{
+    assert(bloom);
+    memset(&bloom->stats, 0, sizeof(jll_bloom_stats_t));
+}
@@ -0,0 +1,458 @@
+
+
+# include <stdlib.h>
+# include <stdio.h>
+# include <string.h>
+# include <assert.h>
+# include "./include/cache.h"
+
+# define JLL_CACHE_INITIAL_TABLE 16
+
+
+/* internal helpers */
+
+static jll_cache_entry_t ** __jll_cache_slot(jll_cache_t * cache, const jll_data_t * key, size_t hash)
+{
+    jll_cache_entry_t ** slot = &cache->table[hash & (cache->table_size - 1)];
+
+    while (*slot)
+    {
+        if (((*slot)->hash == hash) && (cache->cache_comp_func((*slot)->node.data, key) == 0)) break;
+        slot = &(*slot)->chain;
+    }
+
+    return slot;
+}
+
+static void __jll_cache_grow_table(jll_cache_t * cache)
+{
+    size_t new_size = cache->table_size * 2;
+    jll_cache_entry_t ** new_table = (jll_cache_entry_t **)calloc(new_size, sizeof(jll_cache_entry_t *));
+
+    for (size_t k = 0; k < cache->table_size; k++)
+    {
+        jll_cache_entry_t * entry = cache->table[k];
+
+        while (entry)
+        {
+            jll_cache_entry_t * next = entry->chain;
+            size_t index = entry->hash & (new_size - 1);
+
+            entry->chain = new_table[index];
+            new_table[index] = entry;
+            entry = next;
+        }
+    }
+
+    free(cache->table);
+    cache->table = new_table;
+    cache->table_size = new_size;
+}
+
+static jll_cache_freq_t * __jll_cache_alloc_bucket(size_t count)
+{
+    jll_cache_freq_t * bucket = (jll_cache_freq_t *)malloc(sizeof(jll_cache_freq_t));
+
+    jll_init_dlist(&bucket->entries, NULL, false, false, false);
+    bucket->count = count;
+    bucket->next = NULL;
+    bucket->prev = NULL;
+
+    return bucket;
+}
+
+static void __jll_cache_drop_bucket(jll_cache_t * cache, jll_cache_freq_t * bucket)
+{
+    if (bucket->prev) bucket->prev->next = bucket->next;
+    else cache->freq_head = bucket->next;
+
+    if (bucket->next) bucket->next->prev = bucket->prev;
+
+    free(bucket);
+}
+
+/**
+ * @brief Records an access on an entry: LRU moves it to the front of the recency list,
+ * LFU moves it into the bucket for the next access count.
+ */
+static void __jll_cache_promote(jll_cache_t * cache, jll_cache_entry_t * entry)
+{
+    if (cache->policy == JLL_CACHE_LRU)
+    {
+        jll_dlist_move_to_head(&cache->recency, &entry->node);
+        return;
+    }
+
+    jll_cache_freq_t * bucket = entry->bucket;
+    jll_cache_freq_t * target = bucket->next;
+
+    if ((!target) || (target->count != bucket->count + 1))
+    {
+        target = __jll_cache_alloc_bucket(bucket->count + 1);
+        target->prev = bucket;
+        target->next = bucket->next;
+
+        if (bucket->next) bucket->next->prev = target;
+        bucket->next = target;
+    }
+
+    jll_dlist_unlink(&bucket->entries, &entry->node);
+    jll_dlist_link_head(&target->entries, &entry->node);
+    entry->bucket = target;
+
+    if (jll_dlist_is_empty(&bucket->entries)) __jll_cache_drop_bucket(cache, bucket);
+}
+
+static void __jll_cache_link_new(jll_cache_t * cache, jll_cache_entry_t * entry)
+{
+    if (cache->policy == JLL_CACHE_LRU)
+    {
+        jll_dlist_link_head(&cache->recency, &entry->node);
+        return;
+    }
+
+    if ((!cache->freq_head) || (cache->freq_head->count != 1))
+    {
+        jll_cache_freq_t * bucket = __jll_cache_alloc_bucket(1);
+        bucket->next = cache->freq_head;
+
+        if (cache->freq_head) cache->freq_head->prev = bucket;
+        cache->freq_head = bucket;
+    }
+
+    jll_dlist_link_head(&cache->freq_head->entries, &entry->node);
+    entry->bucket = cache->freq_head;
+}
+
+static void __jll_cache_unlink(jll_cache_t * cache, jll_cache_entry_t * entry)
+{
+    if (cache->policy == JLL_CACHE_LRU)
+    {
+        jll_dlist_unlink(&cache->recency, &entry->node);
+        return;
+    }
+
+    jll_cache_freq_t * bucket = entry->bucket;
+    jll_dlist_unlink(&bucket->entries, &entry->node);
+
+    if (jll_dlist_is_empty(&bucket->entries)) __jll_cache_drop_bucket(cache, bucket);
+}
+
+/**
+ * @brief Removes an entry from both the hash table and its ordering list, returning the data it referenced.
+ */
+static const jll_data_t * __jll_cache_detach(jll_cache_t * cache, jll_cache_entry_t ** slot)
+{
+    jll_cache_entry_t * entry = *slot;
+    const jll_data_t * retdata = entry->node.data;
+
+    *slot = entry->chain;
+    __jll_cache_unlink(cache, entry);
+
+    cache->length--;
+    cache->bytes -= entry->size;
+
+    free(entry);
+    return retdata;
+}
+
+static jll_cache_entry_t * __jll_cache_victim(jll_cache_t * cache)
+{
+    if (cache->policy == JLL_CACHE_LRU)
+    {
+        if (jll_dlist_is_empty(&cache->recency)) return NULL;
+        return (jll_cache_entry_t *)cache->recency.tail;
+    }
+
+    if (!cache->freq_head) return NULL;
+    return (jll_cache_entry_t *)cache->freq_head->entries.tail;
+}
+
+static bool __jll_cache_over_bounds(const jll_cache_t * cache)
+{
+    if ((cache->max_length) && (cache->length > cache->max_length)) return true;
+    if ((cache->max_bytes)  && (cache->bytes  > cache->max_bytes))  return true;
+    return false;
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Allocate an LRU/LFU cache
+ *
+ * @param hashfunc   Hash function over the key portion of the cached data
+ * @param compfunc   Comparison function which returns 0 when two data share the same key
+ * @param policy     Replacement policy used when the cache runs over its bounds
+ * @param max_length Maximum number of entries (0 for unbounded)
+ * @param max_bytes  Maximum sum of the user-reported entry sizes (0 for unbounded)
+ * @param evict_func User-specified function which is handed the data of every evicted entry, may be NULL
+ *
+ * @returns Pointer to the newly created cache
+ */
+jll_cache_t * jll_alloc_cache(data_hashfunc_t hashfunc, data_compfunc_t compfunc, jll_cache_policy_t policy,
+                              size_t max_length, size_t max_bytes, void (*evict_func)(const jll_data_t *))
+{
+    assert(hashfunc);
+    assert(compfunc);
+
+    jll_cache_t * new_cache = (jll_cache_t *)malloc(sizeof(jll_cache_t));
+
+    new_cache->table_size = JLL_CACHE_INITIAL_TABLE;
+    new_cache->table = (jll_cache_entry_t **)calloc(new_cache->table_size, sizeof(jll_cache_entry_t *));
+
+    new_cache->length = 0;
+    new_cache->bytes = 0;
+    new_cache->max_length = max_length;
+    new_cache->max_bytes = max_bytes;
+
+    new_cache->policy = policy;
+    jll_init_dlist(&new_cache->recency, NULL, false, false, false);
+    new_cache->freq_head = NULL;
+
+    new_cache->cache_hash_func = hashfunc;
+    new_cache->cache_comp_func = compfunc;
+    new_cache->evict_func = evict_func;
+
+    memset(&new_cache->stats, 0, sizeof(jll_cache_stats_t));
+
+    return new_cache;
+}
+
+/**
+ * @brief Deallocate a cache and every entry it holds
+ *
+ * @param cache Pointer to the cache to be deallocated
+ * @param data_dealloc_func User-specified function which should handle deallocating the cached jll_data_t pointers
+ *
+ * @returns None (is void)
+ */
+void jll_dealloc_cache(jll_cache_t * cache, void (*data_dealloc_func)(const jll_data_t *))
+{
+    assert(cache);
+    assert(data_dealloc_func);
+
+    for (size_t k = 0; k < cache->table_size; k++)
+    {
+        jll_cache_entry_t * entry = cache->table[k];
+
+        while (entry)
+        {
+            jll_cache_entry_t * next = entry->chain;
+
+            data_dealloc_func(entry->node.data);
+            free(entry);
+            entry = next;
+        }
+    }
+
+    jll_cache_freq_t * bucket = cache->freq_head;
+
+    while (bucket)
+    {
+        jll_cache_freq_t * next = bucket->next;
+        free(bucket);
+        bucket = next;
+    }
+
+    free(cache->table);
+    free(cache);
+}
+
+
+/* cache operations */
+
+/**
+ * @brief Looks up the entry matching a key and records the access
+ *
+ * @param cache Pointer to the cache
+ * @param key   Data carrying the key to be looked up
+ *
+ * @returns Constant reference to the cached data, or NULL on a miss
+ */
+const jll_data_t * jll_cache_get(jll_cache_t * cache, const jll_data_t * key)
+{
+    assert(cache);
+    assert(key);
+
+    jll_cache_entry_t * entry = *__jll_cache_slot(cache, key, cache->cache_hash_func(key));
+
+    if (!entry)
+    {
+        cache->stats.misses++;
+        return NULL;
+    }
+
+    cache->stats.hits++;
+    __jll_cache_promote(cache, entry);
+    return entry->node.data;
+}
+
+/**
+ * @brief Looks up the entry matching a key without recording the access or touching the counters
+ */
+const jll_data_t * jll_cache_peek(jll_cache_t * cache, const jll_data_t * key)
+{
+    assert(cache);
+    assert(key);
+
+    jll_cache_entry_t * entry = *__jll_cache_slot(cache, key, cache->cache_hash_func(key));
+    return entry ? entry->node.data : NULL;
+}
+
+/**
+ * @brief Records an access on the entry matching a key without returning it
+ *
+ * @returns True if the key was present in the cache
+ */
+bool jll_cache_touch(jll_cache_t * cache, const jll_data_t * key)
+{
+    assert(cache);
+    assert(key);
+
+    jll_cache_entry_t * entry = *__jll_cache_slot(cache, key, cache->cache_hash_func(key));
+    if (!entry) return false;
+
+    __jll_cache_promote(cache, entry);
+    return true;
+}
+
+/**
+ * @brief Inserts data into the cache, replacing any entry with an equal key, then evicts until within bounds.
+ * Data larger than the byte bound on its own could never stay cached, so it is refused up front.
+ *
+ * @param cache Pointer to the cache
+ * @param dptr  Data to be cached
+ * @param size  User-reported size of the data, counted against the byte bound
+ *
+ * @returns Constant reference to the data of the replaced entry (now owned by the caller), or NULL; dptr
+ * itself if it was refused, in which case the cache is left as it was and dptr stays with the caller
+ */
+const jll_data_t * jll_cache_put(jll_cache_t * cache, const jll_data_t * dptr, size_t size)
+{
+    assert(cache);
+    assert(dptr);
+
+    if ((cache->max_bytes) && (size > cache->max_bytes)) return dptr;
+
+    size_t hash = cache->cache_hash_func(dptr);
+    jll_cache_entry_t ** slot = __jll_cache_slot(cache, dptr, hash);
+    const jll_data_t * retdata = NULL;
+
+    if (*slot)
+    {
+        jll_cache_entry_t * entry = *slot;
+
+        retdata = entry->node.data;
+        entry->node.data = dptr;
+
+        cache->bytes -= entry->size;
+        cache->bytes += size;
+        entry->size = size;
+
+        __jll_cache_promote(cache, entry);
+    }
+    else
+    {
+        jll_cache_entry_t * entry = (jll_cache_entry_t *)malloc(sizeof(jll_cache_entry_t));
+
+        entry->node.next = NULL;
+        entry->node.prev = NULL;
+        entry->node.data = dptr;
+        entry->chain = NULL;
+        entry->bucket = NULL;
+        entry->hash = hash;
+        entry->size = size;
+
+        *slot = entry;
+        __jll_cache_link_new(cache, entry);
+
+        cache->length++;
+        cache->bytes += size;
+        cache->stats.insertions++;
+
+        if (cache->length > cache->table_size) __jll_cache_grow_table(cache);
+    }
+
+    while (__jll_cache_over_bounds(cache)) jll_cache_evict(cache);
+
+    return retdata;
+}
+
+/**
+ * @brief Removes the entry matching a key without calling the eviction function
+ *
+ * @returns Constant reference to the data of the removed entry (now owned by the caller), or NULL
+ */
+const jll_data_t * jll_cache_remove(jll_cache_t * cache, const jll_data_t * key)
+{
+    assert(cache);
+    assert(key);
+
+    jll_cache_entry_t ** slot = __jll_cache_slot(cache, key, cache->cache_hash_func(key));
+    if (!*slot) return NULL;
+
+    return __jll_cache_detach(cache, slot);
+}
+
+/**
+ * @brief Evicts a single entry chosen by the replacement policy and hands its data to the eviction function
+ *
+ * @returns True if an entry was evicted, false if the cache was empty
+ */
+bool jll_cache_evict(jll_cache_t * cache)
+{
+    assert(cache);
+
+    jll_cache_entry_t * victim = __jll_cache_victim(cache);
+    if (!victim) return false;
+
+    jll_cache_entry_t ** slot = &cache->table[victim->hash & (cache->table_size - 1)];
+    while (*slot != victim) slot = &(*slot)->chain;
+
+    const jll_data_t * old_data_ptr = __jll_cache_detach(cache, slot);
+    cache->stats.evictions++;
+
+    if (cache->evict_func) cache->evict_func(old_data_ptr);
+    return true;
+}
+
+/**
+ * @brief Changes the bounds of a cache, evicting immediately if it no longer fits
+ */
+void jll_cache_resize(jll_cache_t * cache, size_t max_length, size_t max_bytes)
+{
+    assert(cache);
+
+    cache->max_length = max_length;
+    cache->max_bytes = max_bytes;
+
+    while (__jll_cache_over_bounds(cache)) jll_cache_evict(cache);
+}
+
+
+/* inspection */
+
+size_t jll_cache_length(const jll_cache_t * cache)
+{
+    assert(cache);
+    return cache->length;
+}
+
+size_t jll_cache_bytes(const jll_cache_t * cache)
+{
+    assert(cache);
+    return cache->bytes;
+}
+
+jll_cache_stats_t jll_cache_get_stats(const jll_cache_t * cache)
+{
+    assert(cache);
+    return cache->stats;
+}
+
+void jll_cache_reset_stats(jll_cache_t * cache)
+{
+    assert(cache);
+    memset(&cache->stats, 0, sizeof(jll_cache_stats_t));
+}
@@ -0,0 +1,1015 @@
+
+
+# include <stdlib.h>
+# include <stdio.h>
+# include <string.h>
+# include <assert.h>
+# include "./include/clist.h"
+
+# define JLL_CLIST_MIN_CAPACITY 16
+# define JLL_CLIST_MAGIC 0x4a4c4c43u
+
+
+/**
+ * @brief Fixed-size header written ahead of the node array by jll_clist_write
+ */
+typedef struct jll_clist_image_type
+{
+    uint32_t magic;
+    uint32_t node_size;
+
+    uint32_t used;
+    uint32_t free_head;
+    uint32_t head;
+    uint32_t tail;
+    uint64_t length;
+
+    uint8_t circular;
+    uint8_t sorted;
+
+} jll_clist_image_t;
+
+
+/* internal helpers */
+
+static void __jll_clist_note_payload(jll_clist_t * clist, const jll_data_payload_t * payload)
+{
+    clist->payload_bytes_issued += sizeof(jll_data_payload_t) + payload->capacity * sizeof(jll_data_t *);
+}
+
+/**
+ * @brief Moves the node array to a larger allocation; links are indices, so nothing needs rewriting
+ */
+static void __jll_clist_grow(jll_clist_t * clist, size_t capacity)
+{
+    assert(capacity < JLL_CLIST_NIL);
+    if (capacity <= clist->capacity) return;
+
+    clist->nodes = (jll_cnode_t *)realloc(clist->nodes, capacity * sizeof(jll_cnode_t));
+    JLL_MEM_ADD(JLL_MEM_NODES, (capacity - clist->capacity) * sizeof(jll_cnode_t));
+
+    clist->capacity = (uint32_t)capacity;
+}
+
+static uint32_t __jll_clist_new_node(jll_clist_t * clist, const jll_data_t * dptr)
+{
+    uint32_t idx;
+
+    if (clist->free_head != JLL_CLIST_NIL)
+    {
+        idx = clist->free_head;
+        clist->free_head = clist->nodes[idx].next;
+    }
+    else
+    {
+        if (clist->used == clist->capacity)
+        {
+            size_t capacity = (clist->capacity) ? 2 * (size_t)clist->capacity : JLL_CLIST_MIN_CAPACITY;
+            if (capacity >= JLL_CLIST_NIL) capacity = JLL_CLIST_NIL - 1;
+
+            __jll_clist_grow(clist, capacity);
+        }
+
+        // Every index below NIL is in use; growing any further would make an index NIL itself.
+        assert(clist->used < clist->capacity);
+        idx = clist->used++;
+    }
+
+    clist->nodes[idx].next = JLL_CLIST_NIL;
+    clist->nodes[idx].prev = JLL_CLIST_NIL;
+    clist->nodes[idx].data = dptr;
+
+    return idx;
+}
+
+static const jll_data_t * __jll_clist_free_node(jll_clist_t * clist, uint32_t idx)
+{
+    const jll_data_t * old_data_ptr = clist->nodes[idx].data;
+
+    clist->nodes[idx].data = NULL;
+    clist->nodes[idx].prev = JLL_CLIST_NIL;
+    clist->nodes[idx].next = clist->free_head;
+    clist->free_head = idx;
+
+    return old_data_ptr;
+}
+
+/**
+ * @brief Restores the wrap-around (circular) or NIL (linear) links at both ends of a list
+ */
+static void __jll_clist_fix_ends(jll_clist_t * clist)
+{
+    if (clist->length == 0)
+    {
+        clist->head = JLL_CLIST_NIL;
+        clist->tail = JLL_CLIST_NIL;
+        return;
+    }
+
+    clist->nodes[clist->tail].next = (clist->circular) ? clist->head : JLL_CLIST_NIL;
+    clist->nodes[clist->head].prev = (clist->circular) ? clist->tail : JLL_CLIST_NIL;
+}
+
+/**
+ * @brief Links a node in after another node, or as the new head when after is NIL
+ */
+static void __jll_clist_link_after(jll_clist_t * clist, uint32_t idx, uint32_t after)
+{
+    jll_cnode_t * nodes = clist->nodes;
+
+    if (clist->length == 0)
+    {
+        clist->head = idx;
+        clist->tail = idx;
+    }
+    else if (after == JLL_CLIST_NIL)
+    {
+        nodes[idx].next = clist->head;
+        nodes[clist->head].prev = idx;
+        clist->head = idx;
+    }
+    else
+    {
+        uint32_t next = (after == clist->tail) ? JLL_CLIST_NIL : nodes[after].next;
+
+        nodes[idx].prev = after;
+        nodes[idx].next = next;
+        nodes[after].next = idx;
+
+        if (next == JLL_CLIST_NIL) clist->tail = idx;
+        else nodes[next].prev = idx;
+    }
+
+    clist->length++;
+    __jll_clist_fix_ends(clist);
+}
+
+static const jll_data_t * __jll_clist_unlink(jll_clist_t * clist, uint32_t idx)
+{
+    jll_cnode_t * nodes = clist->nodes;
+
+    if (clist->length == 1)
+    {
+        clist->head = JLL_CLIST_NIL;
+        clist->tail = JLL_CLIST_NIL;
+    }
+    else if (idx == clist->head) clist->head = nodes[idx].next;
+    else if (idx == clist->tail) clist->tail = nodes[idx].prev;
+    else
+    {
+        nodes[nodes[idx].prev].next = nodes[idx].next;
+        nodes[nodes[idx].next].prev = nodes[idx].prev;
+    }
+
+    clist->length--;
+    __jll_clist_fix_ends(clist);
+
+    return __jll_clist_free_node(clist, idx);
+}
+
+static uint32_t __jll_clist_walk(const jll_clist_t * clist, size_t index)
+{
+    uint32_t rover;
+
+    if (clist->length < 2 * index + 1)
+    {
+        rover = clist->tail;
+        for (size_t k = clist->length - 1; k > index; k--) rover = clist->nodes[rover].prev;
+    }
+    else
+    {
+        rover = clist->head;
+        for (size_t k = 0; k < index; k++) rover = clist->nodes[rover].next;
+    }
+
+    return rover;
+}
+
+/**
+ * @brief Drops every node without touching the array, which is kept for reuse
+ */
+static void __jll_clist_reset(jll_clist_t * clist)
+{
+    clist->used = 0;
+    clist->free_head = JLL_CLIST_NIL;
+    clist->head = JLL_CLIST_NIL;
+    clist->tail = JLL_CLIST_NIL;
+    clist->length = 0;
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Initialise a compact list embedded by value in another structure; the node array is allocated on first use
+ *
+ * @param clist    Pointer to the list storage to be initialised
+ * @param func     The comparison function which the list will use for sorted-based insertions
+ * @param circflag Boolean flag which determines if the list will be circular or not
+ * @param sortflag Boolean flag which determines if the list will be sorted or not
+ *
+ * @returns None (is void)
+ */
+void jll_init_clist(jll_clist_t * clist, data_compfunc_t func, bool circflag, bool sortflag)
+{
+    assert(clist);
+
+    clist->nodes = NULL;
+    clist->capacity = 0;
+    __jll_clist_reset(clist);
+
+    clist->circular = circflag;
+    clist->sorted = sortflag;
+    clist->payload_bytes_issued = 0;
+
+    clist->clist_comp_func = func;
+}
+
+jll_clist_t * jll_alloc_clist(data_compfunc_t func, bool circflag, bool sortflag)
+{
+    JLL_LAT_SCOPE(CLIST_ALLOC);
+    jll_clist_t * new_clist = (jll_clist_t *)malloc(sizeof(jll_clist_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_clist_t));
+
+    jll_init_clist(new_clist, func, circflag, sortflag);
+
+    return new_clist;
+}
+
+/**
+ * @brief Release the node array of a compact list, leaving the (embedded) header storage to its owner
+ *
+ * @param clist Pointer to the compact list
+ * @param data_dealloc_func User-specified function releasing the data referenced by each node (may be NULL)
+ *
+ * @returns None (is void)
+ */
+void jll_fini_clist(jll_clist_t * clist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    assert(clist);
+
+    if (data_dealloc_func)
+    {
+        uint32_t rover = clist->head;
+        for (size_t k = 0; k < clist->length; k++)
+        {
+            data_dealloc_func(clist->nodes[rover].data);
+            rover = clist->nodes[rover].next;
+        }
+    }
+
+    JLL_MEM_SUB(JLL_MEM_NODES, clist->capacity * sizeof(jll_cnode_t));
+    free(clist->nodes);
+
+    jll_init_clist(clist, clist->clist_comp_func, clist->circular, clist->sorted);
+}
+
+void jll_dealloc_clist(jll_clist_t * clist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(CLIST_DEALLOC);
+    assert(clist);
+
+    jll_fini_clist(clist, data_dealloc_func);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_clist_t));
+    free(clist);
+}
+
+/**
+ * @brief Grows the node array so that at least the given number of elements fit without reallocating
+ */
+void jll_clist_reserve(jll_clist_t * clist, size_t capacity)
+{
+    assert(clist);
+    __jll_clist_grow(clist, capacity);
+}
+
+/**
+ * @brief Rewrites the node array in traversal order and trims it to the list's length. Afterwards
+ * node k holds the k-th element, so walking the list is a sequential scan of the array.
+ */
+void jll_clist_shrink_to_fit(jll_clist_t * clist)
+{
+    JLL_LAT_SCOPE(CLIST_SHRINK_TO_FIT);
+    assert(clist);
+
+    size_t length = clist->length;
+    jll_cnode_t * nodes = (length) ? (jll_cnode_t *)malloc(length * sizeof(jll_cnode_t)) : NULL;
+
+    uint32_t rover = clist->head;
+    for (size_t k = 0; k < length; k++)
+    {
+        nodes[k].data = clist->nodes[rover].data;
+        nodes[k].prev = (uint32_t)k - 1;
+        nodes[k].next = (uint32_t)k + 1;
+        rover = clist->nodes[rover].next;
+    }
+
+    JLL_MEM_SUB(JLL_MEM_NODES, clist->capacity * sizeof(jll_cnode_t));
+    JLL_MEM_ADD(JLL_MEM_NODES, length * sizeof(jll_cnode_t));
+    free(clist->nodes);
+
+    clist->nodes = nodes;
+    clist->capacity = (uint32_t)length;
+    clist->used = (uint32_t)length;
+    clist->free_head = JLL_CLIST_NIL;
+
+    clist->head = (length) ? 0 : JLL_CLIST_NIL;
+    clist->tail = (length) ? (uint32_t)(length - 1) : JLL_CLIST_NIL;
+    __jll_clist_fix_ends(clist);
+}
+
+
+/* insertion functions */
+
+void jll_clist_append_head(jll_clist_t * clist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(CLIST_APPEND_HEAD);
+    assert(clist);
+    assert(dptr);
+
+    __jll_clist_link_after(clist, __jll_clist_new_node(clist, dptr), JLL_CLIST_NIL);
+}
+
+void jll_clist_append_tail(jll_clist_t * clist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(CLIST_APPEND_TAIL);
+    assert(clist);
+    assert(dptr);
+
+    __jll_clist_link_after(clist, __jll_clist_new_node(clist, dptr), clist->tail);
+}
+
+/**
+ * @brief Inserts data after every element which does not belong after it. The tail is checked
+ * first, so in-order insertion costs one comparison.
+ */
+void jll_clist_insert_sorted(jll_clist_t * clist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(CLIST_INSERT_SORTED);
+    assert(clist);
+    assert(dptr);
+    assert(clist->clist_comp_func);
+
+    uint32_t after = clist->tail;
+
+    if ((clist->length) && (clist->clist_comp_func(clist->nodes[clist->tail].data, dptr) == -1))
+    {
+        after = JLL_CLIST_NIL;
+
+        uint32_t rover = clist->head;
+        while (clist->clist_comp_func(clist->nodes[rover].data, dptr) != -1)
+        {
+            after = rover;
+            rover = clist->nodes[rover].next;
+        }
+    }
+
+    __jll_clist_link_after(clist, __jll_clist_new_node(clist, dptr), after);
+}
+
+void jll_clist_insert_from_payload(jll_clist_t * clist, const jll_data_payload_t * payload)
+{
+    JLL_LAT_SCOPE(CLIST_INSERT_FROM_PAYLOAD);
+    assert(clist);
+    assert(payload);
+
+    jll_clist_reserve(clist, clist->length + payload->length);
+
+    for (size_t k = 0; k < payload->length; k++)
+    {
+        if (clist->sorted) jll_clist_insert_sorted(clist, payload->data[k]);
+        else jll_clist_append_tail(clist, payload->data[k]);
+    }
+}
+
+/**
+ * @brief Append every element of a doubly-linked list (in order, or sorted into a sorted list)
+ *
+ * @param clist Pointer to the list
+ * @param src   Pointer to the list read from (unchanged)
+ *
+ * @returns None (is void)
+ */
+void jll_clist_insert_from_dlist(jll_clist_t * clist, const jll_dlist_t * src)
+{
+    JLL_LAT_SCOPE(CLIST_INSERT_FROM_DLIST);
+    assert(clist);
+    assert(src);
+
+    jll_clist_reserve(clist, clist->length + src->length);
+
+    const jll_dnode_t * rover = src->head;
+
+    // Tombstones of a lazily deleted source are stepped over.
+    for (size_t k = 0; k < src->length + src->tombstones; k++)
+    {
+        if (rover->data)
+        {
+            if (clist->sorted) jll_clist_insert_sorted(clist, rover->data);
+            else jll_clist_append_tail(clist, rover->data);
+        }
+
+        rover = rover->next;
+    }
+}
+
+
+/* deletion functions */
+
+const jll_data_t * jll_clist_remove_index(jll_clist_t * clist, size_t index)
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_INDEX);
+    assert(clist);
+    if (index >= clist->length) return NULL;
+
+    return __jll_clist_unlink(clist, __jll_clist_walk(clist, index));
+}
+
+const jll_data_t * jll_clist_remove_head(jll_clist_t * clist)
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_HEAD);
+    assert(clist);
+    if (clist->length == 0) return NULL;
+
+    return __jll_clist_unlink(clist, clist->head);
+}
+
+const jll_data_t * jll_clist_remove_tail(jll_clist_t * clist)
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_TAIL);
+    assert(clist);
+    if (clist->length == 0) return NULL;
+
+    return __jll_clist_unlink(clist, clist->tail);
+}
+
+const jll_data_t * jll_clist_remove_cond_first(jll_clist_t * clist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_COND_FIRST);
+    assert(clist);
+    assert(compfunc);
+
+    uint32_t rover = clist->head;
+    for (size_t k = 0; k < clist->length; k++)
+    {
+        if (compfunc(clist->nodes[rover].data)) return __jll_clist_unlink(clist, rover);
+        rover = clist->nodes[rover].next;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Remove the nth element (counting from 1) which satisfies the predicate
+ *
+ * @returns The removed data, or NULL if n is 0 or fewer than n elements match
+ */
+const jll_data_t * jll_clist_remove_cond_nth(jll_clist_t * clist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_COND_NTH);
+    assert(clist);
+    assert(compfunc);
+
+    if ((n == 0) || (n > clist->length)) return NULL;
+
+    uint32_t rover = clist->head;
+    for (size_t k = 0; k < clist->length; k++)
+    {
+        if ((compfunc(clist->nodes[rover].data)) && (--n == 0)) return __jll_clist_unlink(clist, rover);
+        rover = clist->nodes[rover].next;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Remove the first n elements which satisfy the predicate (all of them if fewer match)
+ *
+ * @returns Payload of the removed data in list order, or NULL if n is 0 or nothing matches
+ */
+jll_data_payload_t * jll_clist_remove_cond_first_n(jll_clist_t * clist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_COND_FIRST_N);
+    assert(clist);
+    assert(compfunc);
+
+    if ((n == 0) || (clist->length == 0)) return NULL;
+    if (n > clist->length) n = clist->length;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(n);
+
+    uint32_t rover = clist->head;
+    size_t length = clist->length;
+
+    for (size_t k = 0; (k < length) && (new_payload->length < n); k++)
+    {
+        uint32_t next = clist->nodes[rover].next;
+        if (compfunc(clist->nodes[rover].data)) new_payload->data[new_payload->length++] = __jll_clist_unlink(clist, rover);
+        rover = next;
+    }
+
+    if (new_payload->length == 0)
+    {
+        jll_deallocate_data_payload(new_payload);
+        return NULL;
+    }
+
+    __jll_clist_note_payload(clist, new_payload);
+    return new_payload;
+}
+
+jll_data_payload_t * jll_clist_remove_cond_all(jll_clist_t * clist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_COND_ALL);
+    assert(clist);
+    assert(compfunc);
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(clist->length);
+
+    uint32_t rover = clist->head;
+    size_t length = clist->length;
+
+    for (size_t k = 0; k < length; k++)
+    {
+        uint32_t next = clist->nodes[rover].next;
+        if (compfunc(clist->nodes[rover].data)) new_payload->data[new_payload->length++] = __jll_clist_unlink(clist, rover);
+        rover = next;
+    }
+
+    if (new_payload->length == 0)
+    {
+        jll_deallocate_data_payload(new_payload);
+        return NULL;
+    }
+
+    __jll_clist_note_payload(clist, new_payload);
+    return new_payload;
+}
+
+jll_data_payload_t * jll_clist_remove_all(jll_clist_t * clist)
+{
+    JLL_LAT_SCOPE(CLIST_REMOVE_ALL);
+    assert(clist);
+    if (clist->length == 0) return NULL;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(clist->length);
+    new_payload->length = jll_clist_drain(clist, new_payload->data, clist->length);
+
+    __jll_clist_note_payload(clist, new_payload);
+    return new_payload;
+}
+
+
+/* export and drain into caller-provided storage */
+
+/**
+ * @brief Copies up to max data pointers, in order, into a caller-provided array
+ *
+ * @returns Number of pointers copied
+ */
+size_t jll_clist_to_array(const jll_clist_t * clist, const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(CLIST_TO_ARRAY);
+    assert(clist);
+    assert(out || (max == 0));
+
+    size_t count = (clist->length < max) ? clist->length : max;
+
+    uint32_t rover = clist->head;
+    for (size_t k = 0; k < count; k++)
+    {
+        out[k] = clist->nodes[rover].data;
+        rover = clist->nodes[rover].next;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Removes up to max elements from the head, in order, into a caller-provided array.
+ * Draining the whole list keeps its node array for reuse.
+ *
+ * @returns Number of elements removed
+ */
+size_t jll_clist_drain(jll_clist_t * clist, const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(CLIST_DRAIN);
+    assert(clist);
+    assert(out || (max == 0));
+
+    if (max >= clist->length)
+    {
+        size_t count = jll_clist_to_array(clist, out, clist->length);
+        __jll_clist_reset(clist);
+        return count;
+    }
+
+    for (size_t k = 0; k < max; k++) out[k] = __jll_clist_unlink(clist, clist->head);
+    return max;
+}
+
+
+/* access functions */
+
+const jll_data_t * jll_clist_index_pos(const jll_clist_t * clist, size_t index)
+{
+    JLL_LAT_SCOPE(CLIST_INDEX_POS);
+    assert(clist);
+    if (index >= clist->length) return NULL;
+
+    return clist->nodes[__jll_clist_walk(clist, index)].data;
+}
+
+const jll_data_t * jll_clist_index_head(const jll_clist_t * clist)
+{
+    assert(clist);
+    return (clist->length) ? clist->nodes[clist->head].data : NULL;
+}
+
+const jll_data_t * jll_clist_index_tail(const jll_clist_t * clist)
+{
+    assert(clist);
+    return (clist->length) ? clist->nodes[clist->tail].data : NULL;
+}
+
+const jll_data_t * jll_clist_find_first_occurrence(const jll_clist_t * clist, bool (*compfunc)(const jll_data_t *))
+{
+    return jll_clist_find_nth_occurrence(clist, compfunc, 1);
+}
+
+/**
+ * @brief Finds the n-th element (counting from 1) for which the predicate holds
+ *
+ * @returns The element's data, or NULL if fewer than n elements match
+ */
+const jll_data_t * jll_clist_find_nth_occurrence(const jll_clist_t * clist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(CLIST_FIND_NTH_OCCURRENCE);
+    assert(clist);
+    assert(compfunc);
+
+    uint32_t rover = clist->head;
+    for (size_t k = 0; (n > 0) && (k < clist->length); k++)
+    {
+        if ((compfunc(clist->nodes[rover].data)) && (--n == 0)) return clist->nodes[rover].data;
+        rover = clist->nodes[rover].next;
+    }
+
+    return NULL;
+}
+
+bool jll_clist_check_if_sorted(const jll_clist_t * clist)
+{
+    JLL_LAT_SCOPE(CLIST_CHECK_IF_SORTED);
+    assert(clist);
+    assert(clist->clist_comp_func);
+
+    uint32_t rover = clist->head;
+    for (size_t k = 1; k < clist->length; k++)
+    {
+        uint32_t next = clist->nodes[rover].next;
+        if (clist->clist_comp_func(clist->nodes[rover].data, clist->nodes[next].data) == -1) return false;
+        rover = next;
+    }
+
+    return true;
+}
+
+bool jll_clist_check_if_contains(const jll_clist_t * clist, bool (*compfunc)(const jll_data_t *))
+{
+    return (jll_clist_find_nth_occurrence(clist, compfunc, 1) != NULL);
+}
+
+bool jll_clist_is_empty(const jll_clist_t * clist)
+{
+    assert(clist);
+    return (clist->length == 0);
+}
+
+bool jll_clist_is_circular(const jll_clist_t * clist)
+{
+    assert(clist);
+    return clist->circular;
+}
+
+
+/* list manipulation */
+
+/**
+ * @brief Reverses the list by swapping every node's links; no data moves
+ */
+void jll_clist_reversal(jll_clist_t * clist)
+{
+    JLL_LAT_SCOPE(CLIST_REVERSAL);
+    assert(clist);
+    if (clist->length < 2) return;
+
+    uint32_t rover = clist->head;
+    for (size_t k = 0; k < clist->length; k++)
+    {
+        jll_cnode_t * node = &clist->nodes[rover];
+        uint32_t next = node->next;
+
+        node->next = node->prev;
+        node->prev = next;
+        rover = next;
+    }
+
+    uint32_t head = clist->head;
+    clist->head = clist->tail;
+    clist->tail = head;
+    __jll_clist_fix_ends(clist);
+}
+
+/**
+ * @brief Rotates the list so that the element at position n becomes the head
+ */
+void jll_clist_rotate_n(jll_clist_t * clist, size_t n)
+{
+    JLL_LAT_SCOPE(CLIST_ROTATE_N);
+    assert(clist);
+    if (clist->length < 2) return;
+
+    n %= clist->length;
+    if (n == 0) return;
+
+    // Close the ring, move both ends, then let fix_ends reopen it for linear lists.
+    clist->nodes[clist->tail].next = clist->head;
+    clist->nodes[clist->head].prev = clist->tail;
+
+    uint32_t head = __jll_clist_walk(clist, n);
+    clist->tail = clist->nodes[head].prev;
+    clist->head = head;
+
+    __jll_clist_fix_ends(clist);
+}
+
+/**
+ * @brief Appends the elements of the second list to the first; the second list is left empty but not deallocated
+ */
+void jll_clist_concat(jll_clist_t * lone, jll_clist_t * ltwo)
+{
+    JLL_LAT_SCOPE(CLIST_CONCAT);
+    assert(lone);
+    assert(ltwo);
+    assert(lone != ltwo);
+
+    jll_clist_reserve(lone, lone->length + ltwo->length);
+
+    uint32_t rover = ltwo->head;
+    for (size_t k = 0; k < ltwo->length; k++)
+    {
+        jll_clist_append_tail(lone, ltwo->nodes[rover].data);
+        rover = ltwo->nodes[rover].next;
+    }
+
+    __jll_clist_reset(ltwo);
+}
+
+/**
+ * @brief Splits a list in two; the list keeps its first n elements and the rest move to a new list
+ *
+ * @returns Pointer to the new list holding the elements from position n onward
+ */
+jll_clist_t * jll_clist_split_at_nth(jll_clist_t * clist, size_t n)
+{
+    JLL_LAT_SCOPE(CLIST_SPLIT_AT_NTH);
+    assert(clist);
+
+    jll_clist_t * new_clist = jll_alloc_clist(clist->clist_comp_func, clist->circular, clist->sorted);
+    if (n >= clist->length) return new_clist;
+
+    jll_clist_reserve(new_clist, clist->length - n);
+
+    uint32_t rover = __jll_clist_walk(clist, n);
+    while (clist->length > n)
+    {
+        uint32_t next = clist->nodes[rover].next;
+        jll_clist_append_tail(new_clist, __jll_clist_unlink(clist, rover));
+        rover = next;
+    }
+
+    return new_clist;
+}
+
+/**
+ * @brief Merges a sorted list into another, stably (on ties the first list's elements come first);
+ * the second list is left empty but not deallocated
+ */
+void jll_clist_merge_sorted(jll_clist_t * lone, jll_clist_t * ltwo)
+{
+    JLL_LAT_SCOPE(CLIST_MERGE_SORTED);
+    assert(lone);
+    assert(ltwo);
+    assert(lone != ltwo);
+    assert(lone->clist_comp_func);
+
+    jll_clist_reserve(lone, lone->length + ltwo->length);
+
+    uint32_t after = JLL_CLIST_NIL;
+    uint32_t rover = lone->head;
+    size_t remaining = lone->length;
+
+    uint32_t other = ltwo->head;
+    for (size_t k = 0; k < ltwo->length; k++)
+    {
+        const jll_data_t * dptr = ltwo->nodes[other].data;
+
+        while ((remaining) && (lone->clist_comp_func(lone->nodes[rover].data, dptr) != -1))
+        {
+            after = rover;
+            rover = lone->nodes[rover].next;
+            remaining--;
+        }
+
+        uint32_t idx = __jll_clist_new_node(lone, dptr);
+        __jll_clist_link_after(lone, idx, after);
+        after = idx;
+
+        other = ltwo->nodes[other].next;
+    }
+
+    __jll_clist_reset(ltwo);
+}
+
+/**
+ * @brief Removes adjacent elements which compare equal to their predecessor, keeping the first of each run
+ *
+ * @returns Number of elements removed
+ */
+size_t jll_clist_unique(jll_clist_t * clist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(CLIST_UNIQUE);
+    assert(clist);
+    assert(clist->clist_comp_func);
+    if (clist->length < 2) return 0;
+
+    size_t removed = 0;
+    uint32_t keep = clist->head;
+    size_t remaining = clist->length - 1;
+
+    while (remaining--)
+    {
+        uint32_t next = clist->nodes[keep].next;
+
+        if (clist->clist_comp_func(clist->nodes[keep].data, clist->nodes[next].data) == 0)
+        {
+            const jll_data_t * old_data_ptr = __jll_clist_unlink(clist, next);
+            if (data_dealloc_func) data_dealloc_func(old_data_ptr);
+            removed++;
+        }
+        else keep = next;
+    }
+
+    return removed;
+}
+
+
+/* relocation and serialization */
+
+/**
+ * @brief Writes the list as a fixed header followed by the node array in a single block.
+ * Data pointers are written verbatim, so they must be meaningful to the reader (e.g. offsets or handles).
+ *
+ * @returns True if everything was written
+ */
+bool jll_clist_write(const jll_clist_t * clist, FILE * stream)
+{
+    JLL_LAT_SCOPE(CLIST_WRITE);
+    assert(clist);
+    assert(stream);
+
+    jll_clist_image_t image;
+    memset(&image, 0, sizeof(jll_clist_image_t));
+
+    image.magic = JLL_CLIST_MAGIC;
+    image.node_size = sizeof(jll_cnode_t);
+    image.used = clist->used;
+    image.free_head = clist->free_head;
+    image.head = clist->head;
+    image.tail = clist->tail;
+    image.length = clist->length;
+    image.circular = clist->circular;
+    image.sorted = clist->sorted;
+
+    if (fwrite(&image, sizeof(jll_clist_image_t), 1, stream) != 1) return false;
+    if (clist->used == 0) return true;
+
+    return (fwrite(clist->nodes, sizeof(jll_cnode_t), clist->used, stream) == clist->used);
+}
+
+/**
+ * @brief Checks a freshly read list before anything follows its indices: the live chain must run from head
+ * to tail in exactly length steps, linked consistently both ways and wrapped (or NIL-terminated) as the list
+ * says, and the free chain must account for every other slot below used
+ */
+static bool __jll_clist_image_intact(const jll_clist_t * clist)
+{
+    const jll_cnode_t * nodes = clist->nodes;
+    uint32_t used = clist->used;
+
+    if (clist->length > used) return false;
+    if ((clist->free_head != JLL_CLIST_NIL) && (clist->free_head >= used)) return false;
+
+    if (clist->length == 0)
+    {
+        if ((clist->head != JLL_CLIST_NIL) || (clist->tail != JLL_CLIST_NIL)) return false;
+    }
+    else if ((clist->head >= used) || (clist->tail >= used)) return false;
+
+    uint8_t * seen = (uint8_t *)calloc((used) ? used : 1, sizeof(uint8_t));
+    bool intact = true;
+
+    uint32_t rover = clist->head;
+    uint32_t prev = (clist->circular) ? clist->tail : JLL_CLIST_NIL;
+
+    for (size_t k = 0; (intact) && (k < clist->length); k++)
+    {
+        if ((rover >= used) || (seen[rover]) || (nodes[rover].prev != prev) || (!nodes[rover].data)) intact = false;
+        else
+        {
+            seen[rover] = 1;
+            prev = rover;
+            rover = nodes[rover].next;
+        }
+    }
+
+    if ((intact) && (clist->length))
+    {
+        uint32_t end = (clist->circular) ? clist->head : JLL_CLIST_NIL;
+        intact = (prev == clist->tail) && (rover == end);
+    }
+
+    // Free slots chain through next; a cycle or a live slot in the chain would be handed out twice.
+    size_t free_slots = 0;
+    rover = clist->free_head;
+
+    while ((intact) && (rover != JLL_CLIST_NIL))
+    {
+        if ((rover >= used) || (seen[rover])) intact = false;
+        else
+        {
+            seen[rover] = 1;
+            free_slots++;
+            rover = nodes[rover].next;
+        }
+    }
+
+    free(seen);
+    return (intact) && (clist->length + free_slots == used);
+}
+
+/**
+ * @brief Reads a list written by jll_clist_write. Every index in the image is checked against the slots
+ * actually read, so a truncated, corrupted or hostile image is refused rather than followed.
+ *
+ * @returns Pointer to the newly created list, or NULL if the stream does not hold a compatible, intact image
+ */
+jll_clist_t * jll_clist_read(FILE * stream, data_compfunc_t func)
+{
+    JLL_LAT_SCOPE(CLIST_READ);
+    assert(stream);
+
+    jll_clist_image_t image;
+    if (fread(&image, sizeof(jll_clist_image_t), 1, stream) != 1) return NULL;
+    if ((image.magic != JLL_CLIST_MAGIC) || (image.node_size != sizeof(jll_cnode_t))) return NULL;
+    if ((image.used >= JLL_CLIST_NIL) || (image.length > image.used)) return NULL;
+
+    jll_clist_t * new_clist = jll_alloc_clist(func, image.circular, image.sorted);
+    jll_clist_reserve(new_clist, image.used);
+
+    if ((image.used) && (fread(new_clist->nodes, sizeof(jll_cnode_t), image.used, stream) != image.used))
+    {
+        jll_dealloc_clist(new_clist, NULL);
+        return NULL;
+    }
+
+    new_clist->used = image.used;
+    new_clist->free_head = image.free_head;
+    new_clist->head = image.head;
+    new_clist->tail = image.tail;
+    new_clist->length = (size_t)image.length;
+
+    if (!__jll_clist_image_intact(new_clist))
+    {
+        jll_dealloc_clist(new_clist, NULL);
+        return NULL;
+    }
+
+    return new_clist;
+}
+
+
+/* memory accounting */
+
+void jll_clist_memory(const jll_clist_t * clist, jll_list_memory_t * out)
+{
+    assert(clist);
+    assert(out);
+
+    out->header_bytes = sizeof(jll_clist_t);
+    out->node_bytes = clist->capacity * sizeof(jll_cnode_t);
+    out->payload_bytes_issued = clist->payload_bytes_issued;
+    out->total_bytes = out->header_bytes + out->node_bytes;
+}
@@ -5,601 +5,3441 @@
 # include <string.h>
 # include <assert.h>
 # include "./include/dlist.h"
+# include "./include/reclaim.h"
 
-/* allocators and deallocators */
+# define JLL_DLIST_TEARDOWN_BATCH 256
+# define JLL_DLIST_SCAN_BATCH 64
+# define JLL_DLIST_SCAN_BATCH_MAX 256
+# define JLL_DLIST_SCAN_FIRST_BATCH 8
+# define JLL_DLIST_POOL_BLOCK 64
+# define JLL_DLIST_POOL_BLOCK_MAX 65536
 
 
-jll_dlist_t * jll_alloc_dlist(data_compfunc_t func, bool circflag, bool sortflag, bool perflag)
-{
-    
-    jll_dlist_t * new_dlist = (jll_dlist_t *)malloc(sizeof(jll_dlist_t));
+/* bookkeeping hooks shared by every insertion and removal path */
 
-    new_dlist->head = NULL;
-    new_dlist->tail = NULL;
-    new_dlist->length = 0;
+static void __jll_dlist_note_insert(jll_dlist_t * dlist, const jll_data_t * dptr)
+{
+    if (dlist->bloom) jll_bloom_insert(dlist->bloom, dptr);
+}
 
-    new_dlist->circular = circflag;
-    new_dlist->sorted = sortflag;
-    new_dlist->persistent = perflag;
+static void __jll_dlist_note_remove(jll_dlist_t * dlist)
+{
+    dlist->generation++;
+    if (dlist->bloom) jll_bloom_note_removal(dlist->bloom);
+}
 
-    new_dlist->dlist_comp_func = func;
+static void __jll_dlist_note_payload(jll_dlist_t * dlist, const jll_data_payload_t * payload)
+{
+    dlist->payload_bytes_issued += sizeof(jll_data_payload_t) + payload->capacity * sizeof(jll_data_t *);
+}
 
-    return new_dlist;
+/**
+ * @brief Returns the cached sort key of data, or 0 when the list keeps no keys
+ */
+static uint64_t __jll_dlist_key_of(const jll_dlist_t * dlist, const jll_data_t * dptr)
+{
+    return (dlist->dlist_key_func) ? dlist->dlist_key_func(dptr) : 0;
 }
 
+static void __jll_dlist_rekey(const jll_dlist_t * dlist, jll_dnode_t * rover, size_t count)
+{
+    for (size_t k = 0; k < count; k++)
+    {
+        JLL_DKNODE(rover)->key = __jll_dlist_key_of(dlist, rover->data);
+        rover = rover->next;
+    }
+}
 
-void jll_dealloc_dlist(jll_dlist_t * dlist, void (*data_dealloc_func)(const jll_data_t *))
+/**
+ * @brief Size of the nodes a list holds: keyed nodes while it caches keys or counts, plain ones otherwise
+ */
+static size_t __jll_dlist_node_bytes(const jll_dlist_t * dlist)
 {
-    assert(dlist);
-    assert(data_dealloc_func);
+    return (dlist->keyed) ? sizeof(jll_dknode_t) : sizeof(jll_dnode_t);
+}
 
-    jll_dnode_t * fptr = dlist->head;
-    jll_dnode_t * bptr = NULL;
+/**
+ * @brief Restores the wrap-around (circular) or NULL (linear) links at both ends of a list
+ */
+static void __jll_dlist_fix_ends(jll_dlist_t * dlist)
+{
+    if (jll_dlist_is_empty(dlist)) return;
 
-    while (fptr)
+    if (dlist->circular)
     {
-        bptr = fptr;
-        fptr = fptr->next;
-
-        const jll_data_t * old_data_ptr = jll_dealloc_dnode(bptr);
-        data_dealloc_func(old_data_ptr);
+        dlist->head->prev = dlist->tail;
+        dlist->tail->next = dlist->head;
+    }
+    else
+    {
+        dlist->head->prev = NULL;
+        dlist->tail->next = NULL;
     }
-
-    free(dlist);
 }
 
-/* insertion functions */
 
-void jll_dlist_append_head(jll_dlist_t * dlist, const jll_data_t * dptr)
+/* linking shared by the node-level operations and the paths which relink nodes the list already holds */
+
+static void __jll_dlist_link_head(jll_dlist_t * dlist, jll_dnode_t * node)
 {
-    assert(dlist);
-    assert(dptr);
+    node->prev = NULL;
 
-    jll_dnode_t * newptr = jll_alloc_dnode(dptr);
-    
     if (jll_dlist_is_empty(dlist))
     {
-        dlist->head = newptr;
-        dlist->tail = newptr;
+        node->next = NULL;
+        dlist->head = node;
+        dlist->tail = node;
     }
     else
     {
-        newptr->next = dlist->head;
-        dlist->head->prev = newptr;
-        dlist->head = newptr;
+        node->next = dlist->head;
+        dlist->head->prev = node;
+        dlist->head = node;
     }
 
     dlist->length++;
-
-    if (dlist->circular)
-    {
-        dlist->head->prev = dlist->tail;
-        dlist->tail->next = dlist->head;
-    }
+    __jll_dlist_fix_ends(dlist);
 }
 
-
-void jll_dlist_append_tail(jll_dlist_t * dlist, const jll_data_t * dptr)
+static void __jll_dlist_link_tail(jll_dlist_t * dlist, jll_dnode_t * node)
 {
-    assert(dlist);
-    assert(dptr);
-
-    jll_dnode_t * newptr = jll_alloc_dnode(dptr);
+    node->next = NULL;
 
     if (jll_dlist_is_empty(dlist))
     {
-        dlist->head = newptr;
-        dlist->tail = newptr;
+        node->prev = NULL;
+        dlist->head = node;
+        dlist->tail = node;
     }
     else
     {
-        dlist->tail->next = newptr;
-        newptr->prev = dlist->tail;
-        dlist->tail = newptr;
+        node->prev = dlist->tail;
+        dlist->tail->next = node;
+        dlist->tail = node;
     }
 
     dlist->length++;
+    __jll_dlist_fix_ends(dlist);
+}
+
+static void __jll_dlist_link_before(jll_dlist_t * dlist, jll_dnode_t * node, jll_dnode_t * at)
+{
+    if (at == dlist->head) return __jll_dlist_link_head(dlist, node);
+
+    node->next = at;
+    node->prev = at->prev;
+    at->prev->next = node;
+    at->prev = node;
+
+    dlist->length++;
+}
 
-    if (dlist->circular)
+/**
+ * @brief Takes in a node linked by the caller as any inserted node is: its sort key is cached and its data
+ * enters the filter. Such nodes belong to the caller, so the list never moves them into nodes of another kind.
+ */
+static void __jll_dlist_adopt(jll_dlist_t * dlist, jll_dnode_t * node)
+{
+    dlist->caller_nodes = true;
+    dlist->foreign_nodes = true;
+
+    if (dlist->keyed)
     {
-        dlist->head->prev = dlist->tail;
-        dlist->tail->next = dlist->head;
+        JLL_DKNODE(node)->key = __jll_dlist_key_of(dlist, node->data);
+        JLL_DKNODE(node)->freq = 0;
     }
+
+    __jll_dlist_note_insert(dlist, node->data);
 }
 
-void jll_dlist_insert_sorted(jll_dlist_t * dlist, const jll_data_t * dptr)
+static jll_dnode_t * __jll_dlist_new_node(jll_dlist_t * dlist, const jll_data_t * dptr)
 {
-    assert(dlist);
-    assert(dptr);
-    assert(dlist->dlist_comp_func);
+    JLL_PROF_ALLOC(dlist);
+    jll_dnode_t * node;
 
-    if (jll_dlist_is_empty(dlist)) return jll_dlist_append_head(dlist, dptr);
+    // Rings recycle the nodes preallocated at creation.
+    if (dlist->spare)
+    {
+        node = dlist->spare;
+        dlist->spare = node->next;
 
-    jll_dnode_t * rover = dlist->head;
+        node->next = NULL;
+        node->prev = NULL;
+        node->data = dptr;
 
-    while (rover)
+        JLL_MEM_ADD(JLL_MEM_NODES, __jll_dlist_node_bytes(dlist));
+    }
+    else if (dlist->keyed) node = &((dlist->pool) ? jll_alloc_dknode_from(dlist->pool, dptr) : jll_alloc_dknode(dptr))->node;
+    else node = (dlist->pool) ? jll_alloc_dnode_from(dlist->pool, dptr) : jll_alloc_dnode(dptr);
+
+    if (dlist->keyed)
     {
-        // Comparison function should return -1 if dptr data belongs *before* the rover node.
-        if (dlist->dlist_comp_func(rover->data, dptr) == -1)
-        {
-            // Insert newnode *before* the rover node.
-            if (rover == dlist->head)
-            {
-                return jll_dlist_append_head(dlist, dptr);
-            }
-            else
-            {
-                jll_dnode_t * new_node = jll_alloc_dnode(dptr);
-                
-                new_node->next = rover;
-                new_node->prev = rover->prev;
-
-                if (new_node->prev) new_node->prev->next = new_node;
-                
-                rover->prev = new_node;
-                dlist->length++;
-                return;
-            }
-        }
-        else if (!rover->next)
-        {
-            return jll_dlist_append_tail(dlist, dptr);
-        }
-        else
-        {
-            rover = rover->next;
-        }
+        JLL_DKNODE(node)->key = __jll_dlist_key_of(dlist, dptr);
+        JLL_DKNODE(node)->freq = 0;
     }
-}
 
+    return node;
+}
 
-/* deletion functions */
+/**
+ * @brief Frees a node of the kind the list holds, back to the pool (or heap) it came from. Only nodes which
+ * may have come from elsewhere need their owner looked up; the rest go straight to the list's own pool.
+ */
+static const jll_data_t * __jll_dlist_dealloc_node(const jll_dlist_t * dlist, jll_dnode_t * node)
+{
+    if (dlist->foreign_nodes) return (dlist->keyed) ? jll_dealloc_dknode(JLL_DKNODE(node)) : jll_dealloc_dnode(node);
+    return (dlist->keyed) ? jll_dealloc_dknode_to(dlist->pool, JLL_DKNODE(node)) : jll_dealloc_dnode_to(dlist->pool, node);
+}
 
-const jll_data_t * jll_dlist_remove_index(jll_dlist_t * dlist, size_t index)
+static const jll_data_t * __jll_dlist_free_node(jll_dlist_t * dlist, jll_dnode_t * node)
 {
-    assert(dlist);
-    if ((index < 0) || (index >= dlist->length)) return NULL;
+    JLL_PROF_FREE(dlist);
 
-    if (index == 0) return jll_dlist_remove_head(dlist);
-    else if (index == dlist->length - 1) return jll_dlist_remove_tail(dlist);
+    if (dlist->capacity)
+    {
+        const jll_data_t * old_data_ptr = node->data;
 
-    jll_dnode_t * rover;
-    size_t k;
+        node->next = dlist->spare;
+        dlist->spare = node;
 
-    if (dlist->length < 2 * index + 1)
-    {
-        rover = dlist->tail;
-        for (k = dlist->length - 1; k > index; k--) rover = rover->prev;
+        JLL_MEM_SUB(JLL_MEM_NODES, __jll_dlist_node_bytes(dlist));
+        return old_data_ptr;
     }
-    else
+
+    return __jll_dlist_dealloc_node(dlist, node);
+}
+
+/**
+ * @brief Hands the idle nodes of a ring back to the pool (or heap) they came from
+ */
+static void __jll_dlist_release_spare(jll_dlist_t * dlist)
+{
+    while (dlist->spare)
     {
-        rover = dlist->head;
-        for (k = 0; k < index; k++) rover = rover->next;
+        jll_dnode_t * next = dlist->spare->next;
+        if (!jll_pool_release(dlist->spare)) free(dlist->spare);
+        dlist->spare = next;
     }
+}
 
-    const jll_data_t * retdata = rover->data;
-
-    rover->next->prev = rover->prev;
-    rover->prev->next = rover->next;
+/**
+ * @brief Preallocates the nodes of a ring in one block of a fresh pool and threads them onto the spare chain
+ */
+static void __jll_dlist_stock_ring(jll_dlist_t * dlist)
+{
+    size_t bytes = __jll_dlist_node_bytes(dlist);
 
-    free(rover);
-    dlist->length--;
+    dlist->pool = jll_alloc_pool(bytes, dlist->capacity, false);
+    char * block = (char *)jll_pool_get_block(dlist->pool, dlist->capacity, false);
 
-    return retdata;
+    for (size_t k = dlist->capacity; k > 0; k--)
+    {
+        jll_dnode_t * node = (jll_dnode_t *)(block + (k - 1) * bytes);
+        node->next = dlist->spare;
+        dlist->spare = node;
+    }
 }
 
 
-const jll_data_t * jll_dlist_remove_head(jll_dlist_t * dlist)
+/* tombstones */
+
+/**
+ * @brief Number of nodes linked into a list, dead ones included; length counts live elements only
+ */
+static size_t __jll_dlist_nodes(const jll_dlist_t * dlist)
 {
-    assert(dlist);
-    if (jll_dlist_is_empty(dlist)) return NULL;
+    return dlist->length + dlist->tombstones;
+}
 
+/**
+ * @brief Purges the tombstones of a list ahead of an operation which reads the data of every node or relinks
+ * nodes wholesale, so only the lazy-aware paths ever meet a dead node
+ */
+static void __jll_dlist_settle(jll_dlist_t * dlist)
+{
+    if (dlist->tombstones) jll_dlist_purge_tombstones(dlist);
+}
 
-    const jll_data_t * retdata = dlist->head->data;
+/**
+ * @brief Frees the dead nodes at both ends of a list, so a non-empty list always has a live head and tail.
+ * Their removal was noted when they were buried.
+ */
+static void __jll_dlist_trim_ends(jll_dlist_t * dlist)
+{
+    if (!dlist->tombstones) return;
 
-    if (dlist->head->next)
+    while ((dlist->tombstones) && (!dlist->head->data))
     {
-        dlist->head = dlist->head->next;
-        free(dlist->head->prev);
+        jll_dnode_t * dead = dlist->head;
+        dlist->head = dead->next;
 
-        if (dlist->circular)
-        {
-            dlist->head->prev = dlist->tail;
-            dlist->tail->next = dlist->head;
-        }
-        else
-        {
-            dlist->head->prev = NULL;
-        }
+        __jll_dlist_free_node(dlist, dead);
+        dlist->tombstones--;
     }
-    else
+
+    // With no live element left, the walk from the head has freed every node.
+    if (dlist->length == 0)
     {
-        free(dlist->head);
         dlist->head = NULL;
         dlist->tail = NULL;
+        return;
     }
 
-    dlist->length--;
-    return retdata;
-}
+    while ((dlist->tombstones) && (!dlist->tail->data))
+    {
+        jll_dnode_t * dead = dlist->tail;
+        dlist->tail = dead->prev;
+
+        __jll_dlist_free_node(dlist, dead);
+        dlist->tombstones--;
+    }
 
+    __jll_dlist_fix_ends(dlist);
+}
 
-const jll_data_t * jll_dlist_remove_tail(jll_dlist_t * dlist)
+/**
+ * @brief Marks a located node dead in O(1), purging the list once its dead ratio passes the threshold
+ * 
+ * @returns The data the node referenced
+ */
+static const jll_data_t * __jll_dlist_bury(jll_dlist_t * dlist, jll_dnode_t * node)
 {
-    assert(dlist);
-    if (jll_dlist_is_empty(dlist)) return NULL;
+    const jll_data_t * retdata = node->data;
+
+    node->data = NULL;
+    dlist->length--;
+    dlist->tombstones++;
+    __jll_dlist_note_remove(dlist);
 
+    __jll_dlist_trim_ends(dlist);
+    if ((double)dlist->tombstones > dlist->tombstone_ratio * (double)__jll_dlist_nodes(dlist)) jll_dlist_purge_tombstones(dlist);
 
-    const jll_data_t * retdata = dlist->tail->data;
+    return retdata;
+}
+
+/**
+ * @brief Walks to the index-th live node from whichever end is closer, stepping over tombstones
+ */
+static jll_dnode_t * __jll_dlist_live_node(jll_dlist_t * dlist, size_t index)
+{
+    size_t live = dlist->length;
+    jll_dnode_t * rover;
+    size_t k;
 
-    if (dlist->tail->prev)
+    // Both ends are live, so each walk starts on a live node of known index.
+    if (live < 2 * index + 1)
     {
-        dlist->tail = dlist->tail->prev;
-        free(dlist->tail->next);
-        if (dlist->circular)
+        JLL_PROF_WALK_BWD(dlist);
+        rover = dlist->tail;
+        for (k = live - 1; k > index; )
         {
-            dlist->tail->next = dlist->head;
-            dlist->head->prev = dlist->tail;
+            rover = rover->prev;
+            if (rover->data) k--;
+            JLL_PROF_HOP(dlist);
         }
-        else dlist->tail->next = NULL;
     }
     else
     {
-        free(dlist->tail);
-        dlist->tail = NULL;
-        dlist->head = NULL;
+        JLL_PROF_WALK_FWD(dlist);
+        rover = dlist->head;
+        for (k = 0; k < index; )
+        {
+            rover = rover->next;
+            if (rover->data) k++;
+            JLL_PROF_HOP(dlist);
+        }
     }
 
-    dlist->length--;
-    return retdata;
+    return rover;
 }
 
-const jll_data_t * jll_dlist_remove_cond_first(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+/**
+ * @brief Moves the nodes of a list into nodes of the other kind, keyed or plain, so that only lists which
+ * cache keys or counts pay for them. Ring and pool storage is replaced by storage of the new node size,
+ * and node handles are invalidated.
+ * 
+ * @returns False, leaving the list untouched, if it holds nodes linked in by the caller, which must not move
+ */
+static bool __jll_dlist_recast(jll_dlist_t * dlist, bool keyed)
 {
-    assert(dlist);
-    assert(compfunc);
+    if (dlist->keyed == keyed) return true;
 
-    jll_dnode_t * rover = dlist->head;
-    while (rover)
-    {
-        if (compfunc(rover->data))
-            return rover->data;
-        else
-            rover = rover->next;
-    }
+    __jll_dlist_settle(dlist);
+    if (jll_dlist_is_empty(dlist)) dlist->caller_nodes = false;
+    if (dlist->caller_nodes) return false;
 
-    return NULL;
-}
+    jll_pool_t * old_pool = dlist->pool;
+    jll_dnode_t * old_spare = dlist->spare;
+    jll_dnode_t * rover = dlist->head;
 
-const jll_data_t * jll_dlist_remove_cond_nth(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), size_t n)
-{
-    assert(dlist);
-    assert(compfunc);
+    dlist->keyed = keyed;
+    dlist->spare = NULL;
+    dlist->head = NULL;
+    dlist->tail = NULL;
 
-    if (n >= dlist->length) return NULL;
+    if (dlist->capacity) __jll_dlist_stock_ring(dlist);
+    else if (old_pool) dlist->pool = jll_alloc_pool(__jll_dlist_node_bytes(dlist), JLL_DLIST_POOL_BLOCK, old_pool->hugepage);
 
-    size_t counter = 0;
+    for (size_t k = 0; k < dlist->length; k++)
+    {
+        jll_dnode_t * next = rover->next;
+        jll_dnode_t * copy = __jll_dlist_new_node(dlist, rover->data);
+
+        copy->prev = dlist->tail;
+        if (dlist->tail) dlist->tail->next = copy;
+        else dlist->head = copy;
+        dlist->tail = copy;
+
+        // The old node is of the kind being left behind.
+        if (keyed) jll_dealloc_dnode(rover);
+        else jll_dealloc_dknode(JLL_DKNODE(rover));
+        rover = next;
+    }
 
-    jll_dnode_t * rover = dlist->head;
+    __jll_dlist_fix_ends(dlist);
 
-    while (rover)
+    // The old ring's idle nodes go back too, after which the orphaned pool is destroyed.
+    while (old_spare)
     {
-        if (compfunc(rover->data)) counter++;
-        if (counter == n) return rover->data;
-        else rover = rover->next;
+        jll_dnode_t * next = old_spare->next;
+        jll_pool_release(old_spare);
+        old_spare = next;
     }
 
-    return NULL;
-}
+    if (old_pool) jll_dealloc_pool(old_pool);
 
+    dlist->foreign_nodes = false;
+    dlist->generation++;
+    return true;
+}
 
-jll_data_payload_t * jll_dlist_remove_cond_first_n(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), size_t n)
+/**
+ * @brief Brings the nodes of a list in line with its configuration: keyed nodes while it has a key function
+ * or counts accesses, plain nodes otherwise
+ */
+static bool __jll_dlist_conform(jll_dlist_t * dlist)
 {
+    return __jll_dlist_recast(dlist, (dlist->dlist_key_func) || (dlist->reorg == JLL_REORG_COUNT));
+}
 
-    assert(dlist);
-    assert(compfunc);
+/**
+ * @brief Fits a node which has just entered a count-ordered list into the order: it takes the count of the
+ * node it landed before when that is higher, so counts stay non-increasing from head to tail
+ */
+static void __jll_dlist_count_in(jll_dlist_t * dlist, jll_dnode_t * node)
+{
+    if ((dlist->reorg != JLL_REORG_COUNT) || (node == dlist->tail)) return;
 
-    if (n >= dlist->length) return NULL;
+    size_t next_freq = JLL_DKNODE(node->next)->freq;
+    if (JLL_DKNODE(node)->freq < next_freq) JLL_DKNODE(node)->freq = next_freq;
+}
 
-    size_t index = 0;
-    size_t found = 0;
-    jll_data_t ** vector;
+/**
+ * @brief Zeroes the counts of a count-ordered list, for when the nodes were put in an order of their own
+ */
+static void __jll_dlist_restart_counts(jll_dlist_t * dlist)
+{
+    if (dlist->reorg != JLL_REORG_COUNT) return;
 
     jll_dnode_t * rover = dlist->head;
-
-    while (rover && (found < n))
+    for (size_t k = 0; k < __jll_dlist_nodes(dlist); k++)
     {
-        if (compfunc(rover->data))
-        {
-            found++;
-            vector = (jll_data_t **)realloc(vector, found * sizeof(jll_data_t *));
-            vector[found - 1] = jll_dlist_remove_index(dlist, index);
-        }
-
-        index++;
+        JLL_DKNODE(rover)->freq = 0;
         rover = rover->next;
     }
-
-    if (found == 0)
-        return NULL;
-
-    jll_data_payload_t * new_payload = jll_allocate_data_payload((const jll_data_t **)vector, found);
-    return new_payload;
 }
 
-jll_data_payload_t * jll_dlist_remove_cond_all(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+/**
+ * @brief Hands the nodes of a donor list over to the list absorbing them: they are converted to the absorbing
+ * list's kind of node if need be, the absorbing list's filter and cached sort keys take in the new data, the
+ * donor is left empty and both lists' node handles are invalidated.
+ * 
+ * @param tail Receives the last of the handed-over nodes
+ * 
+ * @returns The first of the handed-over nodes (NULL if the donor was empty)
+ */
+static jll_dnode_t * __jll_dlist_absorb(jll_dlist_t * dlist, jll_dlist_t * donor, jll_dnode_t ** tail)
 {
-    assert(dlist);
-    assert(compfunc);
-
-    size_t index = 0;
-    size_t found = 0;
-    jll_data_t ** vector;
+    // Nodes the caller linked in cannot be converted, so such a donor must already hold the right kind.
+    __jll_dlist_recast(donor, dlist->keyed);
+    assert(donor->keyed == dlist->keyed);
 
+    jll_dnode_t * head = donor->head;
+    *tail = donor->tail;
 
-    jll_dnode_t * rover = dlist->head;
+    // Nodes keyed by another key function (or by none) take the absorbing list's keys.
+    if ((dlist->dlist_key_func) && (donor->dlist_key_func != dlist->dlist_key_func)) __jll_dlist_rekey(dlist, donor->head, donor->length);
 
-    while (rover)
+    if (dlist->bloom)
     {
-        if (compfunc(rover->data))
+        jll_dnode_t * rover = donor->head;
+        for (size_t k = 0; k < donor->length; k++)
         {
-            found++;
-            vector = (jll_data_t **)realloc(vector, found * sizeof(jll_data_t *));
-            vector[found - 1] = jll_dlist_remove_index(dlist, index);
+            jll_bloom_insert(dlist->bloom, rover->data);
+            rover = rover->next;
         }
+    }
 
-        index++;
-        rover = rover->next;
+    if (donor->bloom) jll_bloom_reset(donor->bloom, 0);
+
+    // Counts gathered in the donor mean nothing here; the handed-over nodes start at zero.
+    if (dlist->reorg == JLL_REORG_COUNT)
+    {
+        jll_dnode_t * rover = donor->head;
+        for (size_t k = 0; k < donor->length; k++)
+        {
+            JLL_DKNODE(rover)->freq = 0;
+            rover = rover->next;
+        }
     }
 
-    if (found == 0) return NULL;
+    donor->head = NULL;
+    donor->tail = NULL;
+    donor->length = 0;
+    donor->generation++;
+    donor->pool_shared = true;
+    donor->foreign_nodes = false;
 
-    jll_data_payload_t * new_payload = jll_allocate_data_payload((const jll_data_t **)vector, found);
-    return new_payload;
+    dlist->generation++;
+    dlist->pool_shared = true;
+    dlist->foreign_nodes = true;
+
+    // Left empty, the donor goes back to the kind of node its own configuration calls for.
+    __jll_dlist_conform(donor);
+    return head;
 }
 
 
-jll_data_payload_t * jll_dlist_remove_all(jll_dlist_t * dlist)
+/* adaptive sorted insertion */
+
+/**
+ * @brief Returns true if a node belongs after the node being inserted (the comparison function returns -1).
+ * Cached keys settle the order whenever they differ, so only ties read the data.
+ */
+static bool __jll_dlist_goes_after(jll_dlist_t * dlist, const jll_dnode_t * node, const jll_dnode_t * incoming)
 {
-    assert(dlist);
-    if (jll_dlist_is_empty(dlist)) return NULL;
+    if ((dlist->dlist_key_func) && (JLL_DKNODE(node)->key != JLL_DKNODE(incoming)->key))
+    {
+        dlist->insert_stats.key_decisions++;
+        return (JLL_DKNODE(node)->key > JLL_DKNODE(incoming)->key);
+    }
+
+    JLL_PROF_CMP(dlist);
+    dlist->insert_stats.comparisons++;
+    return (dlist->dlist_comp_func(node->data, incoming->data) == -1);
+}
+
+/**
+ * @brief Orders two nodes as the comparison function would, deciding on the cached keys whenever they differ
+ */
+static int __jll_dlist_compare_nodes(jll_dlist_t * dlist, const jll_dnode_t * a, const jll_dnode_t * b)
+{
+    if ((dlist->dlist_key_func) && (JLL_DKNODE(a)->key != JLL_DKNODE(b)->key)) return (JLL_DKNODE(a)->key > JLL_DKNODE(b)->key) ? -1 : 1;
 
-    size_t index  = 0;
-    size_t veclen = dlist->length;
-    jll_data_t ** vector = (jll_data_t **)malloc(veclen * sizeof(jll_data_t *));
+    JLL_PROF_CMP(dlist);
+    return dlist->dlist_comp_func(a->data, b->data);
+}
 
+static jll_dnode_t * __jll_dlist_advance(jll_dlist_t * dlist, jll_dnode_t * node, size_t steps, size_t * taken)
+{
+    size_t k = 0;
 
-    while (!jll_dlist_is_empty(dlist))
+    while ((k < steps) && (node != dlist->tail))
     {
-        vector[index] = jll_dlist_remove_head(dlist);
-        index++;
+        node = node->next;
+        JLL_PROF_HOP(dlist);
+        k++;
     }
 
-    jll_data_payload_t * newpayload = jll_allocate_data_payload((const jll_data_t **)vector, veclen);
-    return newpayload;
+    dlist->insert_stats.hops += k;
+    *taken = k;
+    return node;
 }
 
+static jll_dnode_t * __jll_dlist_retreat(jll_dlist_t * dlist, jll_dnode_t * node, size_t steps, size_t * taken)
+{
+    size_t k = 0;
 
+    while ((k < steps) && (node != dlist->head))
+    {
+        node = node->prev;
+        JLL_PROF_HOP(dlist);
+        k++;
+    }
 
+    dlist->insert_stats.hops += k;
+    *taken = k;
+    return node;
+}
 
+/**
+ * @brief Bisects a bracket in which lo does not belong after the incoming node and the node distance hops further on does
+ * @returns The last node which does not belong after the incoming node
+ */
+static jll_dnode_t * __jll_dlist_bisect(jll_dlist_t * dlist, jll_dnode_t * lo, size_t distance, const jll_dnode_t * incoming)
+{
+    while (distance > 1)
+    {
+        size_t half = distance / 2;
+        size_t taken;
+        jll_dnode_t * mid = __jll_dlist_advance(dlist, lo, half, &taken);
 
-/* access functions */
-const jll_data_t * jll_dlist_index_pos(jll_dlist_t * dlist, size_t index)
+        if (__jll_dlist_goes_after(dlist, mid, incoming)) distance = half;
+        else
+        {
+            lo = mid;
+            distance -= half;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Exponential search forward from a node which does not belong after the incoming node
+ * @returns The last node which does not belong after the incoming node
+ */
+static jll_dnode_t * __jll_dlist_gallop_forward(jll_dlist_t * dlist, jll_dnode_t * lo, const jll_dnode_t * incoming)
 {
-    assert(dlist);
+    size_t step = 1;
 
-    if ((index < 0) || (index >= dlist->length)) 
-        return NULL;
-    else if (index == 0) 
-        return jll_dlist_index_head(dlist);
-    else if (index == dlist->length - 1)
-        return jll_dlist_index_tail(dlist);
+    while (lo != dlist->tail)
+    {
+        size_t taken;
+        jll_dnode_t * probe = __jll_dlist_advance(dlist, lo, step, &taken);
 
-    jll_dnode_t * rover;
-    size_t k;
-    if (dlist->length < 2 * index + 1)
+        if (__jll_dlist_goes_after(dlist, probe, incoming)) return __jll_dlist_bisect(dlist, lo, taken, incoming);
+
+        lo = probe;
+        step <<= 1;
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Exponential search backward from a node which belongs after the incoming node
+ * @returns The last node which does not belong after the incoming node, or NULL if every node does
+ */
+static jll_dnode_t * __jll_dlist_gallop_backward(jll_dlist_t * dlist, jll_dnode_t * hi, const jll_dnode_t * incoming)
+{
+    size_t step = 1;
+
+    while (hi != dlist->head)
     {
-        rover = dlist->tail;
-        for (k = dlist->length - 1; k > index; k--) rover = rover->prev;
+        size_t taken;
+        jll_dnode_t * probe = __jll_dlist_retreat(dlist, hi, step, &taken);
+
+        if (!__jll_dlist_goes_after(dlist, probe, incoming)) return __jll_dlist_bisect(dlist, probe, taken, incoming);
+
+        hi = probe;
+        step <<= 1;
     }
-    else
+
+    return NULL;
+}
+
+/**
+ * @brief Finds where a new node belongs in a sorted list: after the tail for in-order data, otherwise by
+ * galloping out from the last insertion point or back from the tail.
+ * @returns The node which the new node should follow, or NULL if it becomes the head
+ */
+static jll_dnode_t * __jll_dlist_locate_sorted(jll_dlist_t * dlist, const jll_dnode_t * incoming)
+{
+    if (!__jll_dlist_goes_after(dlist, dlist->tail, incoming))
     {
-        rover = dlist->head;
-        for (k = 0; k < index; k++) rover = rover->next;
+        dlist->insert_stats.tail_hits++;
+        return dlist->tail;
     }
 
-    return (rover->data);
+    jll_dnode_t * start = dlist->tail;
+
+    // The finger is only trusted while no node has been removed or moved since it was set.
+    if ((dlist->finger) && (dlist->finger_generation == dlist->generation) && (dlist->finger != dlist->tail))
+    {
+        dlist->insert_stats.finger_hits++;
+        start = dlist->finger;
+
+        if (!__jll_dlist_goes_after(dlist, start, incoming)) return __jll_dlist_gallop_forward(dlist, start, incoming);
+    }
+
+    return __jll_dlist_gallop_backward(dlist, start, incoming);
 }
 
 
-const jll_data_t * jll_dlist_index_head(jll_dlist_t * dlist)
+/* allocators and deallocators */
+
+
+/**
+ * @brief Initialise a doubly-linked list embedded by value in another structure; no memory is allocated
+ * 
+ * @param dlist Pointer to the list storage to be initialised
+ * @param func The comparison function which the list will use for sorted-based insertions
+ * @param circflag Boolean flag which determines if the list will be circular or not
+ * @param sortflag Boolean flag which determines if the list will be sorted or not
+ * @param perflag  Boolean flag which determines if the list will be persistent or not
+ * 
+ * @returns None (is void)
+ */
+void jll_init_dlist(jll_dlist_t * dlist, data_compfunc_t func, bool circflag, bool sortflag, bool perflag)
 {
     assert(dlist);
-    if (!dlist->head)
-        return NULL;
-    else
-        return dlist->head->data;
-}
 
+    dlist->head = NULL;
+    dlist->tail = NULL;
+    dlist->length = 0;
+
+    dlist->circular = circflag;
+    dlist->sorted = sortflag;
+    dlist->persistent = perflag;
+    dlist->keyed = false;
+
+    dlist->reorg = JLL_REORG_NONE;
+    dlist->bloom = NULL;
+    dlist->payload_bytes_issued = 0;
+    dlist->pool = NULL;
+    dlist->pool_shared = false;
+    dlist->heap_header = false;
+    dlist->caller_nodes = false;
+    dlist->foreign_nodes = false;
+    dlist->generation = 0;
+
+    dlist->finger = NULL;
+    dlist->finger_generation = 0;
+    memset(&dlist->insert_stats, 0, sizeof(jll_insert_stats_t));
+
+    dlist->capacity = 0;
+    dlist->ring_policy = JLL_RING_OVERWRITE;
+    dlist->spare = NULL;
+    dlist->ring_evict_func = NULL;
+    dlist->scan_batch = JLL_DLIST_SCAN_BATCH;
+    dlist->tombstones = 0;
+    dlist->tombstone_ratio = 0;
+    JLL_PROF_INIT(dlist);
+
+    dlist->dlist_comp_func = func;
+    dlist->dlist_key_func = NULL;
+}
 
-const jll_data_t * jll_dlist_index_tail(jll_dlist_t * dlist)
+jll_dlist_t * jll_alloc_dlist(data_compfunc_t func, bool circflag, bool sortflag, bool perflag)
 {
-    assert(dlist);
-    if (!dlist->tail)
-        return NULL;
-    else
-        return dlist->tail->data;
+    JLL_LAT_SCOPE(DLIST_ALLOC);
+    jll_dlist_t * new_dlist = (jll_dlist_t *)malloc(sizeof(jll_dlist_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_dlist_t));
+
+    jll_init_dlist(new_dlist, func, circflag, sortflag, perflag);
+    new_dlist->heap_header = true;
+
+    return new_dlist;
 }
 
 
-const jll_data_t * jll_dlist_find_first_occurrence(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+/**
+ * @brief Allocate a bounded ring: a circular doubly-linked list of fixed capacity whose nodes are preallocated
+ * in one block and recycled, so pushes and pops never allocate
+ * 
+ * @param func     The comparison function used by keyed lookups (may be NULL)
+ * @param capacity Maximum number of elements held
+ * @param policy   Whether a push onto a full ring overwrites the element at the opposite end or is rejected
+ * @param evict_func User-specified function handed the data of overwritten elements (may be NULL)
+ * 
+ * @returns Pointer to the newly created ring
+ */
+jll_dlist_t * jll_alloc_dlist_ring(data_compfunc_t func, size_t capacity, jll_ring_policy_t policy, void (*evict_func)(const jll_data_t *))
 {
-    assert(dlist);
-    assert(compfunc);
+    JLL_LAT_SCOPE(DLIST_ALLOC_RING);
+    assert(capacity > 0);
 
-    jll_dnode_t * rover = dlist->head;
+    jll_dlist_t * new_ring = jll_alloc_dlist(func, true, false, false);
 
-    while (rover)
-    {
-        if (compfunc(rover->data))
-            return rover->data;
-        else
-            rover = rover->next;
-    }
-    
-    return NULL;
-}
+    new_ring->capacity = capacity;
+    new_ring->ring_policy = policy;
+    new_ring->ring_evict_func = evict_func;
 
+    __jll_dlist_stock_ring(new_ring);
 
-const jll_data_t * jll_dlist_find_nth_occurrence(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), size_t n)
+    return new_ring;
+}
+
+/**
+ * @brief Releases the nodes of a list, handing the data to either the per-element or the batched
+ * function (either or both may be NULL). When every node came from the list's own pool and none were
+ * ever exchanged with another list, the pool is dropped wholesale instead of node by node; with no
+ * data function as well, the nodes are not visited at all. The header itself is left to the caller.
+ */
+static void __jll_dlist_teardown(jll_dlist_t * dlist, void (*data_dealloc_func)(const jll_data_t *), data_batchdealloc_t data_batch_func)
 {
-    assert(dlist);
-    assert(compfunc);
+    __jll_dlist_release_spare(dlist);
 
-    if ((n <= 0) || (n >= dlist->length)) return NULL;
+    // Dead nodes are still linked, and are freed (without data) along with the rest.
+    size_t nodes = __jll_dlist_nodes(dlist);
+    // Matching counts alone prove nothing: heap or caller nodes can be linked while pool slots are out elsewhere.
+    bool own_nodes = (!dlist->foreign_nodes) && (!dlist->caller_nodes);
+    bool bulk = (dlist->pool) && (!dlist->pool_shared) && (own_nodes) && (jll_pool_live(dlist->pool) == nodes);
+    bool visit = (!bulk) || (data_dealloc_func) || (data_batch_func);
 
-    size_t counter = 0;
-    jll_dnode_t * rover = dlist->head;
+    const jll_data_t * batch[JLL_DLIST_TEARDOWN_BATCH];
+    size_t batched = 0;
 
-    while (rover)
+    jll_dnode_t * fptr = dlist->head;
+    jll_dnode_t * bptr = NULL;
+
+    // Bounded by the node count so circular lists terminate.
+    for (size_t k = 0; (visit) && (k < nodes); k++)
     {
-        if (compfunc(rover->data)) counter++;
-        if (counter == n) return rover->data;
-        rover = rover->next;
+        bptr = fptr;
+        fptr = fptr->next;
+
+        const jll_data_t * old_data_ptr = (bulk) ? bptr->data : __jll_dlist_free_node(dlist, bptr);
+        if (!old_data_ptr) continue;
+
+        if (data_batch_func)
+        {
+            batch[batched++] = old_data_ptr;
+            if (batched == JLL_DLIST_TEARDOWN_BATCH)
+            {
+                data_batch_func(batch, batched);
+                batched = 0;
+            }
+        }
+        else if (data_dealloc_func) data_dealloc_func(old_data_ptr);
     }
 
-    return NULL;
+    if (batched) data_batch_func(batch, batched);
+
+    if (bulk)
+    {
+        JLL_MEM_SUB(JLL_MEM_NODES, nodes * __jll_dlist_node_bytes(dlist));
+        jll_pool_discard(dlist->pool);
+    }
+    else
+    {
+        // Ring nodes freed by the walk were parked on the spare chain.
+        __jll_dlist_release_spare(dlist);
+        if (dlist->pool) jll_dealloc_pool(dlist->pool);
+    }
+
+    if (dlist->bloom) jll_dealloc_bloom(dlist->bloom);
 }
 
-bool jll_dlist_check_if_sorted(jll_dlist_t * dlist)
+static void __jll_dlist_reclaim(jll_reclaim_job_t * job)
+{
+    jll_dlist_t * dlist = (jll_dlist_t *)job->object;
+
+    __jll_dlist_teardown(dlist, job->data_dealloc_func, job->data_batch_func);
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_dlist_t));
+    free(dlist);
+}
+
+void jll_dealloc_dlist(jll_dlist_t * dlist, void (*data_dealloc_func)(const jll_data_t *))
 {
+    JLL_LAT_SCOPE(DLIST_DEALLOC);
     assert(dlist);
-    if (!dlist->dlist_comp_func)
-        return false;
-    if (jll_dlist_is_empty(dlist))
-        return false;
 
-    jll_dnode_t * rover = dlist->head;
+    __jll_dlist_teardown(dlist, data_dealloc_func, NULL);
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_dlist_t));
+    free(dlist);
+}
 
-    while (rover->next)
-    {
-        if (dlist->dlist_comp_func(rover->data, rover->next->data) == -1)
-            return false;
-        else
-            rover = rover->next;
-    }
+/**
+ * @brief Deallocate a doubly-linked list, handing the data to a user-specified function in arrays
+ * of up to JLL_DLIST_TEARDOWN_BATCH elements rather than one call per element
+ * 
+ * @param dlist Pointer to the doubly-linked list to be deallocated
+ * @param data_batch_func User-specified function releasing an array of data pointers (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_dealloc_dlist_batched(jll_dlist_t * dlist, data_batchdealloc_t data_batch_func)
+{
+    JLL_LAT_SCOPE(DLIST_DEALLOC_BATCHED);
+    assert(dlist);
 
-    return true;
+    __jll_dlist_teardown(dlist, NULL, data_batch_func);
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_dlist_t));
+    free(dlist);
 }
 
-bool jll_dlist_check_if_contains(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+/**
+ * @brief Release the nodes and auxiliary structures of a list initialised with jll_init_dlist, leaving
+ * the (embedded) header storage to its owner. The list is left empty (keeping its comparison and key
+ * functions) and may be initialised again.
+ * 
+ * @param dlist Pointer to the embedded doubly-linked list
+ * @param data_dealloc_func User-specified function releasing the data referenced by each node (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_fini_dlist(jll_dlist_t * dlist, void (*data_dealloc_func)(const jll_data_t *))
 {
     assert(dlist);
-    assert(compfunc);
 
-    jll_dnode_t * rover = dlist->head;
-    while (rover)
-    {  
-        if (compfunc(rover->data))
-            return true;
-        else
-            rover = rover->next;
-    }
-    return false;
+    data_keyfunc_t key_func = dlist->dlist_key_func;
+
+    __jll_dlist_teardown(dlist, data_dealloc_func, NULL);
+    jll_init_dlist(dlist, dlist->dlist_comp_func, dlist->circular, dlist->sorted, dlist->persistent);
+
+    dlist->dlist_key_func = key_func;
+    dlist->keyed = (key_func != NULL);
 }
 
-bool jll_dlist_is_empty(jll_dlist_t * dlist)
+/**
+ * @brief Deallocate a doubly-linked list on the background reclaimer thread. The call returns in
+ * constant time; the list must not be touched again by the caller, and the data function runs on
+ * the reclaimer thread.
+ * 
+ * @param dlist Pointer to the doubly-linked list to be deallocated
+ * @param data_dealloc_func User-specified function releasing the data referenced by each node (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_dealloc_dlist_deferred(jll_dlist_t * dlist, void (*data_dealloc_func)(const jll_data_t *))
 {
-    if (!dlist->head)
-        return true;
-    else if (!dlist->tail)
-        return true;
-    else if (dlist->length == 0)
-        return true;
-    else
-        return false;
+    JLL_LAT_SCOPE(DLIST_DEALLOC_DEFERRED);
+    assert(dlist);
+
+    jll_reclaim_submit(__jll_dlist_reclaim, dlist, data_dealloc_func, NULL);
 }
 
-bool jll_dlist_is_circular(jll_dlist_t * dlist)
+/**
+ * @brief Deallocate a doubly-linked list on the background reclaimer thread, releasing the data in batches
+ */
+void jll_dealloc_dlist_deferred_batched(jll_dlist_t * dlist, data_batchdealloc_t data_batch_func)
 {
+    JLL_LAT_SCOPE(DLIST_DEALLOC_DEFERRED_BATCHED);
     assert(dlist);
 
-    if (jll_dlist_is_empty(dlist))
-        return false;
-    else if (dlist->tail->next != dlist->head)
-        return false;
-    else if (dlist->head->prev != dlist->tail)
-        return false;
-    else
-        return true;
+    jll_reclaim_submit(__jll_dlist_reclaim, dlist, NULL, data_batch_func);
 }
 
-bool jll_dlist_is_circular(jll_dlist_t * dlist)
+/* insertion functions */
+
+void jll_dlist_append_head(jll_dlist_t * dlist, const jll_data_t * dptr)
 {
+    JLL_LAT_SCOPE(DLIST_APPEND_HEAD);
     assert(dlist);
+    assert(dptr);
+
+    // A full ring applies its overwrite/reject policy instead of growing.
+    if (jll_dlist_ring_is_full(dlist))
+    {
+        jll_dlist_ring_push_head(dlist, dptr);
+        return;
+    }
+
+    JLL_PROF_OP(dlist);
+
+    jll_dnode_t * newptr = __jll_dlist_new_node(dlist, dptr);
     
     if (jll_dlist_is_empty(dlist))
-        return false;
-    else if (dlist->tail->next != dlist->head)
-        return false;
-    else if (dlist->head->prev != dlist->tail)
-        return false;
+    {
+        dlist->head = newptr;
+        dlist->tail = newptr;
+    }
     else
-        return true;
-}
+    {
+        newptr->next = dlist->head;
+        dlist->head->prev = newptr;
+        dlist->head = newptr;
+    }
 
+    dlist->length++;
+    __jll_dlist_note_insert(dlist, dptr);
 
-/* list manipulation */
+    if (dlist->circular)
+    {
+        dlist->head->prev = dlist->tail;
+        dlist->tail->next = dlist->head;
+    }
 
-static void __jll_dlist_swap_node_data(jll_dnode_t * nodeone, jll_dnode_t * nodetwo)
-{
-    const jll_data_t * temp = nodeone->data;
-    nodeone->data = nodetwo->data;
-    nodetwo->data = temp;
+    __jll_dlist_count_in(dlist, newptr);
 }
 
-void jll_dlist_reversal(jll_dlist_t * dlist)
+
+void jll_dlist_append_tail(jll_dlist_t * dlist, const jll_data_t * dptr)
 {
+    JLL_LAT_SCOPE(DLIST_APPEND_TAIL);
     assert(dlist);
-    if (jll_dlist_is_empty(dlist)) return;
-    else if (dlist->length == 1) return;
-    
-    jll_dnode_t * front_rover = dlist->head;
-    jll_dnode_t * back_rover  = dlist->tail;
+    assert(dptr);
+
+    // A full ring applies its overwrite/reject policy instead of growing.
+    if (jll_dlist_ring_is_full(dlist))
+    {
+        jll_dlist_ring_push_tail(dlist, dptr);
+        return;
+    }
+
+    JLL_PROF_OP(dlist);
+
+    jll_dnode_t * newptr = __jll_dlist_new_node(dlist, dptr);
 
-    __jll_dlist_swap_node_data(front_rover, back_rover);
+    if (jll_dlist_is_empty(dlist))
+    {
+        dlist->head = newptr;
+        dlist->tail = newptr;
+    }
+    else
+    {
+        dlist->tail->next = newptr;
+        newptr->prev = dlist->tail;
+        dlist->tail = newptr;
+    }
 
-    front_rover = front_rover->next;
-    back_rover  = back_rover->prev;
+    dlist->length++;
+    __jll_dlist_note_insert(dlist, dptr);
 
-    while (front_rover->prev != back_rover)
+    if (dlist->circular)
     {
-        __jll_dlist_swap_node_data(front_rover, back_rover);
-        front_rover = front_rover->next;
-        back_rover = back_rover->prev;
+        dlist->head->prev = dlist->tail;
+        dlist->tail->next = dlist->head;
     }
 }
 
+/**
+ * @brief Inserts a node into a sorted doubly-linked list, after any nodes comparing equal to it.
+ * The search is adaptive: in-order data costs one comparison against the tail, and out-of-order data
+ * gallops out from the previous insertion point (or back from the tail).
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * @param dptr  Data to be referenced by the newly inserted node
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_insert_sorted(jll_dlist_t * dlist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(DLIST_INSERT_SORTED);
+    assert(dlist);
+    assert(dptr);
+    assert(dlist->dlist_comp_func);
+    assert(!jll_dlist_ring_is_full(dlist));
+
+    JLL_PROF_OP(dlist);
+    dlist->insert_stats.inserts++;
+    __jll_dlist_settle(dlist);
+
+    jll_dnode_t * new_node = __jll_dlist_new_node(dlist, dptr);
+    jll_dnode_t * after = (jll_dlist_is_empty(dlist)) ? NULL : __jll_dlist_locate_sorted(dlist, new_node);
+
+    if (!after) __jll_dlist_link_head(dlist, new_node);
+    else if (after == dlist->tail) __jll_dlist_link_tail(dlist, new_node);
+    else __jll_dlist_link_before(dlist, new_node, after->next);
+
+    __jll_dlist_note_insert(dlist, dptr);
+
+    dlist->finger = new_node;
+    dlist->finger_generation = dlist->generation;
+}
+
 
-void jll_dlist_concat(jll_dlist_t * lone, jll_dlist_t * ltwo)
+/* bounded ring mode */
+
+/**
+ * @brief Overwrites the oldest element at one end of a full ring with new data, turning that node into the other end.
+ * The ring is circular and full, so this is a rotation: no node is linked, unlinked or allocated.
+ */
+static void __jll_dlist_ring_overwrite(jll_dlist_t * dlist, const jll_data_t * dptr, bool at_tail)
 {
-    assert(lone);
-    assert(ltwo);
+    jll_dnode_t * victim = (at_tail) ? dlist->head : dlist->tail;
+    const jll_data_t * old_data_ptr = victim->data;
 
-    // lone + ltwo
+    victim->data = dptr;
 
-    lone->tail->next = ltwo->head;
-    ltwo->head->prev = lone->tail;
-    lone->tail = ltwo->tail;
-    
-    if (lone->circular || ltwo->circular)
+    if (dlist->keyed)
     {
-        lone->tail->prev = lone->head;
-        lone->head->next = lone->tail;        
+        JLL_DKNODE(victim)->key = __jll_dlist_key_of(dlist, dptr);
+        JLL_DKNODE(victim)->freq = 0;
     }
 
-    lone->length += ltwo->length;
-    
-    free(ltwo); // Full list is now stored in lone.
-    ltwo = NULL;
-}
\ No newline at end of file
+    if (at_tail)
+    {
+        dlist->tail = dlist->head;
+        dlist->head = dlist->head->next;
+    }
+    else
+    {
+        dlist->head = dlist->tail;
+        dlist->tail = dlist->tail->prev;
+    }
+
+    __jll_dlist_count_in(dlist, victim);
+    __jll_dlist_note_remove(dlist);
+    __jll_dlist_note_insert(dlist, dptr);
+
+    if (dlist->ring_evict_func) dlist->ring_evict_func(old_data_ptr);
+}
+
+/**
+ * @brief Pushes data at the tail of a bounded ring. When the ring is full the policy decides:
+ * overwrite evicts the head (handing its data to the ring's evict function), reject leaves the ring untouched.
+ * 
+ * @param dlist Ring created with jll_alloc_dlist_ring (or any list, which is never full)
+ * @param dptr  Data to be pushed
+ * 
+ * @returns False if the push was rejected, true otherwise
+ */
+bool jll_dlist_ring_push_tail(jll_dlist_t * dlist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(DLIST_RING_PUSH_TAIL);
+    assert(dlist);
+    assert(dptr);
+
+    if (!jll_dlist_ring_is_full(dlist))
+    {
+        jll_dlist_append_tail(dlist, dptr);
+        return true;
+    }
+
+    if (dlist->ring_policy == JLL_RING_REJECT) return false;
+
+    JLL_PROF_OP(dlist);
+    __jll_dlist_ring_overwrite(dlist, dptr, true);
+    return true;
+}
+
+/**
+ * @brief Pushes data at the head of a bounded ring; when full, overwrite evicts the tail (O(1))
+ * 
+ * @returns False if the push was rejected, true otherwise
+ */
+bool jll_dlist_ring_push_head(jll_dlist_t * dlist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(DLIST_RING_PUSH_HEAD);
+    assert(dlist);
+    assert(dptr);
+
+    if (!jll_dlist_ring_is_full(dlist))
+    {
+        jll_dlist_append_head(dlist, dptr);
+        return true;
+    }
+
+    if (dlist->ring_policy == JLL_RING_REJECT) return false;
+
+    JLL_PROF_OP(dlist);
+    __jll_dlist_ring_overwrite(dlist, dptr, false);
+    return true;
+}
+
+bool jll_dlist_ring_is_full(const jll_dlist_t * dlist)
+{
+    assert(dlist);
+    return (dlist->capacity) && (dlist->length == dlist->capacity);
+}
+
+
+/* deletion functions */
+
+const jll_data_t * jll_dlist_remove_index(jll_dlist_t * dlist, size_t index)
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_INDEX);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+
+    // In lazy mode the index counts live nodes and the node found is only marked dead.
+    if (dlist->tombstone_ratio > 0)
+    {
+        if (index >= dlist->length) return NULL;
+        return __jll_dlist_bury(dlist, __jll_dlist_live_node(dlist, index));
+    }
+
+    if ((index < 0) || (index >= dlist->length)) return NULL;
+
+    if (index == 0) return jll_dlist_remove_head(dlist);
+    else if (index == dlist->length - 1) return jll_dlist_remove_tail(dlist);
+
+    jll_dnode_t * rover;
+    size_t k;
+
+    if (dlist->length < 2 * index + 1)
+    {
+        JLL_PROF_WALK_BWD(dlist);
+        rover = dlist->tail;
+        for (k = dlist->length - 1; k > index; k--)
+        {
+            rover = rover->prev;
+            JLL_PROF_HOP(dlist);
+        }
+    }
+    else
+    {
+        JLL_PROF_WALK_FWD(dlist);
+        rover = dlist->head;
+        for (k = 0; k < index; k++)
+        {
+            rover = rover->next;
+            JLL_PROF_HOP(dlist);
+        }
+    }
+
+    const jll_data_t * retdata = rover->data;
+
+    rover->next->prev = rover->prev;
+    rover->prev->next = rover->next;
+
+    __jll_dlist_free_node(dlist, rover);
+    dlist->length--;
+    __jll_dlist_note_remove(dlist);
+
+    return retdata;
+}
+
+
+const jll_data_t * jll_dlist_remove_head(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_HEAD);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+    if (jll_dlist_is_empty(dlist)) return NULL;
+
+
+    const jll_data_t * retdata = dlist->head->data;
+
+    // Test the length rather than next, which points back at the node itself in a circular list of one.
+    if (dlist->length > 1)
+    {
+        dlist->head = dlist->head->next;
+        __jll_dlist_free_node(dlist, dlist->head->prev);
+
+        if (dlist->circular)
+        {
+            dlist->head->prev = dlist->tail;
+            dlist->tail->next = dlist->head;
+        }
+        else
+        {
+            dlist->head->prev = NULL;
+        }
+    }
+    else
+    {
+        __jll_dlist_free_node(dlist, dlist->head);
+        dlist->head = NULL;
+        dlist->tail = NULL;
+    }
+
+    dlist->length--;
+    __jll_dlist_note_remove(dlist);
+    __jll_dlist_trim_ends(dlist);
+    return retdata;
+}
+
+
+const jll_data_t * jll_dlist_remove_tail(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_TAIL);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+    if (jll_dlist_is_empty(dlist)) return NULL;
+
+
+    const jll_data_t * retdata = dlist->tail->data;
+
+    if (dlist->length > 1)
+    {
+        dlist->tail = dlist->tail->prev;
+        __jll_dlist_free_node(dlist, dlist->tail->next);
+        if (dlist->circular)
+        {
+            dlist->tail->next = dlist->head;
+            dlist->head->prev = dlist->tail;
+        }
+        else dlist->tail->next = NULL;
+    }
+    else
+    {
+        __jll_dlist_free_node(dlist, dlist->tail);
+        dlist->tail = NULL;
+        dlist->head = NULL;
+    }
+
+    dlist->length--;
+    __jll_dlist_note_remove(dlist);
+    __jll_dlist_trim_ends(dlist);
+    return retdata;
+}
+
+/**
+ * @brief Unlinks and frees a live node reached by a walk, or only marks it dead in lazy mode
+ */
+static const jll_data_t * __jll_dlist_remove_found(jll_dlist_t * dlist, jll_dnode_t * rover)
+{
+    if (dlist->tombstone_ratio > 0) return __jll_dlist_bury(dlist, rover);
+    if (rover == dlist->head) return jll_dlist_remove_head(dlist);
+    else if (rover == dlist->tail) return jll_dlist_remove_tail(dlist);
+
+    rover->next->prev = rover->prev;
+    rover->prev->next = rover->next;
+
+    const jll_data_t * retdata = __jll_dlist_free_node(dlist, rover);
+    dlist->length--;
+    __jll_dlist_note_remove(dlist);
+
+    return retdata;
+}
+
+/**
+ * @brief Removes the first node of a list whose data matches a predicate
+ * 
+ * @param dlist    List to be edited
+ * @param compfunc Predicate over the data
+ * 
+ * @returns The data of the removed node, or NULL if no node matched
+ */
+const jll_data_t * jll_dlist_remove_cond_first(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_COND_FIRST);
+    assert(dlist);
+    assert(compfunc);
+    JLL_PROF_OP(dlist);
+
+    jll_dnode_t * rover = dlist->head;
+    for (size_t k = 0; k < __jll_dlist_nodes(dlist); k++)
+    {
+        JLL_PROF_PRED(dlist);
+        if ((rover->data) && (compfunc(rover->data))) return __jll_dlist_remove_found(dlist, rover);
+
+        rover = rover->next;
+        JLL_PROF_HOP(dlist);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Removes the n-th node (counting from 1) of a list whose data matches a predicate
+ * 
+ * @param dlist    List to be edited
+ * @param compfunc Predicate over the data
+ * @param n        Which match to remove
+ * 
+ * @returns The data of the removed node, or NULL if fewer than n nodes matched
+ */
+const jll_data_t * jll_dlist_remove_cond_nth(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_COND_NTH);
+    assert(dlist);
+    assert(compfunc);
+    JLL_PROF_OP(dlist);
+
+    if ((n == 0) || (n > dlist->length)) return NULL;
+
+    // Bounded by the node count so circular lists terminate; tombstones are stepped over.
+    jll_dnode_t * rover = dlist->head;
+    for (size_t k = 0; k < __jll_dlist_nodes(dlist); k++)
+    {
+        JLL_PROF_PRED(dlist);
+        if ((rover->data) && (compfunc(rover->data)) && (--n == 0)) return __jll_dlist_remove_found(dlist, rover);
+
+        rover = rover->next;
+        JLL_PROF_HOP(dlist);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Frees a chain of nodes already unlinked from a list, in one batch after the pass which unlinked them
+ */
+static void __jll_dlist_free_chain(jll_dlist_t * dlist, jll_dnode_t * chain)
+{
+    while (chain)
+    {
+        jll_dnode_t * next = chain->next;
+
+        __jll_dlist_note_remove(dlist);
+        __jll_dlist_free_node(dlist, chain);
+
+        chain = next;
+    }
+}
+
+/**
+ * @brief Single-pass removal of up to max nodes matching a predicate (every node if compfunc is NULL),
+ * writing their data to out in list order. Unlinked nodes are freed together once the pass is done.
+ * 
+ * @returns Number of nodes removed
+ */
+static size_t __jll_dlist_drain_cond(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), const jll_data_t ** out, size_t max)
+{
+    if ((jll_dlist_is_empty(dlist)) || (max == 0)) return 0;
+    __jll_dlist_settle(dlist);
+
+    dlist->tail->next = NULL;
+    dlist->head->prev = NULL;
+
+    jll_dnode_t * prev = NULL;
+    jll_dnode_t * rover = dlist->head;
+    jll_dnode_t * doomed = NULL;
+    jll_dnode_t ** doomed_tail = &doomed;
+    size_t found = 0;
+
+    while ((rover) && (found < max))
+    {
+        jll_dnode_t * next = rover->next;
+
+        if (compfunc) JLL_PROF_PRED(dlist);
+
+        if ((!compfunc) || (compfunc(rover->data)))
+        {
+            out[found++] = rover->data;
+
+            if (prev) prev->next = next;
+            else dlist->head = next;
+            if (next) next->prev = prev;
+            if (rover == dlist->tail) dlist->tail = prev;
+
+            *doomed_tail = rover;
+            doomed_tail = &rover->next;
+        }
+        else prev = rover;
+
+        rover = next;
+        JLL_PROF_HOP(dlist);
+    }
+
+    *doomed_tail = NULL;
+    dlist->length -= found;
+
+    if (jll_dlist_is_empty(dlist))
+    {
+        dlist->head = NULL;
+        dlist->tail = NULL;
+    }
+    else __jll_dlist_fix_ends(dlist);
+
+    __jll_dlist_free_chain(dlist, doomed);
+    return found;
+}
+
+/**
+ * @brief Removes, in one pass, the first n nodes of a list whose data matches a predicate
+ * 
+ * @param dlist    List to be edited
+ * @param compfunc Predicate over the data
+ * @param n        Most matches to remove
+ * 
+ * @returns Payload holding the removed data in list order, or NULL if no node matched
+ */
+jll_data_payload_t * jll_dlist_remove_cond_first_n(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_COND_FIRST_N);
+    assert(dlist);
+    assert(compfunc);
+
+    JLL_PROF_OP(dlist);
+
+    if ((n == 0) || (jll_dlist_is_empty(dlist))) return NULL;
+    if (n > dlist->length) n = dlist->length;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(n);
+    new_payload->length = __jll_dlist_drain_cond(dlist, compfunc, new_payload->data, n);
+
+    if (new_payload->length == 0)
+    {
+        jll_deallocate_data_payload(new_payload);
+        return NULL;
+    }
+
+    __jll_dlist_note_payload(dlist, new_payload);
+    return new_payload;
+}
+
+jll_data_payload_t * jll_dlist_remove_cond_all(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_COND_ALL);
+    assert(dlist);
+    assert(compfunc);
+
+    JLL_PROF_OP(dlist);
+
+    if (jll_dlist_is_empty(dlist)) return NULL;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(dlist->length);
+    new_payload->length = __jll_dlist_drain_cond(dlist, compfunc, new_payload->data, dlist->length);
+
+    if (new_payload->length == 0)
+    {
+        jll_deallocate_data_payload(new_payload);
+        return NULL;
+    }
+
+    __jll_dlist_note_payload(dlist, new_payload);
+    return new_payload;
+}
+
+
+jll_data_payload_t * jll_dlist_remove_all(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_REMOVE_ALL);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+    if (jll_dlist_is_empty(dlist)) return NULL;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(dlist->length);
+    new_payload->length = __jll_dlist_drain_cond(dlist, NULL, new_payload->data, dlist->length);
+
+    __jll_dlist_note_payload(dlist, new_payload);
+    return new_payload;
+}
+
+
+/* export and drain */
+
+/**
+ * @brief Copies up to max data references, head first, into a caller-provided array without modifying the list
+ * 
+ * @param dlist List to be exported
+ * @param out   Destination array with room for at least max references
+ * @param max   Capacity of out
+ * 
+ * @returns Number of references written
+ */
+size_t jll_dlist_to_array(const jll_dlist_t * dlist, const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(DLIST_TO_ARRAY);
+    assert(dlist);
+    assert((out) || (max == 0));
+
+    size_t count = 0;
+    const jll_dnode_t * rover = dlist->head;
+
+    // Bounded by the node count so circular lists terminate; tombstones are stepped over.
+    for (size_t k = 0; (k < __jll_dlist_nodes(dlist)) && (count < max); k++)
+    {
+        if (rover->data) out[count++] = rover->data;
+        rover = rover->next;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Appends every data reference of a list to a reusable payload without modifying the list.
+ * The payload only grows when its capacity is exceeded, so repeated exports settle into no allocation.
+ * 
+ * @returns Number of references appended
+ */
+size_t jll_dlist_export_into(const jll_dlist_t * dlist, jll_data_payload_t * payload)
+{
+    assert(dlist);
+    assert(payload);
+
+    jll_data_payload_reserve(payload, payload->length + dlist->length);
+
+    size_t count = jll_dlist_to_array(dlist, payload->data + payload->length, dlist->length);
+    payload->length += count;
+
+    return count;
+}
+
+/**
+ * @brief Removes up to max nodes from the head of a list in one pass, writing their data to a caller-provided array
+ * 
+ * @param dlist List to be drained
+ * @param out   Destination array with room for at least max references
+ * @param max   Capacity of out
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_dlist_drain(jll_dlist_t * dlist, const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(DLIST_DRAIN);
+    assert(dlist);
+    assert((out) || (max == 0));
+    JLL_PROF_OP(dlist);
+
+    return __jll_dlist_drain_cond(dlist, NULL, out, max);
+}
+
+/**
+ * @brief Removes up to max nodes matching a predicate in one pass, writing their data to a caller-provided array in list order
+ * 
+ * @param dlist List to be filtered
+ * @param compfunc Boolean function which returns true for data to be removed
+ * @param out      Destination array with room for at least max references
+ * @param max      Capacity of out
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_dlist_drain_cond(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(DLIST_DRAIN_COND);
+    assert(dlist);
+    assert(compfunc);
+    assert((out) || (max == 0));
+    JLL_PROF_OP(dlist);
+
+    return __jll_dlist_drain_cond(dlist, compfunc, out, max);
+}
+
+/**
+ * @brief Removes every node of a list, appending its data to a reusable payload
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_dlist_drain_into(jll_dlist_t * dlist, jll_data_payload_t * payload)
+{
+    assert(dlist);
+    assert(payload);
+
+    jll_data_payload_reserve(payload, payload->length + dlist->length);
+
+    size_t count = jll_dlist_drain(dlist, payload->data + payload->length, dlist->length);
+    payload->length += count;
+
+    return count;
+}
+
+/**
+ * @brief Removes every node matching a predicate, appending its data to a reusable payload.
+ * Room is reserved for the whole list up front so the pass never reallocates.
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_dlist_drain_cond_into(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), jll_data_payload_t * payload)
+{
+    assert(dlist);
+    assert(compfunc);
+    assert(payload);
+
+    jll_data_payload_reserve(payload, payload->length + dlist->length);
+
+    size_t count = jll_dlist_drain_cond(dlist, compfunc, payload->data + payload->length, dlist->length);
+    payload->length += count;
+
+    return count;
+}
+
+
+/* access functions */
+const jll_data_t * jll_dlist_index_pos(jll_dlist_t * dlist, size_t index)
+{
+    JLL_LAT_SCOPE(DLIST_INDEX_POS);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+
+    if (dlist->tombstones)
+        return (index < dlist->length) ? __jll_dlist_live_node(dlist, index)->data : NULL;
+
+    if ((index < 0) || (index >= dlist->length)) 
+        return NULL;
+    else if (index == 0) 
+        return jll_dlist_index_head(dlist);
+    else if (index == dlist->length - 1)
+        return jll_dlist_index_tail(dlist);
+
+    jll_dnode_t * rover;
+    size_t k;
+    if (dlist->length < 2 * index + 1)
+    {
+        JLL_PROF_WALK_BWD(dlist);
+        rover = dlist->tail;
+        for (k = dlist->length - 1; k > index; k--)
+        {
+            rover = rover->prev;
+            JLL_PROF_HOP(dlist);
+        }
+    }
+    else
+    {
+        JLL_PROF_WALK_FWD(dlist);
+        rover = dlist->head;
+        for (k = 0; k < index; k++)
+        {
+            rover = rover->next;
+            JLL_PROF_HOP(dlist);
+        }
+    }
+
+    return (rover->data);
+}
+
+
+const jll_data_t * jll_dlist_index_head(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_INDEX_HEAD);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+    if (!dlist->head)
+        return NULL;
+    else
+        return dlist->head->data;
+}
+
+
+const jll_data_t * jll_dlist_index_tail(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_INDEX_TAIL);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+    if (!dlist->tail)
+        return NULL;
+    else
+        return dlist->tail->data;
+}
+
+
+/* batched scan */
+
+/**
+ * @brief Neighbourhood of the node found by a scan, which the self-organizing policies relink against
+ */
+typedef struct jll_dlist_scan_type
+{
+    jll_dnode_t * run_first;    // First node in the current run of equal counts.
+
+} jll_dlist_scan_t;
+
+/**
+ * @brief Scan engine behind the find and contains functions. Nodes are visited in chunks: the data pointers of a
+ * chunk are gathered first, with a prefetch issued for each so that the loads overlap, and the chunk is then handed
+ * to the predicate in one go. Chunks start small, so early hits stay cheap, and double up to the list's scan batch.
+ * 
+ * @param dlist List to be scanned
+ * @param batchpred Batch predicate, given a whole chunk at a time (may be NULL)
+ * @param compfunc  Scalar predicate, used when batchpred is NULL (may be NULL)
+ * @param key       Data carrying the key matched with the list's comparison function when both predicates are NULL
+ * @param n         Which match to stop at, counting from 1
+ * @param scan      Receives the neighbourhood of the node found
+ * 
+ * @returns The n-th matching node, or NULL if there are fewer than n matches
+ */
+static jll_dnode_t * __jll_dlist_scan(jll_dlist_t * dlist, data_batchpred_t batchpred, bool (*compfunc)(const jll_data_t *), const jll_data_t * key, size_t n, jll_dlist_scan_t * scan)
+{
+    jll_dnode_t * nodes[JLL_DLIST_SCAN_BATCH_MAX];
+    const jll_data_t * data[JLL_DLIST_SCAN_BATCH_MAX];
+    uint8_t matches[JLL_DLIST_SCAN_BATCH_MAX];
+
+    scan->run_first = dlist->head;
+
+    if (n == 0) return NULL;
+
+    jll_dnode_t * gather = dlist->head;
+    size_t left = __jll_dlist_nodes(dlist);
+    size_t batch = (dlist->scan_batch < JLL_DLIST_SCAN_FIRST_BATCH) ? dlist->scan_batch : JLL_DLIST_SCAN_FIRST_BATCH;
+
+    while (left)
+    {
+        size_t count = 0;
+
+        // Tombstones are stepped over while gathering, so predicates only ever see live data.
+        while ((left) && (count < batch))
+        {
+            if (gather->data)
+            {
+                nodes[count] = gather;
+                data[count] = gather->data;
+                __builtin_prefetch(data[count]);
+                count++;
+            }
+
+            gather = gather->next;
+            left--;
+        }
+
+        if (!count) break;
+
+        if (batchpred)
+        {
+            batchpred(data, count, matches);
+            JLL_PROF_COUNT(dlist, predicates, count);
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            jll_dnode_t * rover = nodes[i];
+            if ((dlist->reorg == JLL_REORG_COUNT) && (JLL_DKNODE(rover)->freq != JLL_DKNODE(scan->run_first)->freq)) scan->run_first = rover;
+
+            bool match;
+            if (batchpred) match = matches[i];
+            else if (compfunc)
+            {
+                JLL_PROF_PRED(dlist);
+                match = compfunc(data[i]);
+            }
+            else
+            {
+                JLL_PROF_CMP(dlist);
+                match = (dlist->dlist_comp_func(data[i], key) == 0);
+            }
+
+            if ((match) && (--n == 0)) return rover;
+            JLL_PROF_HOP(dlist);
+        }
+
+        if (batch < dlist->scan_batch) batch = (2 * batch < dlist->scan_batch) ? 2 * batch : dlist->scan_batch;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Finds the first node matching the batch predicate, the scalar predicate or (when both are NULL) comparing
+ * equal to key, and applies the list's self-organizing policy to it
+ */
+static jll_dnode_t * __jll_dlist_search(jll_dlist_t * dlist, data_batchpred_t batchpred, bool (*compfunc)(const jll_data_t *), const jll_data_t * key)
+{
+    // Reorganizing relinks nodes against their neighbours, which must all be live.
+    if (dlist->reorg != JLL_REORG_NONE) __jll_dlist_settle(dlist);
+
+    jll_dlist_scan_t scan;
+    jll_dnode_t * rover = __jll_dlist_scan(dlist, batchpred, compfunc, key, 1, &scan);
+    if (!rover) return NULL;
+
+    jll_dnode_t * run_first = scan.run_first;
+
+    switch (dlist->reorg)
+    {
+        case JLL_REORG_MOVE_TO_FRONT:
+            jll_dlist_move_to_head(dlist, rover);
+            break;
+
+        case JLL_REORG_TRANSPOSE:
+            if (rover != dlist->head)
+            {
+                jll_dnode_t * before = rover->prev;
+                jll_dlist_unlink(dlist, rover);
+                __jll_dlist_link_before(dlist, rover, before);
+            }
+            break;
+
+        case JLL_REORG_COUNT:
+            // Counts are kept non-increasing from head to tail, so moving the node to the
+            // front of its run keeps the order once its count is bumped.
+            if (rover != run_first)
+            {
+                jll_dlist_unlink(dlist, rover);
+                __jll_dlist_link_before(dlist, rover, run_first);
+            }
+            JLL_DKNODE(rover)->freq++;
+            break;
+
+        default:
+            break;
+    }
+
+    return rover;
+}
+
+const jll_data_t * jll_dlist_find_first_occurrence(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(DLIST_FIND_FIRST_OCCURRENCE);
+    assert(dlist);
+    assert(compfunc);
+    JLL_PROF_OP(dlist);
+
+    jll_dnode_t * found = __jll_dlist_search(dlist, NULL, compfunc, NULL);
+    return found ? found->data : NULL;
+}
+
+
+const jll_data_t * jll_dlist_find_nth_occurrence(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(DLIST_FIND_NTH_OCCURRENCE);
+    assert(dlist);
+    assert(compfunc);
+    JLL_PROF_OP(dlist);
+
+    jll_dlist_scan_t scan;
+    jll_dnode_t * found = __jll_dlist_scan(dlist, NULL, compfunc, NULL, n, &scan);
+    return found ? found->data : NULL;
+}
+
+bool jll_dlist_check_if_sorted(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_CHECK_IF_SORTED);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+    if (!dlist->dlist_comp_func)
+        return false;
+    if (jll_dlist_is_empty(dlist))
+        return false;
+
+    // The head is always live; tombstones are stepped over rather than purged, as this is only a query.
+    jll_dnode_t * last = dlist->head;
+    jll_dnode_t * rover = last->next;
+
+    // Bounded by the node count so circular lists terminate; cached keys spare the data of every pair they can order.
+    for (size_t k = 1; k < __jll_dlist_nodes(dlist); k++)
+    {
+        if (rover->data)
+        {
+            if (__jll_dlist_compare_nodes(dlist, last, rover) == -1) return false;
+            last = rover;
+        }
+
+        rover = rover->next;
+        JLL_PROF_HOP(dlist);
+    }
+
+    return true;
+}
+
+bool jll_dlist_check_if_contains(jll_dlist_t * dlist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(DLIST_CHECK_IF_CONTAINS);
+    assert(dlist);
+    assert(compfunc);
+    JLL_PROF_OP(dlist);
+
+    return (__jll_dlist_search(dlist, NULL, compfunc, NULL) != NULL);
+}
+
+/**
+ * @brief Finds the first element matching a batch predicate and applies the list's self-organizing policy to it.
+ * The predicate is handed the data of up to the list's scan batch of consecutive elements at a time and must
+ * set matches[i] to non-zero for every element i which matches; it may be called on elements past the first match.
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * @param batchpred User-specified batch predicate
+ * 
+ * @returns The data of the first matching element, or NULL if none matched
+ */
+const jll_data_t * jll_dlist_find_first_batched(jll_dlist_t * dlist, data_batchpred_t batchpred)
+{
+    JLL_LAT_SCOPE(DLIST_FIND_FIRST_BATCHED);
+    assert(dlist);
+    assert(batchpred);
+    JLL_PROF_OP(dlist);
+
+    jll_dnode_t * found = __jll_dlist_search(dlist, batchpred, NULL, NULL);
+    return found ? found->data : NULL;
+}
+
+/**
+ * @brief Finds the n-th element (counting from 1) matching a batch predicate; the list is not reorganized
+ */
+const jll_data_t * jll_dlist_find_nth_batched(jll_dlist_t * dlist, data_batchpred_t batchpred, size_t n)
+{
+    JLL_LAT_SCOPE(DLIST_FIND_NTH_BATCHED);
+    assert(dlist);
+    assert(batchpred);
+    JLL_PROF_OP(dlist);
+
+    jll_dlist_scan_t scan;
+    jll_dnode_t * found = __jll_dlist_scan(dlist, batchpred, NULL, NULL, n, &scan);
+    return found ? found->data : NULL;
+}
+
+bool jll_dlist_check_if_contains_batched(jll_dlist_t * dlist, data_batchpred_t batchpred)
+{
+    JLL_LAT_SCOPE(DLIST_CONTAINS_BATCHED);
+    assert(dlist);
+    assert(batchpred);
+    JLL_PROF_OP(dlist);
+
+    return (__jll_dlist_search(dlist, batchpred, NULL, NULL) != NULL);
+}
+
+/**
+ * @brief Sets how many elements a find or contains scan gathers (and prefetches) ahead of evaluating them
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * @param batch Scan batch, between 1 and JLL_DLIST_SCAN_BATCH_MAX
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_set_scan_batch(jll_dlist_t * dlist, size_t batch)
+{
+    assert(dlist);
+    assert((batch > 0) && (batch <= JLL_DLIST_SCAN_BATCH_MAX));
+
+    dlist->scan_batch = batch;
+}
+
+bool jll_dlist_is_empty(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_IS_EMPTY);
+    if (!dlist->head)
+        return true;
+    else if (!dlist->tail)
+        return true;
+    else if (dlist->length == 0)
+        return true;
+    else
+        return false;
+}
+
+bool jll_dlist_is_circular(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_IS_CIRCULAR);
+    assert(dlist);
+
+    if (jll_dlist_is_empty(dlist))
+        return false;
+    else if (dlist->tail->next != dlist->head)
+        return false;
+    else if (dlist->head->prev != dlist->tail)
+        return false;
+    else
+        return true;
+}
+
+
+/* list manipulation */
+
+/**
+ * @brief Reverses a list in place by relinking its nodes, so every node keeps its data together with
+ * its cached key and count. Node handles stay valid but their positions change.
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_reversal(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_REVERSAL);
+    assert(dlist);
+    if (jll_dlist_is_empty(dlist)) return;
+    else if (dlist->length == 1) return;
+
+    jll_dnode_t * rover = dlist->head;
+
+    // Bounded by the node count so circular lists terminate; tombstones are relinked like any node.
+    for (size_t k = 0; k < __jll_dlist_nodes(dlist); k++)
+    {
+        jll_dnode_t * next = rover->next;
+        rover->next = rover->prev;
+        rover->prev = next;
+        rover = next;
+    }
+
+    jll_dnode_t * head = dlist->head;
+    dlist->head = dlist->tail;
+    dlist->tail = head;
+
+    dlist->generation++;
+    __jll_dlist_fix_ends(dlist);
+    __jll_dlist_restart_counts(dlist);
+}
+
+
+/**
+ * @brief Appends every node of ltwo to lone in O(1). An ltwo from jll_alloc_dlist is deallocated; an
+ * embedded one (set up with jll_init_dlist) is left empty and still has to be finalized by its owner.
+ * 
+ * @param lone List to be extended; it keeps its own circular flag
+ * @param ltwo List whose nodes are moved; its header is freed if the library allocated it
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_concat(jll_dlist_t * lone, jll_dlist_t * ltwo)
+{
+    JLL_LAT_SCOPE(DLIST_CONCAT);
+    assert(lone);
+    assert(ltwo);
+    assert(lone != ltwo);
+    assert((!lone->capacity) || (lone->length + ltwo->length <= lone->capacity));
+    __jll_dlist_settle(ltwo);
+
+    // lone + ltwo
+
+    if (!jll_dlist_is_empty(ltwo))
+    {
+        size_t length = ltwo->length;
+        jll_dnode_t * tail;
+        jll_dnode_t * head = __jll_dlist_absorb(lone, ltwo, &tail);
+
+        if (jll_dlist_is_empty(lone))
+        {
+            lone->head = head;
+        }
+        else
+        {
+            lone->tail->next = head;
+            head->prev = lone->tail;
+        }
+
+        lone->tail = tail;
+        lone->length += length;
+
+        // Re-close (or terminate) the combined list at its new ends.
+        __jll_dlist_fix_ends(lone);
+    }
+
+    // Embedded headers are not ours to free; the empty list stays usable until its owner finalizes it.
+    if (!ltwo->heap_header) return;
+
+    // Full list is now stored in lone; nodes from ltwo's pool keep it alive until they are freed.
+    __jll_dlist_release_spare(ltwo);
+    if (ltwo->bloom) jll_dealloc_bloom(ltwo->bloom);
+    if (ltwo->pool) jll_dealloc_pool(ltwo->pool);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_dlist_t));
+    free(ltwo);
+}
+
+/* node-level operations */
+
+/**
+ * @brief Links an already allocated node in as the head of a doubly-linked list
+ * and, like an appended node, caches its sort key and enters its data into the list's filter
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * @param node  Node to be linked; it must not currently belong to any list, and must be a keyed node
+ * (jll_dknode_t) while the list caches keys or counts
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_link_head(jll_dlist_t * dlist, jll_dnode_t * node)
+{
+    JLL_LAT_SCOPE(DLIST_LINK_HEAD);
+    assert(dlist);
+    assert(node);
+
+    __jll_dlist_adopt(dlist, node);
+    __jll_dlist_link_head(dlist, node);
+    __jll_dlist_count_in(dlist, node);
+}
+
+/**
+ * @brief Links an already allocated node in as the tail of a doubly-linked list
+ * and, like an appended node, caches its sort key and enters its data into the list's filter
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * @param node  Node to be linked; it must not currently belong to any list, and must be a keyed node
+ * (jll_dknode_t) while the list caches keys or counts
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_link_tail(jll_dlist_t * dlist, jll_dnode_t * node)
+{
+    JLL_LAT_SCOPE(DLIST_LINK_TAIL);
+    assert(dlist);
+    assert(node);
+
+    __jll_dlist_adopt(dlist, node);
+    __jll_dlist_link_tail(dlist, node);
+}
+
+/**
+ * @brief Unlinks a node from a doubly-linked list in O(1) without freeing it
+ * 
+ * @param dlist Pointer to the doubly-linked list which currently holds the node
+ * @param node  Node to be unlinked
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_unlink(jll_dlist_t * dlist, jll_dnode_t * node)
+{
+    JLL_LAT_SCOPE(DLIST_UNLINK);
+    assert(dlist);
+    assert(node);
+    assert(!jll_dlist_is_empty(dlist));
+
+    dlist->generation++;
+
+    if (__jll_dlist_nodes(dlist) == 1)
+    {
+        dlist->head = NULL;
+        dlist->tail = NULL;
+    }
+    else
+    {
+        if (node == dlist->head) dlist->head = node->next;
+        if (node == dlist->tail) dlist->tail = node->prev;
+
+        if (node->prev) node->prev->next = node->next;
+        if (node->next) node->next->prev = node->prev;
+    }
+
+    node->next = NULL;
+    node->prev = NULL;
+
+    // A dead node only leaves the tombstone count.
+    if (node->data) dlist->length--;
+    else dlist->tombstones--;
+
+    __jll_dlist_fix_ends(dlist);
+    __jll_dlist_trim_ends(dlist);
+}
+
+/**
+ * @brief Links an already allocated node in directly before a node of a doubly-linked list
+ * and, like an appended node, caches its sort key and enters its data into the list's filter
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * @param node  Node to be linked; it must not currently belong to any list, and must be a keyed node
+ * (jll_dknode_t) while the list caches keys or counts
+ * @param at    Node of the list which the new node should precede
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_link_before(jll_dlist_t * dlist, jll_dnode_t * node, jll_dnode_t * at)
+{
+    JLL_LAT_SCOPE(DLIST_LINK_BEFORE);
+    assert(dlist);
+    assert(node);
+    assert(at);
+
+    __jll_dlist_adopt(dlist, node);
+    __jll_dlist_link_before(dlist, node, at);
+    __jll_dlist_count_in(dlist, node);
+}
+
+/**
+ * @brief Moves a node which already belongs to a doubly-linked list to its head in O(1)
+ * 
+ * @param dlist Pointer to the doubly-linked list which holds the node
+ * @param node  Node to be moved
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_move_to_head(jll_dlist_t * dlist, jll_dnode_t * node)
+{
+    JLL_LAT_SCOPE(DLIST_MOVE_TO_HEAD);
+    assert(dlist);
+    assert(node);
+
+    if (node == dlist->head) return;
+
+    jll_dlist_unlink(dlist, node);
+    __jll_dlist_link_head(dlist, node);
+    __jll_dlist_count_in(dlist, node);
+}
+
+
+/* cached sort keys */
+
+/**
+ * @brief Caches a fixed-width sort key in every node, extracted once when the node is created. Sorted insertion,
+ * sortedness checks and sorted merges then order nodes by key and only call the comparison function on ties.
+ * The key lives in a keyed node (jll_dknode_t), so a list of plain nodes has them moved into keyed ones (and
+ * back once neither keys nor counts are needed).
+ * 
+ * @param dlist List to be configured; its existing nodes are keyed straight away
+ * @param func  Key function; key(a) < key(b) must imply that a sorts before b. NULL drops the cached keys.
+ * 
+ * @returns True on success; false, leaving the list as it was, if the change of node kind would have to move
+ * nodes linked in by the caller
+ */
+bool jll_dlist_set_key_func(jll_dlist_t * dlist, data_keyfunc_t func)
+{
+    JLL_LAT_SCOPE(DLIST_SET_KEY_FUNC);
+    assert(dlist);
+    __jll_dlist_settle(dlist);
+
+    data_keyfunc_t old_func = dlist->dlist_key_func;
+    bool was_keyed = dlist->keyed;
+
+    dlist->dlist_key_func = func;
+    if (!__jll_dlist_conform(dlist))
+    {
+        dlist->dlist_key_func = old_func;
+        return false;
+    }
+
+    // Nodes created by a change of kind were keyed as they were made.
+    if ((was_keyed) && (dlist->keyed)) __jll_dlist_rekey(dlist, dlist->head, dlist->length);
+    return true;
+}
+
+/**
+ * @brief Finds data by its cached key without reading any data; a sorted list stops at the first larger key
+ * 
+ * @param dlist List with a key function
+ * @param key   Key to look for
+ * 
+ * @returns The data of the first node holding the key, or NULL if there is none
+ */
+const jll_data_t * jll_dlist_find_cached_key(jll_dlist_t * dlist, uint64_t key)
+{
+    JLL_LAT_SCOPE(DLIST_FIND_CACHED_KEY);
+    assert(dlist);
+    assert(dlist->dlist_key_func);
+    JLL_PROF_OP(dlist);
+
+    jll_dnode_t * rover = dlist->head;
+    size_t nodes = __jll_dlist_nodes(dlist);
+
+    for (size_t k = 0; k < nodes; k++, rover = rover->next)
+    {
+        JLL_PROF_HOP(dlist);
+        if (!rover->data) continue;
+
+        if (JLL_DKNODE(rover)->key == key) return rover->data;
+        if ((dlist->sorted) && (JLL_DKNODE(rover)->key > key)) return NULL;
+    }
+
+    return NULL;
+}
+
+
+/* self-organization */
+
+/**
+ * @brief Selects the self-organizing policy applied on successful finds and contains checks
+ * 
+ * @param dlist  List to be configured
+ * @param policy Move-to-front, transpose, count-ordered or none. Counts live in keyed nodes (jll_dknode_t),
+ * so the count-ordered policy moves a list of plain nodes into keyed ones. Under the count-ordered policy a
+ * node entering the list at its head or before another node takes that node's count, and operations which
+ * put the nodes in an order of their own (reversal, merges, radix sort) restart all counts from zero.
+ * 
+ * @returns True on success; false, leaving the list as it was, if the list is sorted and the policy is not
+ * JLL_REORG_NONE, or if the change of node kind would have to move nodes linked in by the caller
+ */
+bool jll_dlist_set_reorg_policy(jll_dlist_t * dlist, jll_reorg_policy_t policy)
+{
+    assert(dlist);
+
+    // Reorganizing would undo the order sorted insertion relies on.
+    if ((dlist->sorted) && (policy != JLL_REORG_NONE)) return false;
+
+    jll_reorg_policy_t old_policy = dlist->reorg;
+
+    dlist->reorg = policy;
+    if (!__jll_dlist_conform(dlist))
+    {
+        dlist->reorg = old_policy;
+        return false;
+    }
+
+    // Count ordering starts from a clean slate so the non-increasing invariant holds.
+    __jll_dlist_restart_counts(dlist);
+    return true;
+}
+
+
+/* keyed membership */
+
+static void __jll_dlist_rebuild_bloom(jll_dlist_t * dlist)
+{
+    jll_bloom_reset(dlist->bloom, dlist->length);
+
+    jll_dnode_t * rover = dlist->head;
+    for (size_t k = 0; k < __jll_dlist_nodes(dlist); k++)
+    {
+        if (rover->data) jll_bloom_insert(dlist->bloom, rover->data);
+        rover = rover->next;
+    }
+}
+
+/**
+ * @brief Attaches a Bloom filter which lets keyed lookups reject absent keys without walking the list
+ * 
+ * @param dlist    List to be screened; its comparison function decides key equality (returns 0)
+ * @param hashfunc User-specified hash over the key portion of the data
+ * @param fpr      Target false-positive rate
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_attach_bloom(jll_dlist_t * dlist, data_hashfunc_t hashfunc, double fpr)
+{
+    assert(dlist);
+    assert(hashfunc);
+    assert(dlist->dlist_comp_func);
+
+    if (dlist->bloom) jll_dealloc_bloom(dlist->bloom);
+
+    dlist->bloom = jll_alloc_bloom(hashfunc, dlist->length, fpr);
+    __jll_dlist_rebuild_bloom(dlist);
+    dlist->bloom->stats.rebuilds = 0;
+}
+
+void jll_dlist_detach_bloom(jll_dlist_t * dlist)
+{
+    assert(dlist);
+
+    if (dlist->bloom) jll_dealloc_bloom(dlist->bloom);
+    dlist->bloom = NULL;
+}
+
+/**
+ * @brief Finds the first node whose data compares equal (0) to a key, consulting the Bloom filter first if one is attached.
+ * The filter is rebuilt lazily here once removals have left too many stale keys in it.
+ * 
+ * @param dlist List to be searched
+ * @param key   Data carrying the key to be looked up
+ * 
+ * @returns Constant reference to the matching data, or NULL
+ */
+const jll_data_t * jll_dlist_find_key(jll_dlist_t * dlist, const jll_data_t * key)
+{
+    JLL_LAT_SCOPE(DLIST_FIND_KEY);
+    assert(dlist);
+    assert(key);
+    assert(dlist->dlist_comp_func);
+    JLL_PROF_OP(dlist);
+
+    jll_bloom_t * bloom = dlist->bloom;
+
+    if (bloom)
+    {
+        if (jll_bloom_needs_rebuild(bloom)) __jll_dlist_rebuild_bloom(dlist);
+
+        bloom->stats.queries++;
+        if (!jll_bloom_may_contain(bloom, key))
+        {
+            bloom->stats.negatives++;
+            return NULL;
+        }
+    }
+
+    jll_dnode_t * found = __jll_dlist_search(dlist, NULL, NULL, key);
+    if ((!found) && (bloom)) bloom->stats.false_positives++;
+
+    return found ? found->data : NULL;
+}
+
+bool jll_dlist_check_if_contains_key(jll_dlist_t * dlist, const jll_data_t * key)
+{
+    JLL_LAT_SCOPE(DLIST_CHECK_IF_CONTAINS_KEY);
+    return (jll_dlist_find_key(dlist, key) != NULL);
+}
+
+
+/* profiling */
+
+/**
+ * @brief Copies the operation counters of a list (all zero unless built with JLL_ENABLE_PROFILING)
+ * 
+ * @param dlist List to be queried
+ * @param out   Destination for the counters
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_get_profile(const jll_dlist_t * dlist, jll_profile_t * out)
+{
+    assert(dlist);
+    assert(out);
+
+    *out = dlist->profile;
+}
+
+void jll_dlist_reset_profile(jll_dlist_t * dlist)
+{
+    assert(dlist);
+    JLL_PROF_INIT(dlist);
+}
+
+/**
+ * @brief Copies the always-on sorted insertion counters of a list (comparisons and hops per insert,
+ * and how often the tail or the last insertion point resolved the search)
+ */
+void jll_dlist_get_insert_stats(const jll_dlist_t * dlist, jll_insert_stats_t * out)
+{
+    assert(dlist);
+    assert(out);
+    *out = dlist->insert_stats;
+}
+
+void jll_dlist_reset_insert_stats(jll_dlist_t * dlist)
+{
+    assert(dlist);
+    memset(&dlist->insert_stats, 0, sizeof(jll_insert_stats_t));
+}
+
+
+/* memory accounting */
+
+/**
+ * @brief Reports the bytes attributed to a list: its header (plus any attached filter), its nodes,
+ * and (separately, cumulatively) the payload buffers it has handed out. Sizes are requested sizes without allocator overhead.
+ * 
+ * @param dlist List to be measured
+ * @param out   Destination for the byte counts
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_memory(const jll_dlist_t * dlist, jll_list_memory_t * out)
+{
+    assert(dlist);
+    assert(out);
+
+    out->header_bytes = sizeof(jll_dlist_t) + (dlist->bloom ? jll_bloom_bytes(dlist->bloom) : 0);
+    out->node_bytes = __jll_dlist_nodes(dlist) * __jll_dlist_node_bytes(dlist);
+    out->payload_bytes_issued = dlist->payload_bytes_issued;
+    out->total_bytes = out->header_bytes + out->node_bytes;
+}
+
+/**
+ * @brief Walks a list and reports how far apart consecutive nodes sit in memory
+ * 
+ * @param dlist List to be analysed
+ * @param out   Destination for the layout report
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_layout(const jll_dlist_t * dlist, jll_layout_report_t * out)
+{
+    assert(dlist);
+    assert(out);
+
+    jll_layout_begin(out);
+
+    const jll_dnode_t * rover = dlist->head;
+    for (size_t k = 1; k < __jll_dlist_nodes(dlist); k++)
+    {
+        jll_layout_hop(out, rover, rover->next);
+        rover = rover->next;
+    }
+
+    jll_layout_end(out);
+}
+
+
+/* compaction */
+
+static bool __jll_dlist_in_block(const jll_compact_t * state, const jll_dnode_t * node)
+{
+    return ((const char *)node >= state->block) && ((const char *)node < state->block + state->capacity * state->node_size);
+}
+
+/**
+ * @brief Re-establishes the cursor after the list changed under an incremental pass:
+ * the cursor becomes the last node of the leading run of nodes which already sit in the block.
+ */
+static jll_dnode_t * __jll_dlist_compact_resume(jll_dlist_t * dlist, jll_compact_t * state)
+{
+    jll_dnode_t * cursor = NULL;
+    jll_dnode_t * rover = dlist->head;
+
+    // Nodes buried since the pass began are still linked, so the walk covers them too.
+    for (size_t k = 0; k < __jll_dlist_nodes(dlist); k++)
+    {
+        if (!__jll_dlist_in_block(state, rover)) break;
+
+        cursor = rover;
+        rover = rover->next;
+        JLL_PROF_HOP(dlist);
+    }
+
+    state->generation = dlist->generation;
+    return cursor;
+}
+
+/**
+ * @brief Starts an incremental compaction pass, reserving a contiguous block sized for the current length
+ * 
+ * @param dlist    List to be compacted; its nodes must have been allocated by the list itself
+ * (not embedded in caller structures and linked with jll_dlist_link_*)
+ * @param state    Caller-owned progress record for the pass
+ * @param hugepage Back the block with huge pages where the platform allows it
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_compact_begin(jll_dlist_t * dlist, jll_compact_t * state, bool hugepage)
+{
+    assert(dlist);
+    assert(state);
+    __jll_dlist_settle(dlist);
+
+    state->block = NULL;
+    state->pool = NULL;
+    state->node_size = __jll_dlist_node_bytes(dlist);
+    state->capacity = dlist->length;
+    state->placed = 0;
+    state->cursor = NULL;
+    state->generation = dlist->generation;
+    state->active = (dlist->length > 0);
+
+    if (!state->active) return;
+
+    // The nodes already linked did not come from the pool created here.
+    if (!dlist->pool)
+    {
+        dlist->pool = jll_alloc_pool(state->node_size, JLL_DLIST_POOL_BLOCK, hugepage);
+        dlist->foreign_nodes = true;
+    }
+
+    state->pool = dlist->pool;
+    state->block = (char *)jll_pool_get_block(dlist->pool, state->capacity, hugepage);
+}
+
+/**
+ * @brief Relocates up to budget nodes, in traversal order, into the block reserved by jll_dlist_compact_begin.
+ * The list stays fully usable between steps; removals or reordering in between only make the next step
+ * re-find its place. Node addresses change, so pointers to nodes held outside the list become invalid.
+ * 
+ * @param dlist  List being compacted
+ * @param state  Progress record set up by jll_dlist_compact_begin
+ * @param budget Maximum number of nodes to relocate in this step
+ * 
+ * @returns True once the pass has finished (the block is then released with jll_dlist_compact_end)
+ */
+bool jll_dlist_compact_step(jll_dlist_t * dlist, jll_compact_t * state, size_t budget)
+{
+    JLL_LAT_SCOPE(DLIST_COMPACT_STEP);
+    assert(dlist);
+    assert(state);
+
+    if (!state->active) return true;
+
+    jll_dnode_t * cursor = (jll_dnode_t *)state->cursor;
+    if (state->generation != dlist->generation) cursor = __jll_dlist_compact_resume(dlist, state);
+
+    size_t moved = 0;
+    bool finished = false;
+
+    while (moved < budget)
+    {
+        // A list switched to another kind of node since the pass began no longer fits the block, and one which
+        // was recast (even back to the kind it started with) has left the block's pool behind.
+        bool same_pool = (state->pool == dlist->pool) && (state->node_size == __jll_dlist_node_bytes(dlist));
+
+        if ((jll_dlist_is_empty(dlist)) || (cursor == dlist->tail) || (state->placed == state->capacity) || (!same_pool))
+        {
+            // A pass which got through the whole list left every node in the list's own pool.
+            if ((cursor) && (cursor == dlist->tail) && (same_pool)) dlist->foreign_nodes = dlist->caller_nodes;
+
+            finished = true;
+            break;
+        }
+
+        jll_dnode_t * node = (cursor) ? cursor->next : dlist->head;
+        JLL_PROF_HOP(dlist);
+
+        if (!__jll_dlist_in_block(state, node))
+        {
+            jll_dnode_t * slot = (jll_dnode_t *)(state->block + state->placed * state->node_size);
+            memcpy(slot, node, state->node_size);
+            JLL_MEM_ADD(JLL_MEM_NODES, state->node_size);
+            state->placed++;
+
+            // Neighbours (including the wrap-around ones of a circular list) now point at the copy.
+            if (node->prev) node->prev->next = slot;
+            if (node->next) node->next->prev = slot;
+
+            if (node == dlist->head) dlist->head = slot;
+            if (node == dlist->tail) dlist->tail = slot;
+            __jll_dlist_fix_ends(dlist);
+
+            __jll_dlist_dealloc_node(dlist, node);
+            node = slot;
+            moved++;
+        }
+
+        cursor = node;
+    }
+
+    state->cursor = cursor;
+
+    // Relocation moved nodes; anyone tracking node addresses must start over.
+    if (moved) dlist->generation++;
+    state->generation = dlist->generation;
+
+    if (finished) jll_dlist_compact_end(dlist, state);
+    return finished;
+}
+
+/**
+ * @brief Finishes (or abandons) an incremental compaction pass, returning unused block slots to the list's pool
+ */
+void jll_dlist_compact_end(jll_dlist_t * dlist, jll_compact_t * state)
+{
+    assert(dlist);
+    assert(state);
+
+    if (!state->active) return;
+
+    // The list may have moved to a pool of another node size since, so the slots go back to the block's owner.
+    for (size_t k = state->placed; k < state->capacity; k++)
+        jll_pool_release(state->block + k * state->node_size);
+
+    state->active = false;
+}
+
+/**
+ * @brief Copies every node of a list into one contiguous, traversal-ordered block and frees the old nodes
+ * 
+ * @param dlist    List to be compacted
+ * @param hugepage Back the block with huge pages where the platform allows it
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_compact(jll_dlist_t * dlist, bool hugepage)
+{
+    JLL_LAT_SCOPE(DLIST_COMPACT);
+    assert(dlist);
+
+    jll_compact_t state;
+    jll_dlist_compact_begin(dlist, &state, hugepage);
+    while (!jll_dlist_compact_step(dlist, &state, (size_t)-1));
+}
+
+
+/* lazy deletion */
+
+/**
+ * @brief Switches a list to lazy deletion: remove_index and remove_cond_first then only mark the node they locate
+ * dead (a tombstone) in O(1), and traversals, index_pos and exports step over dead nodes. Dead nodes are unlinked
+ * and freed in one pass once they make up more than ratio of the list's nodes, or when purged explicitly.
+ * Operations which relink or rekey the whole list purge first.
+ * 
+ * @param dlist List to be configured; must not be a bounded ring
+ * @param ratio Dead fraction of all nodes which triggers a purge; 0 turns lazy deletion off (purging now) and
+ *              1 or more leaves purging to jll_dlist_purge_tombstones
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_set_lazy_delete(jll_dlist_t * dlist, double ratio)
+{
+    JLL_LAT_SCOPE(DLIST_SET_LAZY_DELETE);
+    assert(dlist);
+    assert(!dlist->capacity);
+    assert(ratio >= 0);
+
+    dlist->tombstone_ratio = ratio;
+    if ((double)dlist->tombstones > ratio * (double)__jll_dlist_nodes(dlist)) jll_dlist_purge_tombstones(dlist);
+}
+
+/**
+ * @brief Unlinks and frees every dead node of a list in a single pass
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * 
+ * @returns Number of nodes freed
+ */
+size_t jll_dlist_purge_tombstones(jll_dlist_t * dlist)
+{
+    JLL_LAT_SCOPE(DLIST_PURGE_TOMBSTONES);
+    assert(dlist);
+    JLL_PROF_OP(dlist);
+
+    size_t purged = dlist->tombstones;
+    if (!purged) return 0;
+
+    // The ends are always live, so the head stays put and the last live node reached is the tail.
+    jll_dnode_t * last = dlist->head;
+    jll_dnode_t * rover = last->next;
+    size_t nodes = __jll_dlist_nodes(dlist);
+
+    for (size_t k = 1; k < nodes; k++)
+    {
+        jll_dnode_t * next = rover->next;
+
+        if (rover->data)
+        {
+            last->next = rover;
+            rover->prev = last;
+            last = rover;
+        }
+        else __jll_dlist_free_node(dlist, rover);
+
+        rover = next;
+        JLL_PROF_HOP(dlist);
+    }
+
+    dlist->tombstones = 0;
+    dlist->generation++;
+    __jll_dlist_fix_ends(dlist);
+
+    return purged;
+}
+
+/**
+ * @brief Number of dead nodes awaiting a purge
+ */
+size_t jll_dlist_tombstones(const jll_dlist_t * dlist)
+{
+    assert(dlist);
+    return dlist->tombstones;
+}
+
+
+/* merging */
+
+/**
+ * @brief Merges two sorted doubly-linked lists by relinking their nodes, in O(n+m) and without allocating.
+ * Equal elements keep their relative order, those of lone first.
+ * 
+ * @param lone List receiving the merged result; its comparison function decides the order
+ * @param ltwo List whose nodes are moved into lone; it is left empty (but not deallocated)
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_merge_sorted(jll_dlist_t * lone, jll_dlist_t * ltwo)
+{
+    JLL_LAT_SCOPE(DLIST_MERGE_SORTED);
+    assert(lone);
+    assert(ltwo);
+    assert(lone != ltwo);
+    assert(lone->dlist_comp_func);
+    JLL_PROF_OP(lone);
+
+    __jll_dlist_settle(lone);
+    __jll_dlist_settle(ltwo);
+    if (jll_dlist_is_empty(ltwo)) return;
+
+    jll_dnode_t * a = lone->head;
+    size_t b_length = ltwo->length;
+    jll_dnode_t * b_tail;
+    jll_dnode_t * b = __jll_dlist_absorb(lone, ltwo, &b_tail);
+
+    if (!a)
+    {
+        lone->head = b;
+        lone->tail = b_tail;
+    }
+    else
+    {
+        lone->tail->next = NULL;
+        b_tail->next = NULL;
+
+        if (__jll_dlist_compare_nodes(lone, lone->tail, b) != -1)
+        {
+            // Ranges do not overlap; a plain append keeps the order.
+            lone->tail->next = b;
+            b->prev = lone->tail;
+            lone->tail = b_tail;
+        }
+        else
+        {
+            jll_dnode_t anchor;
+            jll_dnode_t * last = &anchor;
+
+            while ((a) && (b))
+            {
+                if (__jll_dlist_compare_nodes(lone, a, b) == -1)
+                {
+                    last->next = b;
+                    b->prev = last;
+                    last = b;
+                    b = b->next;
+                }
+                else
+                {
+                    last->next = a;
+                    a->prev = last;
+                    last = a;
+                    a = a->next;
+                }
+                JLL_PROF_HOP(lone);
+            }
+
+            jll_dnode_t * rest = (a) ? a : b;
+            last->next = rest;
+            rest->prev = last;
+
+            lone->head = anchor.next;
+            if (!a) lone->tail = b_tail;
+        }
+    }
+
+    lone->length += b_length;
+    __jll_dlist_fix_ends(lone);
+    __jll_dlist_restart_counts(lone);
+}
+
+/**
+ * @brief Tournament (loser) tree over the heads of the lists taking part in a k-way merge.
+ * Leaves are the sources padded to a power of two; internal node n keeps the loser of the match
+ * played there and losers[0] the overall winner, so replacing the winner costs log2(k) comparisons.
+ */
+typedef struct jll_dlist_merge_tree_type
+{
+    jll_dnode_t ** heads;
+    jll_dnode_t ** tails;
+    size_t * losers;
+    size_t leaves;
+
+} jll_dlist_merge_tree_t;
+
+/**
+ * @brief Match order: source x wins over source y if y's head belongs after x's head;
+ * exhausted sources always lose and ties go to the earlier source so the merge is stable.
+ */
+static bool __jll_dlist_merge_wins(jll_dlist_t * dlist, const jll_dlist_merge_tree_t * tree, size_t x, size_t y)
+{
+    if (!tree->heads[x]) return false;
+    if (!tree->heads[y]) return true;
+
+    int order = __jll_dlist_compare_nodes(dlist, tree->heads[x], tree->heads[y]);
+
+    if (order == 0) return (x < y);
+    return (order != -1);
+}
+
+static void __jll_dlist_merge_build(jll_dlist_t * dlist, jll_dlist_merge_tree_t * tree)
+{
+    size_t * winners = (size_t *)malloc(2 * tree->leaves * sizeof(size_t));
+
+    for (size_t k = 0; k < tree->leaves; k++) winners[tree->leaves + k] = k;
+
+    for (size_t n = tree->leaves - 1; n > 0; n--)
+    {
+        size_t a = winners[2 * n];
+        size_t b = winners[2 * n + 1];
+
+        if (__jll_dlist_merge_wins(dlist, tree, b, a))
+        {
+            size_t t = a;
+            a = b;
+            b = t;
+        }
+
+        winners[n] = a;
+        tree->losers[n] = b;
+    }
+
+    tree->losers[0] = winners[1];
+    free(winners);
+}
+
+static void __jll_dlist_merge_replay(jll_dlist_t * dlist, jll_dlist_merge_tree_t * tree, size_t source)
+{
+    size_t winner = source;
+
+    for (size_t n = (tree->leaves + source) / 2; n > 0; n /= 2)
+    {
+        if (__jll_dlist_merge_wins(dlist, tree, tree->losers[n], winner))
+        {
+            size_t t = tree->losers[n];
+            tree->losers[n] = winner;
+            winner = t;
+        }
+    }
+
+    tree->losers[0] = winner;
+}
+
+/**
+ * @brief Merges any number of sorted doubly-linked lists into one with a tournament tree over the list heads,
+ * relinking nodes in O(N log k) without allocating nodes.
+ * 
+ * @param dlist List receiving the merged result (its current nodes take part in the merge);
+ * its comparison function decides the order
+ * @param lists Lists whose nodes are moved into dlist; each is left empty (but not deallocated)
+ * @param count Number of lists in lists
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_merge_sorted_n(jll_dlist_t * dlist, jll_dlist_t ** lists, size_t count)
+{
+    JLL_LAT_SCOPE(DLIST_MERGE_SORTED_N);
+    assert(dlist);
+    assert((lists) || (count == 0));
+    assert(dlist->dlist_comp_func);
+    JLL_PROF_OP(dlist);
+
+    jll_dlist_merge_tree_t tree;
+    tree.leaves = 1;
+    while (tree.leaves < count + 1) tree.leaves <<= 1;
+
+    tree.heads = (jll_dnode_t **)calloc(2 * tree.leaves, sizeof(jll_dnode_t *));
+    tree.tails = tree.heads + tree.leaves;
+    tree.losers = (size_t *)malloc(tree.leaves * sizeof(size_t));
+
+    size_t live = 0;
+    size_t total = 0;
+
+    for (size_t k = 0; k <= count; k++)
+    {
+        jll_dlist_t * source = (k == 0) ? dlist : lists[k - 1];
+        assert((k == 0) || (source != dlist));
+
+        __jll_dlist_settle(source);
+        if (jll_dlist_is_empty(source)) continue;
+
+        total += source->length;
+        live++;
+
+        if (k > 0) tree.heads[k] = __jll_dlist_absorb(dlist, source, &tree.tails[k]);
+        else
+        {
+            tree.heads[k] = source->head;
+            tree.tails[k] = source->tail;
+        }
+
+        tree.tails[k]->next = NULL;
+    }
+
+    if (live > 0)
+    {
+        __jll_dlist_merge_build(dlist, &tree);
+
+        jll_dnode_t anchor;
+        jll_dnode_t * last = &anchor;
+
+        while (live > 1)
+        {
+            size_t winner = tree.losers[0];
+            jll_dnode_t * node = tree.heads[winner];
+
+            last->next = node;
+            node->prev = last;
+            last = node;
+            JLL_PROF_HOP(dlist);
+
+            tree.heads[winner] = node->next;
+            if (!node->next) live--;
+            else if (node->next->next) __builtin_prefetch(node->next->next);
+
+            __jll_dlist_merge_replay(dlist, &tree, winner);
+        }
+
+        // The last remaining run is already in order.
+        size_t winner = tree.losers[0];
+        last->next = tree.heads[winner];
+        tree.heads[winner]->prev = last;
+
+        dlist->head = anchor.next;
+        dlist->tail = tree.tails[winner];
+        dlist->length = total;
+        dlist->generation++;
+        __jll_dlist_fix_ends(dlist);
+        __jll_dlist_restart_counts(dlist);
+    }
+
+    free(tree.heads);
+    free(tree.losers);
+}
+
+
+/* sorting */
+
+/**
+ * @brief Key and node pair sorted by jll_dlist_radix_sort; keys are read once, up front
+ */
+typedef struct jll_dlist_radix_item_type
+{
+    uint64_t key;
+    jll_dnode_t * node;
+
+} jll_dlist_radix_item_t;
+
+/**
+ * @brief Sorts a doubly-linked list into ascending order of an unsigned integer key with a stable LSD radix sort
+ * (eight passes of one byte each), then relinks the nodes in that order. Each element's key is extracted exactly
+ * once and passes over bytes which are the same for every key are skipped, so 32-bit keys cost four passes.
+ * Signed keys sort correctly if the extractor flips their sign bit.
+ * 
+ * @param dlist Pointer to the doubly-linked list
+ * @param keyfunc User-specified function returning the sort key of an element
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_radix_sort(jll_dlist_t * dlist, data_keyfunc_t keyfunc)
+{
+    JLL_LAT_SCOPE(DLIST_RADIX_SORT);
+    assert(dlist);
+    assert(keyfunc);
+    JLL_PROF_OP(dlist);
+    __jll_dlist_settle(dlist);
+
+    size_t length = dlist->length;
+    if (length < 2) return;
+
+    jll_dlist_radix_item_t * items = (jll_dlist_radix_item_t *)malloc(2 * length * sizeof(jll_dlist_radix_item_t));
+    jll_dlist_radix_item_t * scratch = items + length;
+
+    // One pass over the list reads the keys and builds the histograms of all eight digits.
+    size_t (*counts)[256] = (size_t (*)[256])calloc(8 * 256, sizeof(size_t));
+
+    jll_dnode_t * rover = dlist->head;
+    for (size_t k = 0; k < length; k++)
+    {
+        uint64_t key = keyfunc(rover->data);
+
+        items[k].key = key;
+        items[k].node = rover;
+        for (unsigned d = 0; d < 8; d++) counts[d][(key >> (8 * d)) & 0xff]++;
+
+        rover = rover->next;
+    }
+
+    for (unsigned d = 0; d < 8; d++)
+    {
+        unsigned shift = 8 * d;
+
+        // Every key has the same digit here; the pass would not move anything.
+        if (counts[d][(items[0].key >> shift) & 0xff] == length) continue;
+
+        size_t offset = 0;
+        for (unsigned b = 0; b < 256; b++)
+        {
+            size_t count = counts[d][b];
+            counts[d][b] = offset;
+            offset += count;
+        }
+
+        for (size_t k = 0; k < length; k++) scratch[counts[d][(items[k].key >> shift) & 0xff]++] = items[k];
+
+        jll_dlist_radix_item_t * swap = items;
+        items = scratch;
+        scratch = swap;
+    }
+
+    // Relink the nodes in key order.
+    for (size_t k = 0; k + 1 < length; k++)
+    {
+        items[k].node->next = items[k + 1].node;
+        items[k + 1].node->prev = items[k].node;
+    }
+
+    dlist->head = items[0].node;
+    dlist->tail = items[length - 1].node;
+    __jll_dlist_fix_ends(dlist);
+    __jll_dlist_restart_counts(dlist);
+    dlist->generation++;
+
+    free((items < scratch) ? items : scratch);
+    free(counts);
+}
+
+
+/* set algebra */
+
+/**
+ * @brief Frees a node dropped by a set operation or dedupe pass, handing its data to the optional dealloc function
+ */
+static void __jll_dlist_drop_node(jll_dlist_t * dlist, jll_dnode_t * node, void (*data_dealloc_func)(const jll_data_t *))
+{
+    const jll_data_t * old_data_ptr = __jll_dlist_free_node(dlist, node);
+    if (data_dealloc_func) data_dealloc_func(old_data_ptr);
+}
+
+/**
+ * @brief Applies a set operation to two sorted doubly-linked lists in a single linear pass, splicing nodes.
+ * Lists are treated as multisets: each element of lone is paired with at most one equal element of ltwo,
+ * and for union and intersection the element of lone is the one kept.
+ * 
+ * @param lone List receiving the result; its comparison function decides order and equality
+ * @param ltwo Second operand; it is left empty (but not deallocated)
+ * @param op   Union, intersection, difference (lone - ltwo) or symmetric difference
+ * @param data_dealloc_func Function handed the data of every dropped node (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_dlist_set_operation(jll_dlist_t * lone, jll_dlist_t * ltwo, jll_setop_t op, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(DLIST_SET_OPERATION);
+    assert(lone);
+    assert(ltwo);
+    assert(lone != ltwo);
+    assert(lone->dlist_comp_func);
+    JLL_PROF_OP(lone);
+
+    __jll_dlist_settle(lone);
+    __jll_dlist_settle(ltwo);
+
+    bool keep_lone = (op != JLL_SET_INTERSECTION);
+    bool keep_ltwo = (op == JLL_SET_UNION) || (op == JLL_SET_SYMMETRIC_DIFFERENCE);
+    bool keep_pair = (op == JLL_SET_UNION) || (op == JLL_SET_INTERSECTION);
+
+    if (!jll_dlist_is_empty(lone)) lone->tail->next = NULL;
+
+    jll_dnode_t * a = lone->head;
+
+    // Every node of ltwo becomes lone's (keyed and filtered as such); those the operation drops count as removals.
+    jll_dnode_t * b_tail;
+    jll_dnode_t * b = __jll_dlist_absorb(lone, ltwo, &b_tail);
+    if (b) b_tail->next = NULL;
+
+    jll_dnode_t anchor;
+    jll_dnode_t * last = &anchor;
+    size_t length = 0;
+
+    while ((a) || (b))
+    {
+        int order = 1;
+
+        if (!a) order = -1;
+        else if (b) order = __jll_dlist_compare_nodes(lone, a, b);
+
+        if (order == -1)
+        {
+            // Only in ltwo.
+            jll_dnode_t * next = b->next;
+
+            if (keep_ltwo)
+            {
+                last->next = b;
+                b->prev = last;
+                last = b;
+                length++;
+            }
+            else
+            {
+                __jll_dlist_drop_node(lone, b, data_dealloc_func);
+                __jll_dlist_note_remove(lone);
+            }
+
+            b = next;
+        }
+        else if (order == 0)
+        {
+            // In both; the node of ltwo is always dropped.
+            jll_dnode_t * next_a = a->next;
+            jll_dnode_t * next_b = b->next;
+
+            if (keep_pair)
+            {
+                last->next = a;
+                a->prev = last;
+                last = a;
+                length++;
+            }
+            else
+            {
+                __jll_dlist_drop_node(lone, a, data_dealloc_func);
+                __jll_dlist_note_remove(lone);
+            }
+
+            __jll_dlist_drop_node(lone, b, data_dealloc_func);
+            __jll_dlist_note_remove(lone);
+
+            a = next_a;
+            b = next_b;
+        }
+        else
+        {
+            // Only in lone.
+            jll_dnode_t * next = a->next;
+
+            if (keep_lone)
+            {
+                last->next = a;
+                a->prev = last;
+                last = a;
+                length++;
+            }
+            else
+            {
+                __jll_dlist_drop_node(lone, a, data_dealloc_func);
+                __jll_dlist_note_remove(lone);
+            }
+
+            a = next;
+        }
+
+        JLL_PROF_HOP(lone);
+    }
+
+    last->next = NULL;
+
+    lone->head = (length) ? anchor.next : NULL;
+    lone->tail = (length) ? last : NULL;
+    lone->length = length;
+    lone->generation++;
+    __jll_dlist_fix_ends(lone);
+    __jll_dlist_restart_counts(lone);
+}
+
+/**
+ * @brief Builds the result of a set operation on two sorted doubly-linked lists as a new list, leaving both operands untouched.
+ * The new list allocates its nodes from its own pool and references (does not copy) the operands' data,
+ * so it should be deallocated with a data function which does not free them.
+ * 
+ * @param lone First operand; its comparison function decides order and equality
+ * @param ltwo Second operand
+ * @param op   Union, intersection, difference (lone - ltwo) or symmetric difference
+ * 
+ * @returns Pointer to the newly created sorted list
+ */
+jll_dlist_t * jll_dlist_set_operation_copy(const jll_dlist_t * lone, const jll_dlist_t * ltwo, jll_setop_t op)
+{
+    JLL_LAT_SCOPE(DLIST_SET_OPERATION_COPY);
+    assert(lone);
+    assert(ltwo);
+    assert(lone->dlist_comp_func);
+
+    data_compfunc_t comp = lone->dlist_comp_func;
+
+    // The operands' cached keys order them as the comparison function would when both key by the same function.
+    bool keyed = (lone->dlist_key_func) && (ltwo->dlist_key_func == lone->dlist_key_func);
+
+    bool keep_lone = (op != JLL_SET_INTERSECTION);
+    bool keep_ltwo = (op == JLL_SET_UNION) || (op == JLL_SET_SYMMETRIC_DIFFERENCE);
+    bool keep_pair = (op == JLL_SET_UNION) || (op == JLL_SET_INTERSECTION);
+
+    jll_dlist_t * result = jll_alloc_dlist(comp, false, true, false);
+
+    // Size pool blocks for the result so large builds need few of them.
+    size_t bound = lone->length + ltwo->length;
+    if (bound < JLL_DLIST_POOL_BLOCK) bound = JLL_DLIST_POOL_BLOCK;
+    if (bound > JLL_DLIST_POOL_BLOCK_MAX) bound = JLL_DLIST_POOL_BLOCK_MAX;
+    result->pool = jll_alloc_pool(__jll_dlist_node_bytes(result), bound, false);
+
+    const jll_dnode_t * a = lone->head;
+    const jll_dnode_t * b = ltwo->head;
+    size_t left_a = __jll_dlist_nodes(lone);
+    size_t left_b = __jll_dlist_nodes(ltwo);
+
+    while ((left_a) || (left_b))
+    {
+        // The operands are const and cannot be purged, so their tombstones are stepped over.
+        if ((left_a) && (!a->data))
+        {
+            a = a->next;
+            left_a--;
+            continue;
+        }
+        if ((left_b) && (!b->data))
+        {
+            b = b->next;
+            left_b--;
+            continue;
+        }
+
+        int order = 1;
+
+        if (!left_a) order = -1;
+        else if ((left_b) && (keyed) && (JLL_DKNODE(a)->key != JLL_DKNODE(b)->key))
+        {
+            order = (JLL_DKNODE(a)->key > JLL_DKNODE(b)->key) ? -1 : 1;
+        }
+        else if (left_b)
+        {
+            JLL_PROF_CMP(result);
+            order = comp(a->data, b->data);
+        }
+
+        if (order == -1)
+        {
+            if (keep_ltwo) jll_dlist_append_tail(result, b->data);
+            b = b->next;
+            left_b--;
+        }
+        else if (order == 0)
+        {
+            if (keep_pair) jll_dlist_append_tail(result, a->data);
+            a = a->next;
+            b = b->next;
+            left_a--;
+            left_b--;
+        }
+        else
+        {
+            if (keep_lone) jll_dlist_append_tail(result, a->data);
+            a = a->next;
+            left_a--;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Removes every node of a sorted doubly-linked list which compares equal (0) to its predecessor
+ * 
+ * @param dlist Sorted list to be deduplicated
+ * @param data_dealloc_func Function handed the data of every removed node (may be NULL)
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_dlist_unique(jll_dlist_t * dlist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(DLIST_UNIQUE);
+    assert(dlist);
+    assert(dlist->dlist_comp_func);
+    JLL_PROF_OP(dlist);
+    __jll_dlist_settle(dlist);
+
+    if (dlist->length < 2) return 0;
+
+    dlist->tail->next = NULL;
+
+    size_t removed = 0;
+    jll_dnode_t * rover = dlist->head;
+
+    while (rover->next)
+    {
+        jll_dnode_t * next = rover->next;
+
+        JLL_PROF_CMP(dlist);
+        if (dlist->dlist_comp_func(rover->data, next->data) == 0)
+        {
+            rover->next = next->next;
+            if (next->next) next->next->prev = rover;
+            if (next == dlist->tail) dlist->tail = rover;
+
+            __jll_dlist_drop_node(dlist, next, data_dealloc_func);
+            __jll_dlist_note_remove(dlist);
+            removed++;
+        }
+        else
+        {
+            rover = next;
+            JLL_PROF_HOP(dlist);
+        }
+    }
+
+    dlist->length -= removed;
+    __jll_dlist_fix_ends(dlist);
+
+    return removed;
+}
+
+/**
+ * @brief Removes every node of an unsorted doubly-linked list whose data compares equal (0) to that of an earlier node,
+ * in one pass with an open-addressing hash table; the first occurrence of each element is kept.
+ * 
+ * @param dlist List to be deduplicated; its comparison function decides equality
+ * @param hashfunc User-specified hash, consistent with the comparison function
+ * @param data_dealloc_func Function handed the data of every removed node (may be NULL)
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_dlist_dedupe(jll_dlist_t * dlist, data_hashfunc_t hashfunc, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(DLIST_DEDUPE);
+    assert(dlist);
+    assert(hashfunc);
+    assert(dlist->dlist_comp_func);
+    JLL_PROF_OP(dlist);
+    __jll_dlist_settle(dlist);
+
+    if (dlist->length < 2) return 0;
+
+    unsigned bits = 1;
+    while (((size_t)1 << bits) < 2 * dlist->length) bits++;
+
+    size_t mask = ((size_t)1 << bits) - 1;
+    const jll_data_t ** table = (const jll_data_t **)calloc(mask + 1, sizeof(jll_data_t *));
+
+    dlist->tail->next = NULL;
+
+    size_t removed = 0;
+    jll_dnode_t * prev = NULL;
+    jll_dnode_t * rover = dlist->head;
+
+    while (rover)
+    {
+        jll_dnode_t * next = rover->next;
+
+        // Fibonacci hashing spreads weak user hashes over the table.
+        size_t slot = (size_t)(((unsigned long long)hashfunc(rover->data) * 0x9e3779b97f4a7c15ULL) >> (64 - bits));
+        bool duplicate = false;
+
+        while (table[slot])
+        {
+            JLL_PROF_CMP(dlist);
+            if (dlist->dlist_comp_func(table[slot], rover->data) == 0)
+            {
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+
+        if (duplicate)
+        {
+            // The first node is never a duplicate, so prev is set.
+            prev->next = next;
+            if (next) next->prev = prev;
+            if (rover == dlist->tail) dlist->tail = prev;
+
+            __jll_dlist_drop_node(dlist, rover, data_dealloc_func);
+            __jll_dlist_note_remove(dlist);
+            removed++;
+        }
+        else
+        {
+            table[slot] = rover->data;
+            prev = rover;
+        }
+
+        rover = next;
+        JLL_PROF_HOP(dlist);
+    }
+
+    free(table);
+
+    dlist->length -= removed;
+    __jll_dlist_fix_ends(dlist);
+
+    return removed;
+}
@@ -0,0 +1,184 @@
+
+# include <stdlib.h>
+# include <assert.h>
+# include "./include/dnode.h"
+# include "./include/memstat.h"
+
+
+/**
+ * @brief Allocate a doubly-linked list node
+ * 
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node
+ */
+jll_dnode_t * jll_alloc_dnode(const jll_data_t * dptr)
+{
+    jll_dnode_t * new_dnode = (jll_dnode_t *)malloc(sizeof(jll_dnode_t));
+
+    new_dnode->next = NULL;
+    new_dnode->prev = NULL;
+    new_dnode->data = dptr;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_dnode_t));
+
+    return new_dnode;
+}
+
+/**
+ * @brief Allocate a doubly-linked list node from a node pool
+ * 
+ * @param pool Pool to allocate from; the pool's node size must be at least sizeof(jll_dnode_t)
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node
+ */
+jll_dnode_t * jll_alloc_dnode_from(jll_pool_t * pool, const jll_data_t * dptr)
+{
+    assert(pool);
+    assert(pool->node_size >= sizeof(jll_dnode_t));
+
+    jll_dnode_t * new_dnode = (jll_dnode_t *)jll_pool_get(pool);
+
+    new_dnode->next = NULL;
+    new_dnode->prev = NULL;
+    new_dnode->data = dptr;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_dnode_t));
+
+    return new_dnode;
+}
+
+/**
+ * @brief Deallocate a doubly-linked list node
+ * 
+ * @param dnode Node to be deallocated; pool nodes are returned to the pool they came from
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_dnode(jll_dnode_t * dnode)
+{
+    assert(dnode);
+
+    const jll_data_t * retdata = dnode->data;
+    if (!jll_pool_release(dnode)) free(dnode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_dnode_t));
+
+    return retdata;
+}
+
+/**
+ * @brief Deallocate a doubly-linked list node whose origin is known, without looking its owner up
+ * 
+ * @param pool  Pool the node came from, or NULL if it came from the heap
+ * @param dnode Node to be deallocated
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_dnode_to(jll_pool_t * pool, jll_dnode_t * dnode)
+{
+    assert(dnode);
+
+    const jll_data_t * retdata = dnode->data;
+    if (pool) jll_pool_put(pool, dnode);
+    else free(dnode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_dnode_t));
+
+    return retdata;
+}
+
+/**
+ * @brief Allocate a keyed doubly-linked list node, as used by lists which cache sort keys or access counts
+ * 
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node, with a zero key and count
+ */
+jll_dknode_t * jll_alloc_dknode(const jll_data_t * dptr)
+{
+    jll_dknode_t * new_dknode = (jll_dknode_t *)malloc(sizeof(jll_dknode_t));
+
+    new_dknode->node.next = NULL;
+    new_dknode->node.prev = NULL;
+    new_dknode->node.data = dptr;
+    new_dknode->key = 0;
+    new_dknode->freq = 0;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_dknode_t));
+
+    return new_dknode;
+}
+
+/**
+ * @brief Allocate a keyed doubly-linked list node from a node pool
+ * 
+ * @param pool Pool to allocate from; the pool's node size must be at least sizeof(jll_dknode_t)
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node, with a zero key and count
+ */
+jll_dknode_t * jll_alloc_dknode_from(jll_pool_t * pool, const jll_data_t * dptr)
+{
+    assert(pool);
+    assert(pool->node_size >= sizeof(jll_dknode_t));
+
+    jll_dknode_t * new_dknode = (jll_dknode_t *)jll_pool_get(pool);
+
+    new_dknode->node.next = NULL;
+    new_dknode->node.prev = NULL;
+    new_dknode->node.data = dptr;
+    new_dknode->key = 0;
+    new_dknode->freq = 0;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_dknode_t));
+
+    return new_dknode;
+}
+
+/**
+ * @brief Deallocate a keyed doubly-linked list node
+ * 
+ * @param dknode Node to be deallocated; pool nodes are returned to the pool they came from
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_dknode(jll_dknode_t * dknode)
+{
+    assert(dknode);
+
+    const jll_data_t * retdata = dknode->node.data;
+    if (!jll_pool_release(dknode)) free(dknode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_dknode_t));
+
+    return retdata;
+}
+
+/**
+ * @brief Deallocate a keyed doubly-linked list node whose origin is known, without looking its owner up
+ * 
+ * @param pool   Pool the node came from, or NULL if it came from the heap
+ * @param dknode Node to be deallocated
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_dknode_to(jll_pool_t * pool, jll_dknode_t * dknode)
+{
+    assert(dknode);
+
+    const jll_data_t * retdata = dknode->node.data;
+    if (pool) jll_pool_put(pool, dknode);
+    else free(dknode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_dknode_t));
+
+    return retdata;
+}
+
+const jll_data_t * jll_access_dnode(const jll_dnode_t * dnode)
+{
+    assert(dnode);
+    return dnode->data;
+}
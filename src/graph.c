@@ -0,0 +1,554 @@
+
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include "./include/graph.h"
+
+# define JLL_GRAPH_MIN_CAPACITY 16
+# define JLL_GRAPH_POOL_BLOCK 1024
+
+
+/* internal helpers */
+
+/* Adjacency lists hold target vertices rather than data pointers; the offset keeps vertex 0 non-NULL. */
+
+static const jll_data_t * __jll_graph_encode(jll_vertex_t vertex)
+{
+    return (const jll_data_t *)((uintptr_t)vertex + 1);
+}
+
+static jll_vertex_t __jll_graph_decode(const jll_data_t * dptr)
+{
+    return (jll_vertex_t)((uintptr_t)dptr - 1);
+}
+
+/**
+ * @brief Number of a vertex's out-edges still held in the packed arrays
+ */
+static size_t __jll_graph_row_length(const jll_graph_t * graph, jll_vertex_t vertex)
+{
+    if ((vertex >= graph->csr_vertices) || (graph->thawed[vertex])) return 0;
+    return graph->offsets[vertex + 1] - graph->offsets[vertex];
+}
+
+/**
+ * @brief Returns the adjacency list of a vertex, ready for edits; all lists allocate from the graph's pool
+ */
+static jll_slist_t * __jll_graph_delta(jll_graph_t * graph, jll_vertex_t vertex)
+{
+    if (!graph->pool) graph->pool = jll_alloc_pool(sizeof(jll_snode_t), JLL_GRAPH_POOL_BLOCK, false);
+
+    jll_slist_t * list = &graph->adjacency[vertex];
+    list->pool = graph->pool;
+    list->pool_shared = true;
+
+    return list;
+}
+
+/**
+ * @brief Copies a vertex's row out of the packed arrays into the front of its adjacency list
+ */
+static void __jll_graph_thaw(jll_graph_t * graph, jll_vertex_t vertex)
+{
+    size_t length = __jll_graph_row_length(graph, vertex);
+    if (vertex < graph->csr_vertices) graph->thawed[vertex] = true;
+    if (length == 0) return;
+
+    jll_slist_t * list = __jll_graph_delta(graph, vertex);
+    for (size_t k = graph->offsets[vertex + 1]; k > graph->offsets[vertex]; k--)
+    {
+        jll_slist_append_head(list, __jll_graph_encode(graph->targets[k - 1]));
+    }
+}
+
+/**
+ * @brief Empties every adjacency list. All their nodes came from the graph's pool, so the pool is
+ * dropped in one go instead of node by node.
+ */
+static void __jll_graph_release_delta(jll_graph_t * graph)
+{
+    if (!graph->pool) return;
+
+    size_t live = 0;
+    for (size_t v = 0; v < graph->vertices; v++)
+    {
+        live += graph->adjacency[v].length;
+        jll_init_slist(&graph->adjacency[v], NULL, false, false, false);
+    }
+
+    JLL_MEM_SUB(JLL_MEM_NODES, live * sizeof(jll_snode_t));
+    jll_pool_discard(graph->pool);
+    graph->pool = NULL;
+}
+
+static void __jll_graph_free_csr(jll_graph_t * graph)
+{
+    if (!graph->offsets) return;
+
+    JLL_MEM_SUB(JLL_MEM_NODES, (graph->csr_vertices + 1) * sizeof(size_t) + graph->offsets[graph->csr_vertices] * sizeof(jll_vertex_t));
+    free(graph->offsets);
+    free(graph->targets);
+
+    graph->offsets = NULL;
+    graph->targets = NULL;
+    graph->csr_vertices = 0;
+}
+
+static bool __jll_graph_test_and_set(uint64_t * bits, jll_vertex_t vertex)
+{
+    uint64_t mask = 1ULL << (vertex & 63);
+    bool seen = (bits[vertex >> 6] & mask) != 0;
+
+    bits[vertex >> 6] |= mask;
+    return seen;
+}
+
+static uint64_t * __jll_graph_alloc_bits(const jll_graph_t * graph)
+{
+    return (uint64_t *)calloc((graph->vertices + 63) / 64 + 1, sizeof(uint64_t));
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Allocate an unfrozen directed graph without edges
+ *
+ * @param vertices Initial number of vertices, numbered from 0
+ *
+ * @returns Pointer to the newly created graph
+ */
+jll_graph_t * jll_alloc_graph(size_t vertices)
+{
+    JLL_LAT_SCOPE(GRAPH_ALLOC);
+    assert(vertices < JLL_GRAPH_NO_VERTEX);
+
+    jll_graph_t * new_graph = (jll_graph_t *)malloc(sizeof(jll_graph_t));
+
+    new_graph->vertices = vertices;
+    new_graph->edges = 0;
+    new_graph->capacity = (vertices > JLL_GRAPH_MIN_CAPACITY) ? vertices : JLL_GRAPH_MIN_CAPACITY;
+
+    new_graph->adjacency = (jll_slist_t *)malloc(new_graph->capacity * sizeof(jll_slist_t));
+    new_graph->thawed = (bool *)calloc(new_graph->capacity, sizeof(bool));
+    new_graph->pool = NULL;
+
+    for (size_t v = 0; v < vertices; v++) jll_init_slist(&new_graph->adjacency[v], NULL, false, false, false);
+
+    new_graph->frozen = false;
+    new_graph->csr_vertices = 0;
+    new_graph->offsets = NULL;
+    new_graph->targets = NULL;
+
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_graph_t) + new_graph->capacity * (sizeof(jll_slist_t) + sizeof(bool)));
+
+    return new_graph;
+}
+
+void jll_dealloc_graph(jll_graph_t * graph)
+{
+    JLL_LAT_SCOPE(GRAPH_DEALLOC);
+    assert(graph);
+
+    __jll_graph_release_delta(graph);
+    __jll_graph_free_csr(graph);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_graph_t) + graph->capacity * (sizeof(jll_slist_t) + sizeof(bool)));
+
+    free(graph->adjacency);
+    free(graph->thawed);
+    free(graph);
+}
+
+
+/* editing */
+
+/**
+ * @brief Adds a vertex without edges. The adjacency lists are moved when the vertex array grows,
+ * which is safe because a list holds no pointers into itself.
+ *
+ * @returns The new vertex
+ */
+jll_vertex_t jll_graph_add_vertex(jll_graph_t * graph)
+{
+    assert(graph);
+    assert(!graph->frozen);
+    assert(graph->vertices + 1 < JLL_GRAPH_NO_VERTEX);
+
+    if (graph->vertices == graph->capacity)
+    {
+        size_t capacity = graph->capacity * 2;
+
+        graph->adjacency = (jll_slist_t *)realloc(graph->adjacency, capacity * sizeof(jll_slist_t));
+        graph->thawed = (bool *)realloc(graph->thawed, capacity * sizeof(bool));
+        memset(&graph->thawed[graph->capacity], 0, (capacity - graph->capacity) * sizeof(bool));
+
+        JLL_MEM_ADD(JLL_MEM_HEADERS, (capacity - graph->capacity) * (sizeof(jll_slist_t) + sizeof(bool)));
+        graph->capacity = capacity;
+    }
+
+    jll_init_slist(&graph->adjacency[graph->vertices], NULL, false, false, false);
+    return (jll_vertex_t)graph->vertices++;
+}
+
+/**
+ * @brief Adds a directed edge in constant time; parallel edges and self-loops are allowed
+ *
+ * @param graph Pointer to an unfrozen graph
+ * @param from  Source vertex
+ * @param to    Target vertex
+ *
+ * @returns None (is void)
+ */
+void jll_graph_add_edge(jll_graph_t * graph, jll_vertex_t from, jll_vertex_t to)
+{
+    JLL_LAT_SCOPE(GRAPH_ADD_EDGE);
+    assert(graph);
+    assert(!graph->frozen);
+    assert((from < graph->vertices) && (to < graph->vertices));
+
+    jll_slist_append_tail(__jll_graph_delta(graph, from), __jll_graph_encode(to));
+    graph->edges++;
+}
+
+/**
+ * @brief Removes one edge from one vertex to another. A row still held in the packed arrays is thawed
+ * into its adjacency list first, which costs time proportional to the vertex's out-degree.
+ *
+ * @param graph Pointer to an unfrozen graph
+ * @param from  Source vertex
+ * @param to    Target vertex
+ *
+ * @returns True if an edge was removed, false if there was none
+ */
+bool jll_graph_remove_edge(jll_graph_t * graph, jll_vertex_t from, jll_vertex_t to)
+{
+    JLL_LAT_SCOPE(GRAPH_REMOVE_EDGE);
+    assert(graph);
+    assert(!graph->frozen);
+    assert((from < graph->vertices) && (to < graph->vertices));
+
+    __jll_graph_thaw(graph, from);
+
+    jll_slist_t * list = &graph->adjacency[from];
+    const jll_data_t * target = __jll_graph_encode(to);
+    jll_snode_t * rover = list->head;
+
+    for (size_t k = 0; k < list->length; k++)
+    {
+        if (rover->data == target)
+        {
+            jll_slist_remove_index(list, k);
+            graph->edges--;
+            return true;
+        }
+
+        rover = rover->next;
+    }
+
+    return false;
+}
+
+
+/* representation */
+
+/**
+ * @brief Packs every edge into compressed sparse row arrays and empties the adjacency lists. Each row
+ * keeps its edges in insertion order: the edges packed by the previous freeze, then those added since.
+ *
+ * @param graph Pointer to an unfrozen graph
+ *
+ * @returns None (is void)
+ */
+void jll_graph_freeze(jll_graph_t * graph)
+{
+    JLL_LAT_SCOPE(GRAPH_FREEZE);
+    assert(graph);
+    assert(!graph->frozen);
+
+    size_t vertices = graph->vertices;
+    size_t * offsets = (size_t *)malloc((vertices + 1) * sizeof(size_t));
+    jll_vertex_t * targets = (jll_vertex_t *)malloc((graph->edges + 1) * sizeof(jll_vertex_t));
+
+    offsets[0] = 0;
+    for (size_t v = 0; v < vertices; v++)
+    {
+        offsets[v + 1] = offsets[v] + __jll_graph_row_length(graph, (jll_vertex_t)v) + graph->adjacency[v].length;
+    }
+
+    assert(offsets[vertices] == graph->edges);
+
+    for (size_t v = 0; v < vertices; v++)
+    {
+        size_t position = offsets[v];
+        size_t length = __jll_graph_row_length(graph, (jll_vertex_t)v);
+
+        if (length) memcpy(&targets[position], &graph->targets[graph->offsets[v]], length * sizeof(jll_vertex_t));
+        position += length;
+
+        jll_snode_t * rover = graph->adjacency[v].head;
+        for (size_t k = 0; k < graph->adjacency[v].length; k++)
+        {
+            targets[position++] = __jll_graph_decode(rover->data);
+            rover = rover->next;
+        }
+    }
+
+    __jll_graph_free_csr(graph);
+    __jll_graph_release_delta(graph);
+
+    graph->offsets = offsets;
+    graph->targets = targets;
+    graph->csr_vertices = vertices;
+    memset(graph->thawed, 0, vertices * sizeof(bool));
+
+    JLL_MEM_ADD(JLL_MEM_NODES, (vertices + 1) * sizeof(size_t) + graph->edges * sizeof(jll_vertex_t));
+
+    graph->frozen = true;
+}
+
+/**
+ * @brief Makes a frozen graph editable again in constant time; the packed arrays are kept and only
+ * the rows which lose an edge are copied out of them
+ */
+void jll_graph_unfreeze(jll_graph_t * graph)
+{
+    assert(graph);
+    assert(graph->frozen);
+
+    graph->frozen = false;
+}
+
+bool jll_graph_is_frozen(const jll_graph_t * graph)
+{
+    assert(graph);
+    return graph->frozen;
+}
+
+
+/* access functions */
+
+size_t jll_graph_vertices(const jll_graph_t * graph)
+{
+    assert(graph);
+    return graph->vertices;
+}
+
+size_t jll_graph_edges(const jll_graph_t * graph)
+{
+    assert(graph);
+    return graph->edges;
+}
+
+size_t jll_graph_out_degree(const jll_graph_t * graph, jll_vertex_t vertex)
+{
+    assert(graph);
+    assert(vertex < graph->vertices);
+
+    return __jll_graph_row_length(graph, vertex) + graph->adjacency[vertex].length;
+}
+
+bool jll_graph_has_edge(const jll_graph_t * graph, jll_vertex_t from, jll_vertex_t to)
+{
+    assert(graph);
+    assert((from < graph->vertices) && (to < graph->vertices));
+
+    size_t length = __jll_graph_row_length(graph, from);
+    for (size_t k = 0; k < length; k++)
+    {
+        if (graph->targets[graph->offsets[from] + k] == to) return true;
+    }
+
+    const jll_data_t * target = __jll_graph_encode(to);
+    const jll_snode_t * rover = graph->adjacency[from].head;
+
+    for (size_t k = 0; k < graph->adjacency[from].length; k++)
+    {
+        if (rover->data == target) return true;
+        rover = rover->next;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Gives direct access to a vertex's packed row
+ *
+ * @param graph  Pointer to a frozen graph
+ * @param vertex Source vertex
+ * @param degree Receives the number of out-edges
+ *
+ * @returns Pointer to the targets of the vertex's out-edges, valid until the graph is next frozen or deallocated
+ */
+const jll_vertex_t * jll_graph_neighbours(const jll_graph_t * graph, jll_vertex_t vertex, size_t * degree)
+{
+    assert(graph);
+    assert(graph->frozen);
+    assert(vertex < graph->vertices);
+    assert(degree);
+
+    *degree = graph->offsets[vertex + 1] - graph->offsets[vertex];
+    return &graph->targets[graph->offsets[vertex]];
+}
+
+
+/* traversals */
+
+/**
+ * @brief Breadth-first search. The output array doubles as the queue, so the traversal reads the
+ * packed rows and writes the order sequentially, with a bitmap marking visited vertices.
+ *
+ * @param graph  Pointer to a frozen graph
+ * @param source Vertex the search starts from
+ * @param order  Caller-provided array of at least jll_graph_vertices entries, receiving the visit order
+ * @param depth  Caller-provided array of jll_graph_vertices entries receiving each vertex's distance in
+ *               edges from the source, UINT32_MAX if unreachable (may be NULL)
+ *
+ * @returns Number of vertices reached
+ */
+size_t jll_graph_bfs(const jll_graph_t * graph, jll_vertex_t source, jll_vertex_t * order, uint32_t * depth)
+{
+    JLL_LAT_SCOPE(GRAPH_BFS);
+    assert(graph);
+    assert(graph->frozen);
+    assert(source < graph->vertices);
+    assert(order);
+
+    uint64_t * seen = __jll_graph_alloc_bits(graph);
+
+    if (depth)
+    {
+        for (size_t v = 0; v < graph->vertices; v++) depth[v] = UINT32_MAX;
+        depth[source] = 0;
+    }
+
+    size_t head = 0;
+    size_t tail = 0;
+
+    __jll_graph_test_and_set(seen, source);
+    order[tail++] = source;
+
+    while (head < tail)
+    {
+        jll_vertex_t vertex = order[head++];
+
+        for (size_t e = graph->offsets[vertex]; e < graph->offsets[vertex + 1]; e++)
+        {
+            jll_vertex_t next = graph->targets[e];
+            if (__jll_graph_test_and_set(seen, next)) continue;
+
+            order[tail++] = next;
+            if (depth) depth[next] = depth[vertex] + 1;
+        }
+    }
+
+    free(seen);
+    return tail;
+}
+
+/**
+ * @brief Depth-first search reporting vertices in preorder. The recursion is replaced by an explicit
+ * stack holding, per vertex, the position reached in its packed row.
+ *
+ * @param graph  Pointer to a frozen graph
+ * @param source Vertex the search starts from
+ * @param order  Caller-provided array of at least jll_graph_vertices entries, receiving the visit order
+ *
+ * @returns Number of vertices reached
+ */
+size_t jll_graph_dfs(const jll_graph_t * graph, jll_vertex_t source, jll_vertex_t * order)
+{
+    JLL_LAT_SCOPE(GRAPH_DFS);
+    assert(graph);
+    assert(graph->frozen);
+    assert(source < graph->vertices);
+    assert(order);
+
+    uint64_t * seen = __jll_graph_alloc_bits(graph);
+    jll_vertex_t * stack = (jll_vertex_t *)malloc(graph->vertices * sizeof(jll_vertex_t));
+    size_t * cursor = (size_t *)malloc(graph->vertices * sizeof(size_t));
+
+    size_t count = 0;
+    size_t top = 0;
+
+    __jll_graph_test_and_set(seen, source);
+    order[count++] = source;
+    stack[top++] = source;
+    cursor[source] = graph->offsets[source];
+
+    while (top)
+    {
+        jll_vertex_t vertex = stack[top - 1];
+
+        if (cursor[vertex] == graph->offsets[vertex + 1])
+        {
+            top--;
+            continue;
+        }
+
+        jll_vertex_t next = graph->targets[cursor[vertex]++];
+        if (__jll_graph_test_and_set(seen, next)) continue;
+
+        order[count++] = next;
+        stack[top++] = next;
+        cursor[next] = graph->offsets[next];
+    }
+
+    free(cursor);
+    free(stack);
+    free(seen);
+    return count;
+}
+
+/**
+ * @brief Orders the vertices so that every edge points forward (Kahn's algorithm); the output array
+ * doubles as the queue of vertices whose in-edges have all been counted off
+ *
+ * @param graph Pointer to a frozen graph
+ * @param order Caller-provided array of at least jll_graph_vertices entries
+ *
+ * @returns True if the graph is acyclic and order holds every vertex, false if it has a cycle
+ */
+bool jll_graph_topological_sort(const jll_graph_t * graph, jll_vertex_t * order)
+{
+    JLL_LAT_SCOPE(GRAPH_TOPOLOGICAL_SORT);
+    assert(graph);
+    assert(graph->frozen);
+    assert(order || (graph->vertices == 0));
+
+    size_t * indegree = (size_t *)calloc(graph->vertices + 1, sizeof(size_t));
+    for (size_t e = 0; e < graph->edges; e++) indegree[graph->targets[e]]++;
+
+    size_t head = 0;
+    size_t tail = 0;
+
+    for (size_t v = 0; v < graph->vertices; v++)
+    {
+        if (indegree[v] == 0) order[tail++] = (jll_vertex_t)v;
+    }
+
+    while (head < tail)
+    {
+        jll_vertex_t vertex = order[head++];
+
+        for (size_t e = graph->offsets[vertex]; e < graph->offsets[vertex + 1]; e++)
+        {
+            if (--indegree[graph->targets[e]] == 0) order[tail++] = graph->targets[e];
+        }
+    }
+
+    free(indegree);
+    return (tail == graph->vertices);
+}
+
+bool jll_graph_has_cycle(const jll_graph_t * graph)
+{
+    JLL_LAT_SCOPE(GRAPH_HAS_CYCLE);
+    assert(graph);
+
+    jll_vertex_t * order = (jll_vertex_t *)malloc((graph->vertices + 1) * sizeof(jll_vertex_t));
+    bool acyclic = jll_graph_topological_sort(graph, order);
+
+    free(order);
+    return !acyclic;
+}
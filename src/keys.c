@@ -0,0 +1,269 @@
+
+# include <assert.h>
+# include "./include/keys.h"
+
+# if defined(__x86_64__) || defined(__i386__)
+#   define JLL_KEYS_X86
+#   include <immintrin.h>
+# endif
+
+/* Sorted blocks are bisected down to this many keys, which are then counted with the vector kernel */
+# define JLL_KEYS_LINEAR_WINDOW 32
+
+
+/* scalar kernels */
+
+/**
+ * @brief Counts the keys of a block which are less than key
+ */
+static size_t __jll_keys_count_less_scalar(const uint64_t * keys, size_t n, uint64_t key)
+{
+    size_t count = 0;
+    for (size_t k = 0; k < n; k++) count += (keys[k] < key);
+
+    return count;
+}
+
+/**
+ * @brief Returns the index of the first key equal to key, or n if there is none
+ */
+static size_t __jll_keys_find_scalar(const uint64_t * keys, size_t n, uint64_t key)
+{
+    for (size_t k = 0; k < n; k++)
+    {
+        if (keys[k] == key) return k;
+    }
+
+    return n;
+}
+
+
+# ifdef JLL_KEYS_X86
+
+/* vector kernels; the sign bit is flipped on both sides so the signed 64-bit compares order keys as unsigned */
+
+# define JLL_KEYS_SIGN 0x8000000000000000ULL
+
+__attribute__((target("sse4.2")))
+static size_t __jll_keys_count_less_sse42(const uint64_t * keys, size_t n, uint64_t key)
+{
+    const __m128i sign = _mm_set1_epi64x((long long)JLL_KEYS_SIGN);
+    const __m128i bound = _mm_set1_epi64x((long long)(key ^ JLL_KEYS_SIGN));
+
+    size_t count = 0;
+    size_t k = 0;
+
+    for (; k + 2 <= n; k += 2)
+    {
+        __m128i block = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&keys[k]), sign);
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(bound, block)));
+        count += (size_t)__builtin_popcount((unsigned)mask);
+    }
+
+    return count + __jll_keys_count_less_scalar(&keys[k], n - k, key);
+}
+
+__attribute__((target("sse4.2")))
+static size_t __jll_keys_find_sse42(const uint64_t * keys, size_t n, uint64_t key)
+{
+    const __m128i probe = _mm_set1_epi64x((long long)key);
+    size_t k = 0;
+
+    for (; k + 2 <= n; k += 2)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)&keys[k]);
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(probe, block)));
+        if (mask) return k + (size_t)__builtin_ctz((unsigned)mask);
+    }
+
+    return k + __jll_keys_find_scalar(&keys[k], n - k, key);
+}
+
+__attribute__((target("avx2")))
+static size_t __jll_keys_count_less_avx2(const uint64_t * keys, size_t n, uint64_t key)
+{
+    const __m256i sign = _mm256_set1_epi64x((long long)JLL_KEYS_SIGN);
+    const __m256i bound = _mm256_set1_epi64x((long long)(key ^ JLL_KEYS_SIGN));
+
+    size_t count = 0;
+    size_t k = 0;
+
+    for (; k + 4 <= n; k += 4)
+    {
+        __m256i block = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&keys[k]), sign);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(bound, block)));
+        count += (size_t)__builtin_popcount((unsigned)mask);
+    }
+
+    return count + __jll_keys_count_less_scalar(&keys[k], n - k, key);
+}
+
+__attribute__((target("avx2")))
+static size_t __jll_keys_find_avx2(const uint64_t * keys, size_t n, uint64_t key)
+{
+    const __m256i probe = _mm256_set1_epi64x((long long)key);
+    size_t k = 0;
+
+    for (; k + 4 <= n; k += 4)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)&keys[k]);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(probe, block)));
+        if (mask) return k + (size_t)__builtin_ctz((unsigned)mask);
+    }
+
+    return k + __jll_keys_find_scalar(&keys[k], n - k, key);
+}
+
+# endif
+
+
+/* kernel dispatch */
+
+typedef struct jll_keys_kernels_type
+{
+    size_t (*count_less)(const uint64_t *, size_t, uint64_t);
+    size_t (*find)(const uint64_t *, size_t, uint64_t);
+
+} jll_keys_kernels_t;
+
+static const jll_keys_kernels_t __jll_keys_kernels[JLL_KEYS_ISA_COUNT] =
+{
+    { __jll_keys_count_less_scalar, __jll_keys_find_scalar },
+# ifdef JLL_KEYS_X86
+    { __jll_keys_count_less_sse42,  __jll_keys_find_sse42 },
+    { __jll_keys_count_less_avx2,   __jll_keys_find_avx2 },
+# else
+    { __jll_keys_count_less_scalar, __jll_keys_find_scalar },
+    { __jll_keys_count_less_scalar, __jll_keys_find_scalar },
+# endif
+};
+
+/* JLL_KEYS_ISA_COUNT until the first search resolves it; a race only repeats the same detection */
+static int __jll_keys_active = JLL_KEYS_ISA_COUNT;
+
+static bool __jll_keys_supported(jll_keys_isa_t isa)
+{
+    switch (isa)
+    {
+        case JLL_KEYS_SCALAR:
+            return true;
+# ifdef JLL_KEYS_X86
+        case JLL_KEYS_SSE42:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.2");
+        case JLL_KEYS_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+# endif
+        default:
+            return false;
+    }
+}
+
+static const jll_keys_kernels_t * __jll_keys_resolve(void)
+{
+    int active = __atomic_load_n(&__jll_keys_active, __ATOMIC_RELAXED);
+
+    if (active == JLL_KEYS_ISA_COUNT)
+    {
+        active = JLL_KEYS_AVX2;
+        while (!__jll_keys_supported((jll_keys_isa_t)active)) active--;
+
+        __atomic_store_n(&__jll_keys_active, active, __ATOMIC_RELAXED);
+    }
+
+    return &__jll_keys_kernels[active];
+}
+
+
+/* search kernels */
+
+/**
+ * @brief Finds a key in an unordered block of keys
+ *
+ * @param keys Contiguous block of keys
+ * @param n    Number of keys in the block
+ * @param key  Key to look for
+ *
+ * @returns Index of the first equal key, or n if the block does not hold it
+ */
+size_t jll_keys_find(const uint64_t * keys, size_t n, uint64_t key)
+{
+    assert(keys || (n == 0));
+    return __jll_keys_resolve()->find(keys, n, key);
+}
+
+/**
+ * @brief Finds where a key belongs in an ascending block of keys. Long blocks are bisected down to a
+ * short window, which the vector kernel counts without branching on the keys.
+ *
+ * @param keys Contiguous block of keys in ascending order
+ * @param n    Number of keys in the block
+ * @param key  Key to look for
+ *
+ * @returns Index of the first key which is not less than key (n if every key is)
+ */
+size_t jll_keys_lower_bound(const uint64_t * keys, size_t n, uint64_t key)
+{
+    assert(keys || (n == 0));
+
+    size_t lo = 0;
+
+    while (n > JLL_KEYS_LINEAR_WINDOW)
+    {
+        size_t half = n / 2;
+
+        if (keys[lo + half] < key)
+        {
+            lo += half + 1;
+            n -= half + 1;
+        }
+        else n = half;
+    }
+
+    return lo + __jll_keys_resolve()->count_less(&keys[lo], n, key);
+}
+
+/**
+ * @brief Finds the end of the run of keys equal to key in an ascending block of keys
+ *
+ * @returns Index of the first key greater than key (n if there is none)
+ */
+size_t jll_keys_upper_bound(const uint64_t * keys, size_t n, uint64_t key)
+{
+    if (key == UINT64_MAX) return n;
+    return jll_keys_lower_bound(keys, n, key + 1);
+}
+
+
+/* kernel dispatch */
+
+jll_keys_isa_t jll_keys_get_isa(void)
+{
+    return (jll_keys_isa_t)(__jll_keys_resolve() - __jll_keys_kernels);
+}
+
+/**
+ * @brief Forces the search kernels onto an instruction set, e.g. to compare kernels on one machine
+ *
+ * @param isa Instruction set to use
+ *
+ * @returns False (leaving the kernels unchanged) if the CPU does not support it
+ */
+bool jll_keys_set_isa(jll_keys_isa_t isa)
+{
+    assert(isa < JLL_KEYS_ISA_COUNT);
+
+    if (!__jll_keys_supported(isa)) return false;
+
+    __atomic_store_n(&__jll_keys_active, (int)isa, __ATOMIC_RELAXED);
+    return true;
+}
+
+const char * jll_keys_isa_name(jll_keys_isa_t isa)
+{
+    static const char * const names[JLL_KEYS_ISA_COUNT] = { "scalar", "sse4.2", "avx2" };
+
+    assert(isa < JLL_KEYS_ISA_COUNT);
+    return names[isa];
+}
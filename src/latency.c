@@ -0,0 +1,392 @@
+
+# include <stdlib.h>
+# include <stdio.h>
+# include <string.h>
+# include <assert.h>
+# include <time.h>
+# include <pthread.h>
+# include "./include/latency.h"
+
+# if defined(JLL_LATENCY_USE_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+#   include <x86intrin.h>
+#   define JLL_LATENCY_TSC 1
+# endif
+
+# define JLL_LATENCY_NAME_ENTRY(name, label) label,
+
+static const char * jll_latency_op_names[JLL_LAT_OP_COUNT] = { JLL_LATENCY_OPS(JLL_LATENCY_NAME_ENTRY) };
+
+# define JLL_LATENCY_DISABLED_RECHECK 65536
+
+
+/* histograms */
+
+static size_t __jll_latency_bucket(uint64_t value)
+{
+    if (value < (1ULL << JLL_LATENCY_SUB_BITS)) return (size_t)value;
+
+    unsigned msb = 63 - (unsigned)__builtin_clzll(value);
+    if (msb >= JLL_LATENCY_MAX_BITS) return JLL_LATENCY_BUCKETS - 1;
+
+    unsigned shift = msb - JLL_LATENCY_SUB_BITS;
+    size_t sub = (size_t)(value >> shift) & ((1u << JLL_LATENCY_SUB_BITS) - 1);
+
+    return ((size_t)(shift + 1) << JLL_LATENCY_SUB_BITS) + sub;
+}
+
+/**
+ * @brief Highest value which maps to a bucket
+ */
+static uint64_t __jll_latency_bucket_upper(size_t index)
+{
+    if (index < (1u << JLL_LATENCY_SUB_BITS)) return (uint64_t)index;
+
+    unsigned shift = (unsigned)(index >> JLL_LATENCY_SUB_BITS) - 1;
+    uint64_t sub = (uint64_t)(index & ((1u << JLL_LATENCY_SUB_BITS) - 1));
+
+    return (((1ULL << JLL_LATENCY_SUB_BITS) + sub + 1) << shift) - 1;
+}
+
+static void __jll_latency_bump(uint64_t * counter, uint64_t value)
+{
+    // Each histogram has a single writing thread; relaxed load/store keeps concurrent snapshots well-defined.
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+void jll_latency_hist_record(jll_latency_hist_t * hist, uint64_t value)
+{
+    assert(hist);
+
+    __jll_latency_bump(&hist->count, 1);
+    __jll_latency_bump(&hist->sum, value);
+    __jll_latency_bump(&hist->buckets[__jll_latency_bucket(value)], 1);
+
+    if ((hist->count == 1) || (value < hist->min)) __atomic_store_n(&hist->min, value, __ATOMIC_RELAXED);
+    if (value > hist->max) __atomic_store_n(&hist->max, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Adds the samples of one histogram into another (e.g. per-thread histograms into a process view)
+ */
+void jll_latency_hist_merge(jll_latency_hist_t * dst, const jll_latency_hist_t * src)
+{
+    assert(dst);
+    assert(src);
+
+    uint64_t count = __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+    if (count == 0) return;
+
+    uint64_t min = __atomic_load_n(&src->min, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+
+    if ((dst->count == 0) || (min < dst->min)) dst->min = min;
+    if (max > dst->max) dst->max = max;
+
+    dst->count += count;
+    dst->sum += __atomic_load_n(&src->sum, __ATOMIC_RELAXED);
+
+    for (size_t k = 0; k < JLL_LATENCY_BUCKETS; k++) dst->buckets[k] += __atomic_load_n(&src->buckets[k], __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Estimates a percentile from a histogram
+ * 
+ * @param hist Histogram to be queried
+ * @param q    Quantile in [0, 1], e.g. 0.999 for p999
+ * 
+ * @returns Upper bound of the bucket holding the quantile (clamped to the observed max), or 0 if empty
+ */
+uint64_t jll_latency_hist_percentile(const jll_latency_hist_t * hist, double q)
+{
+    assert(hist);
+    if (hist->count == 0) return 0;
+
+    uint64_t rank = (uint64_t)(q * (double)hist->count);
+    if (rank >= hist->count) rank = hist->count - 1;
+
+    uint64_t seen = 0;
+    for (size_t k = 0; k < JLL_LATENCY_BUCKETS; k++)
+    {
+        seen += hist->buckets[k];
+        if (seen > rank)
+        {
+            uint64_t upper = __jll_latency_bucket_upper(k);
+            return (upper > hist->max) ? hist->max : upper;
+        }
+    }
+
+    return hist->max;
+}
+
+
+/* per-thread recording */
+
+typedef struct jll_latency_thread_type
+{
+    jll_latency_snapshot_t hists;
+
+    struct jll_latency_thread_type * next;
+    struct jll_latency_thread_type * prev;
+
+} jll_latency_thread_t;
+
+static pthread_mutex_t jll_latency_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static jll_latency_thread_t * jll_latency_threads = NULL;
+static jll_latency_snapshot_t jll_latency_retired;
+static uint32_t jll_latency_sample_every = 1;
+
+
+
+
+# ifdef JLL_ENABLE_LATENCY
+
+static pthread_once_t jll_latency_once = PTHREAD_ONCE_INIT;
+static pthread_key_t jll_latency_key;
+
+_Thread_local uint32_t jll_latency_countdown = 1;
+static _Thread_local jll_latency_thread_t * jll_latency_self = NULL;
+static _Thread_local uint64_t jll_latency_rng = 0x9e3779b97f4a7c15ULL;
+
+/**
+ * @brief Folds the histograms of an exiting thread into the retired totals
+ */
+static void __jll_latency_thread_exit(void * arg)
+{
+    jll_latency_thread_t * thread = (jll_latency_thread_t *)arg;
+
+    pthread_mutex_lock(&jll_latency_lock);
+
+    for (size_t k = 0; k < JLL_LAT_OP_COUNT; k++) jll_latency_hist_merge(&jll_latency_retired.ops[k], &thread->hists.ops[k]);
+
+    if (thread->prev) thread->prev->next = thread->next;
+    else jll_latency_threads = thread->next;
+    if (thread->next) thread->next->prev = thread->prev;
+
+    pthread_mutex_unlock(&jll_latency_lock);
+    free(thread);
+}
+
+static void __jll_latency_init_key(void)
+{
+    pthread_key_create(&jll_latency_key, __jll_latency_thread_exit);
+}
+
+static jll_latency_thread_t * __jll_latency_register(void)
+{
+    pthread_once(&jll_latency_once, __jll_latency_init_key);
+
+    jll_latency_thread_t * thread = (jll_latency_thread_t *)calloc(1, sizeof(jll_latency_thread_t));
+
+    pthread_mutex_lock(&jll_latency_lock);
+    thread->next = jll_latency_threads;
+    if (jll_latency_threads) jll_latency_threads->prev = thread;
+    jll_latency_threads = thread;
+    pthread_mutex_unlock(&jll_latency_lock);
+
+    pthread_setspecific(jll_latency_key, thread);
+    return thread;
+}
+
+static uint64_t __jll_latency_now(void)
+{
+# ifdef JLL_LATENCY_TSC
+    return (uint64_t)__rdtsc();
+# else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+# endif
+}
+
+
+/**
+ * @brief Slow path of jll_latency_begin, taken once every sample_rate calls on a thread
+ */
+jll_latency_scope_t jll_latency_begin_sampled(jll_latency_op_t op)
+{
+    jll_latency_scope_t scope = { -1, 0 };
+    uint32_t every = __atomic_load_n(&jll_latency_sample_every, __ATOMIC_RELAXED);
+
+    if (every == 0)
+    {
+        jll_latency_countdown = JLL_LATENCY_DISABLED_RECHECK;
+        return scope;
+    }
+
+    // Jitter the gap between samples (mean of `every` calls) so that call sequences which
+    // repeat with a fixed period, e.g. insert_sorted always calling is_empty, are not aliased.
+    jll_latency_rng ^= jll_latency_rng << 13;
+    jll_latency_rng ^= jll_latency_rng >> 7;
+    jll_latency_rng ^= jll_latency_rng << 17;
+    jll_latency_countdown = (every == 1) ? 1 : 1 + (uint32_t)(jll_latency_rng % (2ULL * every - 1));
+
+    scope.op = (int)op;
+    scope.start = __jll_latency_now();
+    return scope;
+}
+
+void jll_latency_end(jll_latency_scope_t * scope)
+{
+    if (scope->op < 0) return;
+
+    uint64_t elapsed = __jll_latency_now() - scope->start;
+
+    if (!jll_latency_self) jll_latency_self = __jll_latency_register();
+    jll_latency_hist_record(&jll_latency_self->hists.ops[scope->op], elapsed);
+}
+
+# endif
+
+
+/* configuration */
+
+bool jll_latency_enabled(void)
+{
+# ifdef JLL_ENABLE_LATENCY
+    return true;
+# else
+    return false;
+# endif
+}
+
+/**
+ * @brief Sets how often calls are timed: every Nth call on each thread is recorded, 0 stops recording.
+ * Threads pick up a new rate at their next sampling point.
+ */
+void jll_latency_set_sample_rate(uint32_t every)
+{
+    __atomic_store_n(&jll_latency_sample_every, every, __ATOMIC_RELAXED);
+}
+
+const char * jll_latency_unit(void)
+{
+# ifdef JLL_LATENCY_TSC
+    return "cycles";
+# else
+    return "ns";
+# endif
+}
+
+const char * jll_latency_op_name(jll_latency_op_t op)
+{
+    assert(op < JLL_LAT_OP_COUNT);
+    return jll_latency_op_names[op];
+}
+
+
+/* snapshots */
+
+/**
+ * @brief Merges the histograms of every live and exited thread into a snapshot
+ */
+void jll_latency_snapshot(jll_latency_snapshot_t * out)
+{
+    assert(out);
+
+    memset(out, 0, sizeof(jll_latency_snapshot_t));
+
+    pthread_mutex_lock(&jll_latency_lock);
+
+    for (size_t k = 0; k < JLL_LAT_OP_COUNT; k++) jll_latency_hist_merge(&out->ops[k], &jll_latency_retired.ops[k]);
+
+    for (jll_latency_thread_t * thread = jll_latency_threads; thread; thread = thread->next)
+    {
+        for (size_t k = 0; k < JLL_LAT_OP_COUNT; k++) jll_latency_hist_merge(&out->ops[k], &thread->hists.ops[k]);
+    }
+
+    pthread_mutex_unlock(&jll_latency_lock);
+}
+
+/**
+ * @brief Clears every histogram. Samples recorded concurrently with the reset may be lost.
+ */
+void jll_latency_reset(void)
+{
+    pthread_mutex_lock(&jll_latency_lock);
+
+    memset(&jll_latency_retired, 0, sizeof(jll_latency_snapshot_t));
+
+    for (jll_latency_thread_t * thread = jll_latency_threads; thread; thread = thread->next)
+    {
+        uint64_t * words = (uint64_t *)&thread->hists;
+        size_t nwords = sizeof(jll_latency_snapshot_t) / sizeof(uint64_t);
+
+        for (size_t k = 0; k < nwords; k++) __atomic_store_n(&words[k], 0, __ATOMIC_RELAXED);
+    }
+
+    pthread_mutex_unlock(&jll_latency_lock);
+}
+
+void jll_latency_dump_text(FILE * stream, const jll_latency_snapshot_t * snapshot)
+{
+    assert(stream);
+    assert(snapshot);
+
+    fprintf(stream, "%-34s %12s %10s %10s %10s %10s %10s %10s %10s (%s)\n",
+            "operation", "count", "min", "mean", "p50", "p90", "p99", "p999", "max", jll_latency_unit());
+
+    for (size_t k = 0; k < JLL_LAT_OP_COUNT; k++)
+    {
+        const jll_latency_hist_t * hist = &snapshot->ops[k];
+        if (hist->count == 0) continue;
+
+        fprintf(stream, "%-34s %12llu %10llu %10llu %10llu %10llu %10llu %10llu %10llu\n",
+                jll_latency_op_names[k],
+                (unsigned long long)hist->count,
+                (unsigned long long)hist->min,
+                (unsigned long long)(hist->sum / hist->count),
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.50),
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.90),
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.99),
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.999),
+                (unsigned long long)hist->max);
+    }
+}
+
+/**
+ * @brief Writes a snapshot as JSON; non-empty buckets are listed as [upper_bound, count] pairs
+ */
+void jll_latency_dump_json(FILE * stream, const jll_latency_snapshot_t * snapshot)
+{
+    assert(stream);
+    assert(snapshot);
+
+    bool first_op = true;
+
+    fprintf(stream, "{\"unit\":\"%s\",\"ops\":{", jll_latency_unit());
+
+    for (size_t k = 0; k < JLL_LAT_OP_COUNT; k++)
+    {
+        const jll_latency_hist_t * hist = &snapshot->ops[k];
+        if (hist->count == 0) continue;
+
+        fprintf(stream, "%s\"%s\":{\"count\":%llu,\"sum\":%llu,\"min\":%llu,\"max\":%llu,"
+                        "\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"p999\":%llu,\"buckets\":[",
+                first_op ? "" : ",",
+                jll_latency_op_names[k],
+                (unsigned long long)hist->count,
+                (unsigned long long)hist->sum,
+                (unsigned long long)hist->min,
+                (unsigned long long)hist->max,
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.50),
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.90),
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.99),
+                (unsigned long long)jll_latency_hist_percentile(hist, 0.999));
+
+        bool first_bucket = true;
+        for (size_t b = 0; b < JLL_LATENCY_BUCKETS; b++)
+        {
+            if (hist->buckets[b] == 0) continue;
+
+            fprintf(stream, "%s[%llu,%llu]", first_bucket ? "" : ",",
+                    (unsigned long long)__jll_latency_bucket_upper(b), (unsigned long long)hist->buckets[b]);
+            first_bucket = false;
+        }
+
+        fprintf(stream, "]}");
+        first_op = false;
+    }
+
+    fprintf(stream, "}}\n");
+}
@@ -0,0 +1,622 @@
+
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include "./include/match.h"
+
+# define JLL_MATCH_HASH_BASE 0x100000001b3ULL
+
+
+static bool __jll_match_equal(data_compfunc_t compfunc, const jll_data_t * a, const jll_data_t * b)
+{
+    if (a == b) return true;
+    return (compfunc) && (compfunc(a, b) == 0);
+}
+
+
+/* single-pattern matching */
+
+/**
+ * @brief Advances a KMP state (the length of the pattern prefix matched so far) by one element. A
+ * state equal to the pattern length means a match ended at the previous element; it falls back to
+ * the longest proper border first, so overlapping matches are found.
+ */
+static size_t __jll_matcher_step(const jll_matcher_t * matcher, size_t state, const jll_data_t * dptr)
+{
+    if (state == matcher->length) state = matcher->failure[state - 1];
+
+    while ((state > 0) && (!__jll_match_equal(matcher->match_comp_func, matcher->pattern[state], dptr)))
+        state = matcher->failure[state - 1];
+
+    if (__jll_match_equal(matcher->match_comp_func, matcher->pattern[state], dptr)) state++;
+
+    return state;
+}
+
+/**
+ * @brief Allocate a single-pattern matcher
+ *
+ * @param pattern  Elements of the pattern (copied)
+ * @param length   Number of elements (at least 1)
+ * @param compfunc Equality comparator (may be NULL: elements are equal when their pointers are)
+ *
+ * @returns Pointer to the newly created matcher
+ */
+jll_matcher_t * jll_alloc_matcher(const jll_data_t * const * pattern, size_t length, data_compfunc_t compfunc)
+{
+    JLL_LAT_SCOPE(MATCHER_ALLOC);
+    assert(pattern);
+    assert(length > 0);
+
+    jll_matcher_t * new_matcher = (jll_matcher_t *)malloc(sizeof(jll_matcher_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_matcher_t));
+
+    new_matcher->pattern = (const jll_data_t **)malloc(length * sizeof(const jll_data_t *));
+    new_matcher->failure = (size_t *)malloc(length * sizeof(size_t));
+    JLL_MEM_ADD(JLL_MEM_PAYLOADS, length * (sizeof(const jll_data_t *) + sizeof(size_t)));
+
+    memcpy(new_matcher->pattern, pattern, length * sizeof(const jll_data_t *));
+    new_matcher->length = length;
+    new_matcher->match_comp_func = compfunc;
+
+    // failure[k] is the length of the longest proper prefix of pattern[0..k] which is also its suffix.
+    new_matcher->failure[0] = 0;
+    size_t border = 0;
+
+    for (size_t k = 1; k < length; k++)
+    {
+        while ((border > 0) && (!__jll_match_equal(compfunc, pattern[k], pattern[border]))) border = new_matcher->failure[border - 1];
+        if (__jll_match_equal(compfunc, pattern[k], pattern[border])) border++;
+        new_matcher->failure[k] = border;
+    }
+
+    jll_matcher_reset(new_matcher);
+    return new_matcher;
+}
+
+void jll_dealloc_matcher(jll_matcher_t * matcher)
+{
+    JLL_LAT_SCOPE(MATCHER_DEALLOC);
+    assert(matcher);
+
+    JLL_MEM_SUB(JLL_MEM_PAYLOADS, matcher->length * (sizeof(const jll_data_t *) + sizeof(size_t)));
+    free(matcher->pattern);
+    free(matcher->failure);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_matcher_t));
+    free(matcher);
+}
+
+/**
+ * @brief Forget every element fed so far
+ */
+void jll_matcher_reset(jll_matcher_t * matcher)
+{
+    assert(matcher);
+
+    matcher->state = 0;
+    matcher->position = 0;
+}
+
+/**
+ * @brief Feed the next element of a stream to the matcher
+ *
+ * @param matcher Pointer to the matcher
+ * @param dptr    Next element
+ *
+ * @returns true if an occurrence of the pattern ends with this element; it then starts at
+ * jll_matcher_position() minus the pattern length
+ */
+bool jll_matcher_feed(jll_matcher_t * matcher, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(MATCHER_FEED);
+    assert(matcher);
+
+    matcher->state = __jll_matcher_step(matcher, matcher->state, dptr);
+    matcher->position++;
+
+    return (matcher->state == matcher->length);
+}
+
+/**
+ * @brief Returns the number of elements fed since the matcher was allocated or reset
+ */
+size_t jll_matcher_position(const jll_matcher_t * matcher)
+{
+    assert(matcher);
+    return matcher->position;
+}
+
+
+/* multi-pattern matching */
+
+typedef struct jll_pattern_entry_type
+{
+    uint64_t hash;
+    size_t id;
+
+} jll_pattern_entry_t;
+
+static int __jll_pattern_entry_compare(const void * a, const void * b)
+{
+    uint64_t x = ((const jll_pattern_entry_t *)a)->hash;
+    uint64_t y = ((const jll_pattern_entry_t *)b)->hash;
+
+    return (x > y) - (x < y);
+}
+
+static int __jll_size_compare(const void * a, const void * b)
+{
+    size_t x = *(const size_t *)a;
+    size_t y = *(const size_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint64_t __jll_multimatcher_hash(const jll_multimatcher_t * matcher, const jll_data_t * dptr)
+{
+    if (matcher->match_hash_func) return (uint64_t)matcher->match_hash_func(dptr);
+    return ((uint64_t)(uintptr_t)dptr) * 0x9e3779b97f4a7c15ULL;
+}
+
+static void * __jll_multimatcher_alloc(jll_multimatcher_t * matcher, size_t bytes)
+{
+    matcher->bytes += bytes;
+    return malloc(bytes);
+}
+
+/**
+ * @brief Compares a pattern with the window's last elements; the rolling hash only says they may match
+ */
+static bool __jll_multimatcher_verify(const jll_multimatcher_t * matcher, size_t id)
+{
+    size_t length = matcher->offsets[id + 1] - matcher->offsets[id];
+    const jll_data_t ** pattern = &matcher->elements[matcher->offsets[id]];
+    size_t first = matcher->position - length;
+
+    for (size_t k = 0; k < length; k++)
+    {
+        if (!__jll_match_equal(matcher->match_comp_func, pattern[k], matcher->window[(first + k) % matcher->window_length])) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Feeds one element: rolls every group's hash forward, then checks the patterns whose hash
+ * matches. Matches are written to ids or matches (either may be NULL) up to max; all are counted.
+ */
+static size_t __jll_multimatcher_step(jll_multimatcher_t * matcher, const jll_data_t * dptr, size_t * ids, jll_match_t * matches, size_t max)
+{
+    uint64_t hash = __jll_multimatcher_hash(matcher, dptr);
+
+    for (size_t g = 0; g < matcher->groups; g++)
+    {
+        jll_pattern_group_t * group = &matcher->group[g];
+
+        group->rolling = group->rolling * JLL_MATCH_HASH_BASE + hash;
+
+        // The element leaving this group's window; the oldest slot is read before it is overwritten below.
+        if (matcher->position >= group->length)
+            group->rolling -= matcher->window_hashes[(matcher->position - group->length) % matcher->window_length] * group->power;
+    }
+
+    size_t slot = matcher->position % matcher->window_length;
+    matcher->window[slot] = dptr;
+    matcher->window_hashes[slot] = hash;
+    matcher->position++;
+
+    size_t found = 0;
+
+    for (size_t g = 0; g < matcher->groups; g++)
+    {
+        const jll_pattern_group_t * group = &matcher->group[g];
+        if (matcher->position < group->length) break;
+
+        size_t low = 0;
+        size_t high = group->count;
+
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (group->hashes[mid] < group->rolling) low = mid + 1;
+            else high = mid;
+        }
+
+        for (; (low < group->count) && (group->hashes[low] == group->rolling); low++)
+        {
+            if (!__jll_multimatcher_verify(matcher, group->ids[low])) continue;
+
+            if (found < max)
+            {
+                if (ids) ids[found] = group->ids[low];
+                if (matches)
+                {
+                    matches[found].pattern = group->ids[low];
+                    matches[found].position = matcher->position - group->length;
+                }
+            }
+
+            found++;
+        }
+    }
+
+    return found;
+}
+
+/**
+ * @brief Allocate a multi-pattern matcher
+ *
+ * @param patterns Array of patterns, each an array of elements (copied)
+ * @param lengths  Length of each pattern (at least 1)
+ * @param count    Number of patterns (at least 1); a pattern's index is its id
+ * @param compfunc Equality comparator (may be NULL: elements are equal when their pointers are)
+ * @param hashfunc Element hash consistent with compfunc (required with a comparator, else may be NULL)
+ *
+ * @returns Pointer to the newly created matcher
+ */
+jll_multimatcher_t * jll_alloc_multimatcher(const jll_data_t * const * const * patterns, const size_t * lengths, size_t count,
+                                            data_compfunc_t compfunc, data_hashfunc_t hashfunc)
+{
+    JLL_LAT_SCOPE(MULTIMATCHER_ALLOC);
+    assert(patterns);
+    assert(lengths);
+    assert(count > 0);
+    assert((!compfunc) || (hashfunc));
+
+    jll_multimatcher_t * new_matcher = (jll_multimatcher_t *)malloc(sizeof(jll_multimatcher_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_multimatcher_t));
+
+    new_matcher->bytes = 0;
+    new_matcher->patterns = count;
+    new_matcher->match_comp_func = compfunc;
+    new_matcher->match_hash_func = hashfunc;
+
+    // Pattern elements are stored back to back; pattern k spans offsets[k] to offsets[k + 1].
+    new_matcher->offsets = (size_t *)__jll_multimatcher_alloc(new_matcher, (count + 1) * sizeof(size_t));
+    new_matcher->offsets[0] = 0;
+    new_matcher->window_length = 0;
+
+    for (size_t k = 0; k < count; k++)
+    {
+        assert(lengths[k] > 0);
+        new_matcher->offsets[k + 1] = new_matcher->offsets[k] + lengths[k];
+        if (lengths[k] > new_matcher->window_length) new_matcher->window_length = lengths[k];
+    }
+
+    new_matcher->elements = (const jll_data_t **)__jll_multimatcher_alloc(new_matcher, new_matcher->offsets[count] * sizeof(const jll_data_t *));
+    for (size_t k = 0; k < count; k++) memcpy(&new_matcher->elements[new_matcher->offsets[k]], patterns[k], lengths[k] * sizeof(const jll_data_t *));
+
+    new_matcher->window = (const jll_data_t **)__jll_multimatcher_alloc(new_matcher, new_matcher->window_length * sizeof(const jll_data_t *));
+    new_matcher->window_hashes = (uint64_t *)__jll_multimatcher_alloc(new_matcher, new_matcher->window_length * sizeof(uint64_t));
+
+    // One group per distinct length, shortest first.
+    size_t * distinct = (size_t *)malloc(count * sizeof(size_t));
+    memcpy(distinct, lengths, count * sizeof(size_t));
+    qsort(distinct, count, sizeof(size_t), __jll_size_compare);
+
+    size_t groups = 0;
+    for (size_t k = 0; k < count; k++)
+    {
+        if ((groups == 0) || (distinct[groups - 1] != distinct[k])) distinct[groups++] = distinct[k];
+    }
+
+    new_matcher->groups = groups;
+    new_matcher->group = (jll_pattern_group_t *)__jll_multimatcher_alloc(new_matcher, groups * sizeof(jll_pattern_group_t));
+
+    jll_pattern_entry_t * entries = (jll_pattern_entry_t *)malloc(count * sizeof(jll_pattern_entry_t));
+
+    for (size_t g = 0; g < groups; g++)
+    {
+        jll_pattern_group_t * group = &new_matcher->group[g];
+        group->length = distinct[g];
+        group->power = 1;
+        for (size_t k = 0; k < group->length; k++) group->power *= JLL_MATCH_HASH_BASE;
+
+        group->count = 0;
+        for (size_t k = 0; k < count; k++)
+        {
+            if (lengths[k] != group->length) continue;
+
+            uint64_t hash = 0;
+            for (size_t e = 0; e < lengths[k]; e++) hash = hash * JLL_MATCH_HASH_BASE + __jll_multimatcher_hash(new_matcher, patterns[k][e]);
+
+            entries[group->count].hash = hash;
+            entries[group->count].id = k;
+            group->count++;
+        }
+
+        qsort(entries, group->count, sizeof(jll_pattern_entry_t), __jll_pattern_entry_compare);
+
+        group->hashes = (uint64_t *)__jll_multimatcher_alloc(new_matcher, group->count * sizeof(uint64_t));
+        group->ids = (size_t *)__jll_multimatcher_alloc(new_matcher, group->count * sizeof(size_t));
+
+        for (size_t k = 0; k < group->count; k++)
+        {
+            group->hashes[k] = entries[k].hash;
+            group->ids[k] = entries[k].id;
+        }
+    }
+
+    free(entries);
+    free(distinct);
+
+    JLL_MEM_ADD(JLL_MEM_PAYLOADS, new_matcher->bytes);
+    jll_multimatcher_reset(new_matcher);
+
+    return new_matcher;
+}
+
+void jll_dealloc_multimatcher(jll_multimatcher_t * matcher)
+{
+    JLL_LAT_SCOPE(MULTIMATCHER_DEALLOC);
+    assert(matcher);
+
+    for (size_t g = 0; g < matcher->groups; g++)
+    {
+        free(matcher->group[g].hashes);
+        free(matcher->group[g].ids);
+    }
+
+    free(matcher->group);
+    free(matcher->window);
+    free(matcher->window_hashes);
+    free(matcher->elements);
+    free(matcher->offsets);
+    JLL_MEM_SUB(JLL_MEM_PAYLOADS, matcher->bytes);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_multimatcher_t));
+    free(matcher);
+}
+
+/**
+ * @brief Forget every element fed so far
+ */
+void jll_multimatcher_reset(jll_multimatcher_t * matcher)
+{
+    assert(matcher);
+
+    for (size_t g = 0; g < matcher->groups; g++) matcher->group[g].rolling = 0;
+    matcher->position = 0;
+}
+
+/**
+ * @brief Feed the next element of a stream to the matcher
+ *
+ * @param matcher Pointer to the matcher
+ * @param dptr    Next element
+ * @param ids     Receives the ids of the patterns ending with this element, shortest first (may be NULL)
+ * @param max     Capacity of ids
+ *
+ * @returns Number of patterns ending with this element (ids holds the first max of them)
+ */
+size_t jll_multimatcher_feed(jll_multimatcher_t * matcher, const jll_data_t * dptr, size_t * ids, size_t max)
+{
+    JLL_LAT_SCOPE(MULTIMATCHER_FEED);
+    assert(matcher);
+
+    return __jll_multimatcher_step(matcher, dptr, ids, NULL, max);
+}
+
+/**
+ * @brief Returns the number of elements fed since the matcher was allocated or reset
+ */
+size_t jll_multimatcher_position(const jll_multimatcher_t * matcher)
+{
+    assert(matcher);
+    return matcher->position;
+}
+
+
+/* searching lists */
+
+/**
+ * @brief Find the first occurrence of a pattern in a singly-linked list in O(n). A second pointer
+ * trails the scan at the start of the current partial match, so the node is at hand when it completes.
+ *
+ * @param slist    Pointer to the list
+ * @param matcher  Pattern to search for (its streaming state is not used)
+ * @param position Receives the position of the occurrence (may be NULL)
+ *
+ * @returns The node where the occurrence starts, or NULL if there is none
+ */
+jll_snode_t * jll_slist_find_subsequence(const jll_slist_t * slist, const jll_matcher_t * matcher, size_t * position)
+{
+    JLL_LAT_SCOPE(SLIST_FIND_SUBSEQUENCE);
+    assert(slist);
+    assert(matcher);
+
+    jll_snode_t * rover = slist->head;
+    jll_snode_t * start = slist->head;
+    size_t start_position = 0;
+    size_t state = 0;
+
+    for (size_t k = 0; k < slist->length; k++)
+    {
+        state = __jll_matcher_step(matcher, state, rover->data);
+
+        while (start_position < k + 1 - state)
+        {
+            start = start->next;
+            start_position++;
+        }
+
+        if (state == matcher->length)
+        {
+            if (position) *position = start_position;
+            return start;
+        }
+
+        rover = rover->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Find the positions of every occurrence of a pattern, overlapping ones included, in O(n)
+ *
+ * @param slist     Pointer to the list
+ * @param matcher   Pattern to search for (its streaming state is not used)
+ * @param positions Receives the start positions, in order
+ * @param max       Capacity of positions; the search stops once it is full
+ *
+ * @returns Number of occurrences written
+ */
+size_t jll_slist_find_all_subsequences(const jll_slist_t * slist, const jll_matcher_t * matcher, size_t * positions, size_t max)
+{
+    JLL_LAT_SCOPE(SLIST_FIND_ALL_SUBSEQUENCES);
+    assert(slist);
+    assert(matcher);
+    assert(positions || (max == 0));
+
+    const jll_snode_t * rover = slist->head;
+    size_t state = 0;
+    size_t found = 0;
+
+    for (size_t k = 0; (k < slist->length) && (found < max); k++)
+    {
+        state = __jll_matcher_step(matcher, state, rover->data);
+        if (state == matcher->length) positions[found++] = k + 1 - matcher->length;
+
+        rover = rover->next;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Find the occurrences of all of a multi-pattern matcher's patterns in one pass. The matcher
+ * is reset first and is left fed with the whole list.
+ *
+ * @param slist   Pointer to the list
+ * @param matcher Patterns to search for
+ * @param matches Receives the occurrences, ordered by end position and then by pattern length
+ * @param max     Capacity of matches; the search stops once it is full
+ *
+ * @returns Number of occurrences written
+ */
+size_t jll_slist_match_patterns(const jll_slist_t * slist, jll_multimatcher_t * matcher, jll_match_t * matches, size_t max)
+{
+    JLL_LAT_SCOPE(SLIST_MATCH_PATTERNS);
+    assert(slist);
+    assert(matcher);
+    assert(matches || (max == 0));
+
+    jll_multimatcher_reset(matcher);
+
+    const jll_snode_t * rover = slist->head;
+    size_t found = 0;
+
+    for (size_t k = 0; (k < slist->length) && (found < max); k++)
+    {
+        size_t ended = __jll_multimatcher_step(matcher, rover->data, NULL, &matches[found], max - found);
+        found += (ended < max - found) ? ended : max - found;
+
+        rover = rover->next;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Doubly-linked counterpart of jll_slist_find_subsequence
+ */
+jll_dnode_t * jll_dlist_find_subsequence(const jll_dlist_t * dlist, const jll_matcher_t * matcher, size_t * position)
+{
+    JLL_LAT_SCOPE(DLIST_FIND_SUBSEQUENCE);
+    assert(dlist);
+    assert(matcher);
+
+    jll_dnode_t * rover = dlist->head;
+    size_t state = 0;
+    size_t k = 0;
+
+    // Positions count live elements only; tombstones of a lazily deleted list are stepped over.
+    for (size_t hop = 0; hop < dlist->length + dlist->tombstones; hop++)
+    {
+        if (rover->data)
+        {
+            state = __jll_matcher_step(matcher, state, rover->data);
+
+            // The start node is reachable backwards, so no trailing pointer is needed.
+            if (state == matcher->length)
+            {
+                for (size_t back = 1; back < matcher->length; back++)
+                {
+                    do rover = rover->prev;
+                    while (!rover->data);
+                }
+
+                if (position) *position = k + 1 - matcher->length;
+                return rover;
+            }
+
+            k++;
+        }
+
+        rover = rover->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Doubly-linked counterpart of jll_slist_find_all_subsequences
+ */
+size_t jll_dlist_find_all_subsequences(const jll_dlist_t * dlist, const jll_matcher_t * matcher, size_t * positions, size_t max)
+{
+    JLL_LAT_SCOPE(DLIST_FIND_ALL_SUBSEQUENCES);
+    assert(dlist);
+    assert(matcher);
+    assert(positions || (max == 0));
+
+    const jll_dnode_t * rover = dlist->head;
+    size_t state = 0;
+    size_t found = 0;
+
+    size_t k = 0;
+
+    for (size_t hop = 0; (hop < dlist->length + dlist->tombstones) && (found < max); hop++)
+    {
+        if (rover->data)
+        {
+            state = __jll_matcher_step(matcher, state, rover->data);
+            if (state == matcher->length) positions[found++] = k + 1 - matcher->length;
+            k++;
+        }
+
+        rover = rover->next;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Doubly-linked counterpart of jll_slist_match_patterns
+ */
+size_t jll_dlist_match_patterns(const jll_dlist_t * dlist, jll_multimatcher_t * matcher, jll_match_t * matches, size_t max)
+{
+    JLL_LAT_SCOPE(DLIST_MATCH_PATTERNS);
+    assert(dlist);
+    assert(matcher);
+    assert(matches || (max == 0));
+
+    jll_multimatcher_reset(matcher);
+
+    const jll_dnode_t * rover = dlist->head;
+    size_t found = 0;
+
+    for (size_t hop = 0; (hop < dlist->length + dlist->tombstones) && (found < max); hop++)
+    {
+        if (rover->data)
+        {
+            size_t ended = __jll_multimatcher_step(matcher, rover->data, NULL, &matches[found], max - found);
+            found += (ended < max - found) ? ended : max - found;
+        }
+
+        rover = rover->next;
+    }
+
+    return found;
+}
@@ -0,0 +1,120 @@
+
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include <unistd.h>
+# include "./include/memstat.h"
+
+
+static size_t jll_memstat_bytes[JLL_MEM_CATEGORIES];
+static size_t jll_memstat_total = 0;
+static size_t jll_memstat_peak = 0;
+
+
+/* accounting */
+
+void jll_memstat_record_add(jll_mem_category_t category, size_t bytes)
+{
+    assert(category < JLL_MEM_CATEGORIES);
+
+    __atomic_fetch_add(&jll_memstat_bytes[category], bytes, __ATOMIC_RELAXED);
+    size_t total = __atomic_add_fetch(&jll_memstat_total, bytes, __ATOMIC_RELAXED);
+
+    size_t peak = __atomic_load_n(&jll_memstat_peak, __ATOMIC_RELAXED);
+    while ((total > peak) && (!__atomic_compare_exchange_n(&jll_memstat_peak, &peak, total, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)));
+}
+
+void jll_memstat_record_sub(jll_mem_category_t category, size_t bytes)
+{
+    assert(category < JLL_MEM_CATEGORIES);
+
+    __atomic_fetch_sub(&jll_memstat_bytes[category], bytes, __ATOMIC_RELAXED);
+    __atomic_fetch_sub(&jll_memstat_total, bytes, __ATOMIC_RELAXED);
+}
+
+
+/* queries */
+
+bool jll_memstat_enabled(void)
+{
+# ifdef JLL_ENABLE_MEMSTAT
+    return true;
+# else
+    return false;
+# endif
+}
+
+/**
+ * @brief Copies the process-wide byte counts. Counts are requested sizes; allocator overhead is not included.
+ */
+void jll_memstat_global(jll_memstat_t * out)
+{
+    assert(out);
+
+    for (size_t k = 0; k < JLL_MEM_CATEGORIES; k++) out->bytes[k] = __atomic_load_n(&jll_memstat_bytes[k], __ATOMIC_RELAXED);
+
+    out->total_bytes = __atomic_load_n(&jll_memstat_total, __ATOMIC_RELAXED);
+    out->peak_bytes = __atomic_load_n(&jll_memstat_peak, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Restarts high-water mark tracking from the current total
+ */
+void jll_memstat_reset_peak(void)
+{
+    __atomic_store_n(&jll_memstat_peak, __atomic_load_n(&jll_memstat_total, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+}
+
+
+/* layout analysis */
+
+void jll_layout_begin(jll_layout_report_t * report)
+{
+    assert(report);
+    memset(report, 0, sizeof(jll_layout_report_t));
+}
+
+/**
+ * @brief Classifies one next-hop between two nodes by cache line and page distance
+ */
+void jll_layout_hop(jll_layout_report_t * report, const void * from, const void * to)
+{
+    assert(report);
+
+    static size_t page_size = 0;
+    if (!page_size) page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    uintptr_t a = (uintptr_t)from;
+    uintptr_t b = (uintptr_t)to;
+    uintptr_t distance = (b > a) ? b - a : a - b;
+
+    uintptr_t line_a = a / JLL_CACHE_LINE_SIZE, line_b = b / JLL_CACHE_LINE_SIZE;
+    uintptr_t page_a = a / page_size, page_b = b / page_size;
+
+    report->hops++;
+    if (b > a) report->forward++;
+
+    if (line_a == line_b) report->same_line++;
+    else if ((line_a + 1 == line_b) || (line_b + 1 == line_a)) report->adjacent_line++;
+
+    if (page_a == page_b) report->same_page++;
+    else if ((page_a + 1 == page_b) || (page_b + 1 == page_a)) report->adjacent_page++;
+
+    // Running sum; turned into a mean by jll_layout_end.
+    report->mean_distance += (double)distance;
+}
+
+void jll_layout_end(jll_layout_report_t * report)
+{
+    assert(report);
+    if (report->hops) report->mean_distance /= (double)report->hops;
+}
+
+/**
+ * @brief Turns one of the report's counters into a share of all hops, e.g. jll_layout_share(&r, r.same_line)
+ */
+double jll_layout_share(const jll_layout_report_t * report, size_t count)
+{
+    assert(report);
+    return report->hops ? (double)count / (double)report->hops : 0.0;
+}
@@ -0,0 +1,85 @@
+
+# include <stdlib.h>
+# include <assert.h>
+# include "./include/datatype.h"
+# include "./include/memstat.h"
+
+
+/**
+ * @brief Wrap a heap-allocated vector of data references in a payload, taking ownership of the vector
+ * 
+ * @param data   Vector of data references (allocated with malloc/realloc)
+ * @param length Number of references in the vector
+ * 
+ * @returns Pointer to the newly created payload
+ */
+jll_data_payload_t * jll_allocate_data_payload(const jll_data_t ** data, size_t length)
+{
+    jll_data_payload_t * new_payload = (jll_data_payload_t *)malloc(sizeof(jll_data_payload_t));
+
+    new_payload->data = data;
+    new_payload->length = length;
+    new_payload->capacity = length;
+
+    JLL_MEM_ADD(JLL_MEM_PAYLOADS, sizeof(jll_data_payload_t) + length * sizeof(jll_data_t *));
+
+    return new_payload;
+}
+
+/**
+ * @brief Allocate an empty payload meant to be reused, e.g. as the destination of repeated drains
+ * 
+ * @param capacity Number of references to reserve room for up front
+ * 
+ * @returns Pointer to the newly created payload
+ */
+jll_data_payload_t * jll_allocate_empty_payload(size_t capacity)
+{
+    const jll_data_t ** data = (capacity) ? (const jll_data_t **)malloc(capacity * sizeof(jll_data_t *)) : NULL;
+
+    jll_data_payload_t * new_payload = jll_allocate_data_payload(data, capacity);
+    new_payload->length = 0;
+
+    return new_payload;
+}
+
+/**
+ * @brief Deallocate a payload and its vector. The referenced data themselves are left untouched.
+ */
+void jll_deallocate_data_payload(jll_data_payload_t * payload)
+{
+    assert(payload);
+
+    JLL_MEM_SUB(JLL_MEM_PAYLOADS, sizeof(jll_data_payload_t) + payload->capacity * sizeof(jll_data_t *));
+
+    free(payload->data);
+    free(payload);
+}
+
+/**
+ * @brief Makes room for at least capacity references, growing geometrically so repeated appends stay amortized O(1)
+ */
+void jll_data_payload_reserve(jll_data_payload_t * payload, size_t capacity)
+{
+    assert(payload);
+
+    if (capacity <= payload->capacity) return;
+
+    size_t grown = 2 * payload->capacity;
+    if (grown < 8) grown = 8;
+    if (grown < capacity) grown = capacity;
+
+    payload->data = (const jll_data_t **)realloc((void *)payload->data, grown * sizeof(jll_data_t *));
+
+    JLL_MEM_ADD(JLL_MEM_PAYLOADS, (grown - payload->capacity) * sizeof(jll_data_t *));
+    payload->capacity = grown;
+}
+
+/**
+ * @brief Empties a payload while keeping its storage for reuse
+ */
+void jll_data_payload_clear(jll_data_payload_t * payload)
+{
+    assert(payload);
+    payload->length = 0;
+}
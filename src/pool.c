@@ -0,0 +1,334 @@
+
+
+# include <stdlib.h>
+# include <stdint.h>
+# include <string.h>
+# include <assert.h>
+# include <sys/mman.h>
+# include "./include/pool.h"
+
+# define JLL_POOL_HUGEPAGE_SIZE (2UL * 1024 * 1024)
+
+
+/* block registry, so nodes can be routed back to their pool by address */
+
+typedef struct jll_pool_range_type
+{
+    uintptr_t begin;
+    uintptr_t end;
+    jll_pool_t * pool;
+
+} jll_pool_range_t;
+
+static pthread_rwlock_t jll_pool_registry_lock = PTHREAD_RWLOCK_INITIALIZER;
+static jll_pool_range_t * jll_pool_registry = NULL;
+static size_t jll_pool_registry_length = 0;
+static size_t jll_pool_registry_capacity = 0;
+
+
+static void __jll_pool_register(jll_pool_t * pool, jll_pool_block_t * block)
+{
+    pthread_rwlock_wrlock(&jll_pool_registry_lock);
+
+    if (jll_pool_registry_length == jll_pool_registry_capacity)
+    {
+        jll_pool_registry_capacity = jll_pool_registry_capacity ? 2 * jll_pool_registry_capacity : 16;
+        jll_pool_registry = (jll_pool_range_t *)realloc(jll_pool_registry, jll_pool_registry_capacity * sizeof(jll_pool_range_t));
+    }
+
+    // Keep the registry sorted by address for binary search.
+    uintptr_t begin = (uintptr_t)block->base;
+    size_t k = jll_pool_registry_length;
+
+    while ((k > 0) && (jll_pool_registry[k - 1].begin > begin))
+    {
+        jll_pool_registry[k] = jll_pool_registry[k - 1];
+        k--;
+    }
+
+    jll_pool_registry[k].begin = begin;
+    jll_pool_registry[k].end = begin + block->nodes * pool->node_size;
+    jll_pool_registry[k].pool = pool;
+    jll_pool_registry_length++;
+
+    pthread_rwlock_unlock(&jll_pool_registry_lock);
+}
+
+static void __jll_pool_unregister(jll_pool_t * pool)
+{
+    pthread_rwlock_wrlock(&jll_pool_registry_lock);
+
+    size_t kept = 0;
+    for (size_t k = 0; k < jll_pool_registry_length; k++)
+    {
+        if (jll_pool_registry[k].pool != pool) jll_pool_registry[kept++] = jll_pool_registry[k];
+    }
+    jll_pool_registry_length = kept;
+
+    pthread_rwlock_unlock(&jll_pool_registry_lock);
+}
+
+static jll_pool_t * __jll_pool_lookup(const void * ptr)
+{
+    if (__atomic_load_n(&jll_pool_registry_length, __ATOMIC_RELAXED) == 0) return NULL;
+
+    uintptr_t addr = (uintptr_t)ptr;
+    jll_pool_t * owner = NULL;
+
+    pthread_rwlock_rdlock(&jll_pool_registry_lock);
+
+    size_t lo = 0, hi = jll_pool_registry_length;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (addr < jll_pool_registry[mid].begin) hi = mid;
+        else if (addr >= jll_pool_registry[mid].end) lo = mid + 1;
+        else
+        {
+            owner = jll_pool_registry[mid].pool;
+            break;
+        }
+    }
+
+    pthread_rwlock_unlock(&jll_pool_registry_lock);
+    return owner;
+}
+
+
+/* blocks */
+
+static jll_pool_block_t * __jll_pool_new_block(jll_pool_t * pool, size_t nodes, bool hugepage)
+{
+    jll_pool_block_t * block = (jll_pool_block_t *)malloc(sizeof(jll_pool_block_t));
+
+    block->nodes = nodes;
+    block->bytes = nodes * pool->node_size;
+    block->mapped = false;
+    block->base = NULL;
+
+# ifdef MAP_ANONYMOUS
+    if (hugepage)
+    {
+        size_t bytes = (block->bytes + JLL_POOL_HUGEPAGE_SIZE - 1) & ~(JLL_POOL_HUGEPAGE_SIZE - 1);
+        void * base = MAP_FAILED;
+
+#   ifdef MAP_HUGETLB
+        base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#   endif
+        if (base == MAP_FAILED)
+        {
+            // No reserved huge pages; fall back to transparent huge pages where available.
+            base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#   ifdef MADV_HUGEPAGE
+            if (base != MAP_FAILED) madvise(base, bytes, MADV_HUGEPAGE);
+#   endif
+        }
+
+        if (base != MAP_FAILED)
+        {
+            block->base = (char *)base;
+            block->bytes = bytes;
+            block->mapped = true;
+        }
+    }
+# endif
+
+    if (!block->base) block->base = (char *)malloc(block->bytes);
+
+    block->next = pool->blocks;
+    pool->blocks = block;
+    pool->capacity += nodes;
+
+    __jll_pool_register(pool, block);
+    return block;
+}
+
+static void __jll_pool_destroy(jll_pool_t * pool)
+{
+    __jll_pool_unregister(pool);
+
+    jll_pool_block_t * block = pool->blocks;
+    while (block)
+    {
+        jll_pool_block_t * next = block->next;
+
+        if (block->mapped) munmap(block->base, block->bytes);
+        else free(block->base);
+
+        free(block);
+        block = next;
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Allocate a node pool
+ * 
+ * @param node_size       Size of every node handed out (at least a pointer)
+ * @param nodes_per_block Number of nodes carved from each block when the free list runs dry
+ * @param hugepage        Back blocks with huge pages where the platform allows it
+ * 
+ * @returns Pointer to the newly created pool
+ */
+jll_pool_t * jll_alloc_pool(size_t node_size, size_t nodes_per_block, bool hugepage)
+{
+    assert(node_size >= sizeof(void *));
+    assert(nodes_per_block > 0);
+
+    jll_pool_t * new_pool = (jll_pool_t *)malloc(sizeof(jll_pool_t));
+
+    new_pool->node_size = node_size;
+    new_pool->nodes_per_block = nodes_per_block;
+    new_pool->hugepage = hugepage;
+
+    new_pool->free_list = NULL;
+    new_pool->blocks = NULL;
+
+    new_pool->capacity = 0;
+    new_pool->live = 0;
+    new_pool->orphaned = false;
+
+    pthread_mutex_init(&new_pool->lock, NULL);
+
+    return new_pool;
+}
+
+/**
+ * @brief Release a pool. If some of its nodes are still in use (e.g. spliced into another list),
+ * the pool is only destroyed once the last of them is returned.
+ */
+void jll_dealloc_pool(jll_pool_t * pool)
+{
+    assert(pool);
+
+    pthread_mutex_lock(&pool->lock);
+    bool idle = (pool->live == 0);
+    pool->orphaned = true;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (idle) __jll_pool_destroy(pool);
+}
+
+/**
+ * @brief Destroy a pool together with every node still checked out of it, in time proportional
+ * to the number of blocks. The caller guarantees that none of those nodes is referenced anymore.
+ */
+void jll_pool_discard(jll_pool_t * pool)
+{
+    assert(pool);
+    assert(!pool->orphaned);
+
+    __jll_pool_destroy(pool);
+}
+
+
+/* node operations */
+
+void * jll_pool_get(jll_pool_t * pool)
+{
+    assert(pool);
+
+    pthread_mutex_lock(&pool->lock);
+
+    if (!pool->free_list)
+    {
+        jll_pool_block_t * block = __jll_pool_new_block(pool, pool->nodes_per_block, pool->hugepage);
+
+        // Thread the new nodes onto the free list in address order.
+        for (size_t k = block->nodes; k > 0; k--)
+        {
+            void * node = block->base + (k - 1) * pool->node_size;
+            *(void **)node = pool->free_list;
+            pool->free_list = node;
+        }
+    }
+
+    void * node = pool->free_list;
+    pool->free_list = *(void **)node;
+    pool->live++;
+
+    pthread_mutex_unlock(&pool->lock);
+    return node;
+}
+
+void jll_pool_put(jll_pool_t * pool, void * node)
+{
+    assert(pool);
+    assert(node);
+
+    pthread_mutex_lock(&pool->lock);
+
+    *(void **)node = pool->free_list;
+    pool->free_list = node;
+    pool->live--;
+
+    bool destroy = (pool->orphaned) && (pool->live == 0);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (destroy) __jll_pool_destroy(pool);
+}
+
+/**
+ * @brief Hands out a dedicated contiguous block of nodes, all counted as live.
+ * Nodes of the block are returned one at a time with jll_pool_put/jll_pool_release.
+ * 
+ * @param pool     Pool to allocate from
+ * @param nodes    Number of contiguous nodes wanted
+ * @param hugepage Back this block with huge pages where the platform allows it
+ * 
+ * @returns Base address of the block; node k lives at base + k * node_size
+ */
+void * jll_pool_get_block(jll_pool_t * pool, size_t nodes, bool hugepage)
+{
+    assert(pool);
+    assert(nodes > 0);
+
+    pthread_mutex_lock(&pool->lock);
+
+    jll_pool_block_t * block = __jll_pool_new_block(pool, nodes, hugepage);
+    pool->live += nodes;
+
+    pthread_mutex_unlock(&pool->lock);
+    return block->base;
+}
+
+bool jll_pool_owns(jll_pool_t * pool, const void * node)
+{
+    assert(pool);
+    return (__jll_pool_lookup(node) == pool);
+}
+
+/**
+ * @brief Returns a node to whichever pool it came from
+ * 
+ * @returns True if the node belonged to a pool, false if it was not pool memory (caller should free it)
+ */
+bool jll_pool_release(void * node)
+{
+    jll_pool_t * owner = __jll_pool_lookup(node);
+    if (!owner) return false;
+
+    jll_pool_put(owner, node);
+    return true;
+}
+
+
+/* inspection */
+
+size_t jll_pool_live(jll_pool_t * pool)
+{
+    assert(pool);
+    return __atomic_load_n(&pool->live, __ATOMIC_RELAXED);
+}
+
+size_t jll_pool_capacity(jll_pool_t * pool)
+{
+    assert(pool);
+    return __atomic_load_n(&pool->capacity, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,131 @@
+
+# include <stdlib.h>
+# include <stdio.h>
+# include <string.h>
+# include <assert.h>
+# include "./include/profile.h"
+
+
+jll_profile_t jll_profile_global_counters;
+
+static jll_profile_export_t jll_profile_export_func = NULL;
+static void * jll_profile_export_ctx = NULL;
+static uint64_t jll_profile_export_every = 0;
+
+
+static void __jll_profile_max(uint64_t * target, uint64_t value)
+{
+    uint64_t seen = __atomic_load_n(target, __ATOMIC_RELAXED);
+
+    while ((value > seen) && (!__atomic_compare_exchange_n(target, &seen, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)));
+}
+
+
+/* recording */
+
+/**
+ * @brief Records one public operation on a list, sampling its length for the max/avg statistics.
+ * Every export_every operations process-wide, the export hook (if any) is handed the global counters.
+ * 
+ * @param profile Per-list counters
+ * @param length  Length of the list at the start of the operation
+ * 
+ * @returns None (is void)
+ */
+void jll_profile_record_op(jll_profile_t * profile, size_t length)
+{
+    assert(profile);
+
+    profile->operations++;
+    profile->length_sum += length;
+    if (length > profile->length_max) profile->length_max = length;
+
+    uint64_t ops = __atomic_add_fetch(&jll_profile_global_counters.operations, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&jll_profile_global_counters.length_sum, length, __ATOMIC_RELAXED);
+    __jll_profile_max(&jll_profile_global_counters.length_max, length);
+
+    if ((jll_profile_export_func) && (jll_profile_export_every) && (ops % jll_profile_export_every == 0))
+    {
+        jll_profile_t snapshot;
+        jll_profile_global(&snapshot);
+        jll_profile_export_func(&snapshot, jll_profile_export_ctx);
+    }
+}
+
+
+/* query and export */
+
+bool jll_profile_enabled(void)
+{
+# ifdef JLL_ENABLE_PROFILING
+    return true;
+# else
+    return false;
+# endif
+}
+
+/**
+ * @brief Copies the process-wide counters (all zero when profiling is compiled out)
+ */
+void jll_profile_global(jll_profile_t * out)
+{
+    assert(out);
+
+    out->operations     = __atomic_load_n(&jll_profile_global_counters.operations, __ATOMIC_RELAXED);
+    out->hops           = __atomic_load_n(&jll_profile_global_counters.hops, __ATOMIC_RELAXED);
+    out->comparisons    = __atomic_load_n(&jll_profile_global_counters.comparisons, __ATOMIC_RELAXED);
+    out->predicates     = __atomic_load_n(&jll_profile_global_counters.predicates, __ATOMIC_RELAXED);
+    out->node_allocs    = __atomic_load_n(&jll_profile_global_counters.node_allocs, __ATOMIC_RELAXED);
+    out->node_frees     = __atomic_load_n(&jll_profile_global_counters.node_frees, __ATOMIC_RELAXED);
+    out->walks_forward  = __atomic_load_n(&jll_profile_global_counters.walks_forward, __ATOMIC_RELAXED);
+    out->walks_backward = __atomic_load_n(&jll_profile_global_counters.walks_backward, __ATOMIC_RELAXED);
+    out->length_sum     = __atomic_load_n(&jll_profile_global_counters.length_sum, __ATOMIC_RELAXED);
+    out->length_max     = __atomic_load_n(&jll_profile_global_counters.length_max, __ATOMIC_RELAXED);
+}
+
+void jll_profile_reset_global(void)
+{
+    memset(&jll_profile_global_counters, 0, sizeof(jll_profile_t));
+}
+
+/**
+ * @brief Installs a hook which is handed a snapshot of the global counters periodically
+ * 
+ * @param func  Export function, or NULL to remove the hook
+ * @param ctx   User context passed through to the export function
+ * @param every Number of list operations (process-wide) between exports
+ * 
+ * @returns None (is void)
+ */
+void jll_profile_set_export_hook(jll_profile_export_t func, void * ctx, uint64_t every)
+{
+    jll_profile_export_func = func;
+    jll_profile_export_ctx = ctx;
+    jll_profile_export_every = every;
+}
+
+/**
+ * @brief Writes a one-line human readable summary of a set of counters
+ */
+void jll_profile_dump(FILE * stream, const char * label, const jll_profile_t * profile)
+{
+    assert(stream);
+    assert(profile);
+
+    double ops = profile->operations ? (double)profile->operations : 1.0;
+
+    fprintf(stream,
+            "%s: ops=%llu hops=%llu (%.2f/op) cmp=%llu (%.2f/op) pred=%llu (%.2f/op) "
+            "allocs=%llu frees=%llu walk_fwd=%llu walk_bwd=%llu len_avg=%.2f len_max=%llu\n",
+            label ? label : "jll",
+            (unsigned long long)profile->operations,
+            (unsigned long long)profile->hops, (double)profile->hops / ops,
+            (unsigned long long)profile->comparisons, (double)profile->comparisons / ops,
+            (unsigned long long)profile->predicates, (double)profile->predicates / ops,
+            (unsigned long long)profile->node_allocs,
+            (unsigned long long)profile->node_frees,
+            (unsigned long long)profile->walks_forward,
+            (unsigned long long)profile->walks_backward,
+            (double)profile->length_sum / ops,
+            (unsigned long long)profile->length_max);
+}
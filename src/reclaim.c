@@ -0,0 +1,190 @@
+
+
+# include <stdlib.h>
+# include <stdbool.h>
+# include <assert.h>
+# include <pthread.h>
+# include "./include/reclaim.h"
+
+
+/* reclaimer state; the thread is started by the first submission and runs until jll_reclaim_stop */
+
+static pthread_mutex_t jll_reclaim_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jll_reclaim_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t jll_reclaim_idle = PTHREAD_COND_INITIALIZER;
+
+static jll_reclaim_job_t * jll_reclaim_head = NULL;
+static jll_reclaim_job_t * jll_reclaim_tail = NULL;
+
+static pthread_t jll_reclaim_thread;
+static bool jll_reclaim_running = false;
+static bool jll_reclaim_stopping = false;
+static bool jll_reclaim_busy = false;
+
+static jll_reclaim_stats_t jll_reclaim_stats = { 0, 0, 0 };
+
+
+static void * __jll_reclaim_main(void * arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&jll_reclaim_lock);
+
+    for (;;)
+    {
+        while ((!jll_reclaim_head) && (!jll_reclaim_stopping)) pthread_cond_wait(&jll_reclaim_wake, &jll_reclaim_lock);
+        if (!jll_reclaim_head) break;
+
+        // Take the whole queue at once so submitters only contend for the lock briefly.
+        jll_reclaim_job_t * job = jll_reclaim_head;
+        jll_reclaim_head = NULL;
+        jll_reclaim_tail = NULL;
+        jll_reclaim_busy = true;
+
+        pthread_mutex_unlock(&jll_reclaim_lock);
+
+        size_t done = 0;
+        while (job)
+        {
+            jll_reclaim_job_t * next = job->next;
+            job->reclaim_func(job);
+            free(job);
+            job = next;
+            done++;
+        }
+
+        pthread_mutex_lock(&jll_reclaim_lock);
+
+        jll_reclaim_busy = false;
+        jll_reclaim_stats.completed += done;
+        jll_reclaim_stats.pending -= done;
+        if (!jll_reclaim_head) pthread_cond_broadcast(&jll_reclaim_idle);
+    }
+
+    pthread_mutex_unlock(&jll_reclaim_lock);
+    return NULL;
+}
+
+
+/* reclaimer thread */
+
+/**
+ * @brief Queues a detached object for teardown on the background reclaimer thread
+ * 
+ * @param reclaim_func      Function which releases the object, run on the reclaimer thread
+ * @param object            Detached object to be released
+ * @param data_dealloc_func User-specified function releasing one element's data (may be NULL)
+ * @param data_batch_func   User-specified function releasing an array of elements' data (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_reclaim_submit(void (*reclaim_func)(jll_reclaim_job_t *), void * object, void (*data_dealloc_func)(const jll_data_t *), data_batchdealloc_t data_batch_func)
+{
+    assert(reclaim_func);
+    assert(object);
+
+    jll_reclaim_job_t * job = (jll_reclaim_job_t *)malloc(sizeof(jll_reclaim_job_t));
+
+    job->next = NULL;
+    job->reclaim_func = reclaim_func;
+    job->object = object;
+    job->data_dealloc_func = data_dealloc_func;
+    job->data_batch_func = data_batch_func;
+
+    pthread_mutex_lock(&jll_reclaim_lock);
+
+    if (!jll_reclaim_running)
+    {
+        jll_reclaim_stopping = false;
+        jll_reclaim_running = (pthread_create(&jll_reclaim_thread, NULL, __jll_reclaim_main, NULL) == 0);
+    }
+
+    if (!jll_reclaim_running)
+    {
+        // No thread could be started; fall back to tearing the object down on the caller's thread.
+        pthread_mutex_unlock(&jll_reclaim_lock);
+        reclaim_func(job);
+        free(job);
+        return;
+    }
+
+    if (jll_reclaim_tail) jll_reclaim_tail->next = job;
+    else jll_reclaim_head = job;
+    jll_reclaim_tail = job;
+
+    jll_reclaim_stats.submitted++;
+    jll_reclaim_stats.pending++;
+
+    pthread_cond_signal(&jll_reclaim_wake);
+    pthread_mutex_unlock(&jll_reclaim_lock);
+}
+
+/**
+ * @brief Blocks until every teardown submitted so far has completed
+ */
+void jll_reclaim_drain(void)
+{
+    pthread_mutex_lock(&jll_reclaim_lock);
+    while ((jll_reclaim_head) || (jll_reclaim_busy)) pthread_cond_wait(&jll_reclaim_idle, &jll_reclaim_lock);
+    pthread_mutex_unlock(&jll_reclaim_lock);
+}
+
+/**
+ * @brief Completes the outstanding teardowns and joins the reclaimer thread; a later submission starts a new one
+ */
+void jll_reclaim_stop(void)
+{
+    pthread_mutex_lock(&jll_reclaim_lock);
+
+    if (!jll_reclaim_running)
+    {
+        pthread_mutex_unlock(&jll_reclaim_lock);
+        return;
+    }
+
+    jll_reclaim_stopping = true;
+    pthread_cond_signal(&jll_reclaim_wake);
+    pthread_mutex_unlock(&jll_reclaim_lock);
+
+    pthread_join(jll_reclaim_thread, NULL);
+
+    pthread_mutex_lock(&jll_reclaim_lock);
+
+    // Anything queued after the thread saw an empty queue is torn down here.
+    jll_reclaim_job_t * job = jll_reclaim_head;
+    jll_reclaim_head = NULL;
+    jll_reclaim_tail = NULL;
+    jll_reclaim_running = false;
+    jll_reclaim_stopping = false;
+
+    pthread_mutex_unlock(&jll_reclaim_lock);
+
+    while (job)
+    {
+        jll_reclaim_job_t * next = job->next;
+        job->reclaim_func(job);
+        free(job);
+        job = next;
+
+        pthread_mutex_lock(&jll_reclaim_lock);
+        jll_reclaim_stats.completed++;
+        jll_reclaim_stats.pending--;
+        pthread_mutex_unlock(&jll_reclaim_lock);
+    }
+
+    pthread_mutex_lock(&jll_reclaim_lock);
+    pthread_cond_broadcast(&jll_reclaim_idle);
+    pthread_mutex_unlock(&jll_reclaim_lock);
+}
+
+
+/* inspection */
+
+jll_reclaim_stats_t jll_reclaim_get_stats(void)
+{
+    pthread_mutex_lock(&jll_reclaim_lock);
+    jll_reclaim_stats_t stats = jll_reclaim_stats;
+    pthread_mutex_unlock(&jll_reclaim_lock);
+
+    return stats;
+}
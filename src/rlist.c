@@ -0,0 +1,571 @@
+
+# include <stdlib.h>
+# include <assert.h>
+# include "./include/rlist.h"
+
+
+/* run helpers */
+
+static bool __jll_rlist_equal(const jll_rlist_t * rlist, const jll_data_t * a, const jll_data_t * b)
+{
+    if (a == b) return true;
+    return (rlist->rlist_comp_func) && (rlist->rlist_comp_func(a, b) == 0);
+}
+
+static jll_rnode_t * __jll_rlist_new_node(const jll_data_t * dptr, size_t count)
+{
+    jll_rnode_t * node = (jll_rnode_t *)malloc(sizeof(jll_rnode_t));
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_rnode_t));
+
+    node->next = NULL;
+    node->prev = NULL;
+    node->data = dptr;
+    node->count = count;
+
+    return node;
+}
+
+/**
+ * @brief Links a run after another one, or at the head when after is NULL
+ */
+static void __jll_rlist_link_after(jll_rlist_t * rlist, jll_rnode_t * after, jll_rnode_t * node)
+{
+    node->prev = after;
+    node->next = (after) ? after->next : rlist->head;
+
+    if (node->next) node->next->prev = node;
+    else rlist->tail = node;
+
+    if (after) after->next = node;
+    else rlist->head = node;
+
+    rlist->runs++;
+}
+
+static void __jll_rlist_unlink_free(jll_rlist_t * rlist, jll_rnode_t * node)
+{
+    if (node->prev) node->prev->next = node->next;
+    else rlist->head = node->next;
+
+    if (node->next) node->next->prev = node->prev;
+    else rlist->tail = node->prev;
+
+    rlist->runs--;
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_rnode_t));
+    free(node);
+}
+
+/**
+ * @brief Splits a run so that its first offset elements stay in it and the rest move to a new run after it
+ */
+static void __jll_rlist_split(jll_rlist_t * rlist, jll_rnode_t * node, size_t offset)
+{
+    assert((offset > 0) && (offset < node->count));
+
+    __jll_rlist_link_after(rlist, node, __jll_rlist_new_node(node->data, node->count - offset));
+    node->count = offset;
+}
+
+/**
+ * @brief Joins a run with the next one once a removal has made them adjacent. Only runs holding the
+ * same pointer are joined, since joining comparator-equal runs would drop a pointer the list retains.
+ */
+static void __jll_rlist_rejoin(jll_rlist_t * rlist, jll_rnode_t * node)
+{
+    if ((!node) || (!node->next) || (node->data != node->next->data)) return;
+
+    node->count += node->next->count;
+    __jll_rlist_unlink_free(rlist, node->next);
+}
+
+/**
+ * @brief Takes one element off a run, freeing the run once it is empty
+ */
+static void __jll_rlist_drop_one(jll_rlist_t * rlist, jll_rnode_t * node)
+{
+    rlist->length--;
+    rlist->finger = NULL;
+
+    if (--node->count) return;
+
+    jll_rnode_t * prev = node->prev;
+    __jll_rlist_unlink_free(rlist, node);
+    __jll_rlist_rejoin(rlist, prev);
+}
+
+/**
+ * @brief Finds the run holding a position, starting from whichever of the head, the tail and the
+ * finger is closest, and leaves the finger on it
+ *
+ * @param rlist Pointer to the list
+ * @param index Position, which must be in range
+ * @param start Receives the position of the run's first element
+ *
+ * @returns The run
+ */
+static jll_rnode_t * __jll_rlist_locate(jll_rlist_t * rlist, size_t index, size_t * start)
+{
+    assert(index < rlist->length);
+
+    jll_rnode_t * rover = rlist->head;
+    size_t first = 0;
+    size_t distance = index;
+
+    if (rlist->length - index < distance)
+    {
+        rover = rlist->tail;
+        first = rlist->length - rover->count;
+        distance = rlist->length - index;
+    }
+
+    if (rlist->finger)
+    {
+        size_t from_finger = (index >= rlist->finger_start) ? index - rlist->finger_start : rlist->finger_start - index;
+
+        if (from_finger < distance)
+        {
+            rover = rlist->finger;
+            first = rlist->finger_start;
+        }
+    }
+
+    while (index < first)
+    {
+        rover = rover->prev;
+        first -= rover->count;
+    }
+
+    while (index >= first + rover->count)
+    {
+        first += rover->count;
+        rover = rover->next;
+    }
+
+    rlist->finger = rover;
+    rlist->finger_start = first;
+
+    *start = first;
+    return rover;
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Allocate a run-length compressed list
+ *
+ * @param compfunc Comparator deciding when elements share a run (may be NULL: only identical pointers do)
+ *
+ * @returns Pointer to the newly created list
+ */
+jll_rlist_t * jll_alloc_rlist(data_compfunc_t compfunc)
+{
+    JLL_LAT_SCOPE(RLIST_ALLOC);
+    jll_rlist_t * new_rlist = (jll_rlist_t *)malloc(sizeof(jll_rlist_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_rlist_t));
+
+    new_rlist->head = NULL;
+    new_rlist->tail = NULL;
+    new_rlist->length = 0;
+    new_rlist->runs = 0;
+    new_rlist->finger = NULL;
+    new_rlist->finger_start = 0;
+    new_rlist->rlist_comp_func = compfunc;
+
+    return new_rlist;
+}
+
+/**
+ * @brief Deallocate a run-length compressed list
+ *
+ * @param rlist Pointer to the list
+ * @param data_dealloc_func User-specified function called once per run on the pointer it retains (may be NULL)
+ *
+ * @returns None (is void)
+ */
+void jll_dealloc_rlist(jll_rlist_t * rlist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(RLIST_DEALLOC);
+    assert(rlist);
+
+    jll_rnode_t * rover = rlist->head;
+
+    while (rover)
+    {
+        jll_rnode_t * next = rover->next;
+
+        if (data_dealloc_func) data_dealloc_func(rover->data);
+        JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_rnode_t));
+        free(rover);
+
+        rover = next;
+    }
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_rlist_t));
+    free(rlist);
+}
+
+
+/* insertion functions */
+
+bool jll_rlist_append_head(jll_rlist_t * rlist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(RLIST_APPEND_HEAD);
+    assert(rlist);
+
+    bool merged = (rlist->head) && (__jll_rlist_equal(rlist, rlist->head->data, dptr));
+
+    // Every run but a grown head starts one position later.
+    if ((rlist->finger) && ((!merged) || (rlist->finger != rlist->head))) rlist->finger_start++;
+
+    if (merged) rlist->head->count++;
+    else __jll_rlist_link_after(rlist, NULL, __jll_rlist_new_node(dptr, 1));
+
+    rlist->length++;
+    return merged;
+}
+
+bool jll_rlist_append_tail(jll_rlist_t * rlist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(RLIST_APPEND_TAIL);
+    return jll_rlist_append_tail_n(rlist, dptr, 1);
+}
+
+/**
+ * @brief Append count copies of data at the tail, extending the tail run when it is equal
+ *
+ * @param rlist Pointer to the list
+ * @param dptr  Data to be appended
+ * @param count Number of copies
+ *
+ * @returns true if the data joined the tail run (its pointer is then retained only if it was identical)
+ */
+bool jll_rlist_append_tail_n(jll_rlist_t * rlist, const jll_data_t * dptr, size_t count)
+{
+    JLL_LAT_SCOPE(RLIST_APPEND_TAIL_N);
+    assert(rlist);
+
+    if (count == 0) return false;
+    rlist->length += count;
+
+    if ((rlist->tail) && (__jll_rlist_equal(rlist, rlist->tail->data, dptr)))
+    {
+        rlist->tail->count += count;
+        return true;
+    }
+
+    __jll_rlist_link_after(rlist, rlist->tail, __jll_rlist_new_node(dptr, count));
+    return false;
+}
+
+/**
+ * @brief Insert data at a position, joining the run it lands in or next to when equal and splitting
+ * that run otherwise
+ *
+ * @param rlist Pointer to the list
+ * @param index Position, at most the current length
+ * @param dptr  Data to be inserted
+ *
+ * @returns true if the data joined an existing run
+ */
+bool jll_rlist_insert_index(jll_rlist_t * rlist, size_t index, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(RLIST_INSERT_INDEX);
+    assert(rlist);
+    assert(index <= rlist->length);
+
+    if (index == rlist->length) return jll_rlist_append_tail(rlist, dptr);
+
+    size_t start;
+    jll_rnode_t * run = __jll_rlist_locate(rlist, index, &start);
+    bool merged = true;
+
+    if (__jll_rlist_equal(rlist, run->data, dptr)) run->count++;
+    else if ((index == start) && (run->prev) && (__jll_rlist_equal(rlist, run->prev->data, dptr))) run->prev->count++;
+    else
+    {
+        if (index > start) __jll_rlist_split(rlist, run, index - start);
+        else run = run->prev;
+
+        __jll_rlist_link_after(rlist, run, __jll_rlist_new_node(dptr, 1));
+        merged = false;
+    }
+
+    rlist->length++;
+    rlist->finger = NULL;
+
+    return merged;
+}
+
+/**
+ * @brief Append every element of a doubly-linked list, compressing runs as they appear
+ *
+ * @param rlist Pointer to the list
+ * @param src   Pointer to the list read from (unchanged)
+ *
+ * @returns None (is void)
+ */
+void jll_rlist_insert_from_dlist(jll_rlist_t * rlist, const jll_dlist_t * src)
+{
+    JLL_LAT_SCOPE(RLIST_INSERT_FROM_DLIST);
+    assert(rlist);
+    assert(src);
+
+    const jll_dnode_t * rover = src->head;
+
+    // Tombstones of a lazily deleted source are stepped over.
+    for (size_t k = 0; k < src->length + src->tombstones; k++)
+    {
+        if (rover->data) jll_rlist_append_tail(rlist, rover->data);
+        rover = rover->next;
+    }
+}
+
+
+/* deletion functions */
+
+/**
+ * @brief Remove the element at a position. Removing from a run shortens it; the run's pointer is
+ * returned and stays in the list until the run's last element goes.
+ *
+ * @returns The data at that position, or NULL if the position is out of range
+ */
+const jll_data_t * jll_rlist_remove_index(jll_rlist_t * rlist, size_t index)
+{
+    JLL_LAT_SCOPE(RLIST_REMOVE_INDEX);
+    assert(rlist);
+
+    if (index >= rlist->length) return NULL;
+
+    size_t start;
+    jll_rnode_t * run = __jll_rlist_locate(rlist, index, &start);
+    const jll_data_t * old_data_ptr = run->data;
+
+    __jll_rlist_drop_one(rlist, run);
+    return old_data_ptr;
+}
+
+const jll_data_t * jll_rlist_remove_head(jll_rlist_t * rlist)
+{
+    JLL_LAT_SCOPE(RLIST_REMOVE_HEAD);
+    assert(rlist);
+
+    if (jll_rlist_is_empty(rlist)) return NULL;
+
+    const jll_data_t * old_data_ptr = rlist->head->data;
+    __jll_rlist_drop_one(rlist, rlist->head);
+
+    return old_data_ptr;
+}
+
+const jll_data_t * jll_rlist_remove_tail(jll_rlist_t * rlist)
+{
+    JLL_LAT_SCOPE(RLIST_REMOVE_TAIL);
+    assert(rlist);
+
+    if (jll_rlist_is_empty(rlist)) return NULL;
+
+    const jll_data_t * old_data_ptr = rlist->tail->data;
+    __jll_rlist_drop_one(rlist, rlist->tail);
+
+    return old_data_ptr;
+}
+
+/**
+ * @brief Remove count elements starting at a position. Runs cut at either end of the range are shortened;
+ * runs wholly inside it are freed, one per run, rather than element by element.
+ *
+ * @param rlist Pointer to the list
+ * @param index Position of the first element removed
+ * @param count Number of elements (clamped to the end of the list)
+ * @param data_dealloc_func User-specified function called on the pointer of each run removed whole (may be NULL)
+ *
+ * @returns Number of elements removed
+ */
+size_t jll_rlist_remove_range(jll_rlist_t * rlist, size_t index, size_t count, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(RLIST_REMOVE_RANGE);
+    assert(rlist);
+
+    if (index >= rlist->length) return 0;
+    if (count > rlist->length - index) count = rlist->length - index;
+    if (count == 0) return 0;
+
+    size_t start;
+    jll_rnode_t * rover = __jll_rlist_locate(rlist, index, &start);
+    size_t offset = index - start;
+    jll_rnode_t * before = (offset) ? rover : rover->prev;
+    size_t removed = 0;
+
+    while (removed < count)
+    {
+        size_t take = rover->count - offset;
+        if (take > count - removed) take = count - removed;
+
+        jll_rnode_t * next = rover->next;
+        rover->count -= take;
+        removed += take;
+
+        if (rover->count == 0)
+        {
+            if (data_dealloc_func) data_dealloc_func(rover->data);
+            __jll_rlist_unlink_free(rlist, rover);
+        }
+
+        rover = next;
+        offset = 0;
+    }
+
+    rlist->length -= removed;
+    rlist->finger = NULL;
+    __jll_rlist_rejoin(rlist, before);
+
+    return removed;
+}
+
+
+/* access functions */
+
+const jll_data_t * jll_rlist_index_pos(jll_rlist_t * rlist, size_t index)
+{
+    JLL_LAT_SCOPE(RLIST_INDEX_POS);
+    assert(rlist);
+
+    if (index >= rlist->length) return NULL;
+
+    size_t start;
+    return __jll_rlist_locate(rlist, index, &start)->data;
+}
+
+const jll_data_t * jll_rlist_index_head(const jll_rlist_t * rlist)
+{
+    assert(rlist);
+    return (rlist->head) ? rlist->head->data : NULL;
+}
+
+const jll_data_t * jll_rlist_index_tail(const jll_rlist_t * rlist)
+{
+    assert(rlist);
+    return (rlist->tail) ? rlist->tail->data : NULL;
+}
+
+/**
+ * @brief Find the first element satisfying a predicate, which is called once per run
+ *
+ * @param rlist    Pointer to the list
+ * @param compfunc Predicate
+ * @param position Receives the position of the element found (may be NULL)
+ *
+ * @returns The data, or NULL if no element matches
+ */
+const jll_data_t * jll_rlist_find_first_occurrence(const jll_rlist_t * rlist, bool (*compfunc)(const jll_data_t *), size_t * position)
+{
+    JLL_LAT_SCOPE(RLIST_FIND_FIRST_OCCURRENCE);
+    assert(rlist);
+    assert(compfunc);
+
+    size_t start = 0;
+
+    for (const jll_rnode_t * rover = rlist->head; rover; rover = rover->next)
+    {
+        if (compfunc(rover->data))
+        {
+            if (position) *position = start;
+            return rover->data;
+        }
+
+        start += rover->count;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Count the elements satisfying a predicate, which is called once per run
+ */
+size_t jll_rlist_count_cond(const jll_rlist_t * rlist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(RLIST_COUNT_COND);
+    assert(rlist);
+    assert(compfunc);
+
+    size_t count = 0;
+
+    for (const jll_rnode_t * rover = rlist->head; rover; rover = rover->next)
+    {
+        if (compfunc(rover->data)) count += rover->count;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Copy the list, decompressed, into a caller-provided array
+ *
+ * @returns Number of elements copied (at most max)
+ */
+size_t jll_rlist_to_array(const jll_rlist_t * rlist, const jll_data_t ** out, size_t max)
+{
+    assert(rlist);
+    assert(out || (max == 0));
+
+    size_t copied = 0;
+
+    for (const jll_rnode_t * rover = rlist->head; (rover) && (copied < max); rover = rover->next)
+    {
+        for (size_t k = 0; (k < rover->count) && (copied < max); k++) out[copied++] = rover->data;
+    }
+
+    return copied;
+}
+
+/**
+ * @brief Copy the runs into caller-provided arrays of data and repeat counts
+ *
+ * @returns Number of runs copied (at most max)
+ */
+size_t jll_rlist_runs_to_arrays(const jll_rlist_t * rlist, const jll_data_t ** data, size_t * counts, size_t max)
+{
+    assert(rlist);
+
+    size_t copied = 0;
+
+    for (const jll_rnode_t * rover = rlist->head; (rover) && (copied < max); rover = rover->next)
+    {
+        if (data) data[copied] = rover->data;
+        if (counts) counts[copied] = rover->count;
+        copied++;
+    }
+
+    return copied;
+}
+
+bool jll_rlist_is_empty(const jll_rlist_t * rlist)
+{
+    assert(rlist);
+    return (rlist->length == 0);
+}
+
+
+/* compression statistics */
+
+size_t jll_rlist_length(const jll_rlist_t * rlist)
+{
+    assert(rlist);
+    return rlist->length;
+}
+
+size_t jll_rlist_runs(const jll_rlist_t * rlist)
+{
+    assert(rlist);
+    return rlist->runs;
+}
+
+/**
+ * @brief Elements per run: the factor by which the list is smaller than an uncompressed one (1 when empty)
+ */
+double jll_rlist_compression_ratio(const jll_rlist_t * rlist)
+{
+    assert(rlist);
+    return (rlist->runs) ? (double)rlist->length / (double)rlist->runs : 1.0;
+}
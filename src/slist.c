@@ -4,10 +4,468 @@
 # include <string.h>
 # include <assert.h>
 # include "./include/slist.h"
+# include "./include/reclaim.h"
+
+# define JLL_SLIST_TEARDOWN_BATCH 256
+# define JLL_SLIST_SCAN_BATCH 64
+# define JLL_SLIST_POOL_BLOCK 64
+# define JLL_SLIST_POOL_BLOCK_MAX 65536
+# define JLL_SLIST_SCAN_BATCH_MAX 256
+# define JLL_SLIST_SCAN_FIRST_BATCH 8
+
+
+/* bookkeeping hooks shared by every insertion and removal path */
+
+static void __jll_slist_note_insert(jll_slist_t * slist, const jll_data_t * dptr)
+{
+    if (slist->bloom) jll_bloom_insert(slist->bloom, dptr);
+}
+
+static void __jll_slist_note_remove(jll_slist_t * slist)
+{
+    slist->generation++;
+    if (slist->bloom) jll_bloom_note_removal(slist->bloom);
+}
+
+static void __jll_slist_note_payload(jll_slist_t * slist, const jll_data_payload_t * payload)
+{
+    slist->payload_bytes_issued += sizeof(jll_data_payload_t) + payload->capacity * sizeof(jll_data_t *);
+}
+
+/**
+ * @brief Returns the cached sort key of data, or 0 when the list keeps no keys
+ */
+static uint64_t __jll_slist_key_of(const jll_slist_t * slist, const jll_data_t * dptr)
+{
+    return (slist->slist_key_func) ? slist->slist_key_func(dptr) : 0;
+}
+
+/**
+ * @brief Size of the nodes a list holds: keyed nodes while it caches keys or counts, plain ones otherwise
+ */
+static size_t __jll_slist_node_bytes(const jll_slist_t * slist)
+{
+    return (slist->keyed) ? sizeof(jll_sknode_t) : sizeof(jll_snode_t);
+}
+
+static void __jll_slist_rekey(const jll_slist_t * slist, jll_snode_t * rover, size_t count)
+{
+    for (size_t k = 0; k < count; k++)
+    {
+        JLL_SKNODE(rover)->key = __jll_slist_key_of(slist, rover->data);
+        rover = rover->next;
+    }
+}
+
+static jll_snode_t * __jll_slist_new_node(jll_slist_t * slist, const jll_data_t * dptr)
+{
+    JLL_PROF_ALLOC(slist);
+    jll_snode_t * node;
+
+    // Rings recycle the nodes preallocated at creation.
+    if (slist->spare)
+    {
+        node = slist->spare;
+        slist->spare = node->next;
+
+        node->next = NULL;
+        node->data = dptr;
+
+        JLL_MEM_ADD(JLL_MEM_NODES, __jll_slist_node_bytes(slist));
+    }
+    else if (slist->keyed) node = &((slist->pool) ? jll_alloc_sknode_from(slist->pool, dptr) : jll_alloc_sknode(dptr))->node;
+    else node = (slist->pool) ? jll_alloc_snode_from(slist->pool, dptr) : jll_alloc_snode(dptr);
+
+    if (slist->keyed)
+    {
+        JLL_SKNODE(node)->key = __jll_slist_key_of(slist, dptr);
+        JLL_SKNODE(node)->freq = 0;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Frees a node of the kind the list holds, back to the pool (or heap) it came from. Only nodes which
+ * may have come from elsewhere need their owner looked up; the rest go straight to the list's own pool.
+ */
+static const jll_data_t * __jll_slist_dealloc_node(const jll_slist_t * slist, jll_snode_t * node)
+{
+    if (slist->foreign_nodes) return (slist->keyed) ? jll_dealloc_sknode(JLL_SKNODE(node)) : jll_dealloc_snode(node);
+    return (slist->keyed) ? jll_dealloc_sknode_to(slist->pool, JLL_SKNODE(node)) : jll_dealloc_snode_to(slist->pool, node);
+}
+
+static const jll_data_t * __jll_slist_free_node(jll_slist_t * slist, jll_snode_t * node)
+{
+    JLL_PROF_FREE(slist);
+
+    if (slist->capacity)
+    {
+        const jll_data_t * old_data_ptr = node->data;
+
+        node->next = slist->spare;
+        slist->spare = node;
+
+        JLL_MEM_SUB(JLL_MEM_NODES, __jll_slist_node_bytes(slist));
+        return old_data_ptr;
+    }
+
+    return __jll_slist_dealloc_node(slist, node);
+}
+
+/**
+ * @brief Hands the idle nodes of a ring back to the pool (or heap) they came from
+ */
+static void __jll_slist_release_spare(jll_slist_t * slist)
+{
+    while (slist->spare)
+    {
+        jll_snode_t * next = slist->spare->next;
+        if (!jll_pool_release(slist->spare)) free(slist->spare);
+        slist->spare = next;
+    }
+}
+
+/**
+ * @brief Preallocates the nodes of a ring in one block of a fresh pool and threads them onto the spare chain
+ */
+static void __jll_slist_stock_ring(jll_slist_t * slist)
+{
+    size_t bytes = __jll_slist_node_bytes(slist);
+
+    slist->pool = jll_alloc_pool(bytes, slist->capacity, false);
+    char * block = (char *)jll_pool_get_block(slist->pool, slist->capacity, false);
+
+    for (size_t k = slist->capacity; k > 0; k--)
+    {
+        jll_snode_t * node = (jll_snode_t *)(block + (k - 1) * bytes);
+        node->next = slist->spare;
+        slist->spare = node;
+    }
+}
+
+/**
+ * @brief Moves the nodes of a list into nodes of the other kind, keyed or plain, so that only lists which
+ * cache keys or counts pay for them. Ring and pool storage is replaced by storage of the new node size,
+ * and node handles are invalidated.
+ * @returns False, leaving the list untouched, if it holds nodes linked in by the caller, which must not move
+ */
+static bool __jll_slist_recast(jll_slist_t * slist, bool keyed)
+{
+    if (slist->keyed == keyed) return true;
+
+    if (jll_slist_is_empty(slist)) slist->caller_nodes = false;
+    if (slist->caller_nodes) return false;
+
+    jll_pool_t * old_pool = slist->pool;
+    jll_snode_t * old_spare = slist->spare;
+    jll_snode_t * rover = slist->head;
+
+    slist->keyed = keyed;
+    slist->spare = NULL;
+    slist->head = NULL;
+    slist->tail = NULL;
+
+    if (slist->capacity) __jll_slist_stock_ring(slist);
+    else if (old_pool) slist->pool = jll_alloc_pool(__jll_slist_node_bytes(slist), JLL_SLIST_POOL_BLOCK, old_pool->hugepage);
+
+    for (size_t k = 0; k < slist->length; k++)
+    {
+        jll_snode_t * next = rover->next;
+        jll_snode_t * copy = __jll_slist_new_node(slist, rover->data);
+
+        if (slist->tail) slist->tail->next = copy;
+        else slist->head = copy;
+        slist->tail = copy;
+
+        // The old node is of the kind being left behind.
+        if (keyed) jll_dealloc_snode(rover);
+        else jll_dealloc_sknode(JLL_SKNODE(rover));
+        rover = next;
+    }
+
+    if (slist->tail) slist->tail->next = (slist->circular) ? slist->head : NULL;
+
+    // The old ring's idle nodes go back too, after which the orphaned pool is destroyed.
+    while (old_spare)
+    {
+        jll_snode_t * next = old_spare->next;
+        jll_pool_release(old_spare);
+        old_spare = next;
+    }
+
+    if (old_pool) jll_dealloc_pool(old_pool);
+
+    slist->foreign_nodes = false;
+    slist->generation++;
+    return true;
+}
+
+/**
+ * @brief Brings the nodes of a list in line with its configuration: keyed nodes while it has a key function
+ * or counts accesses, plain nodes otherwise
+ */
+static bool __jll_slist_conform(jll_slist_t * slist)
+{
+    return __jll_slist_recast(slist, (slist->slist_key_func) || (slist->reorg == JLL_REORG_COUNT));
+}
+
+
+/**
+ * @brief Fits a node which has just entered a count-ordered list into the order: it takes the count of the
+ * node it landed before when that is higher, so counts stay non-increasing from head to tail
+ */
+static void __jll_slist_count_in(jll_slist_t * slist, jll_snode_t * node)
+{
+    if ((slist->reorg != JLL_REORG_COUNT) || (node == slist->tail)) return;
+
+    size_t next_freq = JLL_SKNODE(node->next)->freq;
+    if (JLL_SKNODE(node)->freq < next_freq) JLL_SKNODE(node)->freq = next_freq;
+}
+
+/**
+ * @brief Zeroes the counts of a count-ordered list, for when the nodes were put in an order of their own
+ */
+static void __jll_slist_restart_counts(jll_slist_t * slist)
+{
+    if (slist->reorg != JLL_REORG_COUNT) return;
+
+    jll_snode_t * rover = slist->head;
+    for (size_t k = 0; k < slist->length; k++)
+    {
+        JLL_SKNODE(rover)->freq = 0;
+        rover = rover->next;
+    }
+}
+
+/**
+ * @brief Hands the nodes of a donor list over to the list absorbing them: they are converted to the absorbing
+ * list's kind of node if need be, the absorbing list's filter and cached sort keys take in the new data, the
+ * donor is left empty and both lists' node handles are invalidated.
+ * @param tail Receives the last of the handed-over nodes
+ * @returns The first of the handed-over nodes (NULL if the donor was empty)
+ */
+static jll_snode_t * __jll_slist_absorb(jll_slist_t * slist, jll_slist_t * donor, jll_snode_t ** tail)
+{
+    // Nodes the caller linked in cannot be converted, so such a donor must already hold the right kind.
+    __jll_slist_recast(donor, slist->keyed);
+    assert(donor->keyed == slist->keyed);
+
+    jll_snode_t * head = donor->head;
+    *tail = donor->tail;
+
+    // Nodes keyed by another key function (or by none) take the absorbing list's keys.
+    if ((slist->slist_key_func) && (donor->slist_key_func != slist->slist_key_func)) __jll_slist_rekey(slist, donor->head, donor->length);
+
+    if (slist->bloom)
+    {
+        jll_snode_t * rover = donor->head;
+        for (size_t k = 0; k < donor->length; k++)
+        {
+            jll_bloom_insert(slist->bloom, rover->data);
+            rover = rover->next;
+        }
+    }
+
+    if (donor->bloom) jll_bloom_reset(donor->bloom, 0);
+
+    // Counts gathered in the donor mean nothing here; the handed-over nodes start at zero.
+    if (slist->reorg == JLL_REORG_COUNT)
+    {
+        jll_snode_t * rover = donor->head;
+        for (size_t k = 0; k < donor->length; k++)
+        {
+            JLL_SKNODE(rover)->freq = 0;
+            rover = rover->next;
+        }
+    }
+
+    donor->head = NULL;
+    donor->tail = NULL;
+    donor->length = 0;
+    donor->generation++;
+    donor->pool_shared = true;
+    donor->foreign_nodes = false;
+
+    slist->generation++;
+    slist->pool_shared = true;
+    slist->foreign_nodes = true;
+
+    // Left empty, the donor goes back to the kind of node its own configuration calls for.
+    __jll_slist_conform(donor);
+    return head;
+}
+
+
+/* adaptive sorted insertion */
+
+/**
+ * @brief Returns true if a node belongs after the node being inserted (the comparison function returns -1).
+ * Cached keys settle the order whenever they differ, so only ties read the data.
+ */
+static bool __jll_slist_goes_after(jll_slist_t * slist, const jll_snode_t * node, const jll_snode_t * incoming)
+{
+    if ((slist->slist_key_func) && (JLL_SKNODE(node)->key != JLL_SKNODE(incoming)->key))
+    {
+        slist->insert_stats.key_decisions++;
+        return (JLL_SKNODE(node)->key > JLL_SKNODE(incoming)->key);
+    }
+
+    JLL_PROF_CMP(slist);
+    slist->insert_stats.comparisons++;
+    return (slist->slist_comp_func(node->data, incoming->data) == -1);
+}
+
+/**
+ * @brief Orders two nodes as the comparison function would, deciding on the cached keys whenever they differ
+ */
+static int __jll_slist_compare_nodes(jll_slist_t * slist, const jll_snode_t * a, const jll_snode_t * b)
+{
+    if ((slist->slist_key_func) && (JLL_SKNODE(a)->key != JLL_SKNODE(b)->key)) return (JLL_SKNODE(a)->key > JLL_SKNODE(b)->key) ? -1 : 1;
+
+    JLL_PROF_CMP(slist);
+    return slist->slist_comp_func(a->data, b->data);
+}
+
+static jll_snode_t * __jll_slist_advance(jll_slist_t * slist, jll_snode_t * node, size_t steps, size_t * taken)
+{
+    size_t k = 0;
+
+    while ((k < steps) && (node != slist->tail))
+    {
+        node = node->next;
+        JLL_PROF_HOP(slist);
+        k++;
+    }
+
+    slist->insert_stats.hops += k;
+    *taken = k;
+    return node;
+}
+
+/**
+ * @brief Bisects a bracket in which lo does not belong after the incoming node and the node distance hops further on does
+ * @returns The last node which does not belong after the incoming node
+ */
+static jll_snode_t * __jll_slist_bisect(jll_slist_t * slist, jll_snode_t * lo, size_t distance, const jll_snode_t * incoming)
+{
+    while (distance > 1)
+    {
+        size_t half = distance / 2;
+        size_t taken;
+        jll_snode_t * mid = __jll_slist_advance(slist, lo, half, &taken);
+
+        if (__jll_slist_goes_after(slist, mid, incoming)) distance = half;
+        else
+        {
+            lo = mid;
+            distance -= half;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Exponential search forward from a node which does not belong after the incoming node
+ * @returns The last node which does not belong after the incoming node
+ */
+static jll_snode_t * __jll_slist_gallop_forward(jll_slist_t * slist, jll_snode_t * lo, const jll_snode_t * incoming)
+{
+    size_t step = 1;
+
+    while (lo != slist->tail)
+    {
+        size_t taken;
+        jll_snode_t * probe = __jll_slist_advance(slist, lo, step, &taken);
+
+        if (__jll_slist_goes_after(slist, probe, incoming)) return __jll_slist_bisect(slist, lo, taken, incoming);
+
+        lo = probe;
+        step <<= 1;
+    }
+
+    return lo;
+}
+
+/**
+ * @brief Finds where a new node belongs in a sorted list: after the tail for in-order data, otherwise by
+ * galloping out from the last insertion point or from the head.
+ * @returns The node which the new node should follow, or NULL if it becomes the head
+ */
+static jll_snode_t * __jll_slist_locate_sorted(jll_slist_t * slist, const jll_snode_t * incoming)
+{
+    if (!__jll_slist_goes_after(slist, slist->tail, incoming))
+    {
+        slist->insert_stats.tail_hits++;
+        return slist->tail;
+    }
+
+    // The finger is only trusted while no node has been removed or moved since it was set.
+    if ((slist->finger) && (slist->finger_generation == slist->generation) && (slist->finger != slist->tail))
+    {
+        if (!__jll_slist_goes_after(slist, slist->finger, incoming))
+        {
+            slist->insert_stats.finger_hits++;
+            return __jll_slist_gallop_forward(slist, slist->finger, incoming);
+        }
+    }
+
+    if (__jll_slist_goes_after(slist, slist->head, incoming)) return NULL;
+    return __jll_slist_gallop_forward(slist, slist->head, incoming);
+}
 
 
 /* allocators and deallocators */
 
+/**
+ * @brief Initialise a singly-linked list embedded by value in another structure; no memory is allocated
+ * 
+ * @param slist Pointer to the list storage to be initialised
+ * @param func The comparison function which the list will use for sorted-based insertions
+ * @param circflag Boolean flag which determines if the list will be circular or not
+ * @param sortflag Boolean flag which determines if the list will be sorted or not
+ * @param perflag  Boolean flag which determines if the list will be persistent or not
+ * 
+ * @returns None (is void)
+ */
+void jll_init_slist(jll_slist_t * slist, data_compfunc_t func, bool circflag, bool sortflag, bool perflag)
+{
+    assert(slist);
+
+    slist->head = NULL;
+    slist->tail = NULL;
+    slist->length = 0;
+
+    slist->circular = circflag;
+    slist->sorted   = sortflag;
+    slist->persistent = perflag;
+    slist->keyed = false;
+
+    slist->reorg = JLL_REORG_NONE;
+    slist->bloom = NULL;
+    slist->payload_bytes_issued = 0;
+    slist->pool = NULL;
+    slist->pool_shared = false;
+    slist->caller_nodes = false;
+    slist->foreign_nodes = false;
+    slist->generation = 0;
+
+    slist->finger = NULL;
+    slist->finger_generation = 0;
+    memset(&slist->insert_stats, 0, sizeof(jll_insert_stats_t));
+
+    slist->capacity = 0;
+    slist->ring_policy = JLL_RING_OVERWRITE;
+    slist->spare = NULL;
+    slist->ring_evict_func = NULL;
+    slist->scan_batch = JLL_SLIST_SCAN_BATCH;
+    JLL_PROF_INIT(slist);
+    
+    slist->slist_comp_func = func;
+    slist->slist_key_func = NULL;
+}
+
 /**
  * @brief Allocate memory for a singly-linked list
  * 
@@ -18,533 +476,2525 @@
  * 
  * @returns Pointer to the newly created singly-linked list
  */
-jll_slist_t * jll_alloc_slist(data_compfunc_t func, bool circflag, bool sortflag, bool perflag)
+jll_slist_t * jll_alloc_slist(data_compfunc_t func, bool circflag, bool sortflag, bool perflag)
+{
+    JLL_LAT_SCOPE(SLIST_ALLOC);
+    jll_slist_t * new_slist = (jll_slist_t *)malloc(sizeof(jll_slist_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_slist_t));
+
+    jll_init_slist(new_slist, func, circflag, sortflag, perflag);
+
+    return new_slist;
+}
+
+/**
+ * @brief Allocate a bounded ring: a circular singly-linked list of fixed capacity whose nodes are preallocated
+ * in one block and recycled, so pushes and pops never allocate
+ * 
+ * @param func     The comparison function used by keyed lookups (may be NULL)
+ * @param capacity Maximum number of elements held
+ * @param policy   Whether a push onto a full ring overwrites the element at the opposite end or is rejected
+ * @param evict_func User-specified function handed the data of overwritten elements (may be NULL)
+ * 
+ * @returns Pointer to the newly created ring
+ */
+jll_slist_t * jll_alloc_slist_ring(data_compfunc_t func, size_t capacity, jll_ring_policy_t policy, void (*evict_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_ALLOC_RING);
+    assert(capacity > 0);
+
+    jll_slist_t * new_ring = jll_alloc_slist(func, true, false, false);
+
+    new_ring->capacity = capacity;
+    new_ring->ring_policy = policy;
+    new_ring->ring_evict_func = evict_func;
+
+    __jll_slist_stock_ring(new_ring);
+
+    return new_ring;
+}
+
+/**
+ * @brief Releases the nodes of a list, handing the data to either the per-element or the batched
+ * function (either or both may be NULL). When every node came from the list's own pool and none were
+ * ever exchanged with another list, the pool is dropped wholesale instead of node by node; with no
+ * data function as well, the nodes are not visited at all. The header itself is left to the caller.
+ */
+static void __jll_slist_teardown(jll_slist_t * slist, void (*data_dealloc_func)(const jll_data_t *), data_batchdealloc_t data_batch_func)
+{
+    __jll_slist_release_spare(slist);
+
+    // Matching counts alone prove nothing: heap or caller nodes can be linked while pool slots are out elsewhere.
+    bool own_nodes = (!slist->foreign_nodes) && (!slist->caller_nodes);
+    bool bulk = (slist->pool) && (!slist->pool_shared) && (own_nodes) && (jll_pool_live(slist->pool) == slist->length);
+    bool visit = (!bulk) || (data_dealloc_func) || (data_batch_func);
+
+    const jll_data_t * batch[JLL_SLIST_TEARDOWN_BATCH];
+    size_t batched = 0;
+
+    jll_snode_t * fptr = slist->head;
+    jll_snode_t * bptr = NULL;
+
+    // Bounded by length so circular lists terminate.
+    for (size_t k = 0; (visit) && (k < slist->length); k++)
+    {
+        bptr = fptr;
+        fptr = fptr->next;
+
+        const jll_data_t * old_data_ptr = (bulk) ? bptr->data : __jll_slist_free_node(slist, bptr);
+
+        if (data_batch_func)
+        {
+            batch[batched++] = old_data_ptr;
+            if (batched == JLL_SLIST_TEARDOWN_BATCH)
+            {
+                data_batch_func(batch, batched);
+                batched = 0;
+            }
+        }
+        else if (data_dealloc_func) data_dealloc_func(old_data_ptr);
+    }
+
+    if (batched) data_batch_func(batch, batched);
+
+    if (bulk)
+    {
+        JLL_MEM_SUB(JLL_MEM_NODES, slist->length * __jll_slist_node_bytes(slist));
+        jll_pool_discard(slist->pool);
+    }
+    else
+    {
+        // Ring nodes freed by the walk were parked on the spare chain.
+        __jll_slist_release_spare(slist);
+        if (slist->pool) jll_dealloc_pool(slist->pool);
+    }
+
+    if (slist->bloom) jll_dealloc_bloom(slist->bloom);
+}
+
+static void __jll_slist_reclaim(jll_reclaim_job_t * job)
+{
+    jll_slist_t * slist = (jll_slist_t *)job->object;
+
+    __jll_slist_teardown(slist, job->data_dealloc_func, job->data_batch_func);
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_slist_t));
+    free(slist);
+}
+
+/**
+ * @brief Deallocate memory for a singly-linked list.
+ * 
+ * @param slist Pointer to the singly-linked list to be deallocated
+ * @param data_dealloc_func User-specified function which should handle deallocated the jll_data_t pointers referenced
+ * by the nodes of the linked list (may be NULL when the list does not own its data).
+ * 
+ * @returns None (is void)
+ * 
+ */
+void jll_dealloc_slist(jll_slist_t * slist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_DEALLOC);
+    assert(slist);
+
+    __jll_slist_teardown(slist, data_dealloc_func, NULL);
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_slist_t));
+    free(slist);
+}
+
+/**
+ * @brief Deallocate a singly-linked list, handing the data to a user-specified function in arrays
+ * of up to JLL_SLIST_TEARDOWN_BATCH elements rather than one call per element
+ * 
+ * @param slist Pointer to the singly-linked list to be deallocated
+ * @param data_batch_func User-specified function releasing an array of data pointers (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_dealloc_slist_batched(jll_slist_t * slist, data_batchdealloc_t data_batch_func)
+{
+    JLL_LAT_SCOPE(SLIST_DEALLOC_BATCHED);
+    assert(slist);
+
+    __jll_slist_teardown(slist, NULL, data_batch_func);
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_slist_t));
+    free(slist);
+}
+
+/**
+ * @brief Release the nodes and auxiliary structures of a list initialised with jll_init_slist, leaving
+ * the (embedded) header storage to its owner. The list is left empty (keeping its comparison and key
+ * functions) and may be initialised again.
+ * 
+ * @param slist Pointer to the embedded singly-linked list
+ * @param data_dealloc_func User-specified function releasing the data referenced by each node (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_fini_slist(jll_slist_t * slist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    assert(slist);
+
+    data_keyfunc_t key_func = slist->slist_key_func;
+
+    __jll_slist_teardown(slist, data_dealloc_func, NULL);
+    jll_init_slist(slist, slist->slist_comp_func, slist->circular, slist->sorted, slist->persistent);
+
+    slist->slist_key_func = key_func;
+    slist->keyed = (key_func != NULL);
+}
+
+/**
+ * @brief Deallocate a singly-linked list on the background reclaimer thread. The call returns in
+ * constant time; the list must not be touched again by the caller, and the data function runs on
+ * the reclaimer thread.
+ * 
+ * @param slist Pointer to the singly-linked list to be deallocated
+ * @param data_dealloc_func User-specified function releasing the data referenced by each node (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_dealloc_slist_deferred(jll_slist_t * slist, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_DEALLOC_DEFERRED);
+    assert(slist);
+
+    jll_reclaim_submit(__jll_slist_reclaim, slist, data_dealloc_func, NULL);
+}
+
+/**
+ * @brief Deallocate a singly-linked list on the background reclaimer thread, releasing the data in batches
+ */
+void jll_dealloc_slist_deferred_batched(jll_slist_t * slist, data_batchdealloc_t data_batch_func)
+{
+    JLL_LAT_SCOPE(SLIST_DEALLOC_DEFERRED_BATCHED);
+    assert(slist);
+
+    jll_reclaim_submit(__jll_slist_reclaim, slist, NULL, data_batch_func);
+}
+
+
+/* insertion functions */
+
+/**
+ * @brief Appends a new node as the head of a singly-linked list
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param dptr  Data which is to be referenced by the newly appended head
+ *
+ * @returns None (is void)
+ * 
+ */
+void jll_slist_append_head(jll_slist_t * slist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(SLIST_APPEND_HEAD);
+    assert(slist);
+    assert(dptr);
+
+    // A full ring applies its overwrite/reject policy instead of growing.
+    if (jll_slist_ring_is_full(slist))
+    {
+        jll_slist_ring_push_head(slist, dptr);
+        return;
+    }
+
+    JLL_PROF_OP(slist);
+
+    jll_snode_t * newptr = __jll_slist_new_node(slist, dptr);
+
+    if (jll_slist_is_empty(slist))
+    {
+        slist->tail = newptr;
+        slist->head = newptr;
+    }
+    else
+    {
+        newptr->next = slist->head;
+        slist->head  = newptr;
+    }
+
+    slist->length++;
+    __jll_slist_note_insert(slist, dptr);
+    if (slist->circular) slist->tail->next = slist->head; // Double checking.
+
+    __jll_slist_count_in(slist, newptr);
+}
+
+
+/**
+ * @brief Appends a new tail to a singly-linked list
+ * 
+ * @param slist Pointer to the singly-linked list to be appended to
+ * @param dptr  Data to be referenced by the newly appended tail node
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_append_tail(jll_slist_t * slist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(SLIST_APPEND_TAIL);
+    assert(slist);
+    assert(dptr);
+
+
+    // A full ring applies its overwrite/reject policy instead of growing.
+    if (jll_slist_ring_is_full(slist))
+    {
+        jll_slist_ring_push_tail(slist, dptr);
+        return;
+    }
+
+    JLL_PROF_OP(slist);
+
+    jll_snode_t * newptr = __jll_slist_new_node(slist, dptr);
+
+    if (jll_slist_is_empty(slist))
+    {
+        slist->tail = newptr;
+        slist->head = newptr;
+    }
+    else
+    {
+        slist->tail->next = newptr;
+        slist->tail = newptr;
+    }
+
+    slist->length++;
+    __jll_slist_note_insert(slist, dptr);
+    if (slist->circular) slist->tail->next = slist->head; // Double checking.
+}
+
+/**
+ * @brief Inserts a node into a sorted singly-linked list, after any nodes comparing equal to it.
+ * The search is adaptive: in-order data costs one comparison against the tail, and out-of-order data
+ * gallops forward from the previous insertion point when it lies ahead of it (from the head otherwise).
+ * 
+ * @param slist Pointer to the singly linked list
+ * @param dptr  Data to be referenced by the newly inserted node
+ * 
+ * @returns None (is void)
+ * 
+ */
+void jll_slist_insert_sorted(jll_slist_t * slist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(SLIST_INSERT_SORTED);
+    assert(slist);
+    assert(dptr);
+    assert(slist->slist_comp_func);
+    assert(!jll_slist_ring_is_full(slist));
+
+    JLL_PROF_OP(slist);
+    slist->insert_stats.inserts++;
+
+    jll_snode_t * new_node = __jll_slist_new_node(slist, dptr);
+    jll_snode_t * after = (jll_slist_is_empty(slist)) ? NULL : __jll_slist_locate_sorted(slist, new_node);
+
+    if (jll_slist_is_empty(slist))
+    {
+        slist->head = new_node;
+        slist->tail = new_node;
+    }
+    else if (!after)
+    {
+        new_node->next = slist->head;
+        slist->head = new_node;
+    }
+    else
+    {
+        new_node->next = after->next;
+        after->next = new_node;
+        if (after == slist->tail) slist->tail = new_node;
+    }
+
+    slist->length++;
+    __jll_slist_note_insert(slist, dptr);
+    slist->tail->next = (slist->circular) ? slist->head : NULL;
+
+    slist->finger = new_node;
+    slist->finger_generation = slist->generation;
+}
+
+
+
+
+/* bounded ring mode */
+
+static jll_snode_t * __jll_slist_predecessor(jll_slist_t * slist, jll_snode_t * node)
+{
+    jll_snode_t * rover = slist->head;
+
+    while (rover->next != node)
+    {
+        rover = rover->next;
+        JLL_PROF_HOP(slist);
+    }
+
+    return rover;
+}
+
+/**
+ * @brief Overwrites the oldest element at one end of a full ring with new data, turning that node into the other end.
+ * The ring is circular and full, so this is a rotation: no node is linked, unlinked or allocated.
+ */
+static void __jll_slist_ring_overwrite(jll_slist_t * slist, const jll_data_t * dptr, bool at_tail)
+{
+    jll_snode_t * victim = (at_tail) ? slist->head : slist->tail;
+    const jll_data_t * old_data_ptr = victim->data;
+
+    victim->data = dptr;
+
+    if (slist->keyed)
+    {
+        JLL_SKNODE(victim)->key = __jll_slist_key_of(slist, dptr);
+        JLL_SKNODE(victim)->freq = 0;
+    }
+
+    if (at_tail)
+    {
+        slist->tail = slist->head;
+        slist->head = slist->head->next;
+    }
+    else
+    {
+        slist->head = slist->tail;
+        slist->tail = __jll_slist_predecessor(slist, slist->tail);
+    }
+
+    __jll_slist_count_in(slist, victim);
+    __jll_slist_note_remove(slist);
+    __jll_slist_note_insert(slist, dptr);
+
+    if (slist->ring_evict_func) slist->ring_evict_func(old_data_ptr);
+}
+
+/**
+ * @brief Pushes data at the tail of a bounded ring. When the ring is full the policy decides:
+ * overwrite evicts the head (handing its data to the ring's evict function), reject leaves the ring untouched.
+ * 
+ * @param slist Ring created with jll_alloc_slist_ring (or any list, which is never full)
+ * @param dptr  Data to be pushed
+ * 
+ * @returns False if the push was rejected, true otherwise
+ */
+bool jll_slist_ring_push_tail(jll_slist_t * slist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(SLIST_RING_PUSH_TAIL);
+    assert(slist);
+    assert(dptr);
+
+    if (!jll_slist_ring_is_full(slist))
+    {
+        jll_slist_append_tail(slist, dptr);
+        return true;
+    }
+
+    if (slist->ring_policy == JLL_RING_REJECT) return false;
+
+    JLL_PROF_OP(slist);
+    __jll_slist_ring_overwrite(slist, dptr, true);
+    return true;
+}
+
+/**
+ * @brief Pushes data at the head of a bounded ring; when full, overwrite evicts the tail,
+ * which costs a walk to find the new tail in a singly-linked ring
+ * 
+ * @returns False if the push was rejected, true otherwise
+ */
+bool jll_slist_ring_push_head(jll_slist_t * slist, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(SLIST_RING_PUSH_HEAD);
+    assert(slist);
+    assert(dptr);
+
+    if (!jll_slist_ring_is_full(slist))
+    {
+        jll_slist_append_head(slist, dptr);
+        return true;
+    }
+
+    if (slist->ring_policy == JLL_RING_REJECT) return false;
+
+    JLL_PROF_OP(slist);
+    __jll_slist_ring_overwrite(slist, dptr, false);
+    return true;
+}
+
+bool jll_slist_ring_is_full(const jll_slist_t * slist)
+{
+    assert(slist);
+    return (slist->capacity) && (slist->length == slist->capacity);
+}
+
+
+/* deletion functions */
+
+
+const jll_data_t * jll_slist_remove_index(jll_slist_t * slist, size_t index)
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_INDEX);
+    assert(slist);
+    JLL_PROF_OP(slist);
+
+    if ((index < 0) || (index >= slist->length))
+        return NULL;
+    else if (index == 0)
+        return jll_slist_remove_head(slist);
+    else if (index == slist->length - 1)
+        return jll_slist_remove_tail(slist);
+    else
+    {
+        jll_snode_t * backptr = NULL;
+        jll_snode_t * frontptr = slist->head;
+        size_t k;
+
+        for (k = 0; k < index; k++) 
+        {
+            backptr = frontptr;
+            frontptr = frontptr->next;
+            JLL_PROF_HOP(slist);
+        }
+
+        backptr->next = frontptr->next;
+
+        const jll_data_t * retdata = frontptr->data;
+        
+        __jll_slist_free_node(slist, frontptr);
+        slist->length--;
+        __jll_slist_note_remove(slist);
+        return retdata;
+    }    
+}
+
+
+/**
+ * @brief Removes head node from a singly-linked list
+ * @param slist List to be edited
+ * @returns Constant reference to the data once held by the removed head
+ * 
+ */
+const jll_data_t * jll_slist_remove_head(jll_slist_t * slist)
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_HEAD);
+    assert(slist);
+    JLL_PROF_OP(slist);
+
+    if (jll_slist_is_empty(slist))
+    {
+        return NULL;
+    }
+
+    
+    const jll_data_t * retdata;
+
+    // Test the length rather than next, which points back at the node itself in a circular list of one.
+    if (slist->length == 1)
+    {
+        retdata = __jll_slist_free_node(slist, slist->head);
+        slist->head = NULL;
+        slist->tail = NULL;
+    }
+    else
+    {
+        jll_snode_t * newhead = slist->head->next;
+        retdata = __jll_slist_free_node(slist, slist->head);
+        slist->head = newhead;
+    }
+
+    slist->length--;
+    __jll_slist_note_remove(slist);
+    if ((slist->circular) && (slist->tail)) slist->tail->next = slist->head;
+
+    return retdata;
+}
+
+
+/**
+ * @brief Removes tail node from a singly-linked list
+ * @param slist List to be edited
+ * @returns Constant reference to the data once held by the removed tail
+ */
+const jll_data_t * jll_slist_remove_tail(jll_slist_t * slist)
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_TAIL);
+
+    assert(slist);
+    JLL_PROF_OP(slist);
+
+    if (jll_slist_is_empty(slist)) return NULL;
+
+    const jll_data_t * retdata;
+    jll_snode_t * newtail;
+
+    if (slist->length == 1)
+    {
+        retdata = __jll_slist_free_node(slist, slist->tail);
+        slist->head = NULL;
+        slist->tail = NULL;
+    }
+    else
+    {
+        newtail = slist->head;
+        while ((newtail) && (newtail->next != slist->tail))
+        {
+            newtail = newtail->next;
+            JLL_PROF_HOP(slist);
+        }
+
+        retdata = __jll_slist_free_node(slist, slist->tail);
+        slist->tail = newtail;
+
+        if (slist->circular) slist->tail->next = slist->head;
+        else slist->tail->next = NULL;
+    }
+
+    slist->length--;
+    __jll_slist_note_remove(slist);
+    return retdata;
+}
+
+
+/**
+ * @brief Unlinks and frees a node reached by a walk from the head, given the node before it (NULL at the head)
+ */
+static const jll_data_t * __jll_slist_remove_found(jll_slist_t * slist, jll_snode_t * bptr, jll_snode_t * fptr)
+{
+    if (!bptr) return jll_slist_remove_head(slist);
+
+    // The node before is already known, so even the tail comes off without a second walk.
+    bptr->next = fptr->next;
+    if (fptr == slist->tail) slist->tail = bptr;
+
+    const jll_data_t * retdata = __jll_slist_free_node(slist, fptr);
+    slist->length--;
+    __jll_slist_note_remove(slist);
+
+    return retdata;
+}
+
+/**
+ * @brief Removes first node in a singly-linked list which matches a user-specified condition
+ * @param slist List to to be edited
+ * @param compfunc Boolean function which returns true if the data in the argument meets some user-specified criteria.
+ * @returns A constant reference to the data of the removed node, or NULL if no node matched
+ */
+const jll_data_t * jll_slist_remove_cond_first(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_COND_FIRST);
+    assert(slist);
+    assert(compfunc);
+    JLL_PROF_OP(slist);
+
+    jll_snode_t * fptr = slist->head;
+    jll_snode_t * bptr = NULL;
+
+    // Bounded by length so circular lists terminate.
+    for (size_t k = 0; k < slist->length; k++)
+    {
+        JLL_PROF_PRED(slist);
+        if (compfunc(fptr->data)) return __jll_slist_remove_found(slist, bptr, fptr);
+
+        bptr = fptr;
+        fptr = fptr->next;
+        JLL_PROF_HOP(slist);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Removes the n-th node (counting from 1) in a singly-linked list which matches a user-specified condition
+ * @param slist List to to be edited
+ * @param compfunc Boolean function which returns true if the data in the argument meets some user-specified criteria.
+ * @param n Which match to remove
+ * @returns A constant reference to the data of the removed node, or NULL if fewer than n nodes matched
+ */
+const jll_data_t * jll_slist_remove_cond_nth(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_COND_NTH);
+    assert(slist);
+    assert(compfunc);
+
+    JLL_PROF_OP(slist);
+
+    if ((n == 0) || (n > slist->length)) return NULL;
+
+    jll_snode_t * fptr = slist->head;
+    jll_snode_t * bptr = NULL;
+
+    // Bounded by length so circular lists terminate.
+    for (size_t k = 0; k < slist->length; k++)
+    {
+        JLL_PROF_PRED(slist);
+        if ((compfunc(fptr->data)) && (--n == 0)) return __jll_slist_remove_found(slist, bptr, fptr);
+
+        bptr = fptr;
+        fptr = fptr->next;
+        JLL_PROF_HOP(slist);
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Frees a chain of nodes already unlinked from a list, in one batch after the pass which unlinked them
+ */
+static void __jll_slist_free_chain(jll_slist_t * slist, jll_snode_t * chain)
+{
+    while (chain)
+    {
+        jll_snode_t * next = chain->next;
+
+        __jll_slist_note_remove(slist);
+        __jll_slist_free_node(slist, chain);
+
+        chain = next;
+    }
+}
+
+/**
+ * @brief Single-pass removal of up to max nodes matching a predicate (every node if compfunc is NULL),
+ * writing their data to out in list order. Unlinked nodes are freed together once the pass is done.
+ * 
+ * @returns Number of nodes removed
+ */
+static size_t __jll_slist_drain_cond(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), const jll_data_t ** out, size_t max)
+{
+    if ((jll_slist_is_empty(slist)) || (max == 0)) return 0;
+
+    slist->tail->next = NULL;
+
+    jll_snode_t * prev = NULL;
+    jll_snode_t * rover = slist->head;
+    jll_snode_t * doomed = NULL;
+    jll_snode_t ** doomed_tail = &doomed;
+    size_t found = 0;
+
+    while ((rover) && (found < max))
+    {
+        jll_snode_t * next = rover->next;
+
+        if (compfunc) JLL_PROF_PRED(slist);
+
+        if ((!compfunc) || (compfunc(rover->data)))
+        {
+            out[found++] = rover->data;
+
+            if (prev) prev->next = next;
+            else slist->head = next;
+            if (rover == slist->tail) slist->tail = prev;
+
+            *doomed_tail = rover;
+            doomed_tail = &rover->next;
+        }
+        else prev = rover;
+
+        rover = next;
+        JLL_PROF_HOP(slist);
+    }
+
+    *doomed_tail = NULL;
+    slist->length -= found;
+
+    if (jll_slist_is_empty(slist))
+    {
+        slist->head = NULL;
+        slist->tail = NULL;
+    }
+    else slist->tail->next = (slist->circular) ? slist->head : NULL;
+
+    __jll_slist_free_chain(slist, doomed);
+    return found;
+}
+
+/**
+ * @brief Removes, in one pass, the first n nodes in a singly-linked list which match a user-specified condition
+ * @param slist List to to be edited
+ * @param compfunc Boolean function which returns true if the data in the argument meets some user-specified criteria.
+ * @param n Most matches to remove
+ * @returns Payload holding the removed data in list order, or NULL if no node matched
+ */
+jll_data_payload_t * jll_slist_remove_cond_first_n(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_COND_FIRST_N);
+    assert(slist);
+    assert(compfunc);
+
+    JLL_PROF_OP(slist);
+
+    if ((n == 0) || (jll_slist_is_empty(slist))) return NULL;
+    if (n > slist->length) n = slist->length;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(n);
+    new_payload->length = __jll_slist_drain_cond(slist, compfunc, new_payload->data, n);
+
+    if (new_payload->length == 0)
+    {
+        jll_deallocate_data_payload(new_payload);
+        return NULL;
+    }
+
+    __jll_slist_note_payload(slist, new_payload);
+    return new_payload;
+}
+
+jll_data_payload_t * jll_slist_remove_cond_all(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_COND_ALL);
+    assert(slist);
+    assert(compfunc);
+
+    JLL_PROF_OP(slist);
+
+    if (jll_slist_is_empty(slist)) return NULL;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(slist->length);
+    new_payload->length = __jll_slist_drain_cond(slist, compfunc, new_payload->data, slist->length);
+
+    if (new_payload->length == 0)
+    {
+        jll_deallocate_data_payload(new_payload);
+        return NULL;
+    }
+
+    __jll_slist_note_payload(slist, new_payload);
+    return new_payload;
+}
+
+
+jll_data_payload_t * jll_slist_remove_all(jll_slist_t * slist)
+{
+    JLL_LAT_SCOPE(SLIST_REMOVE_ALL);
+    assert(slist);
+    JLL_PROF_OP(slist);
+    if (jll_slist_is_empty(slist)) return NULL;
+
+    jll_data_payload_t * new_payload = jll_allocate_empty_payload(slist->length);
+    new_payload->length = __jll_slist_drain_cond(slist, NULL, new_payload->data, slist->length);
+
+    __jll_slist_note_payload(slist, new_payload);
+    return new_payload;
+}
+
+
+/* export and drain */
+
+/**
+ * @brief Copies up to max data references, head first, into a caller-provided array without modifying the list
+ * 
+ * @param slist List to be exported
+ * @param out   Destination array with room for at least max references
+ * @param max   Capacity of out
+ * 
+ * @returns Number of references written
+ */
+size_t jll_slist_to_array(const jll_slist_t * slist, const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(SLIST_TO_ARRAY);
+    assert(slist);
+    assert((out) || (max == 0));
+
+    size_t count = (slist->length < max) ? slist->length : max;
+    const jll_snode_t * rover = slist->head;
+
+    for (size_t k = 0; k < count; k++)
+    {
+        out[k] = rover->data;
+        rover = rover->next;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Appends every data reference of a list to a reusable payload without modifying the list.
+ * The payload only grows when its capacity is exceeded, so repeated exports settle into no allocation.
+ * 
+ * @returns Number of references appended
+ */
+size_t jll_slist_export_into(const jll_slist_t * slist, jll_data_payload_t * payload)
+{
+    assert(slist);
+    assert(payload);
+
+    jll_data_payload_reserve(payload, payload->length + slist->length);
+
+    size_t count = jll_slist_to_array(slist, payload->data + payload->length, slist->length);
+    payload->length += count;
+
+    return count;
+}
+
+/**
+ * @brief Removes up to max nodes from the head of a list in one pass, writing their data to a caller-provided array
+ * 
+ * @param slist List to be drained
+ * @param out   Destination array with room for at least max references
+ * @param max   Capacity of out
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_slist_drain(jll_slist_t * slist, const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(SLIST_DRAIN);
+    assert(slist);
+    assert((out) || (max == 0));
+    JLL_PROF_OP(slist);
+
+    return __jll_slist_drain_cond(slist, NULL, out, max);
+}
+
+/**
+ * @brief Removes up to max nodes matching a predicate in one pass, writing their data to a caller-provided array in list order
+ * 
+ * @param slist List to be filtered
+ * @param compfunc Boolean function which returns true for data to be removed
+ * @param out      Destination array with room for at least max references
+ * @param max      Capacity of out
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_slist_drain_cond(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(SLIST_DRAIN_COND);
+    assert(slist);
+    assert(compfunc);
+    assert((out) || (max == 0));
+    JLL_PROF_OP(slist);
+
+    return __jll_slist_drain_cond(slist, compfunc, out, max);
+}
+
+/**
+ * @brief Removes every node of a list, appending its data to a reusable payload
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_slist_drain_into(jll_slist_t * slist, jll_data_payload_t * payload)
+{
+    assert(slist);
+    assert(payload);
+
+    jll_data_payload_reserve(payload, payload->length + slist->length);
+
+    size_t count = jll_slist_drain(slist, payload->data + payload->length, slist->length);
+    payload->length += count;
+
+    return count;
+}
+
+/**
+ * @brief Removes every node matching a predicate, appending its data to a reusable payload.
+ * Room is reserved for the whole list up front so the pass never reallocates.
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_slist_drain_cond_into(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), jll_data_payload_t * payload)
+{
+    assert(slist);
+    assert(compfunc);
+    assert(payload);
+
+    jll_data_payload_reserve(payload, payload->length + slist->length);
+
+    size_t count = jll_slist_drain_cond(slist, compfunc, payload->data + payload->length, slist->length);
+    payload->length += count;
+
+    return count;
+}
+
+
+/* access functions */
+
+const jll_data_t * jll_slist_index_pos(jll_slist_t * slist, size_t index)
+{
+    JLL_LAT_SCOPE(SLIST_INDEX_POS);
+    assert(slist);
+    JLL_PROF_OP(slist);
+    if ((index < 0) || (index >= slist->length)) return NULL;
+    else if (index == 0) return slist->head->data;
+    else if (index == slist->length - 1) return slist->tail->data;
+
+    JLL_PROF_WALK_FWD(slist);
+
+    jll_snode_t * rover = slist->head;
+    for (size_t k = 0; k < index; k++)
+    {
+        rover = rover->next;
+        JLL_PROF_HOP(slist);
+    }
+    return rover->data;
+}
+
+const jll_data_t * jll_slist_index_head(jll_slist_t * slist)
+{
+    JLL_LAT_SCOPE(SLIST_INDEX_HEAD);
+    assert(slist);
+    JLL_PROF_OP(slist);
+    if (jll_slist_is_empty(slist)) return NULL;
+    else return slist->head->data;
+}
+
+const jll_data_t * jll_slist_index_tail(jll_slist_t * slist)
+{
+    JLL_LAT_SCOPE(SLIST_INDEX_TAIL);
+    assert(slist);
+    JLL_PROF_OP(slist);
+    if (jll_slist_is_empty(slist)) return NULL;
+    else return slist->tail->data;
+}
+
+/**
+ * @brief Moves a node to directly follow another node of the same singly-linked list
+ * @param slist List holding both nodes
+ * @param prev  Current predecessor of the node (NULL if the node is the head)
+ * @param node  Node to be moved
+ * @param dest  Node which should precede the moved node (NULL to make it the head)
+ */
+static void __jll_slist_relink_after(jll_slist_t * slist, jll_snode_t * prev, jll_snode_t * node, jll_snode_t * dest)
+{
+    if ((dest == prev) || (dest == node)) return;
+
+    slist->generation++;
+
+    // Detach the node.
+    if (prev) prev->next = node->next;
+    else slist->head = node->next;
+
+    if (node == slist->tail) slist->tail = prev;
+
+    // Reattach after dest.
+    if (dest)
+    {
+        node->next = dest->next;
+        dest->next = node;
+        if (dest == slist->tail) slist->tail = node;
+    }
+    else
+    {
+        node->next = slist->head;
+        slist->head = node;
+    }
+
+    if (slist->circular) slist->tail->next = slist->head;
+    else slist->tail->next = NULL;
+}
+
+/* batched scan */
+
+/**
+ * @brief Neighbours of the node found by a scan, which the self-organizing policies relink against
+ */
+typedef struct jll_slist_scan_type
+{
+    jll_snode_t * prev;
+    jll_snode_t * prev_prev;
+    jll_snode_t * run_prev;     // Predecessor of the first node in the current run of equal counts.
+
+} jll_slist_scan_t;
+
+/**
+ * @brief Scan engine behind the find and contains functions. Nodes are visited in chunks: the data pointers of a
+ * chunk are gathered first, with a prefetch issued for each so that the loads overlap, and the chunk is then handed
+ * to the predicate in one go. Chunks start small, so early hits stay cheap, and double up to the list's scan batch.
+ * 
+ * @param slist List to be scanned
+ * @param batchpred Batch predicate, given a whole chunk at a time (may be NULL)
+ * @param compfunc  Scalar predicate, used when batchpred is NULL (may be NULL)
+ * @param key       Data carrying the key matched with the list's comparison function when both predicates are NULL
+ * @param n         Which match to stop at, counting from 1
+ * @param scan      Receives the neighbourhood of the node found
+ * 
+ * @returns The n-th matching node, or NULL if there are fewer than n matches
+ */
+static jll_snode_t * __jll_slist_scan(jll_slist_t * slist, data_batchpred_t batchpred, bool (*compfunc)(const jll_data_t *), const jll_data_t * key, size_t n, jll_slist_scan_t * scan)
+{
+    jll_snode_t * nodes[JLL_SLIST_SCAN_BATCH_MAX];
+    const jll_data_t * data[JLL_SLIST_SCAN_BATCH_MAX];
+    uint8_t matches[JLL_SLIST_SCAN_BATCH_MAX];
+
+    scan->prev = NULL;
+    scan->prev_prev = NULL;
+    scan->run_prev = NULL;
+
+    if (n == 0) return NULL;
+
+    jll_snode_t * gather = slist->head;
+    size_t left = slist->length;
+    size_t batch = (slist->scan_batch < JLL_SLIST_SCAN_FIRST_BATCH) ? slist->scan_batch : JLL_SLIST_SCAN_FIRST_BATCH;
+
+    while (left)
+    {
+        size_t count = (left < batch) ? left : batch;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            nodes[i] = gather;
+            data[i] = gather->data;
+            __builtin_prefetch(data[i]);
+
+            gather = gather->next;
+        }
+
+        if (batchpred)
+        {
+            batchpred(data, count, matches);
+            JLL_PROF_COUNT(slist, predicates, count);
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            jll_snode_t * rover = nodes[i];
+            if ((slist->reorg == JLL_REORG_COUNT) && (scan->prev) && (JLL_SKNODE(scan->prev)->freq != JLL_SKNODE(rover)->freq)) scan->run_prev = scan->prev;
+
+            bool match;
+            if (batchpred) match = matches[i];
+            else if (compfunc)
+            {
+                JLL_PROF_PRED(slist);
+                match = compfunc(data[i]);
+            }
+            else
+            {
+                JLL_PROF_CMP(slist);
+                match = (slist->slist_comp_func(data[i], key) == 0);
+            }
+
+            if ((match) && (--n == 0)) return rover;
+
+            scan->prev_prev = scan->prev;
+            scan->prev = rover;
+            JLL_PROF_HOP(slist);
+        }
+
+        left -= count;
+        if (batch < slist->scan_batch) batch = (2 * batch < slist->scan_batch) ? 2 * batch : slist->scan_batch;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Finds the first node matching a predicate (or a key) and applies the list's self-organizing policy to it
+ * @param slist List to be searched
+ * @param batchpred Batch predicate evaluated a chunk at a time; takes precedence over compfunc (may be NULL)
+ * @param compfunc Boolean function which returns true if the data in the argument meets some user-specified criteria.
+ * If both predicates are NULL, nodes are matched against key with the list's comparison function instead.
+ * @param key Data carrying the key to be matched when both predicates are NULL
+ * @returns The matching node (possibly relocated by the policy), or NULL if no node matched
+ */
+static jll_snode_t * __jll_slist_search(jll_slist_t * slist, data_batchpred_t batchpred, bool (*compfunc)(const jll_data_t *), const jll_data_t * key)
+{
+    jll_slist_scan_t scan;
+    jll_snode_t * rover = __jll_slist_scan(slist, batchpred, compfunc, key, 1, &scan);
+    if (!rover) return NULL;
+
+    jll_snode_t * prev = scan.prev;
+    jll_snode_t * prev_prev = scan.prev_prev;
+    jll_snode_t * run_prev = scan.run_prev;
+
+    switch (slist->reorg)
+    {
+        case JLL_REORG_MOVE_TO_FRONT:
+            __jll_slist_relink_after(slist, prev, rover, NULL);
+            break;
+
+        case JLL_REORG_TRANSPOSE:
+            __jll_slist_relink_after(slist, prev, rover, prev_prev);
+            break;
+
+        case JLL_REORG_COUNT:
+            // Counts are kept non-increasing from head to tail, so moving the node to the
+            // front of its run keeps the order once its count is bumped.
+            __jll_slist_relink_after(slist, prev, rover, run_prev);
+            JLL_SKNODE(rover)->freq++;
+            break;
+
+        default:
+            break;
+    }
+
+    return rover;
+}
+
+const jll_data_t * jll_slist_find_first_occurrence(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_FIND_FIRST_OCCURRENCE);
+    assert(slist);
+    assert(compfunc);
+    JLL_PROF_OP(slist);
+
+    jll_snode_t * found = __jll_slist_search(slist, NULL, compfunc, NULL);
+    return found ? found->data : NULL;
+}
+
+const jll_data_t * jll_slist_find_nth_occurrence(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), size_t n)
+{
+    JLL_LAT_SCOPE(SLIST_FIND_NTH_OCCURRENCE);
+    assert(slist);
+    assert(compfunc);
+    JLL_PROF_OP(slist);
+
+    jll_slist_scan_t scan;
+    jll_snode_t * found = __jll_slist_scan(slist, NULL, compfunc, NULL, n, &scan);
+    return found ? found->data : NULL;
+}
+
+
+bool jll_slist_check_if_sorted(jll_slist_t * slist)
+{
+    JLL_LAT_SCOPE(SLIST_CHECK_IF_SORTED);
+    assert(slist);
+    JLL_PROF_OP(slist);
+    if (!slist->slist_comp_func) return false;
+    else if (jll_slist_is_empty(slist)) return false;
+
+    jll_snode_t * rover = slist->head;
+
+    // Bounded by length so circular lists terminate; cached keys spare the data of every pair they can order.
+    for (size_t k = 1; k < slist->length; k++)
+    {
+        if (__jll_slist_compare_nodes(slist, rover, rover->next) == -1) return false;
+
+        rover = rover->next;
+        JLL_PROF_HOP(slist);
+    }
+
+    return true;
+}
+
+
+bool jll_slist_check_if_contains(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_CHECK_IF_CONTAINS);
+    assert(slist);
+    assert(compfunc);
+    JLL_PROF_OP(slist);
+
+    return (__jll_slist_search(slist, NULL, compfunc, NULL) != NULL);
+}
+
+/**
+ * @brief Finds the first element matching a batch predicate and applies the list's self-organizing policy to it.
+ * The predicate is handed the data of up to the list's scan batch of consecutive elements at a time and must
+ * set matches[i] to non-zero for every element i which matches; it may be called on elements past the first match.
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param batchpred User-specified batch predicate
+ * 
+ * @returns The data of the first matching element, or NULL if none matched
+ */
+const jll_data_t * jll_slist_find_first_batched(jll_slist_t * slist, data_batchpred_t batchpred)
+{
+    JLL_LAT_SCOPE(SLIST_FIND_FIRST_BATCHED);
+    assert(slist);
+    assert(batchpred);
+    JLL_PROF_OP(slist);
+
+    jll_snode_t * found = __jll_slist_search(slist, batchpred, NULL, NULL);
+    return found ? found->data : NULL;
+}
+
+/**
+ * @brief Finds the n-th element (counting from 1) matching a batch predicate; the list is not reorganized
+ */
+const jll_data_t * jll_slist_find_nth_batched(jll_slist_t * slist, data_batchpred_t batchpred, size_t n)
+{
+    JLL_LAT_SCOPE(SLIST_FIND_NTH_BATCHED);
+    assert(slist);
+    assert(batchpred);
+    JLL_PROF_OP(slist);
+
+    jll_slist_scan_t scan;
+    jll_snode_t * found = __jll_slist_scan(slist, batchpred, NULL, NULL, n, &scan);
+    return found ? found->data : NULL;
+}
+
+bool jll_slist_check_if_contains_batched(jll_slist_t * slist, data_batchpred_t batchpred)
+{
+    JLL_LAT_SCOPE(SLIST_CONTAINS_BATCHED);
+    assert(slist);
+    assert(batchpred);
+    JLL_PROF_OP(slist);
+
+    return (__jll_slist_search(slist, batchpred, NULL, NULL) != NULL);
+}
+
+/**
+ * @brief Sets how many elements a find or contains scan gathers (and prefetches) ahead of evaluating them
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param batch Scan batch, between 1 and JLL_SLIST_SCAN_BATCH_MAX
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_set_scan_batch(jll_slist_t * slist, size_t batch)
+{
+    assert(slist);
+    assert((batch > 0) && (batch <= JLL_SLIST_SCAN_BATCH_MAX));
+
+    slist->scan_batch = batch;
+}
+
+
+bool jll_slist_is_empty(jll_slist_t * slist)
+{
+    JLL_LAT_SCOPE(SLIST_IS_EMPTY);
+    assert(slist);
+    return ((!slist->head) || (slist->length == 0));
+}
+
+
+/* cached sort keys */
+
+/**
+ * @brief Caches a fixed-width sort key in every node, extracted once when the node is created; sorted insertion,
+ * sortedness checks and sorted merges then order nodes by key and only call the comparison function on ties.
+ * The key lives in a keyed node (jll_sknode_t), so a list of plain nodes has them moved into keyed ones.
+ * @param slist List to be configured; its existing nodes are keyed straight away
+ * @param func Key function; key(a) < key(b) must imply that a sorts before b. NULL drops the cached keys.
+ * @returns False, leaving the list as it was, if the change of node kind would have to move nodes linked in by the caller
+ */
+bool jll_slist_set_key_func(jll_slist_t * slist, data_keyfunc_t func)
+{
+    JLL_LAT_SCOPE(SLIST_SET_KEY_FUNC);
+    assert(slist);
+
+    data_keyfunc_t old_func = slist->slist_key_func;
+    bool was_keyed = slist->keyed;
+
+    slist->slist_key_func = func;
+    if (!__jll_slist_conform(slist))
+    {
+        slist->slist_key_func = old_func;
+        return false;
+    }
+
+    // Nodes created by a change of kind were keyed as they were made.
+    if ((was_keyed) && (slist->keyed)) __jll_slist_rekey(slist, slist->head, slist->length);
+    return true;
+}
+
+/**
+ * @brief Finds data by its cached key without reading any data; a sorted list stops at the first larger key
+ * @returns The data of the first node holding the key, or NULL if there is none
+ */
+const jll_data_t * jll_slist_find_cached_key(jll_slist_t * slist, uint64_t key)
+{
+    JLL_LAT_SCOPE(SLIST_FIND_CACHED_KEY);
+    assert(slist);
+    assert(slist->slist_key_func);
+    JLL_PROF_OP(slist);
+
+    jll_snode_t * rover = slist->head;
+
+    for (size_t k = 0; k < slist->length; k++)
+    {
+        if (JLL_SKNODE(rover)->key == key) return rover->data;
+        if ((slist->sorted) && (JLL_SKNODE(rover)->key > key)) return NULL;
+
+        rover = rover->next;
+        JLL_PROF_HOP(slist);
+    }
+
+    return NULL;
+}
+
+
+/* self-organization */
+
+/**
+ * @brief Selects the self-organizing policy applied on successful finds and contains checks
+ * @param slist List to be configured
+ * @param policy Move-to-front, transpose, count-ordered or none. Counts live in keyed nodes (jll_sknode_t),
+ * so the count-ordered policy moves a list of plain nodes into keyed ones. Under the count-ordered policy a
+ * node entering the list at its head or before another node takes that node's count; merges and radix sort
+ * restart all counts from zero.
+ * @returns False, leaving the list as it was, if the list is sorted and the policy is not JLL_REORG_NONE,
+ * or if the change of node kind would have to move nodes linked in by the caller
+ */
+bool jll_slist_set_reorg_policy(jll_slist_t * slist, jll_reorg_policy_t policy)
+{
+    assert(slist);
+
+    // Reorganizing would undo the order sorted insertion relies on.
+    if ((slist->sorted) && (policy != JLL_REORG_NONE)) return false;
+
+    jll_reorg_policy_t old_policy = slist->reorg;
+
+    slist->reorg = policy;
+    if (!__jll_slist_conform(slist))
+    {
+        slist->reorg = old_policy;
+        return false;
+    }
+
+    // Count ordering starts from a clean slate so the non-increasing invariant holds.
+    __jll_slist_restart_counts(slist);
+    return true;
+}
+
+
+
+
+/* keyed membership */
+
+static void __jll_slist_rebuild_bloom(jll_slist_t * slist)
+{
+    jll_bloom_reset(slist->bloom, slist->length);
+
+    jll_snode_t * rover = slist->head;
+    for (size_t k = 0; k < slist->length; k++)
+    {
+        jll_bloom_insert(slist->bloom, rover->data);
+        rover = rover->next;
+    }
+}
+
+/**
+ * @brief Attaches a Bloom filter which lets keyed lookups reject absent keys without walking the list
+ * @param slist List to be screened; its comparison function decides key equality (returns 0)
+ * @param hashfunc User-specified hash over the key portion of the data
+ * @param fpr Target false-positive rate
+ */
+void jll_slist_attach_bloom(jll_slist_t * slist, data_hashfunc_t hashfunc, double fpr)
 {
-    jll_slist_t * new_slist = (jll_slist_t *)malloc(sizeof(jll_slist_t));
+    assert(slist);
+    assert(hashfunc);
+    assert(slist->slist_comp_func);
 
-    new_slist->head = NULL;
-    new_slist->tail = NULL;
-    new_slist->length = 0;
+    if (slist->bloom) jll_dealloc_bloom(slist->bloom);
 
-    new_slist->circular = circflag;
-    new_slist->sorted   = sortflag;
-    new_slist->persistent = perflag;
-    
-    new_slist->slist_comp_func = func;
+    slist->bloom = jll_alloc_bloom(hashfunc, slist->length, fpr);
+    __jll_slist_rebuild_bloom(slist);
+    slist->bloom->stats.rebuilds = 0;
+}
 
-    return new_slist;
+void jll_slist_detach_bloom(jll_slist_t * slist)
+{
+    assert(slist);
+
+    if (slist->bloom) jll_dealloc_bloom(slist->bloom);
+    slist->bloom = NULL;
 }
 
 /**
- * @brief Deallocate memory for a singly-linked list.
- * 
- * @param slist Pointer to the singly-linked list to be deallocated
- * @param data_dealloc_func User-specified function which should handle deallocated the jll_data_t pointers referenced
- * by the nodes of the linked list.
- * 
- * @returns None (is void)
- * 
+ * @brief Finds the first node whose data compares equal (0) to a key, consulting the Bloom filter first if one is attached.
+ * The filter is rebuilt lazily here once removals have left too many stale keys in it.
+ * @param slist List to be searched
+ * @param key Data carrying the key to be looked up
+ * @returns Constant reference to the matching data, or NULL
  */
-void jll_dealloc_slist(jll_slist_t * slist, void (*data_dealloc_func)(const jll_data_t *))
+const jll_data_t * jll_slist_find_key(jll_slist_t * slist, const jll_data_t * key)
 {
+    JLL_LAT_SCOPE(SLIST_FIND_KEY);
     assert(slist);
-    assert(data_dealloc_func);
+    assert(key);
+    assert(slist->slist_comp_func);
+    JLL_PROF_OP(slist);
 
-    jll_snode_t * fptr = slist->head;
-    jll_snode_t * bptr = NULL;
+    jll_bloom_t * bloom = slist->bloom;
 
-    while (fptr)
+    if (bloom)
     {
-        bptr = fptr;
-        fptr = fptr->next;
-        
-        // Deallocate node structure.
-        const jll_data_t * old_data_ptr = jll_dealloc_snode(bptr);
-        
-        // Deallocate node data with user-defined structure.
-        data_dealloc_func(old_data_ptr);
+        if (jll_bloom_needs_rebuild(bloom)) __jll_slist_rebuild_bloom(slist);
+
+        bloom->stats.queries++;
+        if (!jll_bloom_may_contain(bloom, key))
+        {
+            bloom->stats.negatives++;
+            return NULL;
+        }
     }
 
-    // Free containing list structure.
-    free(slist);
+    jll_snode_t * found = __jll_slist_search(slist, NULL, NULL, key);
+    if ((!found) && (bloom)) bloom->stats.false_positives++;
+
+    return found ? found->data : NULL;
 }
 
+bool jll_slist_check_if_contains_key(jll_slist_t * slist, const jll_data_t * key)
+{
+    JLL_LAT_SCOPE(SLIST_CHECK_IF_CONTAINS_KEY);
+    return (jll_slist_find_key(slist, key) != NULL);
+}
 
-/* insertion functions */
+
+/* profiling */
 
 /**
- * @brief Appends a new node as the head of a singly-linked list
+ * @brief Copies the operation counters of a list (all zero unless built with JLL_ENABLE_PROFILING)
+ * @param slist List to be queried
+ * @param out Destination for the counters
+ */
+void jll_slist_get_profile(const jll_slist_t * slist, jll_profile_t * out)
+{
+    assert(slist);
+    assert(out);
+
+    *out = slist->profile;
+}
+
+void jll_slist_reset_profile(jll_slist_t * slist)
+{
+    assert(slist);
+    JLL_PROF_INIT(slist);
+}
+
+/**
+ * @brief Copies the always-on sorted insertion counters of a list (comparisons and hops per insert,
+ * and how often the tail or the last insertion point resolved the search)
+ */
+void jll_slist_get_insert_stats(const jll_slist_t * slist, jll_insert_stats_t * out)
+{
+    assert(slist);
+    assert(out);
+    *out = slist->insert_stats;
+}
+
+void jll_slist_reset_insert_stats(jll_slist_t * slist)
+{
+    assert(slist);
+    memset(&slist->insert_stats, 0, sizeof(jll_insert_stats_t));
+}
+
+
+/* memory accounting */
+
+/**
+ * @brief Reports the bytes attributed to a list: its header (plus any attached filter), its nodes,
+ * and (separately, cumulatively) the payload buffers it has handed out. Sizes are requested sizes without allocator overhead.
+ * 
+ * @param slist List to be measured
+ * @param out   Destination for the byte counts
  * 
- * @param slist Pointer to the singly-linked list
- * @param dptr  Data which is to be referenced by the newly appended head
- *
  * @returns None (is void)
+ */
+void jll_slist_memory(const jll_slist_t * slist, jll_list_memory_t * out)
+{
+    assert(slist);
+    assert(out);
+
+    out->header_bytes = sizeof(jll_slist_t) + (slist->bloom ? jll_bloom_bytes(slist->bloom) : 0);
+    out->node_bytes = slist->length * __jll_slist_node_bytes(slist);
+    out->payload_bytes_issued = slist->payload_bytes_issued;
+    out->total_bytes = out->header_bytes + out->node_bytes;
+}
+
+/**
+ * @brief Walks a list and reports how far apart consecutive nodes sit in memory
+ * 
+ * @param slist List to be analysed
+ * @param out   Destination for the layout report
  * 
+ * @returns None (is void)
  */
-void jll_slist_append_head(jll_slist_t * slist, const jll_data_t * dptr)
+void jll_slist_layout(const jll_slist_t * slist, jll_layout_report_t * out)
 {
     assert(slist);
-    assert(dptr);
+    assert(out);
 
-    jll_snode_t * newptr = jll_alloc_snode(dptr);
+    jll_layout_begin(out);
 
-    if (jll_slist_is_empty(slist))
+    const jll_snode_t * rover = slist->head;
+    for (size_t k = 1; k < slist->length; k++)
     {
-        slist->tail = newptr;
-        slist->head = newptr;
+        jll_layout_hop(out, rover, rover->next);
+        rover = rover->next;
     }
-    else
+
+    jll_layout_end(out);
+}
+
+
+/* compaction */
+
+static bool __jll_slist_in_block(const jll_compact_t * state, const jll_snode_t * node)
+{
+    return ((const char *)node >= state->block) && ((const char *)node < state->block + state->capacity * state->node_size);
+}
+
+/**
+ * @brief Re-establishes the cursor after the list changed under an incremental pass:
+ * the cursor becomes the last node of the leading run of nodes which already sit in the block.
+ */
+static jll_snode_t * __jll_slist_compact_resume(jll_slist_t * slist, jll_compact_t * state)
+{
+    jll_snode_t * cursor = NULL;
+    jll_snode_t * rover = slist->head;
+
+    for (size_t k = 0; k < slist->length; k++)
     {
-        newptr->next = slist->head;
-        slist->head  = newptr;
+        if (!__jll_slist_in_block(state, rover)) break;
+
+        cursor = rover;
+        rover = rover->next;
+        JLL_PROF_HOP(slist);
     }
 
-    slist->length++;
-    if (slist->circular) slist->tail->next = slist->head; // Double checking.
+    state->generation = slist->generation;
+    return cursor;
 }
 
-
 /**
- * @brief Appends a new tail to a singly-linked list
+ * @brief Starts an incremental compaction pass, reserving a contiguous block sized for the current length
  * 
- * @param slist Pointer to the singly-linked list to be appended to
- * @param dptr  Data to be referenced by the newly appended tail node
+ * @param slist    List to be compacted; its nodes must have been allocated by the list itself
+ * @param state    Caller-owned progress record for the pass
+ * @param hugepage Back the block with huge pages where the platform allows it
  * 
  * @returns None (is void)
  */
-void jll_slist_append_tail(jll_slist_t * slist, const jll_data_t * dptr)
+void jll_slist_compact_begin(jll_slist_t * slist, jll_compact_t * state, bool hugepage)
 {
     assert(slist);
-    assert(dptr);
+    assert(state);
 
+    state->block = NULL;
+    state->pool = NULL;
+    state->node_size = __jll_slist_node_bytes(slist);
+    state->capacity = slist->length;
+    state->placed = 0;
+    state->cursor = NULL;
+    state->generation = slist->generation;
+    state->active = (slist->length > 0);
 
-    jll_snode_t * newptr = jll_alloc_snode(dptr);
+    if (!state->active) return;
 
-    if (jll_slist_is_empty(slist))
-    {
-        slist->tail = newptr;
-        slist->head = newptr;
-    }
-    else
+    // The nodes already linked did not come from the pool created here.
+    if (!slist->pool)
     {
-        slist->tail->next = newptr;
-        slist->tail = newptr;
+        slist->pool = jll_alloc_pool(state->node_size, JLL_SLIST_POOL_BLOCK, hugepage);
+        slist->foreign_nodes = true;
     }
 
-    slist->length++;
-    if (slist->circular) slist->tail->next = slist->head; // Double checking.
+    state->pool = slist->pool;
+    state->block = (char *)jll_pool_get_block(slist->pool, state->capacity, hugepage);
 }
 
 /**
- * @brief Inserts a node due to specified sorting logic into a singly-linked list
- * 
- * @param slist Pointer to the singly linked list
- * @param dptr  Data to be referenced by the newly inserted node
+ * @brief Relocates up to budget nodes, in traversal order, into the block reserved by jll_slist_compact_begin.
+ * The list stays fully usable between steps; removals or reordering in between only make the next step
+ * re-find its place. Node addresses change, so pointers to nodes held outside the list become invalid.
  * 
- * @returns None (is void)
+ * @param slist  List being compacted
+ * @param state  Progress record set up by jll_slist_compact_begin
+ * @param budget Maximum number of nodes to relocate in this step
  * 
+ * @returns True once the pass has finished (the block is then released with jll_slist_compact_end)
  */
-void jll_slist_insert_sorted(jll_slist_t * slist, const jll_data_t * dptr)
+bool jll_slist_compact_step(jll_slist_t * slist, jll_compact_t * state, size_t budget)
 {
+    JLL_LAT_SCOPE(SLIST_COMPACT_STEP);
     assert(slist);
-    assert(dptr);
-    assert(slist->slist_comp_func);
+    assert(state);
 
-    if (jll_slist_is_empty(slist)) return jll_slist_append_head(slist, dptr);
+    if (!state->active) return true;
 
-    jll_snode_t * before_rover = NULL;
-    jll_snode_t * rover = slist->head;
+    jll_snode_t * cursor = (jll_snode_t *)state->cursor;
+    if (state->generation != slist->generation) cursor = __jll_slist_compact_resume(slist, state);
 
+    size_t moved = 0;
+    bool finished = false;
 
-    while (rover)
+    while (moved < budget)
     {
-        if (slist->slist_comp_func(rover->data, dptr) == -1)
+        // A list switched to another kind of node since the pass began no longer fits the block, and one which
+        // was recast (even back to the kind it started with) has left the block's pool behind.
+        bool same_pool = (state->pool == slist->pool) && (state->node_size == __jll_slist_node_bytes(slist));
+
+        if ((jll_slist_is_empty(slist)) || (cursor == slist->tail) || (state->placed == state->capacity) || (!same_pool))
         {
-            if (rover == slist->head)
-            {
-                return jll_slist_append_head(slist, dptr);
-            }
-            else
-            {
-                jll_snode_t * new_node = jll_alloc_snode(dptr);
+            // A pass which got through the whole list left every node in the list's own pool.
+            if ((cursor) && (cursor == slist->tail) && (same_pool)) slist->foreign_nodes = slist->caller_nodes;
+
+            finished = true;
+            break;
+        }
 
-                before_rover->next = new_node;
-                new_node->next = rover;
+        jll_snode_t * node = (cursor) ? cursor->next : slist->head;
+        JLL_PROF_HOP(slist);
 
-                slist->length++;
-                return;
-            }
+        if (!__jll_slist_in_block(state, node))
+        {
+            jll_snode_t * slot = (jll_snode_t *)(state->block + state->placed * state->node_size);
+            memcpy(slot, node, state->node_size);
+            JLL_MEM_ADD(JLL_MEM_NODES, state->node_size);
+            state->placed++;
+
+            if (cursor) cursor->next = slot;
+            else slist->head = slot;
+
+            if (node == slist->tail) slist->tail = slot;
+            if (slist->circular) slist->tail->next = slist->head;
+
+            __jll_slist_dealloc_node(slist, node);
+            node = slot;
+            moved++;
         }
-        else if (!rover->next)
+
+        cursor = node;
+    }
+
+    state->cursor = cursor;
+
+    // Relocation moved nodes; anyone tracking node addresses must start over.
+    if (moved) slist->generation++;
+    state->generation = slist->generation;
+
+    if (finished) jll_slist_compact_end(slist, state);
+    return finished;
+}
+
+/**
+ * @brief Finishes (or abandons) an incremental compaction pass, returning unused block slots to the list's pool
+ */
+void jll_slist_compact_end(jll_slist_t * slist, jll_compact_t * state)
+{
+    assert(slist);
+    assert(state);
+
+    if (!state->active) return;
+
+    // The list may have moved to a pool of another node size since, so the slots go back to the block's owner.
+    for (size_t k = state->placed; k < state->capacity; k++)
+        jll_pool_release(state->block + k * state->node_size);
+
+    state->active = false;
+}
+
+/**
+ * @brief Copies every node of a list into one contiguous, traversal-ordered block and frees the old nodes
+ * 
+ * @param slist    List to be compacted
+ * @param hugepage Back the block with huge pages where the platform allows it
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_compact(jll_slist_t * slist, bool hugepage)
+{
+    JLL_LAT_SCOPE(SLIST_COMPACT);
+    assert(slist);
+
+    jll_compact_t state;
+    jll_slist_compact_begin(slist, &state, hugepage);
+    while (!jll_slist_compact_step(slist, &state, (size_t)-1));
+}
+
+
+/* merging */
+
+/**
+ * @brief Merges two sorted singly-linked lists by relinking their nodes, in O(n+m) and without allocating.
+ * Equal elements keep their relative order, those of lone first.
+ * 
+ * @param lone List receiving the merged result; its comparison function decides the order
+ * @param ltwo List whose nodes are moved into lone; it is left empty (but not deallocated)
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_merge_sorted(jll_slist_t * lone, jll_slist_t * ltwo)
+{
+    JLL_LAT_SCOPE(SLIST_MERGE_SORTED);
+    assert(lone);
+    assert(ltwo);
+    assert(lone != ltwo);
+    assert(lone->slist_comp_func);
+    JLL_PROF_OP(lone);
+
+    if (jll_slist_is_empty(ltwo)) return;
+
+    jll_snode_t * a = lone->head;
+    size_t b_length = ltwo->length;
+    jll_snode_t * b_tail;
+    jll_snode_t * b = __jll_slist_absorb(lone, ltwo, &b_tail);
+
+    if (!a)
+    {
+        lone->head = b;
+        lone->tail = b_tail;
+    }
+    else
+    {
+        lone->tail->next = NULL;
+        b_tail->next = NULL;
+
+        if (__jll_slist_compare_nodes(lone, lone->tail, b) != -1)
         {
-            return jll_slist_append_tail(slist, dptr);
+            // Ranges do not overlap; a plain append keeps the order.
+            lone->tail->next = b;
+            lone->tail = b_tail;
         }
         else
         {
-            before_rover = rover;
-            rover = rover->next;
+            jll_snode_t anchor;
+            jll_snode_t * last = &anchor;
+
+            while ((a) && (b))
+            {
+                if (__jll_slist_compare_nodes(lone, a, b) == -1)
+                {
+                    last->next = b;
+                    last = b;
+                    b = b->next;
+                }
+                else
+                {
+                    last->next = a;
+                    last = a;
+                    a = a->next;
+                }
+                JLL_PROF_HOP(lone);
+            }
+
+            last->next = (a) ? a : b;
+            lone->head = anchor.next;
+            if (!a) lone->tail = b_tail;
         }
     }
+
+    lone->length += b_length;
+    lone->tail->next = (lone->circular) ? lone->head : NULL;
+    __jll_slist_restart_counts(lone);
 }
 
+/**
+ * @brief Tournament (loser) tree over the heads of the lists taking part in a k-way merge.
+ * Leaves are the sources padded to a power of two; internal node n keeps the loser of the match
+ * played there and losers[0] the overall winner, so replacing the winner costs log2(k) comparisons.
+ */
+typedef struct jll_slist_merge_tree_type
+{
+    jll_snode_t ** heads;
+    jll_snode_t ** tails;
+    size_t * losers;
+    size_t leaves;
 
+} jll_slist_merge_tree_t;
 
+/**
+ * @brief Match order: source x wins over source y if y's head belongs after x's head;
+ * exhausted sources always lose and ties go to the earlier source so the merge is stable.
+ */
+static bool __jll_slist_merge_wins(jll_slist_t * slist, const jll_slist_merge_tree_t * tree, size_t x, size_t y)
+{
+    if (!tree->heads[x]) return false;
+    if (!tree->heads[y]) return true;
 
-/* deletion functions */
+    int order = __jll_slist_compare_nodes(slist, tree->heads[x], tree->heads[y]);
 
+    if (order == 0) return (x < y);
+    return (order != -1);
+}
 
-const jll_data_t * jll_slist_remove_index(jll_slist_t * slist, size_t index)
+static void __jll_slist_merge_build(jll_slist_t * slist, jll_slist_merge_tree_t * tree)
 {
-    assert(slist);
-    if ((index < 0) || (index >= slist->length))
-        return NULL;
-    else if (index == 0)
-        return jll_slist_remove_head(slist);
-    else if (index == slist->length - 1)
-        return jll_slist_remove_tail(slist);
-    else
+    size_t * winners = (size_t *)malloc(2 * tree->leaves * sizeof(size_t));
+
+    for (size_t k = 0; k < tree->leaves; k++) winners[tree->leaves + k] = k;
+
+    for (size_t n = tree->leaves - 1; n > 0; n--)
     {
-        jll_snode_t * backptr = NULL;
-        jll_snode_t * frontptr = slist->head;
-        size_t k;
+        size_t a = winners[2 * n];
+        size_t b = winners[2 * n + 1];
 
-        for (k = 0; k < index; k++) 
+        if (__jll_slist_merge_wins(slist, tree, b, a))
         {
-            backptr = frontptr;
-            frontptr = frontptr->next;
+            size_t t = a;
+            a = b;
+            b = t;
         }
 
-        backptr->next = frontptr->next;
+        winners[n] = a;
+        tree->losers[n] = b;
+    }
 
-        const jll_data_t * retdata = frontptr->data;
-        
-        free(frontptr);
-        slist->length--;
-        return retdata;
-    }    
+    tree->losers[0] = winners[1];
+    free(winners);
 }
 
+static void __jll_slist_merge_replay(jll_slist_t * slist, jll_slist_merge_tree_t * tree, size_t source)
+{
+    size_t winner = source;
+
+    for (size_t n = (tree->leaves + source) / 2; n > 0; n /= 2)
+    {
+        if (__jll_slist_merge_wins(slist, tree, tree->losers[n], winner))
+        {
+            size_t t = tree->losers[n];
+            tree->losers[n] = winner;
+            winner = t;
+        }
+    }
+
+    tree->losers[0] = winner;
+}
 
 /**
- * @brief Removes head node from a singly-linked list
- * @param slist List to be edited
- * @returns Constant reference to the data once held by the removed head
+ * @brief Merges any number of sorted singly-linked lists into one with a tournament tree over the list heads,
+ * relinking nodes in O(N log k) without allocating nodes.
+ * 
+ * @param slist List receiving the merged result (its current nodes take part in the merge);
+ * its comparison function decides the order
+ * @param lists Lists whose nodes are moved into slist; each is left empty (but not deallocated)
+ * @param count Number of lists in lists
  * 
+ * @returns None (is void)
  */
-const jll_data_t * jll_slist_remove_head(jll_slist_t * slist)
+void jll_slist_merge_sorted_n(jll_slist_t * slist, jll_slist_t ** lists, size_t count)
 {
+    JLL_LAT_SCOPE(SLIST_MERGE_SORTED_N);
     assert(slist);
+    assert((lists) || (count == 0));
+    assert(slist->slist_comp_func);
+    JLL_PROF_OP(slist);
 
-    if (jll_slist_is_empty(slist))
-    {
-        return NULL;
-    }
+    jll_slist_merge_tree_t tree;
+    tree.leaves = 1;
+    while (tree.leaves < count + 1) tree.leaves <<= 1;
 
-    
-    const jll_data_t * retdata;
+    tree.heads = (jll_snode_t **)calloc(2 * tree.leaves, sizeof(jll_snode_t *));
+    tree.tails = tree.heads + tree.leaves;
+    tree.losers = (size_t *)malloc(tree.leaves * sizeof(size_t));
+
+    size_t live = 0;
+    size_t total = 0;
 
-    if (!slist->head->next)
+    for (size_t k = 0; k <= count; k++)
     {
-        retdata = jll_dealloc_snode(slist->head);
-        slist->head = NULL;
-        slist->tail = NULL;
+        jll_slist_t * source = (k == 0) ? slist : lists[k - 1];
+        assert((k == 0) || (source != slist));
+
+        if (jll_slist_is_empty(source)) continue;
+
+        total += source->length;
+        live++;
+
+        if (k > 0) tree.heads[k] = __jll_slist_absorb(slist, source, &tree.tails[k]);
+        else
+        {
+            tree.heads[k] = source->head;
+            tree.tails[k] = source->tail;
+        }
+
+        tree.tails[k]->next = NULL;
     }
-    else
+
+    if (live > 0)
     {
-        jll_snode_t * newhead = slist->head->next;
-        retdata = jll_dealloc_snode(slist->head);
-        slist->head = newhead;
-    }
+        __jll_slist_merge_build(slist, &tree);
+
+        jll_snode_t anchor;
+        jll_snode_t * last = &anchor;
+
+        while (live > 1)
+        {
+            size_t winner = tree.losers[0];
+            jll_snode_t * node = tree.heads[winner];
+
+            last->next = node;
+            last = node;
+            JLL_PROF_HOP(slist);
 
-    slist->length--;
-    if ((slist->circular) && (slist->tail)) slist->tail->next = slist->head;
+            tree.heads[winner] = node->next;
+            if (!node->next) live--;
+            else if (node->next->next) __builtin_prefetch(node->next->next);
 
-    return retdata;
+            __jll_slist_merge_replay(slist, &tree, winner);
+        }
+
+        // The last remaining run is already in order.
+        size_t winner = tree.losers[0];
+        last->next = tree.heads[winner];
+
+        slist->head = anchor.next;
+        slist->tail = tree.tails[winner];
+        slist->length = total;
+        slist->generation++;
+        slist->tail->next = (slist->circular) ? slist->head : NULL;
+        __jll_slist_restart_counts(slist);
+    }
+
+    free(tree.heads);
+    free(tree.losers);
 }
 
 
+/* sorting */
+
 /**
- * @brief Removes tail node from a singly-linked list
- * @param slist List to be edited
- * @returns Constant reference to the data once held by the removed tail
+ * @brief Key and node pair sorted by jll_slist_radix_sort; keys are read once, up front
  */
-const jll_data_t * jll_slist_remove_tail(jll_slist_t * slist)
+typedef struct jll_slist_radix_item_type
 {
+    uint64_t key;
+    jll_snode_t * node;
+
+} jll_slist_radix_item_t;
 
+/**
+ * @brief Sorts a singly-linked list into ascending order of an unsigned integer key with a stable LSD radix sort
+ * (eight passes of one byte each), then relinks the nodes in that order. Each element's key is extracted exactly
+ * once and passes over bytes which are the same for every key are skipped, so 32-bit keys cost four passes.
+ * Signed keys sort correctly if the extractor flips their sign bit.
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param keyfunc User-specified function returning the sort key of an element
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_radix_sort(jll_slist_t * slist, data_keyfunc_t keyfunc)
+{
+    JLL_LAT_SCOPE(SLIST_RADIX_SORT);
     assert(slist);
+    assert(keyfunc);
+    JLL_PROF_OP(slist);
 
-    if (jll_slist_is_empty(slist)) return NULL;
+    size_t length = slist->length;
+    if (length < 2) return;
 
-    const jll_data_t * retdata;
-    jll_snode_t * newtail;
+    jll_slist_radix_item_t * items = (jll_slist_radix_item_t *)malloc(2 * length * sizeof(jll_slist_radix_item_t));
+    jll_slist_radix_item_t * scratch = items + length;
 
-    if (slist->length == 1)
+    // One pass over the list reads the keys and builds the histograms of all eight digits.
+    size_t (*counts)[256] = (size_t (*)[256])calloc(8 * 256, sizeof(size_t));
+
+    jll_snode_t * rover = slist->head;
+    for (size_t k = 0; k < length; k++)
     {
-        retdata = jll_dealloc_snode(slist->tail);
-        slist->head = NULL;
-        slist->tail = NULL;
+        uint64_t key = keyfunc(rover->data);
+
+        items[k].key = key;
+        items[k].node = rover;
+        for (unsigned d = 0; d < 8; d++) counts[d][(key >> (8 * d)) & 0xff]++;
+
+        rover = rover->next;
     }
-    else
+
+    for (unsigned d = 0; d < 8; d++)
     {
-        newtail = slist->head;
-        while ((newtail) && (newtail->next != slist->tail)) newtail = newtail->next;
+        unsigned shift = 8 * d;
 
-        retdata = jll_dealloc_snode(slist->tail);
-        slist->tail = newtail;
+        // Every key has the same digit here; the pass would not move anything.
+        if (counts[d][(items[0].key >> shift) & 0xff] == length) continue;
 
-        if (slist->circular) slist->tail->next = slist->head;
-        else slist->tail->next = NULL;
+        size_t offset = 0;
+        for (unsigned b = 0; b < 256; b++)
+        {
+            size_t count = counts[d][b];
+            counts[d][b] = offset;
+            offset += count;
+        }
+
+        for (size_t k = 0; k < length; k++) scratch[counts[d][(items[k].key >> shift) & 0xff]++] = items[k];
+
+        jll_slist_radix_item_t * swap = items;
+        items = scratch;
+        scratch = swap;
     }
 
-    slist->length--;
-    return retdata;
+    // Relink the nodes in key order.
+    for (size_t k = 0; k + 1 < length; k++) items[k].node->next = items[k + 1].node;
+
+    slist->head = items[0].node;
+    slist->tail = items[length - 1].node;
+    slist->tail->next = (slist->circular) ? slist->head : NULL;
+    __jll_slist_restart_counts(slist);
+    slist->generation++;
+
+    free((items < scratch) ? items : scratch);
+    free(counts);
 }
 
 
+/* set algebra */
+
 /**
- * @brief Removes first node in a singly-linked list which matches a user-specified condition
- * @param slist List to to be edited
- * @param compfunc Boolean function which returns true if the data in the argument meets some user-specified criteria.
- * @returns A constant reference to the first data in the list to return true from the parameter compfunc.
+ * @brief Frees a node dropped by a set operation or dedupe pass, handing its data to the optional dealloc function
  */
-const jll_data_t * jll_slist_remove_cond_first(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
+static void __jll_slist_drop_node(jll_slist_t * slist, jll_snode_t * node, void (*data_dealloc_func)(const jll_data_t *))
 {
-    assert(slist);
-    assert(compfunc);
+    const jll_data_t * old_data_ptr = __jll_slist_free_node(slist, node);
+    if (data_dealloc_func) data_dealloc_func(old_data_ptr);
+}
+
+/**
+ * @brief Applies a set operation to two sorted singly-linked lists in a single linear pass, splicing nodes.
+ * Lists are treated as multisets: each element of lone is paired with at most one equal element of ltwo,
+ * and for union and intersection the element of lone is the one kept.
+ * 
+ * @param lone List receiving the result; its comparison function decides order and equality
+ * @param ltwo Second operand; it is left empty (but not deallocated)
+ * @param op   Union, intersection, difference (lone - ltwo) or symmetric difference
+ * @param data_dealloc_func Function handed the data of every dropped node (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_set_operation(jll_slist_t * lone, jll_slist_t * ltwo, jll_setop_t op, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SLIST_SET_OPERATION);
+    assert(lone);
+    assert(ltwo);
+    assert(lone != ltwo);
+    assert(lone->slist_comp_func);
+    JLL_PROF_OP(lone);
 
+    bool keep_lone = (op != JLL_SET_INTERSECTION);
+    bool keep_ltwo = (op == JLL_SET_UNION) || (op == JLL_SET_SYMMETRIC_DIFFERENCE);
+    bool keep_pair = (op == JLL_SET_UNION) || (op == JLL_SET_INTERSECTION);
 
-    jll_snode_t * fptr = slist->head;
-    jll_snode_t * bptr = NULL;
+    if (!jll_slist_is_empty(lone)) lone->tail->next = NULL;
+
+    jll_snode_t * a = lone->head;
 
-    while (fptr)
+    // Every node of ltwo becomes lone's (keyed and filtered as such); those the operation drops count as removals.
+    jll_snode_t * b_tail;
+    jll_snode_t * b = __jll_slist_absorb(lone, ltwo, &b_tail);
+    if (b) b_tail->next = NULL;
+
+    jll_snode_t anchor;
+    jll_snode_t * last = &anchor;
+    size_t length = 0;
+
+    while ((a) || (b))
     {
-        if (compfunc(fptr->data))
+        int order = 1;
+
+        if (!a) order = -1;
+        else if (b) order = __jll_slist_compare_nodes(lone, a, b);
+
+        if (order == -1)
         {
-            if (fptr == slist->head)
+            // Only in ltwo.
+            jll_snode_t * next = b->next;
+
+            if (keep_ltwo)
+            {
+                last->next = b;
+                last = b;
+                length++;
+            }
+            else
             {
-                return jll_slist_remove_head(slist);
+                __jll_slist_drop_node(lone, b, data_dealloc_func);
+                __jll_slist_note_remove(lone);
             }
-            else if (fptr == slist->tail)
+
+            b = next;
+        }
+        else if (order == 0)
+        {
+            // In both; the node of ltwo is always dropped.
+            jll_snode_t * next_a = a->next;
+            jll_snode_t * next_b = b->next;
+
+            if (keep_pair)
             {
-                return jll_slist_remove_tail(slist);
+                last->next = a;
+                last = a;
+                length++;
             }
             else
             {
-                bptr->next = fptr->next;
-                const jll_data_t * retdata = jll_dealloc_snode(fptr);
-                slist->length--;
-                return retdata;
+                __jll_slist_drop_node(lone, a, data_dealloc_func);
+                __jll_slist_note_remove(lone);
             }
+
+            __jll_slist_drop_node(lone, b, data_dealloc_func);
+            __jll_slist_note_remove(lone);
+
+            a = next_a;
+            b = next_b;
         }
         else
         {
-            bptr = fptr;
-            fptr = fptr->next;
+            // Only in lone.
+            jll_snode_t * next = a->next;
+
+            if (keep_lone)
+            {
+                last->next = a;
+                last = a;
+                length++;
+            }
+            else
+            {
+                __jll_slist_drop_node(lone, a, data_dealloc_func);
+                __jll_slist_note_remove(lone);
+            }
+
+            a = next;
         }
+
+        JLL_PROF_HOP(lone);
     }
 
-    return NULL;
-}
+    last->next = NULL;
 
+    lone->head = (length) ? anchor.next : NULL;
+    lone->tail = (length) ? last : NULL;
+    lone->length = length;
+    lone->generation++;
+    if (length) lone->tail->next = (lone->circular) ? lone->head : NULL;
+    __jll_slist_restart_counts(lone);
+}
 
-const jll_data_t * jll_slist_remove_cond_nth(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), size_t n)
+/**
+ * @brief Builds the result of a set operation on two sorted singly-linked lists as a new list, leaving both operands untouched.
+ * The new list allocates its nodes from its own pool and references (does not copy) the operands' data,
+ * so it should be deallocated with a data function which does not free them.
+ * 
+ * @param lone First operand; its comparison function decides order and equality
+ * @param ltwo Second operand
+ * @param op   Union, intersection, difference (lone - ltwo) or symmetric difference
+ * 
+ * @returns Pointer to the newly created sorted list
+ */
+jll_slist_t * jll_slist_set_operation_copy(const jll_slist_t * lone, const jll_slist_t * ltwo, jll_setop_t op)
 {
-    assert(slist);
-    assert(compfunc);
+    JLL_LAT_SCOPE(SLIST_SET_OPERATION_COPY);
+    assert(lone);
+    assert(ltwo);
+    assert(lone->slist_comp_func);
 
-    if (n >= slist->length) return NULL;
+    data_compfunc_t comp = lone->slist_comp_func;
 
-    size_t counter = 0;
-    jll_snode_t * rover = slist->head;
+    // The operands' cached keys order them as the comparison function would when both key by the same function.
+    bool keyed = (lone->slist_key_func) && (ltwo->slist_key_func == lone->slist_key_func);
 
-    while (rover)
+    bool keep_lone = (op != JLL_SET_INTERSECTION);
+    bool keep_ltwo = (op == JLL_SET_UNION) || (op == JLL_SET_SYMMETRIC_DIFFERENCE);
+    bool keep_pair = (op == JLL_SET_UNION) || (op == JLL_SET_INTERSECTION);
+
+    jll_slist_t * result = jll_alloc_slist(comp, false, true, false);
+
+    // Size pool blocks for the result so large builds need few of them.
+    size_t bound = lone->length + ltwo->length;
+    if (bound < JLL_SLIST_POOL_BLOCK) bound = JLL_SLIST_POOL_BLOCK;
+    if (bound > JLL_SLIST_POOL_BLOCK_MAX) bound = JLL_SLIST_POOL_BLOCK_MAX;
+    result->pool = jll_alloc_pool(__jll_slist_node_bytes(result), bound, false);
+
+    const jll_snode_t * a = lone->head;
+    const jll_snode_t * b = ltwo->head;
+    size_t left_a = lone->length;
+    size_t left_b = ltwo->length;
+
+    while ((left_a) || (left_b))
     {
-        if (compfunc(rover->data)) counter++;
-        if (counter == n) return rover->data;
-        else rover = rover->next;
+        int order = 1;
+
+        if (!left_a) order = -1;
+        else if ((left_b) && (keyed) && (JLL_SKNODE(a)->key != JLL_SKNODE(b)->key))
+        {
+            order = (JLL_SKNODE(a)->key > JLL_SKNODE(b)->key) ? -1 : 1;
+        }
+        else if (left_b)
+        {
+            JLL_PROF_CMP(result);
+            order = comp(a->data, b->data);
+        }
+
+        if (order == -1)
+        {
+            if (keep_ltwo) jll_slist_append_tail(result, b->data);
+            b = b->next;
+            left_b--;
+        }
+        else if (order == 0)
+        {
+            if (keep_pair) jll_slist_append_tail(result, a->data);
+            a = a->next;
+            b = b->next;
+            left_a--;
+            left_b--;
+        }
+        else
+        {
+            if (keep_lone) jll_slist_append_tail(result, a->data);
+            a = a->next;
+            left_a--;
+        }
     }
 
-    return NULL;
+    return result;
 }
 
-
-jll_data_payload_t * jll_slist_remove_cond_first_n(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), size_t n)
+/**
+ * @brief Removes every node of a sorted singly-linked list which compares equal (0) to its predecessor
+ * 
+ * @param slist Sorted list to be deduplicated
+ * @param data_dealloc_func Function handed the data of every removed node (may be NULL)
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_slist_unique(jll_slist_t * slist, void (*data_dealloc_func)(const jll_data_t *))
 {
+    JLL_LAT_SCOPE(SLIST_UNIQUE);
     assert(slist);
-    assert(compfunc);
-
-    if (n >= slist->length) return NULL;
+    assert(slist->slist_comp_func);
+    JLL_PROF_OP(slist);
 
-    size_t index = 0;
-    size_t found = 0;
-    jll_data_t ** vector;
+    if (slist->length < 2) return 0;
 
+    slist->tail->next = NULL;
 
+    size_t removed = 0;
     jll_snode_t * rover = slist->head;
 
-    
-    while (rover && found < n)
+    while (rover->next)
     {
-        if (compfunc(rover->data))
+        jll_snode_t * next = rover->next;
+
+        JLL_PROF_CMP(slist);
+        if (slist->slist_comp_func(rover->data, next->data) == 0)
         {
-            found++;
-            vector = (jll_data_t **)realloc(vector, found * sizeof(jll_data_t *));
-            vector[found - 1] = jll_slist_remove_index(slist, index);
-        }
+            rover->next = next->next;
+            if (next == slist->tail) slist->tail = rover;
 
-        index++;
-        rover = rover->next;
+            __jll_slist_drop_node(slist, next, data_dealloc_func);
+            __jll_slist_note_remove(slist);
+            removed++;
+        }
+        else
+        {
+            rover = next;
+            JLL_PROF_HOP(slist);
+        }
     }
 
+    slist->length -= removed;
+    slist->tail->next = (slist->circular) ? slist->head : NULL;
 
-    if (found == 0) return NULL;
-
-    jll_data_payload_t * new_payload = jll_allocate_data_payload((const jll_data_t **)vector, found);
-    return new_payload;
+    return removed;
 }
 
-jll_data_payload_t * jll_slist_remove_cond_all(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
+/**
+ * @brief Removes every node of an unsorted singly-linked list whose data compares equal (0) to that of an earlier node,
+ * in one pass with an open-addressing hash table; the first occurrence of each element is kept.
+ * 
+ * @param slist List to be deduplicated; its comparison function decides equality
+ * @param hashfunc User-specified hash, consistent with the comparison function
+ * @param data_dealloc_func Function handed the data of every removed node (may be NULL)
+ * 
+ * @returns Number of nodes removed
+ */
+size_t jll_slist_dedupe(jll_slist_t * slist, data_hashfunc_t hashfunc, void (*data_dealloc_func)(const jll_data_t *))
 {
+    JLL_LAT_SCOPE(SLIST_DEDUPE);
     assert(slist);
-    assert(compfunc);
+    assert(hashfunc);
+    assert(slist->slist_comp_func);
+    JLL_PROF_OP(slist);
 
-    size_t index = 0;
-    size_t found = 0;
-    jll_data_t ** vector;
+    if (slist->length < 2) return 0;
+
+    unsigned bits = 1;
+    while (((size_t)1 << bits) < 2 * slist->length) bits++;
 
+    size_t mask = ((size_t)1 << bits) - 1;
+    const jll_data_t ** table = (const jll_data_t **)calloc(mask + 1, sizeof(jll_data_t *));
 
+    slist->tail->next = NULL;
+
+    size_t removed = 0;
+    jll_snode_t * prev = NULL;
     jll_snode_t * rover = slist->head;
 
     while (rover)
     {
-        if (compfunc(rover->data))
+        jll_snode_t * next = rover->next;
+
+        // Fibonacci hashing spreads weak user hashes over the table.
+        size_t slot = (size_t)(((unsigned long long)hashfunc(rover->data) * 0x9e3779b97f4a7c15ULL) >> (64 - bits));
+        bool duplicate = false;
+
+        while (table[slot])
         {
-            found++;
-            vector = (jll_data_t **)realloc(vector, found * sizeof(jll_data_t *));
-            vector[found - 1] = jll_slist_remove_index(slist, index);
+            JLL_PROF_CMP(slist);
+            if (slist->slist_comp_func(table[slot], rover->data) == 0)
+            {
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1) & mask;
         }
-        index++;
-        rover = rover->next;
+
+        if (duplicate)
+        {
+            // The first node is never a duplicate, so prev is set.
+            prev->next = next;
+            if (rover == slist->tail) slist->tail = prev;
+
+            __jll_slist_drop_node(slist, rover, data_dealloc_func);
+            __jll_slist_note_remove(slist);
+            removed++;
+        }
+        else
+        {
+            table[slot] = rover->data;
+            prev = rover;
+        }
+
+        rover = next;
+        JLL_PROF_HOP(slist);
     }
 
-    if (found == 0) return NULL;
+    free(table);
 
-    jll_data_payload_t * new_payload = jll_allocate_data_payload((const jll_data_t **)vector, found);
-    return new_payload;
+    slist->length -= removed;
+    slist->tail->next = (slist->circular) ? slist->head : NULL;
+
+    return removed;
 }
 
 
-jll_data_payload_t * jll_slist_remove_all(jll_slist_t * slist)
-{
-    assert(slist);
-    if (jll_slist_is_empty(slist)) return NULL;
+/* node-level operations */
 
-    size_t index  = 0;
-    size_t veclen = slist->length;
-    jll_data_t ** vector = (jll_data_t **)malloc(veclen * sizeof(jll_data_t *));
+/**
+ * @brief Takes in a node linked by the caller as any inserted node is: its sort key is cached and its data
+ * enters the filter. Such nodes belong to the caller, so the list never moves them into nodes of another kind.
+ */
+static void __jll_slist_adopt(jll_slist_t * slist, jll_snode_t * node)
+{
+    slist->caller_nodes = true;
+    slist->foreign_nodes = true;
 
-    while (!jll_slist_is_empty(slist))
+    if (slist->keyed)
     {
-        vector[index] = jll_slist_remove_head(slist);
-        index++;
+        JLL_SKNODE(node)->key = __jll_slist_key_of(slist, node->data);
+        JLL_SKNODE(node)->freq = 0;
     }
 
-    jll_data_payload_t * new_payload = jll_allocate_data_payload((const jll_data_t **)vector, veclen);
-    return new_payload;
+    __jll_slist_note_insert(slist, node->data);
 }
 
-/* access functions */
-
-const jll_data_t * jll_slist_index_pos(jll_slist_t * slist, size_t index)
+static void __jll_slist_link_head(jll_slist_t * slist, jll_snode_t * node)
 {
-    assert(slist);
-    if ((index < 0) || (index >= slist->length)) return NULL;
-    else if (index == 0) return slist->head->data;
-    else if (index == slist->length - 1) return slist->tail->data;
+    node->next = slist->head;
+    slist->head = node;
+    if (!slist->tail) slist->tail = node;
 
-    jll_snode_t * rover = slist->head;
-    for (size_t k = 0; k < index; k++) rover = rover->next;
-    return rover->data;
+    slist->length++;
+    slist->tail->next = (slist->circular) ? slist->head : NULL;
 }
 
-const jll_data_t * jll_slist_index_head(jll_slist_t * slist)
+static void __jll_slist_link_tail(jll_slist_t * slist, jll_snode_t * node)
 {
-    assert(slist);
-    if (jll_slist_is_empty(slist)) return NULL;
-    else return slist->head->data;
+    if (jll_slist_is_empty(slist)) slist->head = node;
+    else slist->tail->next = node;
+
+    slist->tail = node;
+    slist->length++;
+    slist->tail->next = (slist->circular) ? slist->head : NULL;
 }
 
-const jll_data_t * jll_slist_index_tail(jll_slist_t * slist)
+/**
+ * @brief Links an already allocated node in as the head of a singly-linked list
+ * and, like an appended node, caches its sort key and enters its data into the list's filter
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param node  Node to be linked; it must not currently belong to any list, and must be a keyed node
+ * (jll_sknode_t) while the list caches keys or counts
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_link_head(jll_slist_t * slist, jll_snode_t * node)
 {
+    JLL_LAT_SCOPE(SLIST_LINK_HEAD);
     assert(slist);
-    if (jll_slist_is_empty(slist)) return NULL;
-    else return slist->tail->data;
+    assert(node);
+
+    __jll_slist_adopt(slist, node);
+    __jll_slist_link_head(slist, node);
+    __jll_slist_count_in(slist, node);
 }
 
-const jll_data_t * jll_slist_find_first_occurrence(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
+/**
+ * @brief Links an already allocated node in as the tail of a singly-linked list
+ * and, like an appended node, caches its sort key and enters its data into the list's filter
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param node  Node to be linked; it must not currently belong to any list, and must be a keyed node
+ * (jll_sknode_t) while the list caches keys or counts
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_link_tail(jll_slist_t * slist, jll_snode_t * node)
 {
+    JLL_LAT_SCOPE(SLIST_LINK_TAIL);
     assert(slist);
-    assert(compfunc);
-
-    jll_snode_t * rover = slist->head;
-
-    while (rover)
-    {
-        if (compfunc(rover->data)) return rover->data;
-        else rover = rover->next;
-    }
+    assert(node);
 
-    return NULL;
+    __jll_slist_adopt(slist, node);
+    __jll_slist_link_tail(slist, node);
 }
 
-const jll_data_t * jll_slist_find_nth_occurrence(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *), size_t n)
+/**
+ * @brief Links an already allocated node in directly after a node of a singly-linked list
+ * and, like an appended node, caches its sort key and enters its data into the list's filter
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param node  Node to be linked; it must not currently belong to any list, and must be a keyed node
+ * (jll_sknode_t) while the list caches keys or counts
+ * @param at    Node of the list which the new node should follow (NULL to link it as the head)
+ * 
+ * @returns None (is void)
+ */
+void jll_slist_link_after(jll_slist_t * slist, jll_snode_t * node, jll_snode_t * at)
 {
+    JLL_LAT_SCOPE(SLIST_LINK_AFTER);
     assert(slist);
-    assert(compfunc);
-    if (n >= slist->length) return NULL;
+    assert(node);
 
-    size_t found = 0;
-    jll_snode_t * rover = slist->head;
+    __jll_slist_adopt(slist, node);
 
-    while (rover)
+    if (!at) __jll_slist_link_head(slist, node);
+    else if (at == slist->tail) __jll_slist_link_tail(slist, node);
+    else
     {
-        if (compfunc(rover->data)) found++;
-        if (found == n) return rover->data;
-        else rover = rover->next;
+        node->next = at->next;
+        at->next = node;
+
+        slist->length++;
     }
 
-    return NULL;
+    __jll_slist_count_in(slist, node);
 }
 
-
-bool jll_slist_check_if_sorted(jll_slist_t * slist)
+/**
+ * @brief Unlinks the node following a node of a singly-linked list in O(1) without freeing it
+ * 
+ * @param slist Pointer to the singly-linked list
+ * @param at    Node preceding the one to be unlinked (NULL to unlink the head); it must not be the tail
+ * 
+ * @returns The unlinked node
+ */
+jll_snode_t * jll_slist_unlink_after(jll_slist_t * slist, jll_snode_t * at)
 {
+    JLL_LAT_SCOPE(SLIST_UNLINK_AFTER);
     assert(slist);
-    if (!slist->slist_comp_func) return false;
-    else if (jll_slist_is_empty(slist)) return false;
+    assert(!jll_slist_is_empty(slist));
+    assert(at != slist->tail);
 
-    jll_snode_t * rover = slist->head;
-    
-    while (rover->next)
+    jll_snode_t * node = (at) ? at->next : slist->head;
+    slist->generation++;
+
+    if (slist->length == 1)
     {
-        if (slist->slist_comp_func(rover->data, rover->next->data) == -1) return false;
-        else rover = rover->next;
+        slist->head = NULL;
+        slist->tail = NULL;
     }
+    else
+    {
+        if (at) at->next = node->next;
+        else slist->head = node->next;
 
-    return true;
-}
-
-
-bool jll_slist_check_if_contains(jll_slist_t * slist, bool (*compfunc)(const jll_data_t *))
-{
-    assert(slist);
-    assert(compfunc);
+        if (node == slist->tail) slist->tail = at;
+        slist->tail->next = (slist->circular) ? slist->head : NULL;
+    }
 
-    jll_snode_t * rover = slist->head;
-    while (rover) if (compfunc(rover->data)) return true;
-    else rover = rover->next;
+    node->next = NULL;
+    slist->length--;
 
-    return false;
+    return node;
 }
-
-
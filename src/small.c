@@ -0,0 +1,380 @@
+
+
+# include <stdlib.h>
+# include <string.h>
+# include <assert.h>
+# include "./include/small.h"
+
+
+/* internal helpers */
+
+static uint64_t __jll_small_key_of(const jll_small_t * small, const jll_data_t * dptr)
+{
+    return (small->small_key_func) ? small->small_key_func(dptr) : 0;
+}
+
+static void __jll_small_put(jll_small_t * small, size_t pos, const jll_data_t * dptr, uint64_t key)
+{
+    small->store.items[pos] = dptr;
+    small->store.keys[pos] = key;
+}
+
+/**
+ * @brief Moves the inline elements into an embedded doubly-linked list. The inline array and the
+ * list share storage, so the elements are copied out first.
+ */
+static void __jll_small_promote(jll_small_t * small)
+{
+    const jll_data_t * items[JLL_SMALL_INLINE];
+    size_t length = small->length;
+
+    memcpy(items, small->store.items, length * sizeof(const jll_data_t *));
+
+    jll_init_dlist(&small->store.list, small->small_comp_func, false, false, false);
+    jll_dlist_set_key_func(&small->store.list, small->small_key_func);
+    for (size_t k = 0; k < length; k++) jll_dlist_append_tail(&small->store.list, items[k]);
+
+    small->promoted = true;
+}
+
+/**
+ * @brief Opens a gap at an inline position, promoting instead when the inline storage is full
+ *
+ * @returns True if the gap was opened, false if the list was promoted
+ */
+static bool __jll_small_open_gap(jll_small_t * small, size_t pos)
+{
+    if (small->length == JLL_SMALL_INLINE)
+    {
+        __jll_small_promote(small);
+        return false;
+    }
+
+    memmove(&small->store.items[pos + 1], &small->store.items[pos], (small->length - pos) * sizeof(const jll_data_t *));
+    memmove(&small->store.keys[pos + 1], &small->store.keys[pos], (small->length - pos) * sizeof(uint64_t));
+    small->length++;
+
+    return true;
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Initialise a small list embedded by value in another structure; no memory is allocated
+ * 
+ * @param small Pointer to the list storage to be initialised
+ * @param func  The comparison function used by sorted insertions (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_init_small(jll_small_t * small, data_compfunc_t func)
+{
+    assert(small);
+
+    small->length = 0;
+    small->promoted = false;
+    small->small_comp_func = func;
+    small->small_key_func = NULL;
+}
+
+/**
+ * @brief Release the elements of a small list initialised with jll_init_small; the list is left empty and inline,
+ * keeping its comparison and key functions
+ * 
+ * @param small Pointer to the small list
+ * @param data_dealloc_func User-specified function releasing the data of each element (may be NULL)
+ * 
+ * @returns None (is void)
+ */
+void jll_fini_small(jll_small_t * small, void (*data_dealloc_func)(const jll_data_t *))
+{
+    assert(small);
+
+    if (small->promoted) jll_fini_dlist(&small->store.list, data_dealloc_func);
+    else if (data_dealloc_func)
+    {
+        for (size_t k = 0; k < small->length; k++) data_dealloc_func(small->store.items[k]);
+    }
+
+    data_keyfunc_t key_func = small->small_key_func;
+
+    jll_init_small(small, small->small_comp_func);
+    small->small_key_func = key_func;
+}
+
+jll_small_t * jll_alloc_small(data_compfunc_t func)
+{
+    jll_small_t * new_small = (jll_small_t *)malloc(sizeof(jll_small_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_small_t));
+
+    jll_init_small(new_small, func);
+
+    return new_small;
+}
+
+void jll_dealloc_small(jll_small_t * small, void (*data_dealloc_func)(const jll_data_t *))
+{
+    assert(small);
+
+    jll_fini_small(small, data_dealloc_func);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_small_t));
+    free(small);
+}
+
+
+/* insertion functions */
+
+void jll_small_append_head(jll_small_t * small, const jll_data_t * dptr)
+{
+    assert(small);
+    assert(dptr);
+
+    if ((small->promoted) || (!__jll_small_open_gap(small, 0)))
+    {
+        jll_dlist_append_head(&small->store.list, dptr);
+        return;
+    }
+
+    __jll_small_put(small, 0, dptr, __jll_small_key_of(small, dptr));
+}
+
+void jll_small_append_tail(jll_small_t * small, const jll_data_t * dptr)
+{
+    assert(small);
+    assert(dptr);
+
+    if ((small->promoted) || (!__jll_small_open_gap(small, small->length)))
+    {
+        jll_dlist_append_tail(&small->store.list, dptr);
+        return;
+    }
+
+    __jll_small_put(small, small->length - 1, dptr, __jll_small_key_of(small, dptr));
+}
+
+/**
+ * @brief Inserts data after every element which does not belong after it, as jll_dlist_insert_sorted does
+ */
+void jll_small_insert_sorted(jll_small_t * small, const jll_data_t * dptr)
+{
+    assert(small);
+    assert(dptr);
+    assert(small->small_comp_func);
+
+    if (small->promoted)
+    {
+        jll_dlist_insert_sorted(&small->store.list, dptr);
+        return;
+    }
+
+    uint64_t key = __jll_small_key_of(small, dptr);
+    size_t pos = small->length;
+
+    // Keys order the elements up to the run of equal keys; only that run is walked with the comparison function.
+    if (small->small_key_func) pos = jll_keys_upper_bound(small->store.keys, small->length, key);
+
+    while ((pos > 0) && ((!small->small_key_func) || (small->store.keys[pos - 1] == key))
+           && (small->small_comp_func(small->store.items[pos - 1], dptr) == -1)) pos--;
+
+    if (!__jll_small_open_gap(small, pos))
+    {
+        jll_dlist_insert_sorted(&small->store.list, dptr);
+        return;
+    }
+
+    __jll_small_put(small, pos, dptr, key);
+}
+
+
+/* deletion functions */
+
+const jll_data_t * jll_small_remove_index(jll_small_t * small, size_t index)
+{
+    assert(small);
+
+    if (small->promoted) return jll_dlist_remove_index(&small->store.list, index);
+    if (index >= small->length) return NULL;
+
+    const jll_data_t * old_data_ptr = small->store.items[index];
+
+    small->length--;
+    memmove(&small->store.items[index], &small->store.items[index + 1], (small->length - index) * sizeof(const jll_data_t *));
+    memmove(&small->store.keys[index], &small->store.keys[index + 1], (small->length - index) * sizeof(uint64_t));
+
+    return old_data_ptr;
+}
+
+const jll_data_t * jll_small_remove_head(jll_small_t * small)
+{
+    assert(small);
+
+    if (small->promoted) return jll_dlist_remove_head(&small->store.list);
+    return jll_small_remove_index(small, 0);
+}
+
+const jll_data_t * jll_small_remove_tail(jll_small_t * small)
+{
+    assert(small);
+
+    if (small->promoted) return jll_dlist_remove_tail(&small->store.list);
+    if (small->length == 0) return NULL;
+
+    return small->store.items[--small->length];
+}
+
+const jll_data_t * jll_small_remove_cond_first(jll_small_t * small, bool (*compfunc)(const jll_data_t *))
+{
+    assert(small);
+    assert(compfunc);
+
+    if (small->promoted) return jll_dlist_remove_cond_first(&small->store.list, compfunc);
+
+    for (size_t k = 0; k < small->length; k++)
+    {
+        if (compfunc(small->store.items[k])) return jll_small_remove_index(small, k);
+    }
+
+    return NULL;
+}
+
+
+/* access functions */
+
+const jll_data_t * jll_small_index_pos(jll_small_t * small, size_t index)
+{
+    assert(small);
+
+    if (small->promoted) return jll_dlist_index_pos(&small->store.list, index);
+    return (index < small->length) ? small->store.items[index] : NULL;
+}
+
+const jll_data_t * jll_small_index_head(jll_small_t * small)
+{
+    assert(small);
+
+    if (small->promoted) return jll_dlist_index_head(&small->store.list);
+    return (small->length) ? small->store.items[0] : NULL;
+}
+
+const jll_data_t * jll_small_index_tail(jll_small_t * small)
+{
+    assert(small);
+
+    if (small->promoted) return jll_dlist_index_tail(&small->store.list);
+    return (small->length) ? small->store.items[small->length - 1] : NULL;
+}
+
+const jll_data_t * jll_small_find_first_occurrence(jll_small_t * small, bool (*compfunc)(const jll_data_t *))
+{
+    assert(small);
+    assert(compfunc);
+
+    if (small->promoted) return jll_dlist_find_first_occurrence(&small->store.list, compfunc);
+
+    for (size_t k = 0; k < small->length; k++)
+    {
+        if (compfunc(small->store.items[k])) return small->store.items[k];
+    }
+
+    return NULL;
+}
+
+bool jll_small_check_if_contains(jll_small_t * small, bool (*compfunc)(const jll_data_t *))
+{
+    return (jll_small_find_first_occurrence(small, compfunc) != NULL);
+}
+
+size_t jll_small_length(const jll_small_t * small)
+{
+    assert(small);
+    return (small->promoted) ? small->store.list.length : small->length;
+}
+
+bool jll_small_is_empty(const jll_small_t * small)
+{
+    return (jll_small_length(small) == 0);
+}
+
+/**
+ * @brief Copies up to max data pointers, in order, into a caller-provided array
+ * 
+ * @returns Number of pointers copied
+ */
+size_t jll_small_to_array(const jll_small_t * small, const jll_data_t ** out, size_t max)
+{
+    assert(small);
+    assert(out || (max == 0));
+
+    if (small->promoted) return jll_dlist_to_array(&small->store.list, out, max);
+
+    size_t count = (small->length < max) ? small->length : max;
+    memcpy(out, small->store.items, count * sizeof(const jll_data_t *));
+
+    return count;
+}
+
+
+/* cached sort keys */
+
+/**
+ * @brief Caches a sort key for every element, as jll_dlist_set_key_func does. The inline keys are
+ * contiguous, so sorted insertion bisects them with the vector kernels instead of reading the data.
+ *
+ * @param small Pointer to the small list; its existing elements are keyed straight away
+ * @param func  Key function; key(a) < key(b) must imply that a sorts before b. NULL drops the cached keys.
+ *
+ * @returns None (is void)
+ */
+void jll_small_set_key_func(jll_small_t * small, data_keyfunc_t func)
+{
+    assert(small);
+
+    small->small_key_func = func;
+
+    if (small->promoted)
+    {
+        jll_dlist_set_key_func(&small->store.list, func);
+        return;
+    }
+
+    for (size_t k = 0; k < small->length; k++) small->store.keys[k] = __jll_small_key_of(small, small->store.items[k]);
+}
+
+/**
+ * @brief Finds data by its cached key without reading any data
+ *
+ * @returns The data of the first element holding the key, or NULL if there is none
+ */
+const jll_data_t * jll_small_find_cached_key(jll_small_t * small, uint64_t key)
+{
+    assert(small);
+    assert(small->small_key_func);
+
+    if (small->promoted) return jll_dlist_find_cached_key(&small->store.list, key);
+
+    size_t pos = jll_keys_find(small->store.keys, small->length, key);
+    return (pos < small->length) ? small->store.items[pos] : NULL;
+}
+
+
+/* representation */
+
+bool jll_small_is_promoted(const jll_small_t * small)
+{
+    assert(small);
+    return small->promoted;
+}
+
+/**
+ * @brief Gives access to the full doubly-linked list API, promoting the list if it is still inline.
+ * The returned list is owned by the small list and must not be deallocated on its own.
+ */
+jll_dlist_t * jll_small_as_dlist(jll_small_t * small)
+{
+    assert(small);
+
+    if (!small->promoted) __jll_small_promote(small);
+    return &small->store.list;
+}
@@ -0,0 +1,180 @@
+
+# include <stdlib.h>
+# include <assert.h>
+# include "./include/snode.h"
+# include "./include/memstat.h"
+
+
+/**
+ * @brief Allocate a singly-linked list node
+ * 
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node
+ */
+jll_snode_t * jll_alloc_snode(const jll_data_t * dptr)
+{
+    jll_snode_t * new_snode = (jll_snode_t *)malloc(sizeof(jll_snode_t));
+
+    new_snode->next = NULL;
+    new_snode->data = dptr;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_snode_t));
+
+    return new_snode;
+}
+
+/**
+ * @brief Allocate a singly-linked list node from a node pool
+ * 
+ * @param pool Pool to allocate from; the pool's node size must be at least sizeof(jll_snode_t)
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node
+ */
+jll_snode_t * jll_alloc_snode_from(jll_pool_t * pool, const jll_data_t * dptr)
+{
+    assert(pool);
+    assert(pool->node_size >= sizeof(jll_snode_t));
+
+    jll_snode_t * new_snode = (jll_snode_t *)jll_pool_get(pool);
+
+    new_snode->next = NULL;
+    new_snode->data = dptr;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_snode_t));
+
+    return new_snode;
+}
+
+/**
+ * @brief Deallocate a singly-linked list node
+ * 
+ * @param snode Node to be deallocated; pool nodes are returned to the pool they came from
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_snode(jll_snode_t * snode)
+{
+    assert(snode);
+
+    const jll_data_t * retdata = snode->data;
+    if (!jll_pool_release(snode)) free(snode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_snode_t));
+
+    return retdata;
+}
+
+/**
+ * @brief Deallocate a singly-linked list node whose origin is known, without looking its owner up
+ * 
+ * @param pool  Pool the node came from, or NULL if it came from the heap
+ * @param snode Node to be deallocated
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_snode_to(jll_pool_t * pool, jll_snode_t * snode)
+{
+    assert(snode);
+
+    const jll_data_t * retdata = snode->data;
+    if (pool) jll_pool_put(pool, snode);
+    else free(snode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_snode_t));
+
+    return retdata;
+}
+
+/**
+ * @brief Allocate a keyed singly-linked list node, as used by lists which cache sort keys or access counts
+ * 
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node, with a zero key and count
+ */
+jll_sknode_t * jll_alloc_sknode(const jll_data_t * dptr)
+{
+    jll_sknode_t * new_sknode = (jll_sknode_t *)malloc(sizeof(jll_sknode_t));
+
+    new_sknode->node.next = NULL;
+    new_sknode->node.data = dptr;
+    new_sknode->key = 0;
+    new_sknode->freq = 0;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_sknode_t));
+
+    return new_sknode;
+}
+
+/**
+ * @brief Allocate a keyed singly-linked list node from a node pool
+ * 
+ * @param pool Pool to allocate from; the pool's node size must be at least sizeof(jll_sknode_t)
+ * @param dptr Data to be referenced by the node
+ * 
+ * @returns Pointer to the newly created node, with a zero key and count
+ */
+jll_sknode_t * jll_alloc_sknode_from(jll_pool_t * pool, const jll_data_t * dptr)
+{
+    assert(pool);
+    assert(pool->node_size >= sizeof(jll_sknode_t));
+
+    jll_sknode_t * new_sknode = (jll_sknode_t *)jll_pool_get(pool);
+
+    new_sknode->node.next = NULL;
+    new_sknode->node.data = dptr;
+    new_sknode->key = 0;
+    new_sknode->freq = 0;
+
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_sknode_t));
+
+    return new_sknode;
+}
+
+/**
+ * @brief Deallocate a keyed singly-linked list node
+ * 
+ * @param sknode Node to be deallocated; pool nodes are returned to the pool they came from
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_sknode(jll_sknode_t * sknode)
+{
+    assert(sknode);
+
+    const jll_data_t * retdata = sknode->node.data;
+    if (!jll_pool_release(sknode)) free(sknode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_sknode_t));
+
+    return retdata;
+}
+
+/**
+ * @brief Deallocate a keyed singly-linked list node whose origin is known, without looking its owner up
+ * 
+ * @param pool   Pool the node came from, or NULL if it came from the heap
+ * @param sknode Node to be deallocated
+ * 
+ * @returns Constant reference to the data once held by the node
+ */
+const jll_data_t * jll_dealloc_sknode_to(jll_pool_t * pool, jll_sknode_t * sknode)
+{
+    assert(sknode);
+
+    const jll_data_t * retdata = sknode->node.data;
+    if (pool) jll_pool_put(pool, sknode);
+    else free(sknode);
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_sknode_t));
+
+    return retdata;
+}
+
+const jll_data_t * jll_access_snode(const jll_snode_t * snode)
+{
+    assert(snode);
+    return snode->data;
+}
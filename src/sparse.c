@@ -0,0 +1,491 @@
+
+# include <stdlib.h>
+# include <assert.h>
+# include "./include/sparse.h"
+
+
+/* treap helpers */
+
+static size_t __jll_sparse_span(const jll_sparse_node_t * node)
+{
+    return (node) ? node->span : 0;
+}
+
+static size_t __jll_sparse_count(const jll_sparse_node_t * node)
+{
+    return (node) ? node->count : 0;
+}
+
+static void __jll_sparse_update(jll_sparse_node_t * node)
+{
+    node->span = __jll_sparse_span(node->left) + node->gap + 1 + __jll_sparse_span(node->right);
+    node->count = __jll_sparse_count(node->left) + 1 + __jll_sparse_count(node->right);
+}
+
+static jll_sparse_node_t * __jll_sparse_new_node(jll_sparse_t * sparse, const jll_data_t * dptr, size_t gap)
+{
+    jll_sparse_node_t * node = (jll_sparse_node_t *)malloc(sizeof(jll_sparse_node_t));
+    JLL_MEM_ADD(JLL_MEM_NODES, sizeof(jll_sparse_node_t));
+
+    sparse->seed ^= sparse->seed << 13;
+    sparse->seed ^= sparse->seed >> 7;
+    sparse->seed ^= sparse->seed << 17;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->data = dptr;
+    node->gap = gap;
+    node->priority = (uint32_t)(sparse->seed >> 32);
+    __jll_sparse_update(node);
+
+    return node;
+}
+
+static const jll_data_t * __jll_sparse_free_node(jll_sparse_node_t * node)
+{
+    const jll_data_t * old_data_ptr = node->data;
+
+    JLL_MEM_SUB(JLL_MEM_NODES, sizeof(jll_sparse_node_t));
+    free(node);
+
+    return old_data_ptr;
+}
+
+/**
+ * @brief Splits a treap into the nodes positioned before a position and the rest. Positions in the right
+ * part are then measured from the end of the left part, which is exactly what its first gap encodes.
+ */
+static void __jll_sparse_split(jll_sparse_node_t * node, size_t position, jll_sparse_node_t ** left, jll_sparse_node_t ** right)
+{
+    if (!node)
+    {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    size_t offset = __jll_sparse_span(node->left) + node->gap;
+
+    if (offset < position)
+    {
+        __jll_sparse_split(node->right, position - offset - 1, &node->right, right);
+        *left = node;
+    }
+    else
+    {
+        __jll_sparse_split(node->left, position, left, &node->left);
+        *right = node;
+    }
+
+    __jll_sparse_update(node);
+}
+
+static jll_sparse_node_t * __jll_sparse_merge(jll_sparse_node_t * left, jll_sparse_node_t * right)
+{
+    if (!left) return right;
+    if (!right) return left;
+
+    if (left->priority > right->priority)
+    {
+        left->right = __jll_sparse_merge(left->right, right);
+        __jll_sparse_update(left);
+        return left;
+    }
+
+    right->left = __jll_sparse_merge(left, right->left);
+    __jll_sparse_update(right);
+    return right;
+}
+
+/**
+ * @brief Widens (grow) or narrows (shrink) the gap in front of a treap's first node, moving every node
+ * of the treap by the same amount without visiting them
+ */
+static void __jll_sparse_shift_first(jll_sparse_node_t * node, size_t grow, size_t shrink)
+{
+    if (!node) return;
+
+    if (node->left) __jll_sparse_shift_first(node->left, grow, shrink);
+    else
+    {
+        assert(node->gap + grow >= shrink);
+        node->gap = node->gap + grow - shrink;
+    }
+
+    __jll_sparse_update(node);
+}
+
+static void __jll_sparse_destroy(jll_sparse_node_t * node, void (*data_dealloc_func)(const jll_data_t *))
+{
+    if (!node) return;
+
+    __jll_sparse_destroy(node->left, data_dealloc_func);
+    __jll_sparse_destroy(node->right, data_dealloc_func);
+
+    const jll_data_t * old_data_ptr = __jll_sparse_free_node(node);
+    if (data_dealloc_func) data_dealloc_func(old_data_ptr);
+}
+
+static size_t __jll_sparse_collect(const jll_sparse_node_t * node, size_t base, size_t * positions, const jll_data_t ** data, size_t max, size_t taken)
+{
+    if ((!node) || (taken == max)) return taken;
+
+    taken = __jll_sparse_collect(node->left, base, positions, data, max, taken);
+    if (taken == max) return taken;
+
+    size_t position = base + __jll_sparse_span(node->left) + node->gap;
+
+    if (positions) positions[taken] = position;
+    if (data) data[taken] = node->data;
+    taken++;
+
+    return __jll_sparse_collect(node->right, position + 1, positions, data, max, taken);
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Allocate a sparse list of empty slots
+ *
+ * @param length Initial logical length; costs no memory
+ *
+ * @returns Pointer to the newly created list
+ */
+jll_sparse_t * jll_alloc_sparse(size_t length)
+{
+    JLL_LAT_SCOPE(SPARSE_ALLOC);
+    jll_sparse_t * new_sparse = (jll_sparse_t *)malloc(sizeof(jll_sparse_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_sparse_t));
+
+    new_sparse->root = NULL;
+    new_sparse->length = length;
+    new_sparse->seed = 0x9e3779b97f4a7c15ULL ^ (uintptr_t)new_sparse;
+
+    return new_sparse;
+}
+
+void jll_dealloc_sparse(jll_sparse_t * sparse, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(SPARSE_DEALLOC);
+    assert(sparse);
+
+    __jll_sparse_destroy(sparse->root, data_dealloc_func);
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_sparse_t));
+    free(sparse);
+}
+
+
+/* slot access */
+
+/**
+ * @brief Returns the data in a slot, in O(log n) for n occupied slots
+ *
+ * @param sparse   Pointer to the sparse list
+ * @param position Logical position
+ *
+ * @returns The data, or NULL if the slot is empty (or past the end)
+ */
+const jll_data_t * jll_sparse_get(const jll_sparse_t * sparse, size_t position)
+{
+    JLL_LAT_SCOPE(SPARSE_GET);
+    assert(sparse);
+
+    const jll_sparse_node_t * node = sparse->root;
+
+    while (node)
+    {
+        size_t offset = __jll_sparse_span(node->left) + node->gap;
+
+        if (position < offset)
+        {
+            // Either inside the left subtree or in the gap just before this node.
+            if (position < __jll_sparse_span(node->left)) node = node->left;
+            else return NULL;
+        }
+        else if (position == offset) return node->data;
+        else
+        {
+            position -= offset + 1;
+            node = node->right;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Stores data in a slot without renumbering anything; a position past the end extends the list
+ *
+ * @param sparse   Pointer to the sparse list
+ * @param position Logical position
+ * @param dptr     Data to be stored (must not be NULL)
+ *
+ * @returns The data previously in the slot, or NULL if it was empty
+ */
+const jll_data_t * jll_sparse_set(jll_sparse_t * sparse, size_t position, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(SPARSE_SET);
+    assert(sparse);
+    assert(dptr);
+
+    if (position >= sparse->length) sparse->length = position + 1;
+
+    jll_sparse_node_t * left;
+    jll_sparse_node_t * middle;
+    jll_sparse_node_t * right;
+
+    __jll_sparse_split(sparse->root, position, &left, &right);
+    __jll_sparse_split(right, position - __jll_sparse_span(left) + 1, &middle, &right);
+
+    const jll_data_t * old_data_ptr = NULL;
+
+    if (middle)
+    {
+        old_data_ptr = middle->data;
+        middle->data = dptr;
+    }
+    else
+    {
+        // The new node takes its slot out of the gap in front of the nodes after it.
+        middle = __jll_sparse_new_node(sparse, dptr, position - __jll_sparse_span(left));
+        __jll_sparse_shift_first(right, 0, middle->gap + 1);
+    }
+
+    sparse->root = __jll_sparse_merge(__jll_sparse_merge(left, middle), right);
+    return old_data_ptr;
+}
+
+/**
+ * @brief Empties a slot without renumbering anything
+ *
+ * @returns The data previously in the slot, or NULL if it was already empty
+ */
+const jll_data_t * jll_sparse_clear(jll_sparse_t * sparse, size_t position)
+{
+    JLL_LAT_SCOPE(SPARSE_CLEAR);
+    assert(sparse);
+
+    if (position >= sparse->length) return NULL;
+
+    jll_sparse_node_t * left;
+    jll_sparse_node_t * middle;
+    jll_sparse_node_t * right;
+
+    __jll_sparse_split(sparse->root, position, &left, &right);
+    __jll_sparse_split(right, position - __jll_sparse_span(left) + 1, &middle, &right);
+
+    const jll_data_t * old_data_ptr = NULL;
+
+    if (middle)
+    {
+        __jll_sparse_shift_first(right, middle->gap + 1, 0);
+        old_data_ptr = __jll_sparse_free_node(middle);
+    }
+
+    sparse->root = __jll_sparse_merge(left, right);
+    return old_data_ptr;
+}
+
+
+/* shifting insertion and removal */
+
+/**
+ * @brief Inserts data at a position, moving every later slot (occupied or not) up by one. Only the
+ * gap in front of the next occupied slot changes, so the cost is O(log n) whatever the distance.
+ *
+ * @param sparse   Pointer to the sparse list
+ * @param position Logical position, at most the current length
+ * @param dptr     Data to be inserted (must not be NULL)
+ *
+ * @returns None (is void)
+ */
+void jll_sparse_insert(jll_sparse_t * sparse, size_t position, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(SPARSE_INSERT);
+    assert(sparse);
+    assert(dptr);
+    assert(position <= sparse->length);
+
+    jll_sparse_node_t * left;
+    jll_sparse_node_t * right;
+
+    __jll_sparse_split(sparse->root, position, &left, &right);
+
+    jll_sparse_node_t * middle = __jll_sparse_new_node(sparse, dptr, position - __jll_sparse_span(left));
+    __jll_sparse_shift_first(right, 0, middle->gap);
+
+    sparse->root = __jll_sparse_merge(__jll_sparse_merge(left, middle), right);
+    sparse->length++;
+}
+
+/**
+ * @brief Inserts empty slots at a position, moving every later slot up by count
+ *
+ * @param sparse   Pointer to the sparse list
+ * @param position Logical position, at most the current length
+ * @param count    Number of empty slots
+ *
+ * @returns None (is void)
+ */
+void jll_sparse_insert_gap(jll_sparse_t * sparse, size_t position, size_t count)
+{
+    JLL_LAT_SCOPE(SPARSE_INSERT_GAP);
+    assert(sparse);
+    assert(position <= sparse->length);
+
+    jll_sparse_node_t * left;
+    jll_sparse_node_t * right;
+
+    __jll_sparse_split(sparse->root, position, &left, &right);
+    __jll_sparse_shift_first(right, count, 0);
+
+    sparse->root = __jll_sparse_merge(left, right);
+    sparse->length += count;
+}
+
+/**
+ * @brief Removes a slot, occupied or not, moving every later slot down by one
+ *
+ * @returns The data the slot held, or NULL if it was empty
+ */
+const jll_data_t * jll_sparse_remove(jll_sparse_t * sparse, size_t position)
+{
+    JLL_LAT_SCOPE(SPARSE_REMOVE);
+    assert(sparse);
+    assert(position < sparse->length);
+
+    jll_sparse_node_t * left;
+    jll_sparse_node_t * middle;
+    jll_sparse_node_t * right;
+
+    __jll_sparse_split(sparse->root, position, &left, &right);
+    __jll_sparse_split(right, position - __jll_sparse_span(left) + 1, &middle, &right);
+
+    const jll_data_t * old_data_ptr = NULL;
+
+    if (middle)
+    {
+        __jll_sparse_shift_first(right, middle->gap, 0);
+        old_data_ptr = __jll_sparse_free_node(middle);
+    }
+    else __jll_sparse_shift_first(right, 0, 1);
+
+    sparse->root = __jll_sparse_merge(left, right);
+    sparse->length--;
+
+    return old_data_ptr;
+}
+
+
+/* iteration over occupied slots */
+
+/**
+ * @brief Finds the first occupied slot at or after a position, in O(log n)
+ *
+ * @param sparse   Pointer to the sparse list
+ * @param from     Logical position the search starts at
+ * @param position Receives the position of the slot found (may be NULL)
+ *
+ * @returns The data in that slot, or NULL if every later slot is empty
+ */
+const jll_data_t * jll_sparse_next_occupied(const jll_sparse_t * sparse, size_t from, size_t * position)
+{
+    JLL_LAT_SCOPE(SPARSE_NEXT_OCCUPIED);
+    assert(sparse);
+
+    const jll_sparse_node_t * node = sparse->root;
+    const jll_sparse_node_t * best = NULL;
+    size_t best_position = 0;
+    size_t base = 0;
+
+    while (node)
+    {
+        size_t offset = base + __jll_sparse_span(node->left) + node->gap;
+
+        if (offset >= from)
+        {
+            best = node;
+            best_position = offset;
+            node = node->left;
+        }
+        else
+        {
+            base = offset + 1;
+            node = node->right;
+        }
+    }
+
+    if ((best) && (position)) *position = best_position;
+    return (best) ? best->data : NULL;
+}
+
+/**
+ * @brief Finds the first run of consecutive occupied slots at or after a position; each slot of the run
+ * costs one O(log n) search
+ *
+ * @param sparse Pointer to the sparse list
+ * @param from   Logical position the search starts at
+ * @param start  Receives the position of the run's first slot
+ *
+ * @returns Length of the run, or 0 if every later slot is empty
+ */
+size_t jll_sparse_next_run(const jll_sparse_t * sparse, size_t from, size_t * start)
+{
+    assert(sparse);
+    assert(start);
+
+    size_t position;
+    if (!jll_sparse_next_occupied(sparse, from, &position)) return 0;
+
+    *start = position;
+    size_t run = 1;
+    size_t next;
+
+    while ((jll_sparse_next_occupied(sparse, position + 1, &next)) && (next == position + 1))
+    {
+        position = next;
+        run++;
+    }
+
+    return run;
+}
+
+/**
+ * @brief Copies the occupied slots, in position order, into caller-provided arrays in O(n)
+ *
+ * @param sparse    Pointer to the sparse list
+ * @param positions Receives the logical positions (may be NULL)
+ * @param data      Receives the data (may be NULL)
+ * @param max       Capacity of the arrays
+ *
+ * @returns Number of slots copied
+ */
+size_t jll_sparse_to_arrays(const jll_sparse_t * sparse, size_t * positions, const jll_data_t ** data, size_t max)
+{
+    JLL_LAT_SCOPE(SPARSE_TO_ARRAYS);
+    assert(sparse);
+
+    return __jll_sparse_collect(sparse->root, 0, positions, data, max, 0);
+}
+
+
+/* access functions */
+
+size_t jll_sparse_length(const jll_sparse_t * sparse)
+{
+    assert(sparse);
+    return sparse->length;
+}
+
+size_t jll_sparse_occupied(const jll_sparse_t * sparse)
+{
+    assert(sparse);
+    return __jll_sparse_count(sparse->root);
+}
+
+bool jll_sparse_is_empty(const jll_sparse_t * sparse)
+{
+    return (jll_sparse_occupied(sparse) == 0);
+}
@@ -0,0 +1,291 @@
+
+# include <stdlib.h>
+# include <assert.h>
+# include "./include/wsdeque.h"
+
+
+/* Memory orderings follow Le, Pop, Cohen and Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak
+ * Memory Models" (PPoPP 2013). Indices are signed so the owner's tentative decrement of an empty deque's
+ * bottom stays comparable with top. */
+
+
+/* slot arrays */
+
+static jll_wsdeque_array_t * __jll_wsdeque_new_array(size_t capacity)
+{
+    size_t bytes = sizeof(jll_wsdeque_array_t) + capacity * sizeof(const jll_data_t *);
+    jll_wsdeque_array_t * array = (jll_wsdeque_array_t *)malloc(bytes);
+    JLL_MEM_ADD(JLL_MEM_PAYLOADS, bytes);
+
+    array->retired = NULL;
+    array->capacity = capacity;
+    array->mask = capacity - 1;
+
+    return array;
+}
+
+static void __jll_wsdeque_free_array(jll_wsdeque_array_t * array)
+{
+    JLL_MEM_SUB(JLL_MEM_PAYLOADS, sizeof(jll_wsdeque_array_t) + array->capacity * sizeof(const jll_data_t *));
+    free(array);
+}
+
+static const jll_data_t * __jll_wsdeque_load(const jll_wsdeque_array_t * array, int64_t index)
+{
+    return __atomic_load_n(&array->slots[(size_t)index & array->mask], __ATOMIC_RELAXED);
+}
+
+static void __jll_wsdeque_store(jll_wsdeque_array_t * array, int64_t index, const jll_data_t * dptr)
+{
+    __atomic_store_n(&array->slots[(size_t)index & array->mask], dptr, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Replaces a full slot array with one twice its size. Only the owner grows the deque, and the
+ * elements keep their indices, so thieves racing with the copy read the same element from either array.
+ */
+static jll_wsdeque_array_t * __jll_wsdeque_grow(jll_wsdeque_t * deque, jll_wsdeque_array_t * array, int64_t top, int64_t bottom)
+{
+    jll_wsdeque_array_t * larger = __jll_wsdeque_new_array(array->capacity * 2);
+
+    for (int64_t k = top; k < bottom; k++) __jll_wsdeque_store(larger, k, __jll_wsdeque_load(array, k));
+
+    larger->retired = array;
+    __atomic_store_n(&deque->array, larger, __ATOMIC_RELEASE);
+
+    return larger;
+}
+
+
+/* allocators and deallocators */
+
+/**
+ * @brief Allocate a work-stealing deque
+ *
+ * @param capacity Initial number of slots, rounded up to a power of two (at least JLL_WSDEQUE_MIN_CAPACITY)
+ *
+ * @returns Pointer to the newly created deque
+ */
+jll_wsdeque_t * jll_alloc_wsdeque(size_t capacity)
+{
+    JLL_LAT_SCOPE(WSDEQUE_ALLOC);
+
+    size_t slots = JLL_WSDEQUE_MIN_CAPACITY;
+    while (slots < capacity) slots <<= 1;
+
+    jll_wsdeque_t * new_deque = (jll_wsdeque_t *)aligned_alloc(JLL_WSDEQUE_LINE, sizeof(jll_wsdeque_t));
+    JLL_MEM_ADD(JLL_MEM_HEADERS, sizeof(jll_wsdeque_t));
+
+    new_deque->top = 0;
+    new_deque->bottom = 0;
+    new_deque->array = __jll_wsdeque_new_array(slots);
+
+    return new_deque;
+}
+
+/**
+ * @brief Deallocate a work-stealing deque along with the arrays it has outgrown. No other thread may be
+ * using the deque.
+ *
+ * @param deque Pointer to the deque
+ * @param data_dealloc_func User-specified function releasing the data still queued (may be NULL)
+ *
+ * @returns None (is void)
+ */
+void jll_dealloc_wsdeque(jll_wsdeque_t * deque, void (*data_dealloc_func)(const jll_data_t *))
+{
+    JLL_LAT_SCOPE(WSDEQUE_DEALLOC);
+    assert(deque);
+
+    jll_wsdeque_array_t * array = deque->array;
+
+    if (data_dealloc_func)
+    {
+        for (int64_t k = deque->top; k < deque->bottom; k++) data_dealloc_func(__jll_wsdeque_load(array, k));
+    }
+
+    while (array)
+    {
+        jll_wsdeque_array_t * retired = array->retired;
+        __jll_wsdeque_free_array(array);
+        array = retired;
+    }
+
+    JLL_MEM_SUB(JLL_MEM_HEADERS, sizeof(jll_wsdeque_t));
+    free(deque);
+}
+
+
+/* owner operations */
+
+/**
+ * @brief Push data at the bottom of the deque; only the owning thread may call this
+ *
+ * @param deque Pointer to the deque
+ * @param dptr  Data to be queued (must not be NULL)
+ *
+ * @returns None (is void)
+ */
+void jll_wsdeque_push(jll_wsdeque_t * deque, const jll_data_t * dptr)
+{
+    JLL_LAT_SCOPE(WSDEQUE_PUSH);
+    assert(deque);
+    assert(dptr);
+
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    jll_wsdeque_array_t * array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+
+    if (bottom - top > (int64_t)array->mask) array = __jll_wsdeque_grow(deque, array, top, bottom);
+
+    __jll_wsdeque_store(array, bottom, dptr);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Pop the most recently pushed data; only the owning thread may call this. A compare-and-swap
+ * is needed only when the deque is down to its last element, which a thief may be taking as well.
+ *
+ * @param deque Pointer to the deque
+ *
+ * @returns The data, or NULL if the deque is empty (or a thief took the last element)
+ */
+const jll_data_t * jll_wsdeque_pop(jll_wsdeque_t * deque)
+{
+    JLL_LAT_SCOPE(WSDEQUE_POP);
+    assert(deque);
+
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+    jll_wsdeque_array_t * array = __atomic_load_n(&deque->array, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+    if (top > bottom)
+    {
+        __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    const jll_data_t * dptr = __jll_wsdeque_load(array, bottom);
+    if (top < bottom) return dptr;
+
+    // Last element: settle the race with thieves on top, then leave the deque empty either way.
+    if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) dptr = NULL;
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+
+    return dptr;
+}
+
+
+/* thief operations */
+
+/**
+ * @brief Steal the oldest data from the top of the deque; any thread may call this
+ *
+ * @param deque Pointer to the victim deque
+ * @param out   Receives the stolen data on success
+ *
+ * @returns JLL_STEAL_SUCCESS, JLL_STEAL_EMPTY, or JLL_STEAL_RETRY if another thread took the element first
+ */
+jll_steal_result_t jll_wsdeque_steal(jll_wsdeque_t * deque, const jll_data_t ** out)
+{
+    JLL_LAT_SCOPE(WSDEQUE_STEAL);
+    assert(deque);
+    assert(out);
+
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+    if (top >= bottom) return JLL_STEAL_EMPTY;
+
+    jll_wsdeque_array_t * array = __atomic_load_n(&deque->array, __ATOMIC_ACQUIRE);
+    const jll_data_t * dptr = __jll_wsdeque_load(array, top);
+
+    if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) return JLL_STEAL_RETRY;
+
+    *out = dptr;
+    return JLL_STEAL_SUCCESS;
+}
+
+/**
+ * @brief Steal up to half of the deque (rounded up) in one call. Every element is claimed with its own
+ * compare-and-swap: a single CAS over a range could overlap pops which the owner makes without one.
+ * The batch stops early if the thief loses a race, so the victim is never fought over.
+ *
+ * @param deque Pointer to the victim deque
+ * @param out   Caller-provided array receiving the stolen data, oldest first
+ * @param max   Capacity of out
+ *
+ * @returns Number of elements stolen
+ */
+size_t jll_wsdeque_steal_half(jll_wsdeque_t * deque, const jll_data_t ** out, size_t max)
+{
+    JLL_LAT_SCOPE(WSDEQUE_STEAL_HALF);
+    assert(deque);
+    assert(out || (max == 0));
+
+    size_t want = (jll_wsdeque_size(deque) + 1) / 2;
+    if (want > max) want = max;
+
+    size_t stolen = 0;
+    while ((stolen < want) && (jll_wsdeque_steal(deque, &out[stolen]) == JLL_STEAL_SUCCESS)) stolen++;
+
+    return stolen;
+}
+
+/**
+ * @brief Steal up to half of a victim's deque straight into the thief's own deque; the calling thread
+ * must own the thief deque. The elements keep their order, so the oldest is popped last and stolen first.
+ *
+ * @param victim Pointer to the deque stolen from
+ * @param thief  Pointer to the caller's own deque
+ *
+ * @returns Number of elements moved
+ */
+size_t jll_wsdeque_steal_half_into(jll_wsdeque_t * victim, jll_wsdeque_t * thief)
+{
+    assert(victim);
+    assert(thief);
+    assert(victim != thief);
+
+    size_t want = (jll_wsdeque_size(victim) + 1) / 2;
+    size_t moved = 0;
+    const jll_data_t * dptr;
+
+    while ((moved < want) && (jll_wsdeque_steal(victim, &dptr) == JLL_STEAL_SUCCESS))
+    {
+        jll_wsdeque_push(thief, dptr);
+        moved++;
+    }
+
+    return moved;
+}
+
+
+/* inspection */
+
+size_t jll_wsdeque_size(const jll_wsdeque_t * deque)
+{
+    assert(deque);
+
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+    return (bottom > top) ? (size_t)(bottom - top) : 0;
+}
+
+bool jll_wsdeque_is_empty(const jll_wsdeque_t * deque)
+{
+    return (jll_wsdeque_size(deque) == 0);
+}
+
+size_t jll_wsdeque_capacity(const jll_wsdeque_t * deque)
+{
+    assert(deque);
+    return __atomic_load_n(&deque->array, __ATOMIC_ACQUIRE)->capacity;
+}
@@ -0,0 +1,136 @@
+/*
+ * LRU/LFU cache: the replacement policies pick the expected victims, replacements hand the old data back,
+ * and data which could never fit the byte bound is refused without disturbing the cache.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/cache.h"
+
+# define JLL_TEST_VALUES 64
+
+static int values[JLL_TEST_VALUES];
+static int twins[JLL_TEST_VALUES];
+static size_t evicted;
+static const jll_data_t * last_evicted;
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static size_t __test_hash(const jll_data_t * dptr)
+{
+    return (size_t)*(const int *)dptr * 0x9E3779B97F4A7C15ULL;
+}
+
+static int __test_comp(const jll_data_t * a, const jll_data_t * b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x == y) ? 0 : ((x < y) ? 1 : -1);
+}
+
+static void __test_ignore(const jll_data_t * dptr)
+{
+    (void)dptr;
+}
+
+static void __test_evict(const jll_data_t * dptr)
+{
+    evicted++;
+    last_evicted = dptr;
+}
+
+
+static void test_lru(void)
+{
+    jll_cache_t * cache = jll_alloc_cache(__test_hash, __test_comp, JLL_CACHE_LRU, 3, 0, __test_evict);
+    evicted = 0;
+
+    for (int k = 0; k < 3; k++) assert(jll_cache_put(cache, __test_value(k), 1) == NULL);
+    assert(jll_cache_get(cache, __test_value(0)) == __test_value(0));
+
+    // 1 is now the least recently used.
+    assert(jll_cache_put(cache, __test_value(3), 1) == NULL);
+    assert((evicted == 1) && (last_evicted == __test_value(1)));
+    assert(jll_cache_peek(cache, __test_value(1)) == NULL);
+    assert(jll_cache_length(cache) == 3);
+
+    // A put with an equal key replaces the entry and hands the old data back.
+    assert(jll_cache_put(cache, (const jll_data_t *)&twins[2], 1) == __test_value(2));
+    assert(jll_cache_peek(cache, __test_value(2)) == (const jll_data_t *)&twins[2]);
+    assert(jll_cache_length(cache) == 3);
+
+    assert(jll_cache_remove(cache, __test_value(0)) == __test_value(0));
+    assert(evicted == 1);
+
+    jll_cache_stats_t stats = jll_cache_get_stats(cache);
+    assert((stats.hits == 1) && (stats.insertions == 4) && (stats.evictions == 1));
+
+    jll_dealloc_cache(cache, __test_ignore);
+}
+
+static void test_lfu(void)
+{
+    jll_cache_t * cache = jll_alloc_cache(__test_hash, __test_comp, JLL_CACHE_LFU, 3, 0, __test_evict);
+    evicted = 0;
+
+    for (int k = 0; k < 3; k++) jll_cache_put(cache, __test_value(k), 1);
+    assert(jll_cache_touch(cache, __test_value(0)));
+    assert(jll_cache_touch(cache, __test_value(0)));
+    assert(jll_cache_touch(cache, __test_value(2)));
+
+    // 1 has the fewest accesses.
+    jll_cache_put(cache, __test_value(5), 1);
+    assert((evicted == 1) && (last_evicted == __test_value(1)));
+    assert(jll_cache_peek(cache, __test_value(0)) && jll_cache_peek(cache, __test_value(2)));
+
+    assert(jll_cache_evict(cache));
+    assert(last_evicted == __test_value(5));
+
+    jll_dealloc_cache(cache, __test_ignore);
+}
+
+/**
+ * @brief Sizes count against the byte bound; an entry larger than the bound itself is refused and returned
+ */
+static void test_byte_bound(void)
+{
+    jll_cache_t * cache = jll_alloc_cache(__test_hash, __test_comp, JLL_CACHE_LRU, 0, 10, __test_evict);
+    evicted = 0;
+
+    for (int k = 0; k < 5; k++) jll_cache_put(cache, __test_value(k), 2);
+    assert((jll_cache_bytes(cache) == 10) && (evicted == 0));
+
+    jll_cache_put(cache, __test_value(5), 4);
+    assert((jll_cache_bytes(cache) == 10) && (evicted == 2));
+    assert(jll_cache_peek(cache, __test_value(1)) == NULL);
+
+    assert(jll_cache_put(cache, __test_value(6), 11) == __test_value(6));
+    assert(jll_cache_put(cache, (const jll_data_t *)&twins[5], 11) == (const jll_data_t *)&twins[5]);
+    assert(jll_cache_peek(cache, __test_value(5)) == __test_value(5));
+    assert((jll_cache_bytes(cache) == 10) && (jll_cache_length(cache) == 4) && (evicted == 2));
+
+    jll_cache_resize(cache, 2, 0);
+    assert((jll_cache_length(cache) == 2) && (evicted == 4));
+
+    evicted = 0;
+    jll_dealloc_cache(cache, __test_evict);
+    assert(evicted == 2);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = twins[k] = k;
+
+    test_lru();
+    test_lfu();
+    test_byte_bound();
+
+    printf("test_cache: ok\n");
+    return 0;
+}
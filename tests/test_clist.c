@@ -0,0 +1,225 @@
+/*
+ * Compact (index-linked) list: the conditional removals and dlist import mirror the dlist versions, and
+ * reading an image back refuses any index that points outside the slots actually read.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/clist.h"
+
+# define JLL_TEST_VALUES 32
+
+static int values[JLL_TEST_VALUES];
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static int __test_comp(const jll_data_t * a, const jll_data_t * b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x == y) ? 0 : ((x < y) ? 1 : -1);
+}
+
+static bool __test_odd(const jll_data_t * dptr)
+{
+    return *(const int *)dptr & 1;
+}
+
+static bool __test_none(const jll_data_t * dptr)
+{
+    return *(const int *)dptr < 0;
+}
+
+/**
+ * @brief The list must hold exactly the expected values, in order, with both ends linked as the list says
+ */
+static void __test_clist_holds(jll_clist_t * clist, const int * expected, size_t count)
+{
+    const jll_data_t * out[JLL_TEST_VALUES];
+
+    assert(clist->length == count);
+    assert(jll_clist_to_array(clist, out, JLL_TEST_VALUES) == count);
+    for (size_t k = 0; k < count; k++) assert(out[k] == __test_value(expected[k]));
+
+    if (count == 0) return;
+
+    assert(jll_clist_index_tail(clist) == __test_value(expected[count - 1]));
+    assert(clist->nodes[clist->tail].next == ((clist->circular) ? clist->head : JLL_CLIST_NIL));
+    assert(clist->nodes[clist->head].prev == ((clist->circular) ? clist->tail : JLL_CLIST_NIL));
+}
+
+/**
+ * @brief Writes the list out and reads it straight back
+ */
+static jll_clist_t * __test_round_trip(const jll_clist_t * clist)
+{
+    FILE * stream = tmpfile();
+    assert(stream);
+
+    assert(jll_clist_write(clist, stream));
+    rewind(stream);
+
+    jll_clist_t * copy = jll_clist_read(stream, __test_comp);
+    fclose(stream);
+    return copy;
+}
+
+
+static void test_remove_cond(bool circular)
+{
+    jll_clist_t * clist = jll_alloc_clist(NULL, circular, false);
+    for (int k = 0; k < 10; k++) jll_clist_append_tail(clist, __test_value(k));
+
+    assert(jll_clist_remove_cond_nth(clist, __test_none, 1) == NULL);
+    assert(jll_clist_remove_cond_first_n(clist, __test_none, 3) == NULL);
+
+    assert(jll_clist_remove_cond_nth(clist, __test_odd, 0) == NULL);
+    assert(jll_clist_remove_cond_nth(clist, __test_odd, 2) == __test_value(3));
+    assert(jll_clist_remove_cond_nth(clist, __test_odd, 5) == NULL);
+    assert(jll_clist_remove_cond_nth(clist, __test_odd, 4) == __test_value(9));
+    __test_clist_holds(clist, (const int []){ 0, 1, 2, 4, 5, 6, 7, 8 }, 8);
+
+    jll_data_payload_t * payload = jll_clist_remove_cond_first_n(clist, __test_odd, 2);
+    assert(payload->length == 2);
+    assert((payload->data[0] == __test_value(1)) && (payload->data[1] == __test_value(5)));
+    jll_deallocate_data_payload(payload);
+    __test_clist_holds(clist, (const int []){ 0, 2, 4, 6, 7, 8 }, 6);
+
+    // Asking for more matches than there are takes every match.
+    payload = jll_clist_remove_cond_first_n(clist, __test_odd, 100);
+    assert((payload->length == 1) && (payload->data[0] == __test_value(7)));
+    jll_deallocate_data_payload(payload);
+    __test_clist_holds(clist, (const int []){ 0, 2, 4, 6, 8 }, 5);
+
+    jll_dealloc_clist(clist, NULL);
+}
+
+/**
+ * @brief Import steps over the tombstones of a lazily deleted source and sorts into a sorted list
+ */
+static void test_insert_from_dlist(void)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    jll_dlist_set_lazy_delete(dlist, 1.0);
+    for (int k = 0; k < 6; k++) jll_dlist_append_tail(dlist, __test_value(5 - k));
+    assert(jll_dlist_remove_cond_first(dlist, __test_odd) == __test_value(5));
+
+    jll_clist_t * clist = jll_alloc_clist(NULL, false, false);
+    jll_clist_append_tail(clist, __test_value(9));
+    jll_clist_insert_from_dlist(clist, dlist);
+    __test_clist_holds(clist, (const int []){ 9, 4, 3, 2, 1, 0 }, 6);
+    jll_dealloc_clist(clist, NULL);
+
+    jll_clist_t * sorted = jll_alloc_clist(__test_comp, false, true);
+    jll_clist_append_tail(sorted, __test_value(2));
+    jll_clist_insert_from_dlist(sorted, dlist);
+    __test_clist_holds(sorted, (const int []){ 0, 1, 2, 2, 3, 4 }, 6);
+    jll_dealloc_clist(sorted, NULL);
+
+    assert(dlist->length == 5);
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+static void test_round_trip(bool circular)
+{
+    jll_clist_t * clist = jll_alloc_clist(__test_comp, circular, false);
+    for (int k = 0; k < 8; k++) jll_clist_append_tail(clist, __test_value(k));
+    jll_clist_remove_index(clist, 3);
+    jll_clist_remove_head(clist);
+
+    jll_clist_t * copy = __test_round_trip(clist);
+    assert(copy);
+    __test_clist_holds(copy, (const int []){ 1, 2, 4, 5, 6, 7 }, 6);
+
+    // The free slots come back too and are reused before the array grows.
+    jll_clist_append_head(copy, __test_value(0));
+    jll_clist_append_tail(copy, __test_value(8));
+    assert(copy->used == 8);
+    __test_clist_holds(copy, (const int []){ 0, 1, 2, 4, 5, 6, 7, 8 }, 8);
+
+    jll_dealloc_clist(copy, NULL);
+
+    jll_clist_t * empty = jll_alloc_clist(__test_comp, circular, false);
+    copy = __test_round_trip(empty);
+    assert((copy) && (jll_clist_is_empty(copy)));
+
+    jll_dealloc_clist(copy, NULL);
+    jll_dealloc_clist(empty, NULL);
+    jll_dealloc_clist(clist, NULL);
+}
+
+/**
+ * @brief Each corruption is written out, must be refused on the way back in, and is then undone
+ */
+static void test_bad_images(void)
+{
+    jll_clist_t * clist = jll_alloc_clist(__test_comp, false, false);
+    for (int k = 0; k < 8; k++) jll_clist_append_tail(clist, __test_value(k));
+    jll_clist_remove_index(clist, 2);
+    jll_clist_remove_index(clist, 4);
+
+    uint32_t * fields[] = { &clist->head, &clist->tail, &clist->free_head,
+                            &clist->nodes[clist->head].next, &clist->nodes[clist->tail].prev,
+                            &clist->nodes[clist->free_head].next };
+
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++)
+    {
+        uint32_t saved = *fields[f];
+        uint32_t bad[] = { clist->used, JLL_CLIST_NIL - 1, clist->head, clist->free_head };
+
+        for (size_t b = 0; b < sizeof(bad) / sizeof(bad[0]); b++)
+        {
+            if (bad[b] == saved) continue;
+
+            *fields[f] = bad[b];
+            assert(__test_round_trip(clist) == NULL);
+        }
+
+        *fields[f] = saved;
+    }
+
+    // A NIL where the chain must go on, and a length the chains do not add up to.
+    uint32_t saved = clist->nodes[clist->head].next;
+    clist->nodes[clist->head].next = JLL_CLIST_NIL;
+    assert(__test_round_trip(clist) == NULL);
+    clist->nodes[clist->head].next = saved;
+
+    clist->length--;
+    assert(__test_round_trip(clist) == NULL);
+    clist->length += 2;
+    assert(__test_round_trip(clist) == NULL);
+    clist->length--;
+
+    jll_clist_t * copy = __test_round_trip(clist);
+    assert(copy);
+    __test_clist_holds(copy, (const int []){ 0, 1, 3, 4, 6, 7 }, 6);
+    jll_dealloc_clist(copy, NULL);
+
+    // A linear image may not claim to be circular, nor the other way round.
+    clist->circular = true;
+    assert(__test_round_trip(clist) == NULL);
+    clist->circular = false;
+
+    jll_dealloc_clist(clist, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = k;
+
+    test_remove_cond(false);
+    test_remove_cond(true);
+    test_insert_from_dlist();
+    test_round_trip(false);
+    test_round_trip(true);
+    test_bad_images();
+
+    printf("test_clist: ok\n");
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * Incremental compaction: the list stays usable between steps, so anything done to it in between
+ * (removals, a change of node kind, teardown) must leave every node owned exactly once.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/dlist.h"
+# include "./include/slist.h"
+
+# define JLL_TEST_VALUES 64
+
+static int values[JLL_TEST_VALUES];
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static uint64_t __test_key(const jll_data_t * dptr)
+{
+    return (uint64_t)*(const int *)dptr;
+}
+
+/**
+ * @brief The list must hold values[0 .. count - 1] in order, in nodes its own pool hands out
+ */
+static void __test_dlist_intact(jll_dlist_t * dlist, int count)
+{
+    assert(dlist->length == (size_t)count);
+
+    jll_dnode_t * rover = dlist->head;
+    for (int k = 0; k < count; k++)
+    {
+        assert(rover->data == __test_value(k));
+        assert(jll_pool_owns(dlist->pool, rover));
+        rover = rover->next;
+    }
+}
+
+static void __test_slist_intact(jll_slist_t * slist, int count)
+{
+    assert(slist->length == (size_t)count);
+
+    jll_snode_t * rover = slist->head;
+    for (int k = 0; k < count; k++)
+    {
+        assert(rover->data == __test_value(k));
+        assert(jll_pool_owns(slist->pool, rover));
+        rover = rover->next;
+    }
+}
+
+
+/**
+ * @brief A round trip through keyed nodes between steps moves the list to a new pool of the same node size;
+ * the pass must end there rather than copy nodes into a block the list no longer owns
+ */
+static void test_recast_between_steps(void)
+{
+    jll_compact_t state;
+
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    for (int k = 0; k < 10; k++) jll_dlist_append_tail(dlist, __test_value(k));
+
+    jll_dlist_compact_begin(dlist, &state, false);
+    assert(!jll_dlist_compact_step(dlist, &state, 3));
+
+    assert(jll_dlist_set_key_func(dlist, __test_key));
+    assert(jll_dlist_set_key_func(dlist, NULL));
+    assert(jll_dlist_compact_step(dlist, &state, 3));
+    __test_dlist_intact(dlist, 10);
+
+    jll_dlist_compact_begin(dlist, &state, false);
+    assert(!jll_dlist_compact_step(dlist, &state, 3));
+
+    assert(jll_dlist_set_reorg_policy(dlist, JLL_REORG_COUNT));
+    assert(jll_dlist_set_reorg_policy(dlist, JLL_REORG_NONE));
+    assert(jll_dlist_compact_step(dlist, &state, 3));
+    __test_dlist_intact(dlist, 10);
+
+    jll_dealloc_dlist(dlist, NULL);
+
+    jll_slist_t * slist = jll_alloc_slist(NULL, false, false, false);
+    for (int k = 0; k < 10; k++) jll_slist_append_tail(slist, __test_value(k));
+
+    jll_slist_compact_begin(slist, &state, false);
+    assert(!jll_slist_compact_step(slist, &state, 3));
+
+    assert(jll_slist_set_key_func(slist, __test_key));
+    assert(jll_slist_set_key_func(slist, NULL));
+    assert(jll_slist_compact_step(slist, &state, 3));
+    __test_slist_intact(slist, 10);
+
+    jll_dealloc_slist(slist, NULL);
+}
+
+/**
+ * @brief Removals between steps make the next step re-find its place; a finished pass leaves the list in order
+ */
+static void test_remove_between_steps(void)
+{
+    jll_compact_t state;
+
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    for (int k = 0; k < 20; k++) jll_dlist_append_tail(dlist, __test_value(k));
+
+    jll_dlist_compact_begin(dlist, &state, false);
+    assert(!jll_dlist_compact_step(dlist, &state, 5));
+
+    for (int k = 19; k >= 12; k--) assert(jll_dlist_remove_tail(dlist) == __test_value(k));
+    while (!jll_dlist_compact_step(dlist, &state, 2));
+    __test_dlist_intact(dlist, 12);
+
+    jll_dealloc_dlist(dlist, NULL);
+
+    jll_slist_t * slist = jll_alloc_slist(NULL, false, false, false);
+    for (int k = 0; k < 20; k++) jll_slist_append_tail(slist, __test_value(k));
+
+    jll_slist_compact_begin(slist, &state, false);
+    assert(!jll_slist_compact_step(slist, &state, 5));
+
+    for (int k = 19; k >= 12; k--) assert(jll_slist_remove_index(slist, k) == __test_value(k));
+    while (!jll_slist_compact_step(slist, &state, 2));
+    __test_slist_intact(slist, 12);
+
+    jll_dealloc_slist(slist, NULL);
+}
+
+/**
+ * @brief Tearing a list down part-way through a pass: the list's pool counts every slot of the block as
+ * checked out, so its live count can match the length while heap nodes are still linked
+ */
+static void test_dealloc_between_steps(void)
+{
+    jll_compact_t state;
+
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    for (int k = 0; k < 10; k++) jll_dlist_append_tail(dlist, __test_value(k));
+
+    jll_dlist_compact_begin(dlist, &state, false);
+    assert(!jll_dlist_compact_step(dlist, &state, 3));
+    assert(jll_pool_live(dlist->pool) == dlist->length);
+    jll_dealloc_dlist(dlist, NULL);
+
+    jll_slist_t * slist = jll_alloc_slist(NULL, false, false, false);
+    for (int k = 0; k < 10; k++) jll_slist_append_tail(slist, __test_value(k));
+
+    jll_slist_compact_begin(slist, &state, false);
+    assert(!jll_slist_compact_step(slist, &state, 3));
+    assert(jll_pool_live(slist->pool) == slist->length);
+    jll_dealloc_slist(slist, NULL);
+}
+
+/**
+ * @brief A caller node linked into a pooled list while one of the pool's nodes is out with the caller:
+ * the counts match again, but the pool cannot be dropped under the node the caller still holds
+ */
+static void test_dealloc_with_caller_nodes(void)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    for (int k = 0; k < 10; k++) jll_dlist_append_tail(dlist, __test_value(k));
+    jll_dlist_compact(dlist, false);
+
+    jll_dnode_t * taken = dlist->head;
+    jll_dlist_unlink(dlist, taken);
+    jll_dlist_link_tail(dlist, jll_alloc_dnode(__test_value(10)));
+    assert(jll_pool_live(dlist->pool) == dlist->length);
+
+    jll_dealloc_dlist(dlist, NULL);
+
+    // The pool outlives the list while the node taken out is still checked out of it.
+    assert(taken->data == __test_value(0));
+    jll_dealloc_dnode(taken);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = k;
+
+    test_recast_between_steps();
+    test_remove_between_steps();
+    test_dealloc_between_steps();
+    test_dealloc_with_caller_nodes();
+
+    printf("test_compact: ok\n");
+    return 0;
+}
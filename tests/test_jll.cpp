@@ -0,0 +1,223 @@
+/*
+ * C++ front end: the containers behave like their standard counterparts under the standard algorithms
+ * and ranges, build elements in place without copying them, splice by relinking, and allocate through
+ * their allocator, including a std::pmr::memory_resource.
+ */
+
+# include <cassert>
+# include <cstdio>
+# include <memory_resource>
+# include <ranges>
+# include <string>
+# include <vector>
+# include "./include/jll.hpp"
+
+static int live;
+static int copies;
+
+
+/**
+ * @brief Element which counts its live instances and its copies, and may only be built from its arguments
+ */
+struct tracked
+{
+    int value;
+
+    explicit tracked(int v) : value(v) { live++; }
+    tracked(const tracked & other) : value(other.value) { live++; copies++; }
+    tracked(tracked && other) noexcept : value(other.value) { live++; }
+    ~tracked() { live--; }
+
+    bool operator==(const tracked & other) const { return value == other.value; }
+};
+
+/**
+ * @brief Element using an allocator, which it must receive from the container
+ */
+struct payload
+{
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    std::pmr::string name;
+    int value;
+
+    payload(std::string_view n, int v, const allocator_type & alloc = {}) : name(n, alloc), value(v) {}
+    payload(payload && other, const allocator_type & alloc) : name(std::move(other.name), alloc), value(other.value) {}
+    payload(payload && other) = default;
+};
+
+template <class List>
+static std::vector<int> __test_values(const List & list)
+{
+    return std::vector<int>(list.begin(), list.end());
+}
+
+
+static void test_dlist_algorithms()
+{
+    jll::dlist<int> a{ 5, 3, 1, 4, 2 };
+    assert((a.size() == 5) && (__test_values(a) == std::vector<int>({ 5, 3, 1, 4, 2 })));
+
+    assert(std::ranges::find(a, 4) != a.end());
+    assert(std::ranges::count_if(a, [](int x) { return x & 1; }) == 3);
+    assert(*std::ranges::max_element(a) == 5);
+
+    std::ranges::reverse(a);
+    assert(__test_values(a) == std::vector<int>({ 2, 4, 1, 3, 5 }));
+    assert(std::vector<int>(a.rbegin(), a.rend()) == std::vector<int>({ 5, 3, 1, 4, 2 }));
+
+    std::vector<int> odd;
+    for (int x : a | std::views::filter([](int x) { return x & 1; })) odd.push_back(x);
+    assert(odd == std::vector<int>({ 1, 3, 5 }));
+
+    a.erase(std::ranges::find(a, 1));
+    a.insert(std::ranges::find(a, 3), 9);
+    assert(__test_values(a) == std::vector<int>({ 2, 4, 9, 3, 5 }));
+
+    a.pop_front();
+    a.pop_back();
+    assert((a.front() == 4) && (a.back() == 3));
+
+    // The C list underneath answers the read-only C queries.
+    const jll_dlist_t * c_list = a.c_list();
+    assert(c_list->length == 3);
+    assert(*(const int *)c_list->head->data == 4);
+}
+
+static void test_dlist_splice()
+{
+    jll::dlist<int> a{ 2, 4, 9 };
+    jll::dlist<int> b{ 7, 8 };
+
+    const int * seven = &b.front();
+    a.splice(std::next(a.begin()), b);
+    assert((b.empty()) && (__test_values(a) == std::vector<int>({ 2, 7, 8, 4, 9 })));
+
+    // Splicing relinks nodes, so elements stay where they are in memory.
+    assert(&*std::next(a.begin()) == seven);
+
+    a.splice(a.end(), a, a.begin());
+    assert(__test_values(a) == std::vector<int>({ 7, 8, 4, 9, 2 }));
+
+    a.reverse();
+    assert(__test_values(a) == std::vector<int>({ 2, 9, 4, 8, 7 }));
+    assert(&a.back() == seven);
+}
+
+static void test_slist()
+{
+    jll::slist<int> s{ 1, 2, 3 };
+    s.emplace_back(4);
+    s.emplace_front(0);
+    assert(__test_values(s) == std::vector<int>({ 0, 1, 2, 3, 4 }));
+
+    s.erase_after(s.begin());
+    s.insert_after(s.before_begin(), -1);
+    assert(__test_values(s) == std::vector<int>({ -1, 0, 2, 3, 4 }));
+
+    assert(s.erase_after(std::ranges::find(s, 3)) == s.end());
+    assert(s.back() == 3);
+
+    jll::slist<int> t{ 10, 11 };
+    s.splice_after(s.begin(), t);
+    assert((t.empty()) && (__test_values(s) == std::vector<int>({ -1, 10, 11, 0, 2, 3 })));
+
+    s.erase_after(s.before_begin(), std::next(s.begin(), 3));
+    assert(__test_values(s) == std::vector<int>({ 0, 2, 3 }));
+
+    s.reverse();
+    assert((s.front() == 3) && (s.back() == 0));
+
+    jll::slist<int> u = std::move(s);
+    assert((s.empty()) && (u.size() == 3));
+    s = u;
+    assert(s == u);
+}
+
+/**
+ * @brief Emplacing builds the element in its node; copies and moves of whole lists keep every element accounted for
+ */
+static void test_lifetimes()
+{
+    live = copies = 0;
+
+    {
+        jll::dlist<tracked> a;
+        a.emplace_back(1);
+        a.emplace_front(0);
+        a.emplace(std::next(a.begin()), 5);
+        assert((live == 3) && (copies == 0));
+
+        jll::dlist<tracked> b = std::move(a);
+        assert((a.empty()) && (b.size() == 3) && (live == 3) && (copies == 0));
+
+        jll::dlist<tracked> c = b;
+        assert((c == b) && (live == 6) && (copies == 3));
+
+        c.erase(c.begin(), std::prev(c.end()));
+        assert((c.size() == 1) && (live == 4));
+
+        jll::slist<tracked> s;
+        s.emplace_back(2);
+        s.emplace_after(s.begin(), 3);
+        s.emplace_front(1);
+        assert((s.size() == 3) && (live == 7) && (copies == 3));
+
+        s.clear();
+        assert(live == 4);
+    }
+
+    assert(live == 0);
+}
+
+/**
+ * @brief Nodes come from the list's memory resource, elements receive it as well, and moving a list to a
+ * different resource moves each element into a node of the new one
+ */
+static void test_pmr()
+{
+    char buffer[1 << 16];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    jll::pmr::dlist<payload> p(&arena);
+    p.emplace_back("alpha", 1);
+    p.emplace_front("a name long enough to need an allocation of its own", 2);
+    p.emplace(std::next(p.begin()), "gamma", 3);
+
+    assert((p.size() == 3) && (p.front().value == 2));
+    assert(p.front().name.get_allocator().resource() == &arena);
+
+    auto it = std::ranges::find_if(p, [](const payload & x) { return x.name == "gamma"; });
+    assert((it != p.end()) && (it->value == 3));
+
+    for (const payload & x : p)
+    {
+        const char * at = (const char *)&x;
+        assert((at >= buffer) && (at < buffer + sizeof(buffer)));
+    }
+
+    jll::pmr::dlist<payload> q(std::move(p), &arena);
+    assert((p.empty()) && (q.size() == 3));
+
+    std::pmr::unsynchronized_pool_resource other;
+    jll::pmr::dlist<payload> r(std::move(q), &other);
+    assert((q.empty()) && (r.size() == 3));
+    assert(r.back().name.get_allocator().resource() == &other);
+
+    jll::pmr::slist<std::pmr::string> s(&arena);
+    s.emplace_back("a string long enough to allocate from the arena");
+    assert(s.front().get_allocator().resource() == &arena);
+}
+
+
+int main()
+{
+    test_dlist_algorithms();
+    test_dlist_splice();
+    test_slist();
+    test_lifetimes();
+    test_pmr();
+
+    std::printf("test_jll: ok\n");
+    return 0;
+}
@@ -0,0 +1,163 @@
+
+/*
+ * Cached sort keys and filters: every path which moves nodes into or around a list must leave each
+ * node's key (and the list's Bloom filter) in step with the data the node holds.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/dlist.h"
+# include "./include/slist.h"
+
+# define JLL_TEST_VALUES 64
+
+static int values[JLL_TEST_VALUES];
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static uint64_t __test_key(const jll_data_t * dptr)
+{
+    return (uint64_t)*(const int *)dptr;
+}
+
+static uint64_t __test_hash(const jll_data_t * dptr)
+{
+    return (uint64_t)*(const int *)dptr * 0x9E3779B97F4A7C15ULL;
+}
+
+static int __test_comp(const jll_data_t * a, const jll_data_t * b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x == y) ? 0 : ((x < y) ? 1 : -1);
+}
+
+/**
+ * @brief Every element of the list must be found through its cached key and pass the filter
+ */
+static void __test_dlist_keys_match(jll_dlist_t * dlist)
+{
+    const jll_data_t * out[JLL_TEST_VALUES];
+    size_t count = jll_dlist_to_array(dlist, out, JLL_TEST_VALUES);
+
+    for (size_t k = 0; k < count; k++)
+    {
+        assert(jll_dlist_find_cached_key(dlist, __test_key(out[k])) == out[k]);
+        if (dlist->bloom) assert(jll_dlist_check_if_contains_key(dlist, out[k]));
+    }
+}
+
+static void __test_slist_keys_match(jll_slist_t * slist)
+{
+    const jll_data_t * out[JLL_TEST_VALUES];
+    size_t count = jll_slist_to_array(slist, out, JLL_TEST_VALUES);
+
+    for (size_t k = 0; k < count; k++)
+    {
+        assert(jll_slist_find_cached_key(slist, __test_key(out[k])) == out[k]);
+        if (slist->bloom) assert(jll_slist_check_if_contains_key(slist, out[k]));
+    }
+}
+
+
+static void test_reversal(void)
+{
+    for (int circular = 0; circular < 2; circular++)
+    {
+        jll_dlist_t * dlist = jll_alloc_dlist(__test_comp, circular, false, false);
+        jll_dlist_set_key_func(dlist, __test_key);
+
+        for (int k = 0; k < 9; k++) jll_dlist_append_tail(dlist, __test_value(k));
+
+        jll_dlist_reversal(dlist);
+        __test_dlist_keys_match(dlist);
+
+        for (int k = 0; k < 9; k++) assert(jll_dlist_index_pos(dlist, k) == __test_value(8 - k));
+        assert(*(const int *)jll_dlist_index_head(dlist) == 8);
+        assert(*(const int *)jll_dlist_index_tail(dlist) == 0);
+        assert(jll_dlist_is_circular(dlist) == (bool)circular);
+
+        jll_dealloc_dlist(dlist, NULL);
+    }
+}
+
+static void test_set_operation(void)
+{
+    for (int op = JLL_SET_UNION; op <= JLL_SET_SYMMETRIC_DIFFERENCE; op++)
+    {
+        jll_dlist_t * lone = jll_alloc_dlist(__test_comp, false, true, false);
+        jll_dlist_t * ltwo = jll_alloc_dlist(__test_comp, false, true, false);
+
+        jll_dlist_set_key_func(lone, __test_key);
+        jll_dlist_attach_bloom(lone, __test_hash, 0.01);
+
+        for (int k = 0; k < 30; k += 2) jll_dlist_insert_sorted(lone, __test_value(k));
+        for (int k = 0; k < 30; k += 3) jll_dlist_insert_sorted(ltwo, __test_value(k));
+
+        jll_dlist_set_operation(lone, ltwo, (jll_setop_t)op, NULL);
+        __test_dlist_keys_match(lone);
+        assert(jll_dlist_check_if_sorted(lone));
+
+        jll_dealloc_dlist(lone, NULL);
+        jll_dealloc_dlist(ltwo, NULL);
+
+        jll_slist_t * sone = jll_alloc_slist(__test_comp, false, true, false);
+        jll_slist_t * stwo = jll_alloc_slist(__test_comp, false, true, false);
+
+        jll_slist_set_key_func(sone, __test_key);
+        jll_slist_attach_bloom(sone, __test_hash, 0.01);
+
+        for (int k = 0; k < 30; k += 2) jll_slist_insert_sorted(sone, __test_value(k));
+        for (int k = 0; k < 30; k += 3) jll_slist_insert_sorted(stwo, __test_value(k));
+
+        jll_slist_set_operation(sone, stwo, (jll_setop_t)op, NULL);
+        __test_slist_keys_match(sone);
+
+        jll_dealloc_slist(sone, NULL);
+        jll_dealloc_slist(stwo, NULL);
+    }
+}
+
+static void test_link(void)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(__test_comp, false, false, false);
+    jll_dlist_set_key_func(dlist, __test_key);
+    jll_dlist_attach_bloom(dlist, __test_hash, 0.01);
+
+    jll_dnode_t * tail = &jll_alloc_dknode(__test_value(9))->node;
+    jll_dlist_link_head(dlist, &jll_alloc_dknode(__test_value(7))->node);
+    jll_dlist_link_tail(dlist, tail);
+    jll_dlist_link_before(dlist, &jll_alloc_dknode(__test_value(8))->node, tail);
+    __test_dlist_keys_match(dlist);
+
+    jll_dealloc_dlist(dlist, NULL);
+
+    jll_slist_t * slist = jll_alloc_slist(__test_comp, false, false, false);
+    jll_slist_set_key_func(slist, __test_key);
+    jll_slist_attach_bloom(slist, __test_hash, 0.01);
+
+    jll_slist_link_head(slist, &jll_alloc_sknode(__test_value(3))->node);
+    jll_slist_link_tail(slist, &jll_alloc_sknode(__test_value(5))->node);
+    jll_slist_link_after(slist, &jll_alloc_sknode(__test_value(4))->node, slist->head);
+    __test_slist_keys_match(slist);
+
+    jll_dealloc_slist(slist, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = k;
+
+    test_reversal();
+    test_set_operation();
+    test_link();
+
+    printf("test_keys: ok\n");
+    return 0;
+}
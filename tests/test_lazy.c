@@ -0,0 +1,234 @@
+/*
+ * Lazy deletion: removals bury nodes in place, the ends of a list are always live, queries step over
+ * tombstones without purging them, and a list is settled before another absorbs its nodes wholesale.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/dlist.h"
+
+# define JLL_TEST_VALUES 32
+
+static int values[JLL_TEST_VALUES];
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static uint64_t __test_key(const jll_data_t * dptr)
+{
+    return (uint64_t)*(const int *)dptr;
+}
+
+static int __test_comp(const jll_data_t * a, const jll_data_t * b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x == y) ? 0 : ((x < y) ? 1 : -1);
+}
+
+static bool __test_odd(const jll_data_t * dptr)
+{
+    return *(const int *)dptr & 1;
+}
+
+static jll_dlist_t * __test_dlist(int first, int count, double lazy)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(__test_comp, false, false, false);
+    jll_dlist_set_lazy_delete(dlist, lazy);
+
+    for (int k = first; k < first + count; k++) jll_dlist_append_tail(dlist, __test_value(k));
+    return dlist;
+}
+
+/**
+ * @brief Counts the nodes actually linked, walking forwards and checking every back link on the way
+ */
+static size_t __test_linked(jll_dlist_t * dlist)
+{
+    size_t nodes = 0;
+
+    for (jll_dnode_t * rover = dlist->head; rover; rover = rover->next)
+    {
+        if (rover != dlist->head) assert(rover->prev->next == rover);
+        nodes++;
+    }
+
+    assert(nodes == dlist->length + jll_dlist_tombstones(dlist));
+    return nodes;
+}
+
+/**
+ * @brief The live elements must be exactly the expected values, in order, with live nodes at both ends
+ */
+static void __test_dlist_holds(jll_dlist_t * dlist, const int * expected, size_t count)
+{
+    const jll_data_t * out[JLL_TEST_VALUES];
+
+    assert(dlist->length == count);
+    assert(jll_dlist_to_array(dlist, out, JLL_TEST_VALUES) == count);
+    for (size_t k = 0; k < count; k++) assert(out[k] == __test_value(expected[k]));
+
+    __test_linked(dlist);
+    if (count) assert((dlist->head->data) && (dlist->tail->data));
+}
+
+
+/**
+ * @brief Burying leaves the node linked; queries and positions count live elements only
+ */
+static void test_bury(void)
+{
+    jll_dlist_t * dlist = __test_dlist(0, 10, 1.0);
+
+    assert(jll_dlist_remove_index(dlist, 3) == __test_value(3));
+    assert(jll_dlist_remove_cond_first(dlist, __test_odd) == __test_value(1));
+    assert((dlist->length == 8) && (jll_dlist_tombstones(dlist) == 2));
+
+    assert(jll_dlist_index_pos(dlist, 1) == __test_value(2));
+    assert(jll_dlist_index_pos(dlist, 2) == __test_value(4));
+    assert(jll_dlist_index_pos(dlist, 7) == __test_value(9));
+    assert(jll_dlist_find_first_occurrence(dlist, __test_odd) == __test_value(5));
+    assert(jll_dlist_find_nth_occurrence(dlist, __test_odd, 3) == __test_value(9));
+    __test_dlist_holds(dlist, (const int []){ 0, 2, 4, 5, 6, 7, 8, 9 }, 8);
+
+    // Neither a sortedness check nor a key lookup purges; they are only queries.
+    assert(jll_dlist_check_if_sorted(dlist));
+    assert(jll_dlist_tombstones(dlist) == 2);
+
+    assert(jll_dlist_purge_tombstones(dlist) == 2);
+    assert(jll_dlist_purge_tombstones(dlist) == 0);
+    __test_dlist_holds(dlist, (const int []){ 0, 2, 4, 5, 6, 7, 8, 9 }, 8);
+    assert(__test_linked(dlist) == 8);
+
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+static void test_find_cached_key(void)
+{
+    jll_dlist_t * dlist = __test_dlist(0, 6, 1.0);
+    assert(jll_dlist_set_key_func(dlist, __test_key));
+
+    assert(jll_dlist_remove_index(dlist, 2) == __test_value(2));
+    assert(jll_dlist_find_cached_key(dlist, 2) == NULL);
+    assert(jll_dlist_find_cached_key(dlist, 4) == __test_value(4));
+    assert(jll_dlist_tombstones(dlist) == 1);
+
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+/**
+ * @brief Dead nodes never sit at either end: removing next to them frees the whole dead run at once
+ */
+static void test_trim_ends(void)
+{
+    jll_dlist_t * dlist = __test_dlist(0, 8, 1.0);
+
+    assert(jll_dlist_remove_index(dlist, 1) == __test_value(1));
+    assert(jll_dlist_remove_index(dlist, 1) == __test_value(2));
+    assert(jll_dlist_remove_index(dlist, 4) == __test_value(6));
+    assert(jll_dlist_tombstones(dlist) == 3);
+
+    assert(jll_dlist_remove_head(dlist) == __test_value(0));
+    assert(jll_dlist_tombstones(dlist) == 1);
+    assert(dlist->head->data == __test_value(3));
+
+    assert(jll_dlist_remove_tail(dlist) == __test_value(7));
+    assert(jll_dlist_tombstones(dlist) == 0);
+    __test_dlist_holds(dlist, (const int []){ 3, 4, 5 }, 3);
+
+    // Burying every element leaves nothing linked at all.
+    assert(jll_dlist_remove_index(dlist, 1) == __test_value(4));
+    assert(jll_dlist_remove_index(dlist, 1) == __test_value(5));
+    assert(jll_dlist_remove_index(dlist, 0) == __test_value(3));
+    assert((jll_dlist_is_empty(dlist)) && (jll_dlist_tombstones(dlist) == 0));
+    assert((dlist->head == NULL) && (dlist->tail == NULL));
+
+    jll_dlist_append_tail(dlist, __test_value(9));
+    __test_dlist_holds(dlist, (const int []){ 9 }, 1);
+
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+/**
+ * @brief The list purges itself once the dead nodes make up more than the ratio of all its nodes
+ */
+static void test_ratio(void)
+{
+    jll_dlist_t * dlist = __test_dlist(0, 10, 0.25);
+
+    assert(jll_dlist_remove_index(dlist, 2) == __test_value(2));
+    assert(jll_dlist_remove_index(dlist, 2) == __test_value(3));
+    assert(jll_dlist_tombstones(dlist) == 2);
+
+    // 3 of 10 nodes dead passes a quarter.
+    assert(jll_dlist_remove_index(dlist, 2) == __test_value(4));
+    assert(jll_dlist_tombstones(dlist) == 0);
+    __test_dlist_holds(dlist, (const int []){ 0, 1, 5, 6, 7, 8, 9 }, 7);
+
+    // Turning lazy deletion off purges at once.
+    jll_dlist_remove_index(dlist, 3);
+    assert(jll_dlist_tombstones(dlist) == 1);
+    jll_dlist_set_lazy_delete(dlist, 0);
+    assert(jll_dlist_tombstones(dlist) == 0);
+
+    // With lazy deletion off removals unlink straight away.
+    jll_dlist_remove_index(dlist, 3);
+    assert(jll_dlist_tombstones(dlist) == 0);
+    __test_dlist_holds(dlist, (const int []){ 0, 1, 5, 8, 9 }, 5);
+
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+/**
+ * @brief Concatenation and merging absorb the other list's nodes wholesale, so the donor is purged first;
+ * a merge relinks the receiving list as well and purges it too
+ */
+static void test_settle_before_absorb(void)
+{
+    jll_dlist_t * lone = __test_dlist(0, 5, 1.0);
+    jll_dlist_t * ltwo = __test_dlist(5, 5, 1.0);
+
+    jll_dlist_remove_index(lone, 2);
+    jll_dlist_remove_index(ltwo, 1);
+    jll_dlist_remove_index(ltwo, 2);
+
+    // The receiving list keeps its own tombstones; they stay between live ends.
+    jll_dlist_concat(lone, ltwo);
+    assert(jll_dlist_tombstones(lone) == 1);
+    __test_dlist_holds(lone, (const int []){ 0, 1, 3, 4, 5, 7, 9 }, 7);
+
+    jll_dealloc_dlist(lone, NULL);
+
+    lone = __test_dlist(0, 8, 1.0);
+    ltwo = __test_dlist(4, 8, 1.0);
+
+    assert(jll_dlist_remove_cond_first(lone, __test_odd) == __test_value(1));
+    assert(jll_dlist_remove_cond_first(ltwo, __test_odd) == __test_value(5));
+    assert(jll_dlist_remove_index(ltwo, 3) == __test_value(8));
+
+    jll_dlist_merge_sorted(lone, ltwo);
+    assert(jll_dlist_tombstones(lone) == 0);
+    __test_dlist_holds(lone, (const int []){ 0, 2, 3, 4, 4, 5, 6, 6, 7, 7, 9, 10, 11 }, 13);
+
+    jll_dealloc_dlist(lone, NULL);
+    jll_dealloc_dlist(ltwo, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = k;
+
+    test_bury();
+    test_find_cached_key();
+    test_trim_ends();
+    test_ratio();
+    test_settle_before_absorb();
+
+    printf("test_lazy: ok\n");
+    return 0;
+}
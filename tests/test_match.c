@@ -0,0 +1,243 @@
+/*
+ * Subsequence search: single-pattern searches, streaming feeds and multi-pattern matching are checked
+ * against a brute-force scan over random lists drawn from a small alphabet, so matches overlap often.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/match.h"
+
+# define JLL_TEST_ALPHABET 3
+# define JLL_TEST_ELEMENTS 300
+# define JLL_TEST_PATTERNS 6
+# define JLL_TEST_ROUNDS 40
+
+static int values[JLL_TEST_ALPHABET];
+static int twins[JLL_TEST_ALPHABET];
+
+static const jll_data_t * text[JLL_TEST_ELEMENTS];
+static uint64_t state = 0xD1B54A32D192ED03ULL;
+
+
+static size_t __test_random(size_t bound)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (size_t)(state % bound);
+}
+
+static int __test_comp(const jll_data_t * a, const jll_data_t * b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x == y) ? 0 : ((x < y) ? 1 : -1);
+}
+
+static size_t __test_hash(const jll_data_t * dptr)
+{
+    return (size_t)*(const int *)dptr * 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * @brief Picks one of the alphabet's values, or (when twinned) sometimes its comparator-equal twin
+ */
+static const jll_data_t * __test_element(bool twinned)
+{
+    size_t k = __test_random(JLL_TEST_ALPHABET);
+    return ((twinned) && (__test_random(2))) ? (const jll_data_t *)&twins[k] : (const jll_data_t *)&values[k];
+}
+
+static bool __test_equal(const jll_data_t * a, const jll_data_t * b, bool twinned)
+{
+    return (twinned) ? (__test_comp(a, b) == 0) : (a == b);
+}
+
+/**
+ * @brief Does the pattern occur in the text starting at a position?
+ */
+static bool __test_occurs_at(const jll_data_t * const * pattern, size_t length, size_t position, size_t count, bool twinned)
+{
+    if (position + length > count) return false;
+
+    for (size_t k = 0; k < length; k++)
+    {
+        if (!__test_equal(text[position + k], pattern[k], twinned)) return false;
+    }
+
+    return true;
+}
+
+
+static void test_single(bool twinned)
+{
+    data_compfunc_t comp = (twinned) ? __test_comp : NULL;
+
+    for (size_t round = 0; round < JLL_TEST_ROUNDS; round++)
+    {
+        size_t count = 1 + __test_random(JLL_TEST_ELEMENTS);
+        for (size_t k = 0; k < count; k++) text[k] = __test_element(twinned);
+
+        // A dlist with a few tombstones interleaved, whose positions must count live elements only.
+        jll_slist_t * slist = jll_alloc_slist(NULL, false, false, false);
+        jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+        jll_dlist_set_lazy_delete(dlist, 1.0);
+        size_t buried = 0;
+
+        for (size_t k = 0; k < count; k++)
+        {
+            jll_slist_append_tail(slist, text[k]);
+            jll_dlist_append_tail(dlist, text[k]);
+
+            // Re-append the element behind a filler and bury both earlier nodes, leaving two tombstones mid-list.
+            if ((k) && (__test_random(4) == 0))
+            {
+                jll_dlist_append_tail(dlist, __test_element(twinned));
+                jll_dlist_append_tail(dlist, text[k]);
+                jll_dlist_remove_index(dlist, dlist->length - 3);
+                jll_dlist_remove_index(dlist, dlist->length - 2);
+                buried += 2;
+            }
+        }
+
+        assert((dlist->length == count) && (jll_dlist_tombstones(dlist) == buried));
+
+        const jll_data_t * pattern[JLL_TEST_PATTERNS];
+        size_t length = 1 + __test_random(JLL_TEST_PATTERNS);
+        for (size_t k = 0; k < length; k++) pattern[k] = __test_element(twinned);
+
+        jll_matcher_t * matcher = jll_alloc_matcher(pattern, length, comp);
+
+        size_t expected[JLL_TEST_ELEMENTS];
+        size_t occurrences = 0;
+        for (size_t k = 0; k < count; k++)
+        {
+            if (__test_occurs_at(pattern, length, k, count, twinned)) expected[occurrences++] = k;
+        }
+
+        size_t positions[JLL_TEST_ELEMENTS];
+        assert(jll_slist_find_all_subsequences(slist, matcher, positions, JLL_TEST_ELEMENTS) == occurrences);
+        for (size_t k = 0; k < occurrences; k++) assert(positions[k] == expected[k]);
+        assert(jll_dlist_find_all_subsequences(dlist, matcher, positions, JLL_TEST_ELEMENTS) == occurrences);
+        for (size_t k = 0; k < occurrences; k++) assert(positions[k] == expected[k]);
+
+        // The search stops once the positions are full.
+        if (occurrences > 1) assert(jll_slist_find_all_subsequences(slist, matcher, positions, 1) == 1);
+
+        size_t position = JLL_TEST_ELEMENTS;
+        jll_snode_t * snode = jll_slist_find_subsequence(slist, matcher, &position);
+        jll_dnode_t * dnode = jll_dlist_find_subsequence(dlist, matcher, NULL);
+
+        if (occurrences)
+        {
+            assert((position == expected[0]) && (snode->data == text[expected[0]]));
+            assert(dnode->data == text[expected[0]]);
+            assert(jll_dlist_find_subsequence(dlist, matcher, &position) == dnode);
+            assert(position == expected[0]);
+        }
+        else assert((snode == NULL) && (dnode == NULL));
+
+        // Feeding the elements one at a time finds the same occurrences, by where they end.
+        jll_matcher_reset(matcher);
+        size_t streamed = 0;
+
+        for (size_t k = 0; k < count; k++)
+        {
+            if (jll_matcher_feed(matcher, text[k]))
+            {
+                assert(jll_matcher_position(matcher) - length == expected[streamed]);
+                streamed++;
+            }
+        }
+        assert((streamed == occurrences) && (jll_matcher_position(matcher) == count));
+
+        jll_dealloc_matcher(matcher);
+        jll_dealloc_slist(slist, NULL);
+        jll_dealloc_dlist(dlist, NULL);
+    }
+}
+
+static void test_multiple(bool twinned)
+{
+    data_compfunc_t comp = (twinned) ? __test_comp : NULL;
+    data_hashfunc_t hash = (twinned) ? __test_hash : NULL;
+
+    for (size_t round = 0; round < JLL_TEST_ROUNDS; round++)
+    {
+        size_t count = 1 + __test_random(JLL_TEST_ELEMENTS);
+        for (size_t k = 0; k < count; k++) text[k] = __test_element(twinned);
+
+        jll_slist_t * slist = jll_alloc_slist(NULL, false, false, false);
+        jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+        for (size_t k = 0; k < count; k++) jll_slist_append_tail(slist, text[k]);
+        for (size_t k = 0; k < count; k++) jll_dlist_append_tail(dlist, text[k]);
+
+        const jll_data_t * storage[JLL_TEST_PATTERNS][JLL_TEST_PATTERNS];
+        const jll_data_t * const * patterns[JLL_TEST_PATTERNS];
+        size_t lengths[JLL_TEST_PATTERNS];
+        size_t pattern_count = 1 + __test_random(JLL_TEST_PATTERNS);
+
+        for (size_t p = 0; p < pattern_count; p++)
+        {
+            lengths[p] = 1 + __test_random(JLL_TEST_PATTERNS);
+            for (size_t k = 0; k < lengths[p]; k++) storage[p][k] = __test_element(twinned);
+            patterns[p] = storage[p];
+        }
+
+        jll_multimatcher_t * matcher = jll_alloc_multimatcher(patterns, lengths, pattern_count, comp, hash);
+
+        size_t occurrences = 0;
+        for (size_t k = 0; k < count; k++)
+        {
+            for (size_t p = 0; p < pattern_count; p++) occurrences += __test_occurs_at(patterns[p], lengths[p], k, count, twinned);
+        }
+
+        static jll_match_t matches[JLL_TEST_ELEMENTS * JLL_TEST_PATTERNS];
+        size_t found[2];
+        found[0] = jll_slist_match_patterns(slist, matcher, matches, JLL_TEST_ELEMENTS * JLL_TEST_PATTERNS);
+        assert(found[0] == occurrences);
+
+        // Every match reported is real, and they come ordered by where they end, shortest first.
+        for (size_t m = 0; m < found[0]; m++)
+        {
+            size_t p = matches[m].pattern;
+            assert(__test_occurs_at(patterns[p], lengths[p], matches[m].position, count, twinned));
+
+            if (m == 0) continue;
+            size_t end = matches[m].position + lengths[p];
+            size_t before = matches[m - 1].position + lengths[matches[m - 1].pattern];
+            assert((before < end) || ((before == end) && (lengths[matches[m - 1].pattern] <= lengths[p])));
+        }
+
+        found[1] = jll_dlist_match_patterns(dlist, matcher, matches, JLL_TEST_ELEMENTS * JLL_TEST_PATTERNS);
+        assert(found[1] == occurrences);
+        assert(jll_multimatcher_position(matcher) == count);
+
+        // Streaming counts every pattern ending at each element, even past the capacity of ids.
+        jll_multimatcher_reset(matcher);
+        size_t streamed = 0;
+        size_t ids[1];
+
+        for (size_t k = 0; k < count; k++) streamed += jll_multimatcher_feed(matcher, text[k], ids, 1);
+        assert(streamed == occurrences);
+
+        jll_dealloc_multimatcher(matcher);
+        jll_dealloc_slist(slist, NULL);
+        jll_dealloc_dlist(dlist, NULL);
+    }
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_ALPHABET; k++) values[k] = twins[k] = k;
+
+    test_single(false);
+    test_single(true);
+    test_multiple(false);
+    test_multiple(true);
+
+    printf("test_match: ok\n");
+    return 0;
+}
@@ -0,0 +1,290 @@
+/*
+ * Merges and set algebra over sorted lists: two-way and k-way merges stay sorted and stable, the set
+ * operations treat lists as multisets, and lists with cached keys order by key before calling the
+ * comparison function.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/dlist.h"
+# include "./include/slist.h"
+
+# define JLL_TEST_VALUES 64
+
+static int values[JLL_TEST_VALUES];
+static int twins[JLL_TEST_VALUES];
+static size_t compared;
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static const jll_data_t * __test_twin(int k)
+{
+    return (const jll_data_t *)&twins[k];
+}
+
+static uint64_t __test_key(const jll_data_t * dptr)
+{
+    return (uint64_t)*(const int *)dptr;
+}
+
+static int __test_comp(const jll_data_t * a, const jll_data_t * b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    compared++;
+    return (x == y) ? 0 : ((x < y) ? 1 : -1);
+}
+
+static jll_dlist_t * __test_dlist(const int * ks, size_t count, bool keyed, bool twin)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(__test_comp, false, false, false);
+    if (keyed) jll_dlist_set_key_func(dlist, __test_key);
+
+    for (size_t k = 0; k < count; k++) jll_dlist_append_tail(dlist, twin ? __test_twin(ks[k]) : __test_value(ks[k]));
+    return dlist;
+}
+
+static jll_slist_t * __test_slist(const int * ks, size_t count, bool keyed, bool twin)
+{
+    jll_slist_t * slist = jll_alloc_slist(__test_comp, false, false, false);
+    if (keyed) jll_slist_set_key_func(slist, __test_key);
+
+    for (size_t k = 0; k < count; k++) jll_slist_append_tail(slist, twin ? __test_twin(ks[k]) : __test_value(ks[k]));
+    return slist;
+}
+
+/**
+ * @brief The list must hold exactly the expected data, in order, and be linked consistently both ways
+ */
+static void __test_dlist_holds(jll_dlist_t * dlist, const jll_data_t * const * expected, size_t count)
+{
+    assert(dlist->length == count);
+
+    jll_dnode_t * rover = dlist->head;
+    for (size_t k = 0; k < count; k++)
+    {
+        assert(rover->data == expected[k]);
+        if (k) assert(rover->prev->data == expected[k - 1]);
+        rover = rover->next;
+    }
+
+    assert(rover == NULL);
+    if (count) assert(dlist->tail->data == expected[count - 1]);
+}
+
+static void __test_slist_holds(jll_slist_t * slist, const jll_data_t * const * expected, size_t count)
+{
+    assert(slist->length == count);
+
+    jll_snode_t * rover = slist->head;
+    for (size_t k = 0; k < count; k++)
+    {
+        assert(rover->data == expected[k]);
+        rover = rover->next;
+    }
+
+    assert(rover == NULL);
+    if (count) assert(slist->tail->data == expected[count - 1]);
+}
+
+
+/**
+ * @brief Equal elements keep their order across the merge, those of the receiving list first
+ */
+static void test_merge(bool keyed)
+{
+    jll_dlist_t * lone = __test_dlist((const int []){ 1, 3, 5, 7 }, 4, keyed, false);
+    jll_dlist_t * ltwo = __test_dlist((const int []){ 2, 3, 8 }, 3, keyed, true);
+
+    jll_dlist_merge_sorted(lone, ltwo);
+    __test_dlist_holds(lone, (const jll_data_t *[]){ __test_value(1), __test_twin(2), __test_value(3), __test_twin(3),
+                                                   __test_value(5), __test_value(7), __test_twin(8) }, 7);
+    assert(jll_dlist_is_empty(ltwo));
+
+    jll_dealloc_dlist(lone, NULL);
+    jll_dealloc_dlist(ltwo, NULL);
+
+    jll_slist_t * sone = __test_slist((const int []){ 1, 3, 5, 7 }, 4, keyed, false);
+    jll_slist_t * stwo = __test_slist((const int []){ 2, 3, 8 }, 3, keyed, true);
+
+    jll_slist_merge_sorted(sone, stwo);
+    __test_slist_holds(sone, (const jll_data_t *[]){ __test_value(1), __test_twin(2), __test_value(3), __test_twin(3),
+                                                   __test_value(5), __test_value(7), __test_twin(8) }, 7);
+    assert(jll_slist_is_empty(stwo));
+
+    jll_dealloc_slist(sone, NULL);
+    jll_dealloc_slist(stwo, NULL);
+}
+
+static void test_merge_n(bool keyed)
+{
+    jll_dlist_t * dlist = __test_dlist((const int []){ 4, 9 }, 2, keyed, false);
+    jll_dlist_t * lists[3];
+    lists[0] = __test_dlist((const int []){ 1, 4, 10 }, 3, keyed, true);
+    lists[1] = __test_dlist(NULL, 0, keyed, false);
+    lists[2] = __test_dlist((const int []){ 0, 2, 11, 12 }, 4, keyed, false);
+
+    jll_dlist_merge_sorted_n(dlist, lists, 3);
+    __test_dlist_holds(dlist, (const jll_data_t *[]){ __test_value(0), __test_twin(1), __test_value(2), __test_value(4),
+                                                    __test_twin(4), __test_value(9), __test_twin(10), __test_value(11),
+                                                    __test_value(12) }, 9);
+
+    for (int k = 0; k < 3; k++)
+    {
+        assert(jll_dlist_is_empty(lists[k]));
+        jll_dealloc_dlist(lists[k], NULL);
+    }
+    jll_dealloc_dlist(dlist, NULL);
+
+    jll_slist_t * slist = __test_slist((const int []){ 4, 9 }, 2, keyed, false);
+    jll_slist_t * slists[2];
+    slists[0] = __test_slist((const int []){ 1, 4, 10 }, 3, keyed, true);
+    slists[1] = __test_slist((const int []){ 0, 2, 11, 12 }, 4, keyed, false);
+
+    jll_slist_merge_sorted_n(slist, slists, 2);
+    __test_slist_holds(slist, (const jll_data_t *[]){ __test_value(0), __test_twin(1), __test_value(2), __test_value(4),
+                                                    __test_twin(4), __test_value(9), __test_twin(10), __test_value(11),
+                                                    __test_value(12) }, 9);
+
+    for (int k = 0; k < 2; k++) jll_dealloc_slist(slists[k], NULL);
+    jll_dealloc_slist(slist, NULL);
+}
+
+/**
+ * @brief Every operation over the multisets { 1 2 2 4 6 } and { 2 3 4 4 7 }, in place and into a new list
+ */
+static void test_set_operations(bool keyed)
+{
+    static const int a[] = { 1, 2, 2, 4, 6 };
+    static const int b[] = { 2, 3, 4, 4, 7 };
+
+    struct { jll_setop_t op; int expected[10]; size_t count; } cases[] =
+    {
+        { JLL_SET_UNION,                { 1, 2, 2, 3, 4, 4, 6, 7 }, 8 },
+        { JLL_SET_INTERSECTION,         { 2, 4 },                   2 },
+        { JLL_SET_DIFFERENCE,           { 1, 2, 6 },                3 },
+        { JLL_SET_SYMMETRIC_DIFFERENCE, { 1, 2, 3, 4, 6, 7 },       6 },
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        const jll_data_t * expected[10];
+        for (size_t k = 0; k < cases[c].count; k++) expected[k] = __test_value(cases[c].expected[k]);
+
+        jll_dlist_t * lone = __test_dlist(a, 5, keyed, false);
+        jll_dlist_t * ltwo = __test_dlist(b, 5, keyed, false);
+
+        jll_dlist_t * copy = jll_dlist_set_operation_copy(lone, ltwo, cases[c].op);
+        __test_dlist_holds(copy, expected, cases[c].count);
+        jll_dealloc_dlist(copy, NULL);
+
+        jll_dlist_set_operation(lone, ltwo, cases[c].op, NULL);
+        __test_dlist_holds(lone, expected, cases[c].count);
+        assert(jll_dlist_is_empty(ltwo));
+
+        jll_dealloc_dlist(lone, NULL);
+        jll_dealloc_dlist(ltwo, NULL);
+
+        jll_slist_t * sone = __test_slist(a, 5, keyed, false);
+        jll_slist_t * stwo = __test_slist(b, 5, keyed, false);
+
+        jll_slist_t * scopy = jll_slist_set_operation_copy(sone, stwo, cases[c].op);
+        __test_slist_holds(scopy, expected, cases[c].count);
+        jll_dealloc_slist(scopy, NULL);
+
+        jll_slist_set_operation(sone, stwo, cases[c].op, NULL);
+        __test_slist_holds(sone, expected, cases[c].count);
+
+        jll_dealloc_slist(sone, NULL);
+        jll_dealloc_slist(stwo, NULL);
+    }
+}
+
+/**
+ * @brief With distinct cached keys on both sides, merges and set operations never need the comparison function
+ */
+static void test_keys_decide(void)
+{
+    static const int evens[] = { 0, 2, 4, 6, 8, 10 };
+    static const int odds[] = { 1, 3, 5, 7, 9, 11 };
+    static const int highs[] = { 12, 13, 14, 15, 16, 17 };
+    static const int tops[] = { 6, 18, 19 };
+
+    jll_dlist_t * lone = __test_dlist(evens, 6, true, false);
+    jll_dlist_t * ltwo = __test_dlist(odds, 6, true, false);
+    jll_dlist_t * lthree = __test_dlist(tops + 1, 2, true, false);
+    jll_dlist_t * lists[1] = { __test_dlist(highs, 6, true, false) };
+
+    compared = 0;
+    jll_dlist_t * copy = jll_dlist_set_operation_copy(lone, ltwo, JLL_SET_UNION);
+    jll_dlist_set_operation(lone, ltwo, JLL_SET_SYMMETRIC_DIFFERENCE, NULL);
+    jll_dlist_merge_sorted_n(lone, lists, 1);
+    jll_dlist_merge_sorted(lone, lthree);
+    assert(compared == 0);
+    assert((copy->length == 12) && (lone->length == 20));
+
+    // Equal keys still need the comparison function to tell equal data apart.
+    jll_dlist_t * lfour = __test_dlist(tops, 1, true, true);
+    jll_dlist_merge_sorted(lone, lfour);
+    assert(compared == 1);
+
+    jll_dealloc_dlist(lone, NULL);
+    jll_dealloc_dlist(ltwo, NULL);
+    jll_dealloc_dlist(lthree, NULL);
+    jll_dealloc_dlist(lfour, NULL);
+    jll_dealloc_dlist(copy, NULL);
+    jll_dealloc_dlist(lists[0], NULL);
+
+    jll_slist_t * sone = __test_slist(evens, 6, true, false);
+    jll_slist_t * stwo = __test_slist(odds, 6, true, false);
+    jll_slist_t * slists[1] = { __test_slist(highs, 6, true, false) };
+
+    compared = 0;
+    jll_slist_t * scopy = jll_slist_set_operation_copy(sone, stwo, JLL_SET_UNION);
+    jll_slist_set_operation(sone, stwo, JLL_SET_SYMMETRIC_DIFFERENCE, NULL);
+    jll_slist_merge_sorted_n(sone, slists, 1);
+    assert(compared == 0);
+    assert((scopy->length == 12) && (sone->length == 18));
+
+    jll_dealloc_slist(sone, NULL);
+    jll_dealloc_slist(stwo, NULL);
+    jll_dealloc_slist(scopy, NULL);
+    jll_dealloc_slist(slists[0], NULL);
+}
+
+static void test_unique(void)
+{
+    jll_dlist_t * dlist = __test_dlist((const int []){ 1, 1, 2, 3, 3, 3, 5 }, 7, false, false);
+    assert(jll_dlist_unique(dlist, NULL) == 3);
+    __test_dlist_holds(dlist, (const jll_data_t *[]){ __test_value(1), __test_value(2), __test_value(3), __test_value(5) }, 4);
+    jll_dealloc_dlist(dlist, NULL);
+
+    jll_slist_t * slist = __test_slist((const int []){ 1, 1, 2, 3, 3, 3, 5 }, 7, false, false);
+    assert(jll_slist_unique(slist, NULL) == 3);
+    __test_slist_holds(slist, (const jll_data_t *[]){ __test_value(1), __test_value(2), __test_value(3), __test_value(5) }, 4);
+    jll_dealloc_slist(slist, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = twins[k] = k;
+
+    for (int keyed = 0; keyed < 2; keyed++)
+    {
+        test_merge(keyed);
+        test_merge_n(keyed);
+        test_set_operations(keyed);
+    }
+
+    test_keys_decide();
+    test_unique();
+
+    printf("test_merge: ok\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Conditional removals: remove_cond_first, remove_cond_nth and remove_cond_first_n all unlink and free
+ * what they return, count matches from 1, and terminate on circular lists with no match.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/dlist.h"
+# include "./include/slist.h"
+
+# define JLL_TEST_VALUES 16
+
+static int values[JLL_TEST_VALUES];
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static bool __test_odd(const jll_data_t * dptr)
+{
+    return *(const int *)dptr & 1;
+}
+
+static bool __test_none(const jll_data_t * dptr)
+{
+    return *(const int *)dptr < 0;
+}
+
+/**
+ * @brief The list must hold exactly the expected values, in order, whichever way it is walked
+ */
+static void __test_dlist_holds(jll_dlist_t * dlist, const int * expected, size_t count)
+{
+    const jll_data_t * out[JLL_TEST_VALUES];
+
+    assert(dlist->length == count);
+    assert(jll_dlist_to_array(dlist, out, JLL_TEST_VALUES) == count);
+    for (size_t k = 0; k < count; k++) assert(out[k] == __test_value(expected[k]));
+
+    if (count) assert(dlist->tail->data == __test_value(expected[count - 1]));
+}
+
+static void __test_slist_holds(jll_slist_t * slist, const int * expected, size_t count)
+{
+    const jll_data_t * out[JLL_TEST_VALUES];
+
+    assert(slist->length == count);
+    assert(jll_slist_to_array(slist, out, JLL_TEST_VALUES) == count);
+    for (size_t k = 0; k < count; k++) assert(out[k] == __test_value(expected[k]));
+
+    if (count) assert(slist->tail->data == __test_value(expected[count - 1]));
+}
+
+
+static void test_dlist(bool circular, double lazy)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, circular, false, false);
+    jll_dlist_set_lazy_delete(dlist, lazy);
+    for (int k = 0; k < 10; k++) jll_dlist_append_tail(dlist, __test_value(k));
+
+    assert(jll_dlist_remove_cond_first(dlist, __test_none) == NULL);
+    assert(jll_dlist_remove_cond_nth(dlist, __test_none, 1) == NULL);
+    assert(jll_dlist_remove_cond_first_n(dlist, __test_none, 3) == NULL);
+
+    assert(jll_dlist_remove_cond_first(dlist, __test_odd) == __test_value(1));
+    assert(jll_dlist_remove_cond_nth(dlist, __test_odd, 0) == NULL);
+    assert(jll_dlist_remove_cond_nth(dlist, __test_odd, 2) == __test_value(5));
+    assert(jll_dlist_remove_cond_nth(dlist, __test_odd, 5) == NULL);
+    __test_dlist_holds(dlist, (const int []){ 0, 2, 3, 4, 6, 7, 8, 9 }, 8);
+
+    // The tail is a match like any other.
+    assert(jll_dlist_remove_cond_nth(dlist, __test_odd, 3) == __test_value(9));
+    __test_dlist_holds(dlist, (const int []){ 0, 2, 3, 4, 6, 7, 8 }, 7);
+
+    // Asking for more matches than there are takes every match.
+    jll_data_payload_t * payload = jll_dlist_remove_cond_first_n(dlist, __test_odd, 100);
+    assert(payload->length == 2);
+    assert((payload->data[0] == __test_value(3)) && (payload->data[1] == __test_value(7)));
+    jll_deallocate_data_payload(payload);
+    __test_dlist_holds(dlist, (const int []){ 0, 2, 4, 6, 8 }, 5);
+
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+static void test_slist(bool circular)
+{
+    jll_slist_t * slist = jll_alloc_slist(NULL, circular, false, false);
+    for (int k = 0; k < 10; k++) jll_slist_append_tail(slist, __test_value(k));
+
+    assert(jll_slist_remove_cond_first(slist, __test_none) == NULL);
+    assert(jll_slist_remove_cond_nth(slist, __test_none, 1) == NULL);
+    assert(jll_slist_remove_cond_first_n(slist, __test_none, 3) == NULL);
+
+    assert(jll_slist_remove_cond_first(slist, __test_odd) == __test_value(1));
+    assert(jll_slist_remove_cond_nth(slist, __test_odd, 0) == NULL);
+    assert(jll_slist_remove_cond_nth(slist, __test_odd, 2) == __test_value(5));
+    assert(jll_slist_remove_cond_nth(slist, __test_odd, 5) == NULL);
+    __test_slist_holds(slist, (const int []){ 0, 2, 3, 4, 6, 7, 8, 9 }, 8);
+
+    assert(jll_slist_remove_cond_nth(slist, __test_odd, 3) == __test_value(9));
+    __test_slist_holds(slist, (const int []){ 0, 2, 3, 4, 6, 7, 8 }, 7);
+    if (circular) assert(slist->tail->next == slist->head);
+
+    jll_data_payload_t * payload = jll_slist_remove_cond_first_n(slist, __test_odd, 100);
+    assert(payload->length == 2);
+    assert((payload->data[0] == __test_value(3)) && (payload->data[1] == __test_value(7)));
+    jll_deallocate_data_payload(payload);
+    __test_slist_holds(slist, (const int []){ 0, 2, 4, 6, 8 }, 5);
+
+    jll_dealloc_slist(slist, NULL);
+}
+
+/**
+ * @brief Reversal relinks every node, including the middle one of an odd-length list
+ */
+static void test_reversal(void)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    for (int k = 0; k < 5; k++) jll_dlist_append_tail(dlist, __test_value(k));
+
+    jll_dlist_reversal(dlist);
+    __test_dlist_holds(dlist, (const int []){ 4, 3, 2, 1, 0 }, 5);
+    assert((dlist->head->prev == NULL) && (dlist->tail->next == NULL));
+
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = k;
+
+    test_dlist(false, 0);
+    test_dlist(true, 0);
+    test_dlist(false, 1.0);
+    test_slist(false);
+    test_slist(true);
+    test_reversal();
+
+    printf("test_remove: ok\n");
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Bounded rings: a full ring overwrites or rejects as its policy says, pops and pushes at either end
+ * recycle the nodes preallocated at creation, and the ring stays closed on itself throughout.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/dlist.h"
+# include "./include/slist.h"
+
+# define JLL_TEST_VALUES 64
+# define JLL_TEST_RING 4
+
+static int values[JLL_TEST_VALUES];
+static size_t evicted;
+static const jll_data_t * last_evicted;
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static void __test_evict(const jll_data_t * dptr)
+{
+    evicted++;
+    last_evicted = dptr;
+}
+
+/**
+ * @brief The ring must hold exactly the expected values, be closed on itself both ways, and use only
+ * nodes of the block it was stocked with
+ */
+static void __test_dlist_ring_holds(jll_dlist_t * dlist, const int * expected, size_t count)
+{
+    assert(dlist->length == count);
+    assert(jll_pool_live(dlist->pool) == JLL_TEST_RING);
+    if (count == 0) return;
+
+    jll_dnode_t * rover = dlist->head;
+    for (size_t k = 0; k < count; k++)
+    {
+        assert(rover->data == __test_value(expected[k]));
+        assert(rover->next->prev == rover);
+        assert(jll_pool_owns(dlist->pool, rover));
+        rover = rover->next;
+    }
+
+    assert((rover == dlist->head) && (dlist->head->prev == dlist->tail));
+}
+
+static void __test_slist_ring_holds(jll_slist_t * slist, const int * expected, size_t count)
+{
+    assert(slist->length == count);
+    assert(jll_pool_live(slist->pool) == JLL_TEST_RING);
+    if (count == 0) return;
+
+    jll_snode_t * rover = slist->head;
+    for (size_t k = 0; k < count; k++)
+    {
+        assert(rover->data == __test_value(expected[k]));
+        assert(jll_pool_owns(slist->pool, rover));
+        rover = rover->next;
+    }
+
+    assert(rover == slist->head);
+}
+
+
+static void test_dlist_overwrite(void)
+{
+    jll_dlist_t * ring = jll_alloc_dlist_ring(NULL, JLL_TEST_RING, JLL_RING_OVERWRITE, __test_evict);
+    evicted = 0;
+
+    __test_dlist_ring_holds(ring, NULL, 0);
+    for (int k = 0; k < 4; k++) assert(jll_dlist_ring_push_tail(ring, __test_value(k)));
+    assert((jll_dlist_ring_is_full(ring)) && (evicted == 0));
+
+    // A tail push evicts the head, a head push the tail; plain appends follow the same policy.
+    assert(jll_dlist_ring_push_tail(ring, __test_value(4)));
+    assert((evicted == 1) && (last_evicted == __test_value(0)));
+    assert(jll_dlist_ring_push_head(ring, __test_value(5)));
+    assert((evicted == 2) && (last_evicted == __test_value(4)));
+    jll_dlist_append_tail(ring, __test_value(6));
+    assert((evicted == 3) && (last_evicted == __test_value(5)));
+    __test_dlist_ring_holds(ring, (const int []){ 1, 2, 3, 6 }, 4);
+
+    // Popping and pushing recycles the same nodes.
+    assert(jll_dlist_remove_head(ring) == __test_value(1));
+    assert(jll_dlist_remove_tail(ring) == __test_value(6));
+    assert(!jll_dlist_ring_is_full(ring));
+    __test_dlist_ring_holds(ring, (const int []){ 2, 3 }, 2);
+
+    for (int k = 10; k < 40; k++)
+    {
+        jll_dlist_ring_push_tail(ring, __test_value(k));
+        if (k & 1) jll_dlist_remove_head(ring);
+    }
+    jll_dlist_ring_push_tail(ring, __test_value(40));
+    __test_dlist_ring_holds(ring, (const int []){ 37, 38, 39, 40 }, 4);
+    assert(jll_dlist_index_head(ring) == __test_value(37));
+    assert(jll_dlist_index_tail(ring) == __test_value(40));
+
+    while (!jll_dlist_is_empty(ring)) jll_dlist_remove_tail(ring);
+    __test_dlist_ring_holds(ring, NULL, 0);
+    jll_dlist_ring_push_head(ring, __test_value(7));
+    __test_dlist_ring_holds(ring, (const int []){ 7 }, 1);
+
+    evicted = 0;
+    jll_dealloc_dlist(ring, __test_evict);
+    assert(evicted == 1);
+}
+
+static void test_dlist_reject(void)
+{
+    jll_dlist_t * ring = jll_alloc_dlist_ring(NULL, JLL_TEST_RING, JLL_RING_REJECT, __test_evict);
+    evicted = 0;
+
+    for (int k = 0; k < 4; k++) assert(jll_dlist_ring_push_head(ring, __test_value(k)));
+    assert(!jll_dlist_ring_push_tail(ring, __test_value(4)));
+    assert(!jll_dlist_ring_push_head(ring, __test_value(5)));
+    jll_dlist_append_head(ring, __test_value(6));
+    assert(evicted == 0);
+    __test_dlist_ring_holds(ring, (const int []){ 3, 2, 1, 0 }, 4);
+
+    assert(jll_dlist_remove_head(ring) == __test_value(3));
+    assert(jll_dlist_ring_push_tail(ring, __test_value(4)));
+    __test_dlist_ring_holds(ring, (const int []){ 2, 1, 0, 4 }, 4);
+
+    jll_dealloc_dlist(ring, NULL);
+}
+
+static void test_slist_rings(void)
+{
+    jll_slist_t * ring = jll_alloc_slist_ring(NULL, JLL_TEST_RING, JLL_RING_OVERWRITE, __test_evict);
+    evicted = 0;
+
+    for (int k = 0; k < 6; k++) assert(jll_slist_ring_push_tail(ring, __test_value(k)));
+    assert((evicted == 2) && (last_evicted == __test_value(1)));
+    assert(jll_slist_ring_push_head(ring, __test_value(6)));
+    assert((evicted == 3) && (last_evicted == __test_value(5)));
+    __test_slist_ring_holds(ring, (const int []){ 6, 2, 3, 4 }, 4);
+
+    for (int k = 10; k < 40; k++)
+    {
+        jll_slist_ring_push_tail(ring, __test_value(k));
+        if (k & 1) jll_slist_remove_head(ring);
+    }
+    jll_slist_ring_push_tail(ring, __test_value(40));
+    __test_slist_ring_holds(ring, (const int []){ 37, 38, 39, 40 }, 4);
+
+    jll_dealloc_slist(ring, NULL);
+
+    ring = jll_alloc_slist_ring(NULL, JLL_TEST_RING, JLL_RING_REJECT, NULL);
+
+    for (int k = 0; k < 4; k++) assert(jll_slist_ring_push_tail(ring, __test_value(k)));
+    assert(!jll_slist_ring_push_tail(ring, __test_value(4)));
+    assert(!jll_slist_ring_push_head(ring, __test_value(5)));
+    __test_slist_ring_holds(ring, (const int []){ 0, 1, 2, 3 }, 4);
+
+    assert(jll_slist_remove_tail(ring) == __test_value(3));
+    assert(jll_slist_ring_push_head(ring, __test_value(4)));
+    __test_slist_ring_holds(ring, (const int []){ 4, 0, 1, 2 }, 4);
+
+    jll_dealloc_slist(ring, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = k;
+
+    test_dlist_overwrite();
+    test_dlist_reject();
+    test_slist_rings();
+
+    printf("test_ring: ok\n");
+    return 0;
+}
@@ -0,0 +1,254 @@
+/*
+ * Run-length compressed list: every operation is checked against a plain array of elements, runs stay
+ * maximal for identical pointers, and comparator-equal data joins a run while keeping its first pointer.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/rlist.h"
+
+# define JLL_TEST_VALUES 4
+# define JLL_TEST_ELEMENTS 1024
+# define JLL_TEST_ROUNDS 4000
+
+static int values[JLL_TEST_VALUES];
+static int twins[JLL_TEST_VALUES];
+
+static const jll_data_t * model[JLL_TEST_ELEMENTS];
+static size_t model_length;
+static uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static size_t __test_random(size_t bound)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (size_t)(state % bound);
+}
+
+static int __test_comp(const jll_data_t * a, const jll_data_t * b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x == y) ? 0 : ((x < y) ? 1 : -1);
+}
+
+static bool __test_is_last(const jll_data_t * dptr)
+{
+    return dptr == __test_value(JLL_TEST_VALUES - 1);
+}
+
+/**
+ * @brief Compares the list with the model element by element, run by run and through the queries
+ */
+static void __test_matches_model(jll_rlist_t * rlist)
+{
+    static const jll_data_t * out[JLL_TEST_ELEMENTS];
+    static const jll_data_t * data[JLL_TEST_ELEMENTS];
+    static size_t counts[JLL_TEST_ELEMENTS];
+
+    assert(jll_rlist_length(rlist) == model_length);
+    assert(jll_rlist_to_array(rlist, out, JLL_TEST_ELEMENTS) == model_length);
+
+    size_t runs = 0;
+    size_t first_last = model_length;
+    size_t lasts = 0;
+
+    for (size_t k = 0; k < model_length; k++)
+    {
+        assert(out[k] == model[k]);
+        if ((k == 0) || (model[k] != model[k - 1])) runs++;
+        if (__test_is_last(model[k]))
+        {
+            if (first_last == model_length) first_last = k;
+            lasts++;
+        }
+    }
+
+    // Identical pointers always share a run, however the elements got next to each other.
+    assert(jll_rlist_runs(rlist) == runs);
+    assert(jll_rlist_runs_to_arrays(rlist, data, counts, JLL_TEST_ELEMENTS) == runs);
+
+    size_t position = 0;
+    for (size_t r = 0; r < runs; r++)
+    {
+        assert((counts[r] > 0) && ((r == 0) || (data[r] != data[r - 1])));
+        for (size_t k = 0; k < counts[r]; k++) assert(model[position++] == data[r]);
+    }
+    assert(position == model_length);
+
+    assert(jll_rlist_count_cond(rlist, __test_is_last) == lasts);
+    position = 0;
+    assert(jll_rlist_find_first_occurrence(rlist, __test_is_last, &position) == ((lasts) ? model[first_last] : NULL));
+    if (lasts) assert(position == first_last);
+
+    if (model_length == 0)
+    {
+        assert((jll_rlist_is_empty(rlist)) && (jll_rlist_compression_ratio(rlist) == 1.0));
+        return;
+    }
+
+    assert(jll_rlist_compression_ratio(rlist) == (double)model_length / (double)runs);
+    assert((jll_rlist_index_head(rlist) == model[0]) && (jll_rlist_index_tail(rlist) == model[model_length - 1]));
+
+    // Sequential walks both ways step from the remembered run; random probes jump about.
+    for (size_t k = 0; k < model_length; k++) assert(jll_rlist_index_pos(rlist, k) == model[k]);
+    for (size_t k = model_length; k > 0; k--) assert(jll_rlist_index_pos(rlist, k - 1) == model[k - 1]);
+    for (size_t k = 0; k < 16; k++)
+    {
+        size_t probe = __test_random(model_length);
+        assert(jll_rlist_index_pos(rlist, probe) == model[probe]);
+    }
+    assert(jll_rlist_index_pos(rlist, model_length) == NULL);
+}
+
+static void __test_model_insert(size_t position, const jll_data_t * dptr, size_t count)
+{
+    for (size_t k = model_length; k > position; k--) model[k - 1 + count] = model[k - 1];
+    for (size_t k = 0; k < count; k++) model[position + k] = dptr;
+    model_length += count;
+}
+
+static void __test_model_remove(size_t position, size_t count)
+{
+    for (size_t k = position; k + count < model_length; k++) model[k] = model[k + count];
+    model_length -= count;
+}
+
+
+static void test_against_model(void)
+{
+    jll_rlist_t * rlist = jll_alloc_rlist(NULL);
+
+    for (size_t round = 0; round < JLL_TEST_ROUNDS; round++)
+    {
+        const jll_data_t * dptr = __test_value((int)__test_random(JLL_TEST_VALUES));
+        bool room = (model_length + 8 <= JLL_TEST_ELEMENTS);
+        size_t position;
+        size_t count;
+
+        switch (__test_random((model_length) ? 7 : 3))
+        {
+            case 0:
+                if (!room) break;
+                assert(jll_rlist_append_head(rlist, dptr) == ((model_length) && (model[0] == dptr)));
+                __test_model_insert(0, dptr, 1);
+                break;
+
+            case 1:
+                if (!room) break;
+                count = __test_random(8);
+                assert(jll_rlist_append_tail_n(rlist, dptr, count) == ((count) && (model_length) && (model[model_length - 1] == dptr)));
+                __test_model_insert(model_length, dptr, count);
+                break;
+
+            case 2:
+                if (!room) break;
+                position = __test_random(model_length + 1);
+                jll_rlist_insert_index(rlist, position, dptr);
+                __test_model_insert(position, dptr, 1);
+                break;
+
+            case 3:
+                position = __test_random(model_length);
+                assert(jll_rlist_remove_index(rlist, position) == model[position]);
+                __test_model_remove(position, 1);
+                break;
+
+            case 4:
+                assert(jll_rlist_remove_head(rlist) == model[0]);
+                __test_model_remove(0, 1);
+                break;
+
+            case 5:
+                assert(jll_rlist_remove_tail(rlist) == model[model_length - 1]);
+                __test_model_remove(model_length - 1, 1);
+                break;
+
+            default:
+                position = __test_random(model_length);
+                count = __test_random(12);
+                if (count > model_length - position) count = model_length - position;
+
+                // A range running past the end is clamped to it.
+                size_t asked = ((position + count == model_length) && (__test_random(2))) ? count + 100 : count;
+                assert(jll_rlist_remove_range(rlist, position, asked, NULL) == count);
+                __test_model_remove(position, count);
+                break;
+        }
+
+        __test_matches_model(rlist);
+    }
+
+    jll_dealloc_rlist(rlist, NULL);
+}
+
+/**
+ * @brief With a comparator, equal data joins a run (reported by returning true) and the run keeps its first pointer
+ */
+static void test_comparator_runs(void)
+{
+    jll_rlist_t * rlist = jll_alloc_rlist(__test_comp);
+
+    assert(!jll_rlist_append_tail(rlist, __test_value(1)));
+    assert(jll_rlist_append_tail(rlist, (const jll_data_t *)&twins[1]));
+    assert(jll_rlist_append_tail_n(rlist, (const jll_data_t *)&twins[1], 3));
+    assert(!jll_rlist_append_tail(rlist, __test_value(2)));
+    assert(jll_rlist_insert_index(rlist, 5, (const jll_data_t *)&twins[1]));
+    assert(jll_rlist_append_head(rlist, (const jll_data_t *)&twins[1]));
+
+    assert((jll_rlist_length(rlist) == 8) && (jll_rlist_runs(rlist) == 2));
+    for (size_t k = 0; k < 7; k++) assert(jll_rlist_index_pos(rlist, k) == __test_value(1));
+    assert(jll_rlist_index_tail(rlist) == __test_value(2));
+
+    // Splitting a run: the new element sits between two halves which keep the same pointer.
+    assert(!jll_rlist_insert_index(rlist, 3, __test_value(3)));
+    assert(jll_rlist_runs(rlist) == 4);
+    assert(jll_rlist_remove_index(rlist, 3) == __test_value(3));
+    assert(jll_rlist_runs(rlist) == 2);
+
+    jll_dealloc_rlist(rlist, NULL);
+}
+
+static void test_insert_from_dlist(void)
+{
+    jll_dlist_t * dlist = jll_alloc_dlist(NULL, false, false, false);
+    jll_dlist_set_lazy_delete(dlist, 1.0);
+
+    int ks[] = { 0, 0, 1, 2, 2, 2, 0 };
+    for (size_t k = 0; k < sizeof(ks) / sizeof(ks[0]); k++) jll_dlist_append_tail(dlist, __test_value(ks[k]));
+    assert(jll_dlist_remove_index(dlist, 2) == __test_value(1));
+
+    jll_rlist_t * rlist = jll_alloc_rlist(NULL);
+    jll_rlist_insert_from_dlist(rlist, dlist);
+
+    const jll_data_t * data[4];
+    size_t counts[4];
+    assert(jll_rlist_runs_to_arrays(rlist, data, counts, 4) == 3);
+    assert((data[0] == __test_value(0)) && (counts[0] == 2));
+    assert((data[1] == __test_value(2)) && (counts[1] == 3));
+    assert((data[2] == __test_value(0)) && (counts[2] == 1));
+
+    jll_dealloc_rlist(rlist, NULL);
+    jll_dealloc_dlist(dlist, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = twins[k] = k;
+
+    test_against_model();
+    test_comparator_runs();
+    test_insert_from_dlist();
+
+    printf("test_rlist: ok\n");
+    return 0;
+}
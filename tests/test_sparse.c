@@ -0,0 +1,190 @@
+/*
+ * Sparse positional list: every operation is checked against a plain array of slots, and shifting
+ * operations on a logically huge list renumber later slots without costing memory for the gaps.
+ */
+
+# include <stdio.h>
+# include <assert.h>
+# include "./include/sparse.h"
+
+# define JLL_TEST_VALUES 64
+# define JLL_TEST_SLOTS 512
+# define JLL_TEST_ROUNDS 4000
+
+static int values[JLL_TEST_VALUES];
+
+static const jll_data_t * model[JLL_TEST_SLOTS];
+static size_t model_length;
+static uint64_t state = 0x2545F4914F6CDD1DULL;
+
+
+static const jll_data_t * __test_value(int k)
+{
+    return (const jll_data_t *)&values[k];
+}
+
+static size_t __test_random(size_t bound)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (size_t)(state % bound);
+}
+
+/**
+ * @brief Compares the list with the model slot by slot, and through each of the iteration functions
+ */
+static void __test_matches_model(const jll_sparse_t * sparse)
+{
+    size_t positions[JLL_TEST_SLOTS];
+    const jll_data_t * data[JLL_TEST_SLOTS];
+    size_t occupied = 0;
+
+    assert(jll_sparse_length(sparse) == model_length);
+
+    for (size_t k = 0; k < model_length; k++)
+    {
+        assert(jll_sparse_get(sparse, k) == model[k]);
+        if (model[k]) occupied++;
+    }
+
+    assert(jll_sparse_get(sparse, model_length) == NULL);
+    assert(jll_sparse_occupied(sparse) == occupied);
+    assert(jll_sparse_is_empty(sparse) == (occupied == 0));
+
+    assert(jll_sparse_to_arrays(sparse, positions, data, JLL_TEST_SLOTS) == occupied);
+    for (size_t k = 0; k < occupied; k++) assert(model[positions[k]] == data[k]);
+
+    // Walking the occupied slots and the runs must visit the same slots in the same order.
+    size_t position = 0;
+    size_t visited = 0;
+
+    for (size_t from = 0; jll_sparse_next_occupied(sparse, from, &position); from = position + 1)
+    {
+        assert(position == positions[visited]);
+        visited++;
+    }
+    assert(visited == occupied);
+
+    size_t start = 0;
+    size_t run;
+    visited = 0;
+
+    for (size_t from = 0; (run = jll_sparse_next_run(sparse, from, &start)) > 0; from = start + run)
+    {
+        assert((start == 0) || (!model[start - 1]));
+        assert((start + run == model_length) || (!model[start + run]));
+        for (size_t k = 0; k < run; k++) assert(start + k == positions[visited++]);
+    }
+    assert(visited == occupied);
+}
+
+static void __test_model_shift(size_t position, size_t count)
+{
+    for (size_t k = model_length; k > position; k--) model[k - 1 + count] = model[k - 1];
+    for (size_t k = 0; k < count; k++) model[position + k] = NULL;
+    model_length += count;
+}
+
+
+static void test_against_model(void)
+{
+    jll_sparse_t * sparse = jll_alloc_sparse(40);
+    model_length = 40;
+
+    for (size_t round = 0; round < JLL_TEST_ROUNDS; round++)
+    {
+        const jll_data_t * dptr = __test_value((int)__test_random(JLL_TEST_VALUES));
+        size_t room = JLL_TEST_SLOTS - model_length;
+        size_t position;
+
+        switch (__test_random(5))
+        {
+            case 0:
+                position = __test_random(model_length + ((room) ? 1 : 0));
+                assert(jll_sparse_set(sparse, position, dptr) == ((position < model_length) ? model[position] : NULL));
+                if (position >= model_length) model_length = position + 1;
+                model[position] = dptr;
+                break;
+
+            case 1:
+                position = __test_random(model_length + 1);
+                assert(jll_sparse_clear(sparse, position) == ((position < model_length) ? model[position] : NULL));
+                if (position < model_length) model[position] = NULL;
+                break;
+
+            case 2:
+                if (!room) break;
+                position = __test_random(model_length + 1);
+                jll_sparse_insert(sparse, position, dptr);
+                __test_model_shift(position, 1);
+                model[position] = dptr;
+                break;
+
+            case 3:
+                if (room < 8) break;
+                position = __test_random(model_length + 1);
+                size_t count = __test_random(8);
+                jll_sparse_insert_gap(sparse, position, count);
+                __test_model_shift(position, count);
+                break;
+
+            default:
+                if (!model_length) break;
+                position = __test_random(model_length);
+                assert(jll_sparse_remove(sparse, position) == model[position]);
+                for (size_t k = position; k + 1 < model_length; k++) model[k] = model[k + 1];
+                model_length--;
+                break;
+        }
+
+        __test_matches_model(sparse);
+    }
+
+    jll_dealloc_sparse(sparse, NULL);
+}
+
+/**
+ * @brief A trillion slots with three occupied: positions move by whole gaps at a time
+ */
+static void test_huge(void)
+{
+    const size_t far = (size_t)1 << 40;
+    jll_sparse_t * sparse = jll_alloc_sparse(far);
+
+    jll_sparse_set(sparse, 5, __test_value(0));
+    jll_sparse_set(sparse, far / 2, __test_value(1));
+    jll_sparse_set(sparse, far + 10, __test_value(2));
+    assert((jll_sparse_length(sparse) == far + 11) && (jll_sparse_occupied(sparse) == 3));
+
+    jll_sparse_insert_gap(sparse, 0, far);
+    jll_sparse_insert(sparse, far + 6, __test_value(3));
+    assert(jll_sparse_remove(sparse, 17) == NULL);
+    assert(jll_sparse_length(sparse) == 2 * far + 11);
+
+    size_t positions[4];
+    const jll_data_t * data[4];
+    assert(jll_sparse_to_arrays(sparse, positions, data, 4) == 4);
+    assert((positions[0] == far + 4) && (data[0] == __test_value(0)));
+    assert((positions[1] == far + 5) && (data[1] == __test_value(3)));
+    assert((positions[2] == far + far / 2) && (data[2] == __test_value(1)));
+    assert((positions[3] == 2 * far + 10) && (data[3] == __test_value(2)));
+
+    size_t start;
+    assert(jll_sparse_next_run(sparse, 0, &start) == 2);
+    assert(start == far + 4);
+
+    jll_dealloc_sparse(sparse, NULL);
+}
+
+
+int main(void)
+{
+    for (int k = 0; k < JLL_TEST_VALUES; k++) values[k] = k;
+
+    test_against_model();
+    test_huge();
+
+    printf("test_sparse: ok\n");
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * Work-stealing deque under contention: one owner pushes and pops while thieves steal singly, by halves and
+ * straight into deques of their own (which are stolen from in turn). Every element must be consumed exactly once.
+ */
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <assert.h>
+# include <pthread.h>
+# include "./include/wsdeque.h"
+
+# define JLL_TEST_ITEMS   2000000
+# define JLL_TEST_THIEVES 4
+# define JLL_TEST_BATCH   32
+
+static int items[JLL_TEST_ITEMS];
+static unsigned char seen[JLL_TEST_ITEMS];
+static size_t consumed;
+
+static jll_wsdeque_t * owner_deque;
+static jll_wsdeque_t * thief_deques[JLL_TEST_THIEVES];
+
+
+static void __test_consume(const jll_data_t * dptr)
+{
+    size_t k = (size_t)((const int *)dptr - items);
+
+    assert(k < JLL_TEST_ITEMS);
+    assert(__atomic_fetch_add(&seen[k], 1, __ATOMIC_RELAXED) == 0);
+    __atomic_fetch_add(&consumed, 1, __ATOMIC_RELAXED);
+}
+
+static bool __test_done(void)
+{
+    return __atomic_load_n(&consumed, __ATOMIC_RELAXED) == JLL_TEST_ITEMS;
+}
+
+static uint64_t __test_rand(uint64_t * state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * @brief Pushes every item in bursts of random length (growing the deque well past its initial size),
+ * popping some after each burst, then drains whatever the thieves leave behind
+ */
+static void * __test_owner(void * arg)
+{
+    (void)arg;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    size_t pushed = 0;
+
+    while (pushed < JLL_TEST_ITEMS)
+    {
+        size_t burst = 1 + __test_rand(&rng) % 512;
+        for (size_t k = 0; (k < burst) && (pushed < JLL_TEST_ITEMS); k++) jll_wsdeque_push(owner_deque, (const jll_data_t *)&items[pushed++]);
+
+        size_t pops = __test_rand(&rng) % (burst + 1);
+        for (size_t k = 0; k < pops; k++)
+        {
+            const jll_data_t * dptr = jll_wsdeque_pop(owner_deque);
+            if (!dptr) break;
+            __test_consume(dptr);
+        }
+    }
+
+    while (!__test_done())
+    {
+        const jll_data_t * dptr = jll_wsdeque_pop(owner_deque);
+        if (dptr) __test_consume(dptr);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Thief k steals with the operation k selects: singly, by halves into a buffer, or by halves into its
+ * own deque, which it then pops as its owner. Victims are mostly the owner and sometimes another thief.
+ */
+static void * __test_thief(void * arg)
+{
+    size_t self = (size_t)arg;
+    uint64_t rng = 0xD1B54A32D192ED03ULL * (self + 1);
+    const jll_data_t * batch[JLL_TEST_BATCH];
+
+    while (!__test_done())
+    {
+        size_t pick = __test_rand(&rng) % (4 * JLL_TEST_THIEVES);
+        jll_wsdeque_t * victim = (pick < JLL_TEST_THIEVES) ? thief_deques[pick] : owner_deque;
+        if (victim == thief_deques[self]) victim = owner_deque;
+
+        switch (self % 3)
+        {
+            case 0:
+            {
+                const jll_data_t * dptr;
+                if (jll_wsdeque_steal(victim, &dptr) == JLL_STEAL_SUCCESS) __test_consume(dptr);
+                break;
+            }
+
+            case 1:
+            {
+                size_t stolen = jll_wsdeque_steal_half(victim, batch, JLL_TEST_BATCH);
+                for (size_t k = 0; k < stolen; k++) __test_consume(batch[k]);
+                break;
+            }
+
+            default:
+                jll_wsdeque_steal_half_into(victim, thief_deques[self]);
+                break;
+        }
+
+        // Work taken into the thief's own deque is popped there, unless other thieves get to it first.
+        const jll_data_t * dptr = jll_wsdeque_pop(thief_deques[self]);
+        if (dptr) __test_consume(dptr);
+    }
+
+    return NULL;
+}
+
+
+static void test_exactly_once(void)
+{
+    pthread_t owner;
+    pthread_t thieves[JLL_TEST_THIEVES];
+
+    owner_deque = jll_alloc_wsdeque(0);
+    for (size_t k = 0; k < JLL_TEST_THIEVES; k++) thief_deques[k] = jll_alloc_wsdeque(0);
+
+    pthread_create(&owner, NULL, __test_owner, NULL);
+    for (size_t k = 0; k < JLL_TEST_THIEVES; k++) pthread_create(&thieves[k], NULL, __test_thief, (void *)k);
+
+    pthread_join(owner, NULL);
+    for (size_t k = 0; k < JLL_TEST_THIEVES; k++) pthread_join(thieves[k], NULL);
+
+    for (size_t k = 0; k < JLL_TEST_ITEMS; k++) assert(seen[k] == 1);
+
+    assert(jll_wsdeque_is_empty(owner_deque));
+    assert(jll_wsdeque_capacity(owner_deque) > JLL_WSDEQUE_MIN_CAPACITY);
+    jll_dealloc_wsdeque(owner_deque, NULL);
+
+    for (size_t k = 0; k < JLL_TEST_THIEVES; k++)
+    {
+        assert(jll_wsdeque_is_empty(thief_deques[k]));
+        jll_dealloc_wsdeque(thief_deques[k], NULL);
+    }
+}
+
+/**
+ * @brief Single-threaded: the owner sees its own pushes last in, first out, thieves see them first in, first out
+ */
+static void test_order(void)
+{
+    jll_wsdeque_t * deque = jll_alloc_wsdeque(0);
+    const jll_data_t * dptr;
+
+    for (int k = 0; k < 200; k++) jll_wsdeque_push(deque, (const jll_data_t *)&items[k]);
+    assert(jll_wsdeque_size(deque) == 200);
+
+    assert(jll_wsdeque_steal(deque, &dptr) == JLL_STEAL_SUCCESS);
+    assert(dptr == (const jll_data_t *)&items[0]);
+    assert(jll_wsdeque_pop(deque) == (const jll_data_t *)&items[199]);
+
+    const jll_data_t * batch[JLL_TEST_BATCH];
+    assert(jll_wsdeque_steal_half(deque, batch, JLL_TEST_BATCH) == JLL_TEST_BATCH);
+    for (int k = 0; k < JLL_TEST_BATCH; k++) assert(batch[k] == (const jll_data_t *)&items[1 + k]);
+
+    while (jll_wsdeque_pop(deque));
+    assert(jll_wsdeque_steal(deque, &dptr) == JLL_STEAL_EMPTY);
+
+    jll_dealloc_wsdeque(deque, NULL);
+}
+
+
+int main(void)
+{
+    test_order();
+    test_exactly_once();
+
+    printf("test_wsdeque: ok\n");
+    return 0;
+}